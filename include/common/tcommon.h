@@ -354,6 +354,7 @@ typedef struct SSortExecInfo {
   int32_t loops;       // loop count
   int32_t writeBytes;  // write io bytes
   int32_t readBytes;   // read io bytes
+  int64_t stallTime;   // us, waited for the spill io
 } SSortExecInfo;
 
 typedef struct STUidTagInfo {
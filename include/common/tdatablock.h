@@ -236,8 +236,16 @@ int32_t      blockDataAppendColInfo(SSDataBlock* pBlock, SColumnInfoData* pColIn
 SColumnInfoData  createColumnInfoData(int16_t type, int32_t bytes, int16_t colId);
 SColumnInfoData* bdGetColumnInfoData(const SSDataBlock* pBlock, int32_t index);
 
+// version 2 is the column compressed form of version 1, it is produced by blockCompressEncode only
+#define BLOCK_ENCODE_VERSION      1
+#define BLOCK_ENCODE_CMPR_VERSION 2
+
 int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols);
 const char* blockDecode(SSDataBlock* pBlock, const char* pData);
+int32_t blockCompressEncode(const char* pData, char* pOut);
+int32_t blockCompressGetBound(const char* pData);
+int32_t blockDecompressEncode(const char* pData, char* pOut);
+int32_t blockDecompressGetSize(const char* pData);
 
 void blockDebugShowDataBlock(SSDataBlock* pBlock, const char* flag);
 void blockDebugShowDataBlocks(const SArray* dataBlocks, const char* flag);
@@ -57,6 +57,7 @@ extern int32_t tsNumOfRpcThreads;
 extern int32_t tsNumOfRpcSessions;
 extern int32_t tsTimeToGetAvailableConn;
 extern int32_t tsNumOfCommitThreads;
+extern int32_t tsNumOfCommitFileThreads;
 extern int32_t tsNumOfTaskQueueThreads;
 extern int32_t tsNumOfMnodeQueryThreads;
 extern int32_t tsNumOfMnodeFetchThreads;
@@ -75,9 +76,16 @@ extern int64_t tsRpcQueueMemoryAllowed;
 extern int32_t tsElectInterval;
 extern int32_t tsHeartbeatInterval;
 extern int32_t tsHeartbeatTimeout;
+extern int32_t tsSnapReplWindow;
+extern bool    tsSnapReplCompress;
 
 // vnode
 extern int64_t tsVndCommitMaxIntervalMs;
+extern int32_t tsTsdbPageCacheSize;  // MB
+extern int32_t tsTsdbReadAheadBlocks;
+extern int32_t tsTsdbParallelDecmprSize;  // KB
+extern int32_t tsQueryParallelScan;
+extern int32_t tsRetentionSpeedLimit;  // MB/s
 
 // mnode
 extern int64_t tsMndSdbWriteDelta;
@@ -116,6 +124,7 @@ extern int32_t tsQueryRsmaTolerance;
 extern bool    tsQueryPlannerTrace;
 extern int32_t tsQueryNodeChunkSize;
 extern bool    tsQueryUseNodeAllocator;
+extern int32_t tsQueryPlanCacheSize;
 extern bool    tsKeepColumnName;
 extern bool    tsEnableQueryHb;
 extern bool    tsEnableScience;
@@ -159,6 +168,7 @@ extern char tsUdfdLdLibPath[];
 // schemaless
 extern char tsSmlChildTableName[];
 extern char tsSmlTagName[];
+extern int32_t tsSmlParseThreads;
 // extern bool    tsSmlDataFormat;
 // extern int32_t tsSmlBatchSize;
 
@@ -1190,6 +1190,11 @@ typedef struct {
   int64_t numOfBatchInsertReqs;
   int64_t numOfBatchInsertSuccessReqs;
   int32_t numOfCachedTables;
+  int64_t pageCacheHits;
+  int64_t pageCacheMisses;
+  int64_t migrateSize;   // bytes to move to lower tiers by the running or last retention
+  int64_t migrateDone;   // bytes moved
+  int64_t migrateSpeed;  // bytes per second
 } SVnodeLoad;
 
 typedef struct {
@@ -115,6 +115,13 @@ int32_t dsGetDataBlock(DataSinkHandle handle, SOutputData* pOutput);
 
 int32_t dsGetCacheSize(DataSinkHandle handle, uint64_t* pSize);
 
+/**
+ * Compress the cached blocks that have a column of at least compressSize bytes, -1 disables compression.
+ * @param handle
+ * @param compressSize
+ */
+void dsSetCompressSize(DataSinkHandle handle, int32_t compressSize);
+
 /**
  * After dsGetStatus returns DS_NEED_SCHEDULE, the caller need to put this into the work queue.
  * @param ahandle
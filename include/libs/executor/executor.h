@@ -176,6 +176,14 @@ int32_t qKillTask(qTaskInfo_t tinfo, int32_t rspCode);
 
 bool qTaskIsExecuting(qTaskInfo_t qinfo);
 
+/**
+ * init the thread pool that scans the time ranges of a table scan concurrently, see queryParallelScan
+ * @return
+ */
+int32_t qInitParallelScanPool();
+
+void qCleanupParallelScanPool();
+
 /**
  * destroy query info structure
  * @param qHandle
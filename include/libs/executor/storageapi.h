@@ -164,6 +164,8 @@ typedef struct TsdReader {
   int32_t      (*tsdReaderGetDataBlockDistInfo)();
   int64_t      (*tsdReaderGetNumOfInMemRows)();
   void         (*tsdReaderNotifyClosing)();
+  int32_t      (*tsdReaderSplitTimeWindow)(void* pVnode, const STimeWindow* pWindow, int32_t maxParts,
+                                           SArray* pWindows, int64_t* pVersion);
 } TsdReader;
 
 typedef struct SStoreCacheReader {
@@ -68,6 +68,11 @@ typedef struct SParseContext {
 int32_t qParseSql(SParseContext* pCxt, SQuery** pQuery);
 bool    qIsInsertValuesSql(const char* pStr, size_t length);
 
+// Normalize a select statement into the key of the client plan cache: keywords and identifiers are lower-cased,
+// comments are dropped and blanks are collapsed. The buffer must be at least @length bytes. Returns false if the
+// statement is not a single select or depends on the time or session, such as now() and database().
+bool    qNormalizeQuerySql(const char* pStr, size_t length, char* pBuf, int32_t* pLen);
+
 // for async mode
 int32_t qParseSqlSyntax(SParseContext* pCxt, SQuery** pQuery, struct SCatalogReq* pCatalogReq);
 int32_t qAnalyseSqlSemantic(SParseContext* pCxt, const struct SCatalogReq* pCatalogReq,
@@ -65,6 +65,11 @@ int32_t qMsgToSubplan(const char* pStr, int32_t len, SSubplan** pSubplan);
 
 SQueryPlan* qStringToQueryPlan(const char* pStr);
 
+// Convert the whole query plan to msg, and rebuild it from the msg with the specified query id. The msg is only
+// kept in the local process, e.g. by the plan cache of the client.
+int32_t qQueryPlanToMsg(const SQueryPlan* pPlan, char** pStr, int32_t* pLen);
+int32_t qMsgToQueryPlan(const char* pStr, int32_t len, uint64_t queryId, SQueryPlan** pPlan);
+
 void qDestroyQueryPlan(SQueryPlan* pPlan);
 
 #ifdef __cplusplus
@@ -66,7 +66,9 @@ typedef enum {
 #define QUERY_RSP_POLICY_QUICK 1
 
 #define QUERY_MSG_MASK_SHOW_REWRITE() (1 << 0)
+#define QUERY_MSG_MASK_COMPRESS_RSP() (1 << 1)
 #define TEST_SHOW_REWRITE_MASK(m)     (((m)&QUERY_MSG_MASK_SHOW_REWRITE()) != 0)
+#define TEST_COMPRESS_RSP_MASK(m)     (((m)&QUERY_MSG_MASK_COMPRESS_RSP()) != 0)
 
 typedef struct STableComInfo {
   uint8_t  numOfTags;     // the number of tags in schema
@@ -39,10 +39,13 @@ extern "C" {
 #define SNAPSHOT_MAX_CLOCK_SKEW_MS   1000 * 10
 #define SNAPSHOT_WAIT_MS             1000 * 30
 
-#define SYNC_MAX_RETRY_BACKOFF         5
-#define SYNC_LOG_REPL_RETRY_WAIT_MS    100
-#define SYNC_APPEND_ENTRIES_TIMEOUT_MS 10000
-#define SYNC_HEART_TIMEOUT_MS          1000 * 15
+#define SYNC_MAX_RETRY_BACKOFF          5
+#define SYNC_LOG_REPL_RETRY_WAIT_MS     100
+#define SYNC_LOG_REPL_WINDOW_BYTES      (16 * 1024 * 1024)
+#define SYNC_APPEND_ENTRIES_TIMEOUT_MS  10000
+#define SYNC_APPEND_ENTRIES_BATCH_SIZE  128
+#define SYNC_APPEND_ENTRIES_BATCH_BYTES (1024 * 1024)
+#define SYNC_HEART_TIMEOUT_MS           1000 * 15
 
 #define SYNC_HEARTBEAT_SLOW_MS       1500
 #define SYNC_HEARTBEAT_REPLY_SLOW_MS 1500
@@ -207,6 +210,9 @@ typedef struct SSyncLogStore {
   SyncTerm (*syncLogLastTerm)(struct SSyncLogStore* pLogStore);
 
   int32_t (*syncLogAppendEntry)(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forcSync);
+  // append consecutive entries with one write and at most one fsync
+  int32_t (*syncLogAppendEntryBatch)(struct SSyncLogStore* pLogStore, SSyncRaftEntry** ppEntries, int32_t numOfEntries,
+                                     bool forcSync);
   int32_t (*syncLogGetEntry)(struct SSyncLogStore* pLogStore, SyncIndex index, SSyncRaftEntry** ppEntry);
   int32_t (*syncLogTruncate)(struct SSyncLogStore* pLogStore, SyncIndex fromIndex);
 
@@ -116,6 +116,10 @@ typedef struct SWal {
   // ctl
   int64_t       refId;
   TdThreadMutex mutex;
+  // group commit
+  TdThreadCond fsyncCond;
+  int8_t       fsyncing;
+  int64_t      syncedVer;
   // ref
   SHashObj *pRefHash;  // refId -> SWalRef
   // path
@@ -124,6 +128,14 @@ typedef struct SWal {
   SWalCkHead writeHead;
 } SWal;
 
+typedef struct {
+  int64_t      index;
+  tmsg_t       msgType;
+  SWalSyncInfo syncMeta;
+  const void  *body;
+  int32_t      bodyLen;
+} SWalAppendEntry;
+
 typedef struct {
   int64_t refId;
   int64_t refVer;
@@ -177,6 +189,12 @@ int32_t walWriteWithSyncInfo(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo
 // Assign version automatically and return to caller,
 // -1 will be returned for failed writes
 int64_t walAppendLog(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body, int32_t bodyLen);
+// Append consecutive entries with one writev on the log file and one on the idx file,
+// the index of the last entry will be returned
+int64_t walAppendLogBatch(SWal *, const SWalAppendEntry *pEntries, int32_t numOfEntries);
+
+// Group commit: concurrent callers waiting on an fsync in flight are covered by
+// one fsync, which is done outside of the wal mutex
 
 void walFsync(SWal *, bool force);
 
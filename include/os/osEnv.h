@@ -41,6 +41,7 @@ extern char            tsSSE42Enable;
 extern char            tsAVXEnable;
 extern char            tsAVX2Enable;
 extern char            tsFMAEnable;
+extern char            tsAVX512Enable;
 extern char            tsTagFilterCache;
 
 extern char configDir[];
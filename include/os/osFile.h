@@ -54,6 +54,17 @@ extern "C" {
 
 typedef struct TdFile *TdFilePtr;
 
+#ifdef WINDOWS
+typedef struct {
+  void  *iov_base;
+  size_t iov_len;
+} TdIoVec;
+#else
+typedef struct iovec TdIoVec;
+#endif
+
+#define TD_IOV_MAX 1024
+
 #define TD_FILE_CREATE   0x0001
 #define TD_FILE_WRITE    0x0002
 #define TD_FILE_READ     0x0004
@@ -89,6 +100,7 @@ int64_t taosReadFile(TdFilePtr pFile, void *buf, int64_t count);
 int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset);
 int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count);
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset);
+int64_t taosWritevFile(TdFilePtr pFile, const TdIoVec *iov, int32_t iovcnt);
 void    taosFprintfFile(TdFilePtr pFile, const char *format, ...);
 
 int64_t taosGetLineFile(TdFilePtr pFile, char **__restrict ptrBuf);
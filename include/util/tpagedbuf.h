@@ -27,6 +27,10 @@ extern "C" {
 typedef struct SPageInfo     SPageInfo;
 typedef struct SDiskbasedBuf SDiskbasedBuf;
 
+extern int32_t tsPagedBufDirtyRatio;  // percentage of in-memory pages that may stay dirty, the older ones are written
+                                      // in background, 100 means disabled
+extern bool    tsPagedBufCompress;    // compress the pages flushed to disk
+
 typedef struct SFilePage {
   int32_t num;
   char    data[];
@@ -39,6 +43,9 @@ typedef struct SDiskbasedBufStatis {
   int32_t getPages;
   int32_t releasePages;
   int32_t flushPages;
+  int32_t asyncFlushPages;  // pages written in background
+  int32_t prefetchPages;    // pages read ahead in background
+  int64_t stallTime;        // us, the query thread spent on disk io and waiting for the background io
 } SDiskbasedBufStatis;
 
 /**
@@ -158,6 +165,27 @@ void setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp);
  */
 void dBufSetBufPageRecycled(SDiskbasedBuf* pBuf, void* pPage);
 
+/**
+ * Hint that the pages will be needed soon, the ones on disk are read ahead in background. The number of pages read
+ * ahead but not consumed yet is limited, so later hints may be ignored.
+ * @param pBuf
+ * @param pageIds
+ * @param num
+ */
+void dBufPrefetchPages(SDiskbasedBuf* pBuf, const int32_t* pageIds, int32_t num);
+
+/**
+ * Init the shared thread pool of the background io of paged buffers. Without it, the pages are written when evicted
+ * and loaded when needed on the query thread.
+ * @return
+ */
+int32_t dBufInitIOPool();
+
+/**
+ * Stop the shared thread pool of the background io, all paged buffers must have been destroyed.
+ */
+void dBufCleanupIOPool();
+
 /**
  * Print the statistics when closing this buffer
  * @param pBuf
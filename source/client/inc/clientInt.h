@@ -56,6 +56,7 @@ enum {
 #define TD_RES_TMQ_METADATA(res) (*(int8_t*)res == RES_TYPE__TMQ_METADATA)
 
 typedef struct SAppInstInfo SAppInstInfo;
+typedef struct SPlanCache   SPlanCache;
 
 typedef struct {
   char*   key;
@@ -115,6 +116,7 @@ struct SAppInstInfo {
   void*              pTransporter;
   SAppHbMgr*         pAppHbMgr;
   char*              instKey;
+  SPlanCache*        pPlanCache;
 };
 
 typedef struct SAppInfo {
@@ -183,6 +185,8 @@ typedef struct SReqResultInfo {
   bool           convertUcs4;
   int32_t        payloadLen;
   char*          convertJson;
+  char*          decompBuf;   // the fetched block restored from the column compressed format
+  int32_t        decompBufSize;
 } SReqResultInfo;
 
 typedef struct SRequestSendRecvBody {
@@ -254,6 +258,8 @@ typedef struct SRequestObj {
   uint32_t             retry;
   int64_t              allocatorRefId;
   SQuery*              pQuery;
+  char*                planCacheKey;  // not NULL if the plan of the query can be cached
+  int32_t              planCacheKeyLen;
 } SRequestObj;
 
 typedef struct SSyncQueryParam {
@@ -348,6 +354,10 @@ int32_t buildRequest(uint64_t connId, const char* sql, int sqlLen, void* param,
 
 void taos_close_internal(void* taos);
 
+// --- schemaless
+// the pool of the threads parsing the lines of a schemaless batch, started by the first batch split into tasks
+void smlCleanupParsePool();
+
 // --- heartbeat
 // global, called by mgmt
 int  hbMgrInit();
@@ -382,6 +392,15 @@ int32_t handleCreateTbExecRes(void* res, SCatalog* pCatalog);
 bool    qnodeRequired(SRequestObj* pRequest);
 void    continueInsertFromCsv(SSqlCallbackWrapper* pWrapper, SRequestObj* pRequest);
 void    destorySqlCallbackWrapper(SSqlCallbackWrapper* pWrapper);
+void    launchAsyncCachedQuery(SRequestObj* pRequest, SQueryPlan* pDag, SArray* pMnodeList,
+                               SSqlCallbackWrapper* pWrapper);
+
+// plan cache of the select statements
+SPlanCache* planCacheInit(int32_t sizeMB);
+void        planCacheCleanup(SPlanCache* pCache);
+bool        planCacheLaunchQuery(SRequestObj* pRequest, SSqlCallbackWrapper* pWrapper);
+void        planCachePut(SRequestObj* pRequest, const SQuery* pQuery, const SQueryPlan* pDag, const SArray* pMnodeList);
+void        planCacheRemove(SRequestObj* pRequest);
 
 #ifdef __cplusplus
 }
@@ -248,6 +248,8 @@ STableMeta*       smlGetMeta(SSmlHandle *info, const void* measure, int32_t meas
 int32_t           is_same_child_table_telnet(const void *a, const void *b);
 int64_t           smlParseOpenTsdbTime(SSmlHandle *info, const char *data, int32_t len);
 int32_t           smlClearForRerun(SSmlHandle *info);
+bool              smlCanParseParallel(SSmlHandle *info, int numLines);
+int32_t           smlParseLineParallel(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines);
 int32_t           smlParseValue(SSmlKv *pVal, SSmlMsgBuf *msg);
 uint8_t           smlGetTimestampLen(int64_t num);
 void              clearColValArray(SArray* pCols);
@@ -23,6 +23,7 @@
 #include "scheduler.h"
 #include "tcache.h"
 #include "tglobal.h"
+#include "tpagedbuf.h"
 #include "thttp.h"
 #include "tmsg.h"
 #include "tref.h"
@@ -87,8 +88,8 @@ static void deregisterRequest(SRequestObj *pRequest) {
            "current:%d, app current:%d",
            pRequest->self, pTscObj->id, pRequest->requestId, duration / 1000.0, num, currentInst);
 
-  if (pRequest->pQuery && pRequest->pQuery->pRoot) {
-    if (QUERY_NODE_VNODE_MODIFY_STMT == pRequest->pQuery->pRoot->type &&
+  if (pRequest->pQuery) {
+    if (pRequest->pQuery->pRoot && QUERY_NODE_VNODE_MODIFY_STMT == pRequest->pQuery->pRoot->type &&
         (0 == ((SVnodeModifyOpStmt *)pRequest->pQuery->pRoot)->sqlNodeType)) {
       tscDebug("insert duration %" PRId64 "us: parseCost:%" PRId64 "us, ctgCost:%" PRId64 "us, analyseCost:%" PRId64
                "us, planCost:%" PRId64 "us, exec:%" PRId64 "us",
@@ -231,6 +232,8 @@ void destroyAppInst(SAppInstInfo *pAppInfo) {
   taosArrayDestroy(pAppInfo->pQnodeList);
   taosThreadMutexUnlock(&pAppInfo->qnodeMutex);
 
+  planCacheCleanup(pAppInfo->pPlanCache);
+
   taosMemoryFree(pAppInfo);
 }
 
@@ -343,6 +346,7 @@ void doFreeReqResultInfo(SReqResultInfo *pResInfo) {
   taosMemoryFreeClear(pResInfo->fields);
   taosMemoryFreeClear(pResInfo->userFields);
   taosMemoryFreeClear(pResInfo->convertJson);
+  taosMemoryFreeClear(pResInfo->decompBuf);
 
   if (pResInfo->convertBuf != NULL) {
     for (int32_t i = 0; i < pResInfo->numOfCols; ++i) {
@@ -374,6 +378,7 @@ void doDestroyRequest(void *p) {
 
   taosMemoryFreeClear(pRequest->msgBuf);
   taosMemoryFreeClear(pRequest->pDb);
+  taosMemoryFreeClear(pRequest->planCacheKey);
 
   doFreeReqResultInfo(&pRequest->body.resInfo);
   tsem_destroy(&pRequest->body.rspSem);
@@ -593,6 +598,7 @@ void taos_init_imp(void) {
 #endif
 
   initTaskQueue();
+  dBufInitIOPool();
   fmFuncMgtInit();
   nodesInitAllocatorSet();
 
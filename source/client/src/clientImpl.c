@@ -151,6 +151,7 @@ STscObj* taos_connect_internal(const char* ip, const char* user, const char* pas
       taosMemoryFreeClear(key);
       return NULL;
     }
+    p->pPlanCache = planCacheInit(tsQueryPlanCacheSize);
     taosHashPut(appInfo.pInstMap, key, strlen(key), &p, POINTER_BYTES);
     p->instKey = key;
     key = NULL;
@@ -875,6 +876,10 @@ int32_t handleQueryExecRsp(SRequestObj* pRequest) {
 }
 
 static bool incompletaFileParsing(SNode* pStmt) {
+  // the query restored from the plan cache has no AST
+  if (NULL == pStmt) {
+    return false;
+  }
   return QUERY_NODE_VNODE_MODIFY_STMT != nodeType(pStmt) ? false : ((SVnodeModifyOpStmt*)pStmt)->fileProcessing;
 }
 
@@ -1023,6 +1028,29 @@ SRequestObj* launchQueryImpl(SRequestObj* pRequest, SQuery* pQuery, bool keepQue
   return pRequest;
 }
 
+static int32_t asyncExecSchJob(SRequestObj* pRequest, SQueryPlan* pDag, SArray* pNodeList,
+                               SSqlCallbackWrapper* pWrapper) {
+  SRequestConnInfo conn = {.pTrans = getAppInfo(pRequest)->pTransporter,
+                           .requestId = pRequest->requestId,
+                           .requestObjRefId = pRequest->self};
+  SSchedulerReq    req = {
+         .syncReq = false,
+         .localReq = (tsQueryPolicy == QUERY_POLICY_CLIENT),
+         .pConn = &conn,
+         .pNodeList = pNodeList,
+         .pDag = pDag,
+         .allocatorRefId = pRequest->allocatorRefId,
+         .sql = pRequest->sqlstr,
+         .startTs = pRequest->metric.start,
+         .execFp = schedulerExecCb,
+         .cbParam = pWrapper,
+         .chkKillFp = chkRequestKilled,
+         .chkKillParam = (void*)pRequest->self,
+         .pExecRes = NULL,
+  };
+  return schedulerExecJob(&req, &pRequest->body.queryJob);
+}
+
 static int32_t asyncExecSchQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaData* pResultMeta,
                                  SSqlCallbackWrapper* pWrapper) {
   pRequest->type = pQuery->msgType;
@@ -1060,25 +1088,10 @@ static int32_t asyncExecSchQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaDat
       buildAsyncExecNodeList(pRequest, &pNodeList, pMnodeList, pResultMeta);
     }
 
-    SRequestConnInfo conn = {.pTrans = getAppInfo(pRequest)->pTransporter,
-                             .requestId = pRequest->requestId,
-                             .requestObjRefId = pRequest->self};
-    SSchedulerReq    req = {
-           .syncReq = false,
-           .localReq = (tsQueryPolicy == QUERY_POLICY_CLIENT),
-           .pConn = &conn,
-           .pNodeList = pNodeList,
-           .pDag = pDag,
-           .allocatorRefId = pRequest->allocatorRefId,
-           .sql = pRequest->sqlstr,
-           .startTs = pRequest->metric.start,
-           .execFp = schedulerExecCb,
-           .cbParam = pWrapper,
-           .chkKillFp = chkRequestKilled,
-           .chkKillParam = (void*)pRequest->self,
-           .pExecRes = NULL,
-    };
-    code = schedulerExecJob(&req, &pRequest->body.queryJob);
+    // the plan is cached before it is scheduled, since the scheduler changes it when executing
+    planCachePut(pRequest, pQuery, pDag, pMnodeList);
+
+    code = asyncExecSchJob(pRequest, pDag, pNodeList, pWrapper);
     taosArrayDestroy(pNodeList);
   } else {
     tscDebug("0x%" PRIx64 " plan not executed, code:%s 0x%" PRIx64, pRequest->self, tstrerror(code),
@@ -1137,6 +1150,36 @@ void launchAsyncQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaData* pResultM
   }
 }
 
+// launch the select statement with the plan restored from the plan cache, the query has been set to the request
+void launchAsyncCachedQuery(SRequestObj* pRequest, SQueryPlan* pDag, SArray* pMnodeList,
+                            SSqlCallbackWrapper* pWrapper) {
+  pRequest->type = pRequest->pQuery->msgType;
+  pRequest->body.execMode = QUERY_EXEC_MODE_SCHEDULE;
+  pRequest->body.subplanNum = pDag->numOfSubplans;
+
+  if (!pRequest->inRetry) {
+    SAppClusterSummary* pActivity = &pRequest->pTscObj->pAppInfo->summary;
+    atomic_add_fetch_64((int64_t*)&pActivity->numOfQueryReq, 1);
+  }
+
+  pRequest->metric.execStart = taosGetTimestampUs();
+
+  // the vgroups of the databases are in the cache of catalog, which has been checked by the plan cache
+  SArray* pNodeList = NULL;
+  int32_t code = buildSyncExecNodeList(pRequest, &pNodeList, pMnodeList);
+  if (TSDB_CODE_SUCCESS == code) {
+    asyncExecSchJob(pRequest, pDag, pNodeList, pWrapper);
+  } else {
+    tscError("0x%" PRIx64 " failed to build node list for cached plan, code:%s 0x%" PRIx64, pRequest->self,
+             tstrerror(code), pRequest->requestId);
+    qDestroyQueryPlan(pDag);
+    destorySqlCallbackWrapper(pWrapper);
+    pRequest->code = code;
+    pRequest->body.queryFp(pRequest->body.param, pRequest, code);
+  }
+  taosArrayDestroy(pNodeList);
+}
+
 int32_t refreshMeta(STscObj* pTscObj, SRequestObj* pRequest) {
   SCatalog* pCatalog = NULL;
   int32_t   code = 0;
@@ -1999,6 +2042,31 @@ void resetConnectDB(STscObj* pTscObj) {
   taosThreadMutexUnlock(&pTscObj->mutex);
 }
 
+static int32_t doDecompressResultBlock(SReqResultInfo* pResultInfo) {
+  if (*(int32_t*)pResultInfo->pData != BLOCK_ENCODE_CMPR_VERSION) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t len = blockDecompressGetSize(pResultInfo->pData);
+  if (len > pResultInfo->decompBufSize) {
+    char* p = taosMemoryRealloc(pResultInfo->decompBuf, len);
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    pResultInfo->decompBuf = p;
+    pResultInfo->decompBufSize = len;
+  }
+
+  if (blockDecompressEncode(pResultInfo->pData, pResultInfo->decompBuf) < 0) {
+    tscError("failed to decompress the result block, code:%s", tstrerror(terrno));
+    return terrno != 0 ? terrno : TSDB_CODE_TSC_INTERNAL_ERROR;
+  }
+
+  pResultInfo->pData = pResultInfo->decompBuf;
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t setQueryResultFromRsp(SReqResultInfo* pResultInfo, const SRetrieveTableRsp* pRsp, bool convertUcs4,
                               bool freeAfterUse) {
   if (pResultInfo == NULL || pRsp == NULL) {
@@ -2016,7 +2084,13 @@ int32_t setQueryResultFromRsp(SReqResultInfo* pResultInfo, const SRetrieveTableR
   pResultInfo->payloadLen = htonl(pRsp->compLen);
   pResultInfo->precision = pRsp->precision;
 
-  // TODO handle the compressed case
+  if (pRsp->compressed && pResultInfo->numOfRows > 0) {
+    int32_t code = doDecompressResultBlock(pResultInfo);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
   pResultInfo->totalRows += pResultInfo->numOfRows;
   return setResultDataPtr(pResultInfo, pResultInfo->fields, pResultInfo->numOfCols, pResultInfo->numOfRows,
                           convertUcs4);
@@ -23,6 +23,7 @@
 #include "scheduler.h"
 #include "tdatablock.h"
 #include "tglobal.h"
+#include "tpagedbuf.h"
 #include "tmsg.h"
 #include "tref.h"
 #include "trpc.h"
@@ -78,6 +79,8 @@ void taos_cleanup(void) {
   tscDebug("rpc cleanup");
 
   cleanupTaskQueue();
+  dBufCleanupIOPool();
+  smlCleanupParsePool();
 
   taosConvDestroy();
 
@@ -990,6 +993,15 @@ void doAsyncQuery(SRequestObj *pRequest, bool updateMetaForce) {
     }
   }
 
+  if (TSDB_CODE_SUCCESS == code) {
+    if (updateMetaForce) {
+      // the cached plan may be built on the outdated metadata
+      planCacheRemove(pRequest);
+    } else if (planCacheLaunchQuery(pRequest, pWrapper)) {
+      return;
+    }
+  }
+
   if (TSDB_CODE_SUCCESS == code) {
     code = createParseContext(pRequest, &pWrapper->pParseCtx);
   }
@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catalog.h"
+#include "clientInt.h"
+#include "clientLog.h"
+#include "tglobal.h"
+#include "tlrucache.h"
+
+/*
+ * The plan cache keeps the physical plans of the select statements of an app instance. The key is the normalized sql
+ * together with the user, the current database and the client options that change the plan, so a repeated statement
+ * skips parsing, fetching the metadata, translating and planning.
+ *
+ * The versions of the databases (vgroup version), the tables (schema and tag version) and the user (privilege version)
+ * known by the catalog when the plan is created are kept with the plan, the plan is dropped once any of them changes.
+ * The plan is also dropped if the query has to be retried with the metadata refreshed.
+ */
+
+struct SPlanCache {
+  SLRUCache* pCache;
+  int64_t    hitNum;
+  int64_t    missNum;
+  int64_t    expiredNum;
+};
+
+typedef struct SPlanCacheDbVer {
+  int64_t dbId;  // a dropped and recreated db has the same name but a new id
+  int32_t vgVersion;
+} SPlanCacheDbVer;
+
+typedef struct SPlanCacheTableVer {
+  uint64_t uid;  // a dropped and recreated table may have the same versions but a new uid
+  uint64_t suid;
+  int32_t  sversion;
+  int32_t  tversion;
+} SPlanCacheTableVer;
+
+typedef struct SPlanCacheEntry {
+  char*    pPlanMsg;
+  int32_t  planMsgLen;
+  int32_t  msgType;
+  bool     stableQuery;
+  int8_t   precision;
+  int32_t  numOfResCols;
+  SSchema* pResSchema;
+  int32_t  authVer;
+  SArray*  pDbList;      // element is char[TSDB_DB_FNAME_LEN]
+  SArray*  pDbVers;      // element is SPlanCacheDbVer
+  SArray*  pTableList;   // element is SName
+  SArray*  pTableVers;   // element is SPlanCacheTableVer
+  SArray*  pMnodeList;   // element is SQueryNodeLoad
+} SPlanCacheEntry;
+
+static void planCacheDestroyEntry(SPlanCacheEntry* pEntry) {
+  if (NULL == pEntry) {
+    return;
+  }
+  taosMemoryFree(pEntry->pPlanMsg);
+  taosMemoryFree(pEntry->pResSchema);
+  taosArrayDestroy(pEntry->pDbList);
+  taosArrayDestroy(pEntry->pDbVers);
+  taosArrayDestroy(pEntry->pTableList);
+  taosArrayDestroy(pEntry->pTableVers);
+  taosArrayDestroy(pEntry->pMnodeList);
+  taosMemoryFree(pEntry);
+}
+
+static void planCacheDeleteEntry(const void* key, size_t keyLen, void* value, void* ud) {
+  planCacheDestroyEntry((SPlanCacheEntry*)value);
+}
+
+SPlanCache* planCacheInit(int32_t sizeMB) {
+  if (sizeMB <= 0) {
+    return NULL;
+  }
+
+  SPlanCache* pCache = taosMemoryCalloc(1, sizeof(SPlanCache));
+  if (NULL == pCache) {
+    return NULL;
+  }
+
+  pCache->pCache = taosLRUCacheInit((size_t)sizeMB * 1024 * 1024, -1, .5);
+  if (NULL == pCache->pCache) {
+    taosMemoryFree(pCache);
+    return NULL;
+  }
+
+  return pCache;
+}
+
+void planCacheCleanup(SPlanCache* pCache) {
+  if (NULL == pCache) {
+    return;
+  }
+
+  tscInfo("plan cache %p, hit:%" PRId64 ", miss:%" PRId64 ", expired:%" PRId64 ", elems:%d", pCache, pCache->hitNum,
+          pCache->missNum, pCache->expiredNum, taosLRUCacheGetElems(pCache->pCache));
+
+  taosLRUCacheEraseUnrefEntries(pCache->pCache);
+  taosLRUCacheCleanup(pCache->pCache);
+  taosMemoryFree(pCache);
+}
+
+static int32_t planCacheBuildKey(SRequestObj* pRequest) {
+  STscObj* pTscObj = pRequest->pTscObj;
+  char     prefix[TSDB_USER_LEN + TSDB_DB_NAME_LEN + 64] = {0};
+  int32_t  prefixLen =
+      snprintf(prefix, sizeof(prefix), "%s:%s:%d:%d:%d:", pTscObj->user, pRequest->pDb ? pRequest->pDb : "",
+               tsQueryPolicy, tsKeepColumnName, tsQuerySmaOptimize);
+  prefixLen = TMIN(prefixLen, (int32_t)sizeof(prefix) - 1);
+
+  char* pKey = taosMemoryMalloc(prefixLen + pRequest->sqlLen + 1);
+  if (NULL == pKey) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t sqlLen = 0;
+  if (!qNormalizeQuerySql(pRequest->sqlstr, pRequest->sqlLen, pKey + prefixLen, &sqlLen)) {
+    taosMemoryFree(pKey);
+    return TSDB_CODE_SUCCESS;
+  }
+  memcpy(pKey, prefix, prefixLen);
+
+  pRequest->planCacheKey = pKey;
+  pRequest->planCacheKeyLen = prefixLen + sqlLen;
+  return TSDB_CODE_SUCCESS;
+}
+
+static bool planCacheIsValid(SPlanCacheEntry* pEntry, SRequestObj* pRequest, SCatalog* pCtg) {
+  int32_t authVer = 0;
+  if (TSDB_CODE_SUCCESS != catalogGetUserAuthVersion(pCtg, pRequest->pTscObj->user, &authVer) ||
+      authVer != pEntry->authVer) {
+    return false;
+  }
+
+  int32_t dbNum = taosArrayGetSize(pEntry->pDbList);
+  for (int32_t i = 0; i < dbNum; ++i) {
+    int32_t vgVer = 0;
+    int64_t dbId = 0;
+    int32_t tableNum = 0;
+    int64_t stateTs = 0;
+    SPlanCacheDbVer* pVer = taosArrayGet(pEntry->pDbVers, i);
+    if (TSDB_CODE_SUCCESS !=
+            catalogGetDBVgVersion(pCtg, taosArrayGet(pEntry->pDbList, i), &vgVer, &dbId, &tableNum, &stateTs) ||
+        vgVer < 0 || vgVer != pVer->vgVersion || dbId != pVer->dbId) {
+      return false;
+    }
+  }
+
+  int32_t tbNum = taosArrayGetSize(pEntry->pTableList);
+  for (int32_t i = 0; i < tbNum; ++i) {
+    STableMeta* pMeta = NULL;
+    if (TSDB_CODE_SUCCESS != catalogGetCachedTableMeta(pCtg, taosArrayGet(pEntry->pTableList, i), &pMeta) ||
+        NULL == pMeta) {
+      return false;
+    }
+    SPlanCacheTableVer* pVer = taosArrayGet(pEntry->pTableVers, i);
+    bool                valid = (pMeta->uid == pVer->uid && pMeta->suid == pVer->suid &&
+                  pMeta->sversion == pVer->sversion && pMeta->tversion == pVer->tversion);
+    taosMemoryFree(pMeta);
+    if (!valid) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static int32_t planCacheRestoreQuery(SPlanCacheEntry* pEntry, SRequestObj* pRequest, SQueryPlan** pDag,
+                                     SArray** pMnodeList) {
+  SQuery* pQuery = (SQuery*)nodesMakeNode(QUERY_NODE_QUERY);
+  if (NULL == pQuery) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pQuery->execStage = QUERY_EXEC_STAGE_SCHEDULE;
+  pQuery->execMode = QUERY_EXEC_MODE_SCHEDULE;
+  pQuery->haveResultSet = true;
+  pQuery->msgType = pEntry->msgType;
+  pQuery->stableQuery = pEntry->stableQuery;
+  pQuery->precision = pEntry->precision;
+  pQuery->numOfResCols = pEntry->numOfResCols;
+  pQuery->pResSchema = taosMemoryMalloc(pEntry->numOfResCols * sizeof(SSchema));
+
+  SArray* pDbList = taosArrayDup(pEntry->pDbList, NULL);
+  SArray* pTableList = taosArrayDup(pEntry->pTableList, NULL);
+  *pMnodeList = taosArrayDup(pEntry->pMnodeList, NULL);
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (NULL == pQuery->pResSchema || NULL == pDbList || NULL == pTableList || NULL == *pMnodeList) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    memcpy(pQuery->pResSchema, pEntry->pResSchema, pEntry->numOfResCols * sizeof(SSchema));
+    code = qMsgToQueryPlan(pEntry->pPlanMsg, pEntry->planMsgLen, pRequest->requestId, pDag);
+  }
+  if (TSDB_CODE_SUCCESS != code) {
+    qDestroyQuery(pQuery);
+    taosArrayDestroy(pDbList);
+    taosArrayDestroy(pTableList);
+    taosArrayDestroy(*pMnodeList);
+    *pMnodeList = NULL;
+    return code;
+  }
+
+  pRequest->pQuery = pQuery;
+  pRequest->stmtType = QUERY_NODE_SELECT_STMT;
+  pRequest->stableQuery = pQuery->stableQuery;
+  setResSchemaInfo(&pRequest->body.resInfo, pQuery->pResSchema, pQuery->numOfResCols);
+  setResPrecision(&pRequest->body.resInfo, pQuery->precision);
+
+  taosArrayDestroy(pRequest->dbList);
+  pRequest->dbList = pDbList;
+  taosArrayDestroy(pRequest->tableList);
+  pRequest->tableList = pTableList;
+  return TSDB_CODE_SUCCESS;
+}
+
+// the leader of a vgroup may change without changing the vgroup version, so the execution nodes of the scan subplans
+// are refreshed from the vgroups in the cache of catalog
+static void planCacheUpdateExecNode(SRequestObj* pRequest, SCatalog* pCtg, SQueryPlan* pDag) {
+  SAppInstInfo*    pInst = pRequest->pTscObj->pAppInfo;
+  SRequestConnInfo conn = {.pTrans = pInst->pTransporter,
+                           .requestId = pRequest->requestId,
+                           .requestObjRefId = pRequest->self,
+                           .mgmtEps = getEpSet_s(&pInst->mgmtEp)};
+
+  int32_t dbNum = taosArrayGetSize(pRequest->dbList);
+  for (int32_t i = 0; i < dbNum; ++i) {
+    SArray* pVgList = NULL;
+    if (TSDB_CODE_SUCCESS != catalogGetDBVgList(pCtg, &conn, taosArrayGet(pRequest->dbList, i), &pVgList)) {
+      continue;
+    }
+
+    int32_t vgNum = taosArrayGetSize(pVgList);
+    SNode*  pGroup = NULL;
+    FOREACH(pGroup, pDag->pSubplans) {
+      SNode* pNode = NULL;
+      FOREACH(pNode, ((SNodeListNode*)pGroup)->pNodeList) {
+        SSubplan* pSubplan = (SSubplan*)pNode;
+        if (SUBPLAN_TYPE_SCAN != pSubplan->subplanType) {
+          continue;
+        }
+        for (int32_t j = 0; j < vgNum; ++j) {
+          SVgroupInfo* pVg = taosArrayGet(pVgList, j);
+          if (pVg->vgId == pSubplan->execNode.nodeId) {
+            pSubplan->execNode.epSet = pVg->epSet;
+            break;
+          }
+        }
+      }
+    }
+    taosArrayDestroy(pVgList);
+  }
+}
+
+bool planCacheLaunchQuery(SRequestObj* pRequest, SSqlCallbackWrapper* pWrapper) {
+  SPlanCache* pCache = pRequest->pTscObj->pAppInfo->pPlanCache;
+  if (NULL == pCache || pRequest->validateOnly) {
+    return false;
+  }
+
+  if (NULL == pRequest->planCacheKey && TSDB_CODE_SUCCESS != planCacheBuildKey(pRequest)) {
+    return false;
+  }
+  if (NULL == pRequest->planCacheKey) {
+    return false;
+  }
+
+  SCatalog* pCtg = NULL;
+  if (TSDB_CODE_SUCCESS != catalogGetHandle(pRequest->pTscObj->pAppInfo->clusterId, &pCtg)) {
+    return false;
+  }
+
+  int64_t    st = taosGetTimestampUs();
+  LRUHandle* h = taosLRUCacheLookup(pCache->pCache, pRequest->planCacheKey, pRequest->planCacheKeyLen);
+  if (NULL == h) {
+    atomic_add_fetch_64(&pCache->missNum, 1);
+    return false;
+  }
+
+  SPlanCacheEntry* pEntry = taosLRUCacheValue(pCache->pCache, h);
+  if (!planCacheIsValid(pEntry, pRequest, pCtg)) {
+    taosLRUCacheRelease(pCache->pCache, h, false);
+    taosLRUCacheErase(pCache->pCache, pRequest->planCacheKey, pRequest->planCacheKeyLen);
+    atomic_add_fetch_64(&pCache->expiredNum, 1);
+    atomic_add_fetch_64(&pCache->missNum, 1);
+    tscDebug("0x%" PRIx64 " cached plan expired, reqId:0x%" PRIx64, pRequest->self, pRequest->requestId);
+    return false;
+  }
+
+  SQueryPlan* pDag = NULL;
+  SArray*     pMnodeList = NULL;
+  int32_t     code = planCacheRestoreQuery(pEntry, pRequest, &pDag, &pMnodeList);
+  taosLRUCacheRelease(pCache->pCache, h, false);
+  if (TSDB_CODE_SUCCESS != code) {
+    tscWarn("0x%" PRIx64 " failed to restore cached plan since %s, reqId:0x%" PRIx64, pRequest->self, tstrerror(code),
+            pRequest->requestId);
+    taosLRUCacheErase(pCache->pCache, pRequest->planCacheKey, pRequest->planCacheKeyLen);
+    atomic_add_fetch_64(&pCache->missNum, 1);
+    return false;
+  }
+
+  planCacheUpdateExecNode(pRequest, pCtg, pDag);
+
+  int64_t hitNum = atomic_add_fetch_64(&pCache->hitNum, 1);
+  pRequest->metric.planCostUs = taosGetTimestampUs() - st;
+  tscDebug("0x%" PRIx64 " hit cached plan, hit:%" PRId64 ", miss:%" PRId64 ", reqId:0x%" PRIx64, pRequest->self,
+           hitNum, atomic_load_64(&pCache->missNum), pRequest->requestId);
+
+  launchAsyncCachedQuery(pRequest, pDag, pMnodeList, pWrapper);
+  taosArrayDestroy(pMnodeList);
+  return true;
+}
+
+static int32_t planCacheBuildVersions(SRequestObj* pRequest, SCatalog* pCtg, SPlanCacheEntry* pEntry) {
+  if (TSDB_CODE_SUCCESS != catalogGetUserAuthVersion(pCtg, pRequest->pTscObj->user, &pEntry->authVer)) {
+    return TSDB_CODE_FAILED;
+  }
+
+  int32_t dbNum = taosArrayGetSize(pRequest->dbList);
+  for (int32_t i = 0; i < dbNum; ++i) {
+    const char* dbFName = taosArrayGet(pRequest->dbList, i);
+    const char* dbName = strchr(dbFName, '.');
+    if (NULL == dbName || IS_SYS_DBNAME(dbName + 1)) {
+      return TSDB_CODE_FAILED;
+    }
+
+    int32_t vgVer = 0;
+    int64_t dbId = 0;
+    int32_t tableNum = 0;
+    int64_t stateTs = 0;
+    if (TSDB_CODE_SUCCESS != catalogGetDBVgVersion(pCtg, dbFName, &vgVer, &dbId, &tableNum, &stateTs) || vgVer < 0) {
+      return TSDB_CODE_FAILED;
+    }
+    SPlanCacheDbVer ver = {.dbId = dbId, .vgVersion = vgVer};
+    if (NULL == taosArrayPush(pEntry->pDbVers, &ver)) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  int32_t tbNum = taosArrayGetSize(pRequest->tableList);
+  for (int32_t i = 0; i < tbNum; ++i) {
+    STableMeta* pMeta = NULL;
+    if (TSDB_CODE_SUCCESS != catalogGetCachedTableMeta(pCtg, taosArrayGet(pRequest->tableList, i), &pMeta) ||
+        NULL == pMeta) {
+      return TSDB_CODE_FAILED;
+    }
+    SPlanCacheTableVer ver = {
+        .uid = pMeta->uid, .suid = pMeta->suid, .sversion = pMeta->sversion, .tversion = pMeta->tversion};
+    taosMemoryFree(pMeta);
+    if (NULL == taosArrayPush(pEntry->pTableVers, &ver)) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+void planCachePut(SRequestObj* pRequest, const SQuery* pQuery, const SQueryPlan* pDag, const SArray* pMnodeList) {
+  SPlanCache* pCache = pRequest->pTscObj->pAppInfo->pPlanCache;
+  if (NULL == pCache || NULL == pRequest->planCacheKey || NULL == pQuery->pRoot ||
+      QUERY_NODE_SELECT_STMT != nodeType(pQuery->pRoot) || !pQuery->haveResultSet ||
+      QUERY_EXEC_MODE_SCHEDULE != pQuery->execMode) {
+    return;
+  }
+
+  SCatalog* pCtg = NULL;
+  if (TSDB_CODE_SUCCESS != catalogGetHandle(pRequest->pTscObj->pAppInfo->clusterId, &pCtg)) {
+    return;
+  }
+
+  SPlanCacheEntry* pEntry = taosMemoryCalloc(1, sizeof(SPlanCacheEntry));
+  if (NULL == pEntry) {
+    return;
+  }
+  pEntry->msgType = pQuery->msgType;
+  pEntry->stableQuery = pQuery->stableQuery;
+  pEntry->precision = pQuery->precision;
+  pEntry->numOfResCols = pQuery->numOfResCols;
+  pEntry->pResSchema = taosMemoryMalloc(pQuery->numOfResCols * sizeof(SSchema));
+  pEntry->pDbList = pRequest->dbList ? taosArrayDup(pRequest->dbList, NULL) : taosArrayInit(1, TSDB_DB_FNAME_LEN);
+  pEntry->pDbVers = taosArrayInit(taosArrayGetSize(pRequest->dbList), sizeof(SPlanCacheDbVer));
+  pEntry->pTableList = pRequest->tableList ? taosArrayDup(pRequest->tableList, NULL) : taosArrayInit(1, sizeof(SName));
+  pEntry->pTableVers = taosArrayInit(taosArrayGetSize(pRequest->tableList), sizeof(SPlanCacheTableVer));
+  pEntry->pMnodeList = taosArrayDup(pMnodeList, NULL);
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (NULL == pEntry->pResSchema || NULL == pEntry->pDbList || NULL == pEntry->pDbVers ||
+      NULL == pEntry->pTableList || NULL == pEntry->pTableVers || NULL == pEntry->pMnodeList) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    memcpy(pEntry->pResSchema, pQuery->pResSchema, pQuery->numOfResCols * sizeof(SSchema));
+    // the plan is only cached if all versions are known by the catalog
+    code = planCacheBuildVersions(pRequest, pCtg, pEntry);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = qQueryPlanToMsg(pDag, &pEntry->pPlanMsg, &pEntry->planMsgLen);
+  }
+  if (TSDB_CODE_SUCCESS != code) {
+    planCacheDestroyEntry(pEntry);
+    return;
+  }
+
+  size_t charge = sizeof(SPlanCacheEntry) + pRequest->planCacheKeyLen + pEntry->planMsgLen +
+                  pEntry->numOfResCols * sizeof(SSchema) + taosArrayGetSize(pEntry->pDbList) * TSDB_DB_FNAME_LEN +
+                  taosArrayGetSize(pEntry->pTableList) * sizeof(SName);
+  LRUStatus status = taosLRUCacheInsert(pCache->pCache, pRequest->planCacheKey, pRequest->planCacheKeyLen, pEntry,
+                                        charge, planCacheDeleteEntry, NULL, TAOS_LRU_PRIORITY_LOW, NULL);
+  if (TAOS_LRU_STATUS_OK != status && TAOS_LRU_STATUS_OK_OVERWRITTEN != status) {
+    tscDebug("0x%" PRIx64 " failed to cache plan, status:%d, reqId:0x%" PRIx64, pRequest->self, status,
+             pRequest->requestId);
+  }
+}
+
+void planCacheRemove(SRequestObj* pRequest) {
+  SPlanCache* pCache = pRequest->pTscObj->pAppInfo->pPlanCache;
+  if (NULL == pCache || NULL == pRequest->planCacheKey) {
+    return;
+  }
+
+  taosLRUCacheErase(pCache->pCache, pRequest->planCacheKey, pRequest->planCacheKeyLen);
+}
@@ -19,6 +19,10 @@
 #include <string.h>
 
 #include "clientSml.h"
+#include "tsched.h"
+
+#define SML_PARSE_QUEUE_SIZE     1000
+#define SML_PARSE_MIN_TASK_LINES 1000  // a batch is split only if every parse task gets this many lines
 
 int64_t smlToMilli[3] = {3600000LL, 60000LL, 1000LL};
 int64_t smlFactorNS[3] = {NANOSECOND_PER_MSEC, NANOSECOND_PER_USEC, 1};
@@ -1516,6 +1520,231 @@ int32_t smlClearForRerun(SSmlHandle *info) {
   return TSDB_CODE_SUCCESS;
 }
 
+typedef struct {
+  SSmlHandle   *info;  // private handle of the task, it owns the child tables found in its lines
+  SSmlLineInfo *lines;
+  char        **sql;
+  int32_t      *len;
+  int32_t       startLine;
+  int32_t       numOfLines;
+  int32_t       code;
+  tsem_t        done;
+  char          msg[ERROR_MSG_BUF_DEFAULT_SIZE];
+} SSmlParseTask;
+
+static TdThreadOnce smlParsePoolOnce = PTHREAD_ONCE_INIT;
+static SSchedQueue  smlParseQueue = {0};
+static int32_t      smlParsePoolThreads = 0;
+
+void smlCleanupParsePool() {
+  if (smlParsePoolThreads > 0) {
+    taosCleanUpScheduler(&smlParseQueue);
+    smlParsePoolThreads = 0;
+  }
+}
+
+static void smlInitParsePool() {
+  // the caller parses the first part of a batch itself
+  int32_t numOfThreads = TMAX(tsSmlParseThreads - 1, 1);
+  if (taosInitScheduler(SML_PARSE_QUEUE_SIZE, numOfThreads, "sml-parse", &smlParseQueue) == NULL) {
+    uError("SML:failed to init parse pool, numOfThreads:%d", numOfThreads);
+    return;
+  }
+
+  smlParsePoolThreads = numOfThreads;
+}
+
+// Only lines in non-format mode are parsed in parallel: they are parsed into the child table hash and the line array,
+// which can be split and merged, while format mode binds every line into the data block of its table in order.
+bool smlCanParseParallel(SSmlHandle *info, int numLines) {
+  if (info->protocol != TSDB_SML_LINE_PROTOCOL || info->dataFormat || tsSmlParseThreads <= 1 ||
+      numLines < SML_PARSE_MIN_TASK_LINES * 2) {
+    return false;
+  }
+
+  taosThreadOnce(&smlParsePoolOnce, smlInitParsePool);
+  return smlParsePoolThreads > 0;
+}
+
+static void smlDestroyParseHandle(SSmlHandle *pHandle) {
+  if (pHandle == NULL) {
+    return;
+  }
+
+  // child tables moved to the handle of the request are set to NULL
+  SSmlTableInfo **ppTable = (SSmlTableInfo **)taosHashIterate(pHandle->childTables, NULL);
+  while (ppTable) {
+    if (*ppTable != NULL) {
+      smlDestroyTableInfo(ppTable);
+    }
+    ppTable = (SSmlTableInfo **)taosHashIterate(pHandle->childTables, ppTable);
+  }
+
+  taosHashCleanup(pHandle->childTables);
+  taosHashCleanup(pHandle->tableUids);
+  taosArrayDestroyEx(pHandle->preLineTagKV, freeSSmlKv);
+  taosMemoryFree(pHandle);
+}
+
+static SSmlHandle *smlBuildParseHandle(SSmlHandle *info, SSmlParseTask *pTask) {
+  SSmlHandle *pHandle = (SSmlHandle *)taosMemoryCalloc(1, sizeof(SSmlHandle));
+  if (pHandle == NULL) {
+    return NULL;
+  }
+
+  pHandle->id = info->id;
+  pHandle->protocol = info->protocol;
+  pHandle->precision = info->precision;
+  pHandle->isRawLine = info->isRawLine;
+  pHandle->dataFormat = false;
+  pHandle->msgBuf.buf = pTask->msg;
+  pHandle->msgBuf.len = sizeof(pTask->msg);
+  pHandle->childTables = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  pHandle->tableUids = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  pHandle->preLineTagKV = taosArrayInit(8, sizeof(SSmlKv));
+  if (pHandle->childTables == NULL || pHandle->tableUids == NULL || pHandle->preLineTagKV == NULL) {
+    smlDestroyParseHandle(pHandle);
+    return NULL;
+  }
+
+  return pHandle;
+}
+
+static void smlDoParseTask(SSmlParseTask *pTask) {
+  for (int32_t i = pTask->startLine; i < pTask->startLine + pTask->numOfLines; ++i) {
+    pTask->code = smlParseInfluxString(pTask->info, pTask->sql[i], pTask->sql[i] + pTask->len[i], pTask->lines + i);
+    if (pTask->code != TSDB_CODE_SUCCESS) {
+      uError("SML:0x%" PRIx64 " smlParseLine failed. line %d : %s", pTask->info->id, i,
+             pTask->info->isRawLine ? "rawdata" : pTask->sql[i]);
+      break;
+    }
+  }
+}
+
+static void smlParseTaskFp(SSchedMsg *pMsg) {
+  SSmlParseTask *pTask = (SSmlParseTask *)pMsg->ahandle;
+  smlDoParseTask(pTask);
+  tsem_post(&pTask->done);
+}
+
+// Move the child tables first seen by a task to the request. The tasks are merged in task order and the lines of each
+// task are walked in order, so a table keeps the tags of its first line and gets the uid the serial parse would give it.
+static int32_t smlMergeParseHandle(SSmlHandle *info, SSmlParseTask *pTask) {
+  for (int32_t i = pTask->startLine; i < pTask->startLine + pTask->numOfLines; ++i) {
+    SSmlLineInfo *elements = pTask->lines + i;
+    if (taosHashGet(info->childTables, elements->measure, elements->measureTagsLen) != NULL) {
+      continue;
+    }
+
+    SSmlTableInfo **ppTable =
+        (SSmlTableInfo **)taosHashGet(pTask->info->childTables, elements->measure, elements->measureTagsLen);
+    if (ppTable == NULL || *ppTable == NULL) {
+      continue;
+    }
+
+    SSmlTableInfo *tinfo = *ppTable;
+    getTableUid(info, elements, tinfo);
+    if (taosHashPut(info->childTables, elements->measure, elements->measureTagsLen, &tinfo, POINTER_BYTES) != 0) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    *ppTable = NULL;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t smlParseLineParallel(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines) {
+  int32_t        code = TSDB_CODE_SUCCESS;
+  int32_t        numOfTasks = TMIN(tsSmlParseThreads, numLines / SML_PARSE_MIN_TASK_LINES);
+  char         **pSql = (char **)taosMemoryMalloc(numLines * POINTER_BYTES);
+  int32_t       *pLen = (int32_t *)taosMemoryMalloc(numLines * sizeof(int32_t));
+  SSmlParseTask *pTasks = (SSmlParseTask *)taosMemoryCalloc(numOfTasks, sizeof(SSmlParseTask));
+  if (pSql == NULL || pLen == NULL || pTasks == NULL) {
+    taosMemoryFree(pSql);
+    taosMemoryFree(pLen);
+    taosMemoryFree(pTasks);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  // split the batch at line boundaries, comment lines of raw data are skipped as the serial parse does
+  int32_t num = 0;
+  if (lines) {
+    for (; num < numLines; ++num) {
+      pSql[num] = lines[num];
+      pLen[num] = strlen(lines[num]);
+    }
+  } else {
+    while (num < numLines && rawLine < rawLineEnd) {
+      char *eol = memchr(rawLine, '\n', rawLineEnd - rawLine);
+      char *end = (eol != NULL) ? eol : rawLineEnd;
+      if (rawLine[0] != '#') {
+        pSql[num] = rawLine;
+        pLen[num++] = end - rawLine;
+      }
+      rawLine = (eol != NULL) ? eol + 1 : rawLineEnd;
+    }
+    for (; num < numLines; ++num) {
+      pSql[num] = rawLineEnd;
+      pLen[num] = 0;
+    }
+  }
+
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    SSmlParseTask *pTask = &pTasks[i];
+    pTask->lines = info->lines;
+    pTask->sql = pSql;
+    pTask->len = pLen;
+    pTask->startLine = (int64_t)numLines * i / numOfTasks;
+    pTask->numOfLines = (int64_t)numLines * (i + 1) / numOfTasks - pTask->startLine;
+    tsem_init(&pTask->done, 0, 0);
+  }
+
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    pTasks[i].info = smlBuildParseHandle(info, &pTasks[i]);
+    if (pTasks[i].info == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _end;
+    }
+  }
+
+  uDebug("SML:0x%" PRIx64 " smlParseLine split %d lines into %d tasks", info->id, numLines, numOfTasks);
+  for (int32_t i = 1; i < numOfTasks; ++i) {
+    SSchedMsg schedMsg = {.fp = smlParseTaskFp, .ahandle = &pTasks[i]};
+    if (taosScheduleTask(&smlParseQueue, &schedMsg) != 0) {
+      smlDoParseTask(&pTasks[i]);
+      tsem_post(&pTasks[i].done);
+    }
+  }
+  smlDoParseTask(&pTasks[0]);
+
+  for (int32_t i = 1; i < numOfTasks; ++i) {
+    tsem_wait(&pTasks[i].done);
+  }
+
+  // report the error of the first failed line, like the serial parse
+  for (int32_t i = 0; i < numOfTasks && code == TSDB_CODE_SUCCESS; ++i) {
+    SSmlParseTask *pTask = &pTasks[i];
+    if (pTask->code != TSDB_CODE_SUCCESS) {
+      code = pTask->code;
+      if (pTask->msg[0] != 0) {
+        tstrncpy(info->msgBuf.buf, pTask->msg, info->msgBuf.len);
+      }
+      break;
+    }
+    code = smlMergeParseHandle(info, pTask);
+  }
+
+_end:
+  for (int32_t i = 0; i < numOfTasks; ++i) {
+    smlDestroyParseHandle(pTasks[i].info);
+    tsem_destroy(&pTasks[i].done);
+  }
+  taosMemoryFree(pTasks);
+  taosMemoryFree(pLen);
+  taosMemoryFree(pSql);
+  return code;
+}
+
 static int32_t smlParseLine(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines) {
   uDebug("SML:0x%" PRIx64 " smlParseLine start", info->id);
   int32_t code = TSDB_CODE_SUCCESS;
@@ -1586,6 +1815,9 @@ static int32_t smlParseLine(SSmlHandle *info, char *lines[], char *rawLine, char
       if (code != TSDB_CODE_SUCCESS) {
         return code;
       }
+      if (smlCanParseParallel(info, numLines)) {
+        return smlParseLineParallel(info, lines, oldRaw, rawLineEnd, numLines);
+      }
       continue;
     }
     i++;
@@ -54,6 +54,33 @@
 #define BINARY_ADD_LEN 2  // "binary"   2 means " "
 #define NCHAR_ADD_LEN  3  // L"nchar"   3 means L" "
 
+// Skip the bytes that can not end a measure, key or value. Only comma, equal sign, space, quote and slash need to be
+// looked at by the parse loops, so they restart from the returned position without missing an escape.
+static FORCE_INLINE char *smlSkipPlainChars(char *sql, char *sqlEnd) {
+#if __AVX__ || __SSE4_2__
+  const __m128i comma = _mm_set1_epi8(COMMA);
+  const __m128i equal = _mm_set1_epi8(EQUAL);
+  const __m128i space = _mm_set1_epi8(SPACE);
+  const __m128i quote = _mm_set1_epi8(QUOTE);
+  const __m128i slash = _mm_set1_epi8(SLASH);
+
+  while (sqlEnd - sql >= 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)sql);
+    __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, equal)),
+                             _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, quote)));
+    int32_t mask = _mm_movemask_epi8(_mm_or_si128(m, _mm_cmpeq_epi8(v, slash)));
+    if (mask != 0) {
+      return sql + BUILDIN_CTZ(mask);
+    }
+    sql += 16;
+  }
+#endif
+  while (sql < sqlEnd && *sql != COMMA && *sql != EQUAL && *sql != SPACE && *sql != QUOTE && *sql != SLASH) {
+    sql++;
+  }
+  return sql;
+}
+
 uint8_t smlPrecisionConvert[7] = {TSDB_TIME_PRECISION_NANO,    TSDB_TIME_PRECISION_HOURS, TSDB_TIME_PRECISION_MINUTES,
                                   TSDB_TIME_PRECISION_SECONDS, TSDB_TIME_PRECISION_MILLI, TSDB_TIME_PRECISION_MICRO,
                                   TSDB_TIME_PRECISION_NANO};
@@ -202,6 +229,10 @@ static int32_t smlParseTagKv(SSmlHandle *info, char **sql, char *sqlEnd, SSmlLin
     bool        keyEscaped = false;
     size_t      keyLenEscaped = 0;
     while (*sql < sqlEnd) {
+      *sql = smlSkipPlainChars(*sql, sqlEnd);
+      if (*sql >= sqlEnd) {
+        break;
+      }
       if (unlikely(IS_SPACE(*sql) || IS_COMMA(*sql))) {
         smlBuildInvalidDataMsg(&info->msgBuf, "invalid data", *sql);
         return TSDB_CODE_SML_INVALID_DATA;
@@ -230,6 +261,10 @@ static int32_t smlParseTagKv(SSmlHandle *info, char **sql, char *sqlEnd, SSmlLin
     size_t      valueLenEscaped = 0;
     while (*sql < sqlEnd) {
       // parse value
+      *sql = smlSkipPlainChars(*sql, sqlEnd);
+      if (*sql >= sqlEnd) {
+        break;
+      }
       if (unlikely(IS_SPACE(*sql) || IS_COMMA(*sql))) {
         break;
       } else if (unlikely(IS_EQUAL(*sql))) {
@@ -410,6 +445,10 @@ static int32_t smlParseColKv(SSmlHandle *info, char **sql, char *sqlEnd, SSmlLin
     bool        keyEscaped = false;
     size_t      keyLenEscaped = 0;
     while (*sql < sqlEnd) {
+      *sql = smlSkipPlainChars(*sql, sqlEnd);
+      if (*sql >= sqlEnd) {
+        break;
+      }
       if (unlikely(IS_SPACE(*sql) || IS_COMMA(*sql))) {
         smlBuildInvalidDataMsg(&info->msgBuf, "invalid data", *sql);
         return TSDB_CODE_SML_INVALID_DATA;
@@ -440,6 +479,10 @@ static int32_t smlParseColKv(SSmlHandle *info, char **sql, char *sqlEnd, SSmlLin
     const char *escapeChar = NULL;
     while (*sql < sqlEnd) {
       // parse value
+      *sql = smlSkipPlainChars(*sql, sqlEnd);
+      if (*sql >= sqlEnd) {
+        break;
+      }
       if (unlikely(*(*sql) == QUOTE && (*(*sql - 1) != SLASH || (*sql - 1) == escapeChar))) {
         quoteNum++;
         (*sql)++;
@@ -561,6 +604,10 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   // parse measure
   size_t measureLenEscaped = 0;
   while (sql < sqlEnd) {
+    sql = smlSkipPlainChars(sql, sqlEnd);
+    if (sql >= sqlEnd) {
+      break;
+    }
     if (unlikely((sql != elements->measure) && IS_SLASH_LETTER_IN_MEASUREMENT(sql))) {
       elements->measureEscaped = true;
       measureLenEscaped++;
@@ -585,6 +632,10 @@ int32_t smlParseInfluxString(SSmlHandle *info, char *sql, char *sqlEnd, SSmlLine
   // to get measureTagsLen before
   const char *tmp = sql;
   while (tmp < sqlEnd) {
+    tmp = smlSkipPlainChars((char *)tmp, sqlEnd);
+    if (tmp >= sqlEnd) {
+      break;
+    }
     if (unlikely(IS_SPACE(tmp))) {
       break;
     }
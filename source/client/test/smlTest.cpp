@@ -18,6 +18,9 @@
 #include <taoserror.h>
 #include <tglobal.h>
 #include <iostream>
+#include <map>
+#include <string>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -148,6 +151,44 @@ TEST(testCase, smlParseInfluxString_Test) {
 
 }
 
+TEST(testCase, smlParseInfluxString_Escape_Test) {
+  SSmlLineInfo elements = {0};
+  SSmlHandle  *info = smlBuildSmlInfo(NULL);
+  info->protocol = TSDB_SML_LINE_PROTOCOL;
+  info->dataFormat = false;
+
+  // delimiters and escapes far from the start of each token
+  const char *tmp =
+      "measurement_with_a_long\\ name\\,x,location_of_sensor=beijing\\ haidian\\=a "
+      "c_long_column_name=\"string value with \\\"quote\\\" and, comma\",c2=12345678901234i64 1626006833639000000";
+  char *sql = (char *)taosMemoryCalloc(256, 1);
+  memcpy(sql, tmp, strlen(tmp) + 1);
+  int ret = smlParseInfluxString(info, sql, sql + strlen(sql), &elements);
+  ASSERT_EQ(ret, 0);
+  ASSERT_EQ(elements.measureLen, strlen("measurement_with_a_long\\ name\\,x"));
+  ASSERT_EQ(elements.measureEscaped, true);
+  ASSERT_EQ(elements.tagsLen, strlen("location_of_sensor=beijing\\ haidian\\=a"));
+  ASSERT_EQ(elements.colsLen,
+            strlen("c_long_column_name=\"string value with \\\"quote\\\" and, comma\",c2=12345678901234i64"));
+  ASSERT_EQ(elements.timestampLen, strlen("1626006833639000000"));
+  ASSERT_EQ(taosArrayGetSize(elements.colArray), 3);
+
+  SSmlKv     *kv = (SSmlKv *)taosArrayGet(elements.colArray, 1);
+  const char *value = "string value with \"quote\" and, comma";
+  ASSERT_EQ(kv->keyLen, strlen("c_long_column_name"));
+  ASSERT_EQ(kv->type, TSDB_DATA_TYPE_BINARY);
+  ASSERT_EQ(kv->length, strlen(value));
+  ASSERT_EQ(memcmp(kv->value, value, kv->length), 0);
+
+  kv = (SSmlKv *)taosArrayGet(elements.colArray, 2);
+  ASSERT_EQ(kv->type, TSDB_DATA_TYPE_BIGINT);
+  ASSERT_EQ(kv->i, 12345678901234);
+  taosArrayDestroyEx(elements.colArray, freeSSmlKv);
+
+  taosMemoryFree(sql);
+  smlDestroyInfo(info);
+}
+
 TEST(testCase, smlParseCols_Error_Test) {
   const char *data[] = {"st,t=1 c=\"89sd 1626006833639000000",  // binary, nchar
                         "st,t=1 c=j\"89sd\" 1626006833639000000",
@@ -581,4 +622,131 @@ TEST(testCase, smlParseNumber_performance_Test) {
     printf("smlParseNumberOld:%s cost:%" PRId64, str[i], taosGetTimestampUs() - t2);
     printf("\n\n");
   }
-}
\ No newline at end of file
+}
+// the child tables and the rows a batch is parsed into
+typedef struct {
+  std::map<std::string, std::string> tables;  // key of the child table -> its uid, name and tags
+  std::vector<std::string>           rows;    // key of the child table and the columns of each line
+} SSmlParseResult;
+
+static std::string smlKvToString(const SSmlKv *kv) {
+  std::string str = kv->key ? std::string(kv->key, kv->keyLen) : std::string();
+  str += ":" + std::to_string(kv->type) + "=";
+  if (IS_VAR_DATA_TYPE(kv->type)) {
+    str.append(kv->value, kv->length);
+  } else {
+    str += std::to_string(kv->i);
+  }
+  return str;
+}
+
+static SSmlHandle *smlBuildParseInfo(int32_t numLines, bool isRawLine, SSmlMsgBuf msgBuf) {
+  SSmlHandle *info = smlBuildSmlInfo(NULL);
+  info->protocol = TSDB_SML_LINE_PROTOCOL;
+  info->dataFormat = false;
+  info->isRawLine = isRawLine;
+  info->msgBuf = msgBuf;
+  info->lineNum = numLines;
+  info->lines = (SSmlLineInfo *)taosMemoryCalloc(numLines, sizeof(SSmlLineInfo));
+  return info;
+}
+
+static void smlGetParseResult(SSmlHandle *info, SSmlParseResult *pResult) {
+  SSmlTableInfo **ppTable = (SSmlTableInfo **)taosHashIterate(info->childTables, NULL);
+  while (ppTable) {
+    size_t         keyLen = 0;
+    char          *key = (char *)taosHashGetKey(ppTable, &keyLen);
+    SSmlTableInfo *tinfo = *ppTable;
+    std::string    desc = std::to_string(tinfo->uid) + " " + tinfo->childTableName;
+    for (int32_t i = 0; i < taosArrayGetSize(tinfo->tags); ++i) {
+      desc += " " + smlKvToString((SSmlKv *)taosArrayGet(tinfo->tags, i));
+    }
+    pResult->tables[std::string(key, keyLen)] = desc;
+    ppTable = (SSmlTableInfo **)taosHashIterate(info->childTables, ppTable);
+  }
+
+  for (int32_t i = 0; i < info->lineNum; ++i) {
+    SSmlLineInfo *elements = info->lines + i;
+    std::string   row(elements->measure, elements->measureTagsLen);
+    for (int32_t j = 0; j < taosArrayGetSize(elements->colArray); ++j) {
+      row += " " + smlKvToString((SSmlKv *)taosArrayGet(elements->colArray, j));
+    }
+    pResult->rows.push_back(row);
+  }
+}
+
+TEST(testCase, smlParseLineParallel_Test) {
+  char       msg[256] = {0};
+  SSmlMsgBuf msgBuf = {.len = 256, .buf = msg};
+
+  // new tables are first seen all over the batch, so every parse task finds some, and the raw data has comment lines
+  const int32_t            numLines = 5000;
+  std::vector<std::string> lines;
+  std::string              raw;
+  for (int32_t i = 0; i < numLines; ++i) {
+    std::string line = "st" + std::to_string(i % 3) + ",t1=" + std::to_string(i * 7919 % (i / 4 + 1)) +
+                       ",t2=tag c1=" + std::to_string(i) + "i64,c2=" + std::to_string(i % 5) + ".5,c3=\"v" +
+                       std::to_string(i % 11) + "\" " + std::to_string(1626006833639000000LL + i);
+    lines.push_back(line);
+    if (i % 100 == 0) {
+      raw += "# comment " + std::to_string(i) + "\n";
+    }
+    raw += line + "\n";
+  }
+
+  SSmlParseResult serial;
+  SSmlHandle     *info = smlBuildParseInfo(numLines, false, msgBuf);
+  for (int32_t i = 0; i < numLines; ++i) {
+    char *sql = (char *)lines[i].c_str();
+    ASSERT_EQ(smlParseInfluxString(info, sql, sql + lines[i].size(), info->lines + i), 0);
+  }
+  smlGetParseResult(info, &serial);
+  smlDestroyInfo(info);
+  ASSERT_GT(serial.tables.size(), (size_t)1000);
+
+  for (int32_t isRawLine = 0; isRawLine < 2; ++isRawLine) {
+    std::vector<std::string> copy(lines);
+    std::vector<char *>      sql;
+    for (auto &line : copy) {
+      sql.push_back((char *)line.c_str());
+    }
+    std::string rawCopy(raw);
+
+    SSmlParseResult parallel;
+    info = smlBuildParseInfo(numLines, isRawLine, msgBuf);
+    ASSERT_TRUE(smlCanParseParallel(info, numLines));
+    int32_t code = isRawLine ? smlParseLineParallel(info, NULL, &rawCopy[0], &rawCopy[0] + rawCopy.size(), numLines)
+                             : smlParseLineParallel(info, sql.data(), NULL, NULL, numLines);
+    ASSERT_EQ(code, 0);
+    smlGetParseResult(info, &parallel);
+    smlDestroyInfo(info);
+
+    ASSERT_EQ(parallel.tables, serial.tables);
+    ASSERT_EQ(parallel.rows.size(), serial.rows.size());
+    for (size_t i = 0; i < serial.rows.size(); ++i) {
+      ASSERT_EQ(parallel.rows[i], serial.rows[i]) << "line " << i;
+    }
+  }
+
+  // a bad line in the last task fails the batch like the serial parse
+  std::vector<std::string> copy(lines);
+  copy[numLines - 10] = "st0,t1=1 c1=";
+  std::vector<char *> sql;
+  for (auto &line : copy) {
+    sql.push_back((char *)line.c_str());
+  }
+  info = smlBuildParseInfo(numLines, false, msgBuf);
+  char   *badLine = sql[numLines - 10];
+  int32_t expect = smlParseInfluxString(info, badLine, badLine + strlen(badLine), info->lines);
+  smlDestroyInfo(info);
+  ASSERT_NE(expect, 0);
+
+  info = smlBuildParseInfo(numLines, false, msgBuf);
+  ASSERT_EQ(smlParseLineParallel(info, sql.data(), NULL, NULL, numLines), expect);
+  smlDestroyInfo(info);
+
+  smlCleanupParsePool();
+  info = smlBuildParseInfo(numLines, false, msgBuf);
+  ASSERT_FALSE(smlCanParseParallel(info, numLines));
+  smlDestroyInfo(info);
+}
@@ -16,6 +16,7 @@
 #define _DEFAULT_SOURCE
 #include "tdatablock.h"
 #include "tcompare.h"
+#include "tcompression.h"
 #include "tlog.h"
 #include "tname.h"
 
@@ -999,6 +1000,263 @@ static int32_t* createTupleIndex(size_t rows) {
 
 static void destroyTupleIndex(int32_t* index) { taosMemoryFreeClear(index); }
 
+#define BLOCK_SORT_VAR_PREFIX   8   // bytes of a var-length value encoded in the normalized key
+#define BLOCK_SORT_SMALL_BUCKET 32  // buckets smaller than this are finished by insertion sort
+
+typedef struct SBlockSortKeyCol {
+  SColumnInfoData* pColData;
+  int32_t          bytes;  // value bytes in the key, excluding the null byte
+  bool             hasNull;
+  bool             nullFirst;
+  bool             desc;
+} SBlockSortKeyCol;
+
+static bool isNormalizedKeyType(int32_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Collect the leading order columns that can be encoded into a key whose memcmp order is the order of
+// dataBlockCompar. The key stops after the first binary column, since only its prefix is encoded, and before a column
+// that can not be encoded: float and double are compared with a tolerance, nchar and json by other rules. *exact is
+// false if rows with equal keys may still differ in the order columns.
+static int32_t prepareSortKeyCols(SSDataBlock* pDataBlock, SArray* pOrderInfo, SBlockSortKeyCol* pKeyCols,
+                                  bool* exact) {
+  int32_t numOfOrder = taosArrayGetSize(pOrderInfo);
+  int32_t num = 0;
+
+  *exact = true;
+  for (int32_t i = 0; i < numOfOrder; ++i) {
+    SBlockOrderInfo* pOrder = taosArrayGet(pOrderInfo, i);
+    SColumnInfoData* pCol = taosArrayGet(pDataBlock->pDataBlock, pOrder->slotId);
+    int32_t          type = pCol->info.type;
+
+    if (!isNormalizedKeyType(type) && type != TSDB_DATA_TYPE_VARCHAR) {
+      *exact = false;
+      break;
+    }
+
+    SBlockSortKeyCol* pKeyCol = &pKeyCols[num++];
+    pKeyCol->pColData = pCol;
+    pKeyCol->hasNull = pCol->hasNull;
+    pKeyCol->nullFirst = pOrder->nullFirst;
+    pKeyCol->desc = (pOrder->order == TSDB_ORDER_DESC);
+
+    if (type == TSDB_DATA_TYPE_VARCHAR) {
+      pKeyCol->bytes = BLOCK_SORT_VAR_PREFIX;
+      *exact = false;
+      break;
+    }
+
+    pKeyCol->bytes = tDataTypes[type].bytes;
+  }
+
+  return num;
+}
+
+static void encodeSortKey(char* p, const SBlockSortKeyCol* pKeyCol, int32_t rows, int32_t row) {
+  const SColumnInfoData* pCol = pKeyCol->pColData;
+
+  if (pKeyCol->hasNull) {
+    bool isNull = colDataIsNull(pCol, rows, row, NULL);
+    *p++ = (isNull == pKeyCol->nullFirst) ? 0 : 1;
+    if (isNull) {
+      memset(p, 0, pKeyCol->bytes);
+      return;
+    }
+  }
+
+  char* pVal = colDataGetData(pCol, row);
+  if (pCol->info.type == TSDB_DATA_TYPE_VARCHAR) {
+    // strncmp stops at the first '\0', so does the prefix. Values that are equal here are compared in full later.
+    int32_t len = TMIN(varDataLen(pVal), pKeyCol->bytes);
+    int32_t i = 0;
+    for (; i < len && varDataVal(pVal)[i] != 0; ++i) {
+      p[i] = varDataVal(pVal)[i];
+    }
+    memset(p + i, 0, pKeyCol->bytes - i);
+  } else {
+    // big endian, with the sign bit flipped for signed types
+    uint64_t v = 0;
+    switch (pCol->info.type) {
+      case TSDB_DATA_TYPE_BOOL:
+      case TSDB_DATA_TYPE_TINYINT:
+        v = (uint8_t)(*(int8_t*)pVal) ^ 0x80u;
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        v = (uint16_t)(*(int16_t*)pVal) ^ 0x8000u;
+        break;
+      case TSDB_DATA_TYPE_INT:
+        v = (uint32_t)(*(int32_t*)pVal) ^ 0x80000000u;
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        v = (uint64_t)(*(int64_t*)pVal) ^ 0x8000000000000000ull;
+        break;
+      case TSDB_DATA_TYPE_UTINYINT:
+        v = *(uint8_t*)pVal;
+        break;
+      case TSDB_DATA_TYPE_USMALLINT:
+        v = *(uint16_t*)pVal;
+        break;
+      case TSDB_DATA_TYPE_UINT:
+        v = *(uint32_t*)pVal;
+        break;
+      case TSDB_DATA_TYPE_UBIGINT:
+        v = *(uint64_t*)pVal;
+        break;
+    }
+
+    for (int32_t i = pKeyCol->bytes - 1; i >= 0; --i) {
+      p[i] = (char)(v & 0xFF);
+      v >>= 8;
+    }
+  }
+
+  if (pKeyCol->desc) {
+    for (int32_t i = 0; i < pKeyCol->bytes; ++i) {
+      p[i] = ~p[i];
+    }
+  }
+}
+
+static void insertionSortKeys(char* pKeys, char* pTmp, int32_t n, int32_t stride, int32_t width, int32_t byte) {
+  for (int32_t i = 1; i < n; ++i) {
+    memcpy(pTmp, pKeys + i * stride, stride);
+
+    int32_t j = i - 1;
+    while (j >= 0 && memcmp(pKeys + j * stride + byte, pTmp + byte, width - byte) > 0) {
+      memcpy(pKeys + (j + 1) * stride, pKeys + j * stride, stride);
+      j -= 1;
+    }
+    memcpy(pKeys + (j + 1) * stride, pTmp, stride);
+  }
+}
+
+// most significant byte first radix sort of n records of stride bytes, ordered by the first width bytes
+static void radixSortKeys(char* pKeys, char* pTmp, int32_t n, int32_t stride, int32_t width, int32_t byte) {
+  int32_t count[256];
+
+  while (1) {
+    if (byte >= width) {
+      return;
+    }
+
+    if (n < BLOCK_SORT_SMALL_BUCKET) {
+      insertionSortKeys(pKeys, pTmp, n, stride, width, byte);
+      return;
+    }
+
+    memset(count, 0, sizeof(count));
+    for (int32_t i = 0; i < n; ++i) {
+      count[(uint8_t)pKeys[i * stride + byte]] += 1;
+    }
+
+    // all records share this byte, e.g. the high bytes of a timestamp
+    if (count[(uint8_t)pKeys[byte]] != n) {
+      break;
+    }
+    byte += 1;
+  }
+
+  int32_t offset[256];
+  offset[0] = 0;
+  for (int32_t i = 1; i < 256; ++i) {
+    offset[i] = offset[i - 1] + count[i - 1];
+  }
+
+  for (int32_t i = 0; i < n; ++i) {
+    char* p = pKeys + i * stride;
+    memcpy(pTmp + (offset[(uint8_t)p[byte]]++) * stride, p, stride);
+  }
+  memcpy(pKeys, pTmp, (size_t)n * stride);
+
+  int32_t start = 0;
+  for (int32_t i = 0; i < 256; ++i) {
+    if (count[i] > 1) {
+      radixSortKeys(pKeys + start * stride, pTmp, count[i], stride, width, byte + 1);
+    }
+    start += count[i];
+  }
+}
+
+// Sort the tuple index by normalized keys. Returns false if none of the order columns can be encoded.
+static bool sortByNormalizedKey(SSDataBlock* pDataBlock, SSDataBlockSortHelper* pHelper, int32_t* index) {
+  int32_t           numOfOrder = taosArrayGetSize(pHelper->orderInfo);
+  SBlockSortKeyCol* pKeyCols = taosMemoryCalloc(numOfOrder, sizeof(SBlockSortKeyCol));
+  if (pKeyCols == NULL) {
+    return false;
+  }
+
+  bool    exact = true;
+  int32_t numOfKeyCols = prepareSortKeyCols(pDataBlock, pHelper->orderInfo, pKeyCols, &exact);
+  if (numOfKeyCols == 0) {
+    taosMemoryFree(pKeyCols);
+    return false;
+  }
+
+  int32_t width = 0;
+  for (int32_t i = 0; i < numOfKeyCols; ++i) {
+    width += pKeyCols[i].bytes + (pKeyCols[i].hasNull ? 1 : 0);
+  }
+
+  // each record is the key followed by the row index
+  int32_t rows = pDataBlock->info.rows;
+  int32_t stride = width + sizeof(int32_t);
+  char*   pKeys = taosMemoryMalloc((size_t)rows * stride * 2);
+  if (pKeys == NULL) {
+    taosMemoryFree(pKeyCols);
+    return false;
+  }
+
+  for (int32_t i = 0; i < rows; ++i) {
+    char* p = pKeys + (size_t)i * stride;
+    for (int32_t j = 0; j < numOfKeyCols; ++j) {
+      encodeSortKey(p, &pKeyCols[j], rows, i);
+      p += pKeyCols[j].bytes + (pKeyCols[j].hasNull ? 1 : 0);
+    }
+    *(int32_t*)p = i;
+  }
+
+  radixSortKeys(pKeys, pKeys + (size_t)rows * stride, rows, stride, width, 0);
+
+  for (int32_t i = 0; i < rows; ++i) {
+    index[i] = *(int32_t*)(pKeys + (size_t)i * stride + width);
+  }
+
+  // rows with equal keys are ordered by the remaining order columns
+  if (!exact) {
+    int32_t start = 0;
+    for (int32_t i = 1; i <= rows; ++i) {
+      if (i < rows && memcmp(pKeys + (size_t)start * stride, pKeys + (size_t)i * stride, width) == 0) {
+        continue;
+      }
+
+      if (i - start > 1) {
+        taosqsort(index + start, i - start, sizeof(int32_t), pHelper, dataBlockCompar);
+      }
+      start = i;
+    }
+  }
+
+  taosMemoryFree(pKeys);
+  taosMemoryFree(pKeyCols);
+  return true;
+}
+
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   if (pDataBlock->info.rows <= 1) {
     return TSDB_CODE_SUCCESS;
@@ -1061,8 +1319,14 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   }
 
   terrno = 0;
-  taosqsort(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
-  if (terrno) return terrno;
+  if (!sortByNormalizedKey(pDataBlock, &helper, index)) {
+    terrno = 0;
+    taosqsort(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
+  }
+  if (terrno) {
+    destroyTupleIndex(index);
+    return terrno;
+  }
 
   int64_t p1 = taosGetTimestampUs();
 
@@ -2527,7 +2791,7 @@ int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
 
   // todo extract method
   int32_t* version = (int32_t*)data;
-  *version = 1;
+  *version = BLOCK_ENCODE_VERSION;
   data += sizeof(int32_t);
 
   int32_t* actualLen = (int32_t*)data;
@@ -2618,12 +2882,17 @@ int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols) {
   return dataLen;
 }
 
+static const char* blockDecodeCmpr(SSDataBlock* pBlock, const char* pData);
+
 const char* blockDecode(SSDataBlock* pBlock, const char* pData) {
   const char* pStart = pData;
 
   int32_t version = *(int32_t*)pStart;
   pStart += sizeof(int32_t);
-  ASSERT(version == 1);
+  if (version == BLOCK_ENCODE_CMPR_VERSION) {
+    return blockDecodeCmpr(pBlock, pData);
+  }
+  ASSERT(version == BLOCK_ENCODE_VERSION);
 
   // total length sizeof(int32_t)
   int32_t dataLen = *(int32_t*)pStart;
@@ -2709,3 +2978,267 @@ const char* blockDecode(SSDataBlock* pBlock, const char* pData) {
   ASSERT(pStart - pData == dataLen);
   return pStart;
 }
+
+// Column compressed encoding (version 2): the header, the column schemas and the column lengths are the same as in
+// version 1, the lengths are those of the uncompressed columns. Each column is then stored as
+// | offset/bitmap length | offset/bitmap | codec type | value length | values |
+// where a part whose length equals its uncompressed size is kept as it is. The var-length offsets are compressed by the
+// integer codec, the values by the codec of their type, or by LZ4 for var-length and bool columns.
+#define BLOCK_ENCODE_HEAD_SIZE (sizeof(int32_t) * 5 + sizeof(uint64_t))
+#define BLOCK_COL_CMPR_OVERHEAD (sizeof(int8_t) + (sizeof(int32_t) + COMP_OVERFLOW_BYTES) * 2)
+
+static int8_t blockGetColCmprType(int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      return type;
+#ifdef TD_TSZ
+    // the float codecs turn lossy when lossy compression is configured for tsdb
+    case TSDB_DATA_TYPE_FLOAT:
+      return lossyFloat ? TSDB_DATA_TYPE_VARCHAR : type;
+    case TSDB_DATA_TYPE_DOUBLE:
+      return lossyDouble ? TSDB_DATA_TYPE_VARCHAR : type;
+#else
+    case TSDB_DATA_TYPE_FLOAT:
+    case TSDB_DATA_TYPE_DOUBLE:
+      return type;
+#endif
+    default:
+      return TSDB_DATA_TYPE_VARCHAR;
+  }
+}
+
+static int32_t blockGetColMetaSize(int8_t type, int32_t numOfRows) {
+  return IS_VAR_DATA_TYPE(type) ? numOfRows * sizeof(int32_t) : BitmapLen(numOfRows);
+}
+
+// pOut must have room for the length and nIn + COMP_OVERFLOW_BYTES bytes
+static int32_t blockCompressColPart(int8_t cmprType, const char* pIn, int32_t nIn, char* pOut) {
+  char*   p = pOut + sizeof(int32_t);
+  int32_t len = -1;
+
+  if (cmprType != TSDB_DATA_TYPE_NULL && nIn > 0) {
+    len = tDataTypes[cmprType].compFunc((void*)pIn, nIn, nIn / tDataTypes[cmprType].bytes, p,
+                                        nIn + COMP_OVERFLOW_BYTES, ONE_STAGE_COMP, NULL, 0);
+  }
+
+  if (len <= 0 || len >= nIn) {
+    len = nIn;
+    if (nIn > 0) {
+      memcpy(p, pIn, nIn);
+    }
+  }
+
+  *(int32_t*)pOut = len;
+  return sizeof(int32_t) + len;
+}
+
+static int32_t blockDecompressColPart(int8_t cmprType, const char* pIn, char* pOut, int32_t nOut) {
+  int32_t len = *(int32_t*)pIn;
+  pIn += sizeof(int32_t);
+
+  if (len == nOut) {
+    if (nOut > 0) {
+      memcpy(pOut, pIn, nOut);
+    }
+  } else if (cmprType == TSDB_DATA_TYPE_NULL ||
+             tDataTypes[cmprType].decompFunc((void*)pIn, len, nOut / tDataTypes[cmprType].bytes, pOut, nOut,
+                                             ONE_STAGE_COMP, NULL, 0) != nOut) {
+    terrno = TSDB_CODE_COMPRESS_ERROR;
+    return -1;
+  }
+
+  return sizeof(int32_t) + len;
+}
+
+int32_t blockCompressGetBound(const char* pData) {
+  int32_t dataLen = *(int32_t*)(pData + sizeof(int32_t));
+  int32_t numOfCols = *(int32_t*)(pData + sizeof(int32_t) * 3);
+  return dataLen + numOfCols * BLOCK_COL_CMPR_OVERHEAD;
+}
+
+// compress a version 1 encoded block into pOut, which has room for blockCompressGetBound bytes, and return the length
+int32_t blockCompressEncode(const char* pData, char* pOut) {
+  int32_t numOfRows = *(int32_t*)(pData + sizeof(int32_t) * 2);
+  int32_t numOfCols = *(int32_t*)(pData + sizeof(int32_t) * 3);
+  int32_t metaSize = blockDataGetSerialMetaSize(numOfCols);
+
+  ASSERT(*(int32_t*)pData == BLOCK_ENCODE_VERSION);
+
+  memcpy(pOut, pData, metaSize);
+  *(int32_t*)pOut = BLOCK_ENCODE_CMPR_VERSION;
+
+  const char*    pSchema = pData + BLOCK_ENCODE_HEAD_SIZE;
+  const int32_t* colLen = (const int32_t*)(pData + metaSize - numOfCols * sizeof(int32_t));
+  const char*    pStart = pData + metaSize;
+  char*          p = pOut + metaSize;
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int8_t  type = *(int8_t*)(pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+    int32_t metaLen = blockGetColMetaSize(type, numOfRows);
+    int32_t len = htonl(colLen[i]);
+
+    // the bitmap is too small to be worth compressing
+    p += blockCompressColPart(IS_VAR_DATA_TYPE(type) ? TSDB_DATA_TYPE_INT : TSDB_DATA_TYPE_NULL, pStart, metaLen, p);
+    pStart += metaLen;
+
+    int8_t cmprType = blockGetColCmprType(type);
+    *(int8_t*)p = cmprType;
+    p += sizeof(int8_t);
+    p += blockCompressColPart(cmprType, pStart, len, p);
+    pStart += len;
+  }
+
+  int32_t dataLen = p - pOut;
+  *(int32_t*)(pOut + sizeof(int32_t)) = dataLen;
+  return dataLen;
+}
+
+int32_t blockDecompressGetSize(const char* pData) {
+  int32_t numOfRows = *(int32_t*)(pData + sizeof(int32_t) * 2);
+  int32_t numOfCols = *(int32_t*)(pData + sizeof(int32_t) * 3);
+  int32_t metaSize = blockDataGetSerialMetaSize(numOfCols);
+
+  const char*    pSchema = pData + BLOCK_ENCODE_HEAD_SIZE;
+  const int32_t* colLen = (const int32_t*)(pData + metaSize - numOfCols * sizeof(int32_t));
+  int32_t        dataLen = metaSize;
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int8_t type = *(int8_t*)(pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+    dataLen += blockGetColMetaSize(type, numOfRows) + htonl(colLen[i]);
+  }
+
+  return dataLen;
+}
+
+// restore the version 1 encoding of a compressed block into pOut, which has room for blockDecompressGetSize bytes
+int32_t blockDecompressEncode(const char* pData, char* pOut) {
+  int32_t numOfRows = *(int32_t*)(pData + sizeof(int32_t) * 2);
+  int32_t numOfCols = *(int32_t*)(pData + sizeof(int32_t) * 3);
+  int32_t metaSize = blockDataGetSerialMetaSize(numOfCols);
+
+  ASSERT(*(int32_t*)pData == BLOCK_ENCODE_CMPR_VERSION);
+
+  memcpy(pOut, pData, metaSize);
+  *(int32_t*)pOut = BLOCK_ENCODE_VERSION;
+
+  const char*    pSchema = pData + BLOCK_ENCODE_HEAD_SIZE;
+  const int32_t* colLen = (const int32_t*)(pData + metaSize - numOfCols * sizeof(int32_t));
+  const char*    pStart = pData + metaSize;
+  char*          p = pOut + metaSize;
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    int8_t  type = *(int8_t*)(pSchema + i * (sizeof(int8_t) + sizeof(int32_t)));
+    int32_t metaLen = blockGetColMetaSize(type, numOfRows);
+    int32_t len = htonl(colLen[i]);
+
+    int32_t n = blockDecompressColPart(IS_VAR_DATA_TYPE(type) ? TSDB_DATA_TYPE_INT : TSDB_DATA_TYPE_NULL, pStart, p,
+                                       metaLen);
+    if (n < 0) return -1;
+    pStart += n;
+    p += metaLen;
+
+    int8_t cmprType = *(int8_t*)pStart;
+    pStart += sizeof(int8_t);
+    n = blockDecompressColPart(cmprType, pStart, p, len);
+    if (n < 0) return -1;
+    pStart += n;
+    p += len;
+  }
+
+  int32_t dataLen = p - pOut;
+  *(int32_t*)(pOut + sizeof(int32_t)) = dataLen;
+  return dataLen;
+}
+
+// decode a compressed block straight into the columns of pBlock
+static const char* blockDecodeCmpr(SSDataBlock* pBlock, const char* pData) {
+  const char* pStart = pData + sizeof(int32_t);
+
+  int32_t dataLen = *(int32_t*)pStart;
+  pStart += sizeof(int32_t);
+
+  int32_t numOfRows = *(int32_t*)pStart;
+  pStart += sizeof(int32_t);
+
+  int32_t numOfCols = *(int32_t*)pStart;
+  pStart += sizeof(int32_t) * 2;
+
+  pBlock->info.id.groupId = *(uint64_t*)pStart;
+  pStart += sizeof(uint64_t);
+
+  if (pBlock->pDataBlock == NULL) {
+    pBlock->pDataBlock = taosArrayInit_s(sizeof(SColumnInfoData), numOfCols);
+  }
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, i);
+    pColInfoData->info.type = *(int8_t*)pStart;
+    pStart += sizeof(int8_t);
+
+    pColInfoData->info.bytes = *(int32_t*)pStart;
+    pStart += sizeof(int32_t);
+
+    if (IS_VAR_DATA_TYPE(pColInfoData->info.type)) {
+      pBlock->info.hasVarCol = true;
+    }
+  }
+
+  if (blockDataEnsureCapacity(pBlock, numOfRows) != TSDB_CODE_SUCCESS) {
+    return NULL;
+  }
+
+  const int32_t* colLen = (const int32_t*)pStart;
+  pStart += sizeof(int32_t) * numOfCols;
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, i);
+    int32_t          len = htonl(colLen[i]);
+    int32_t          n = 0;
+
+    if (IS_VAR_DATA_TYPE(pColInfoData->info.type)) {
+      n = blockDecompressColPart(TSDB_DATA_TYPE_INT, pStart, (char*)pColInfoData->varmeta.offset,
+                                 sizeof(int32_t) * numOfRows);
+      if (n < 0) return NULL;
+      pStart += n;
+
+      if (len > 0 && pColInfoData->varmeta.allocLen < len) {
+        char* tmp = taosMemoryRealloc(pColInfoData->pData, len);
+        if (tmp == NULL) {
+          terrno = TSDB_CODE_OUT_OF_MEMORY;
+          return NULL;
+        }
+
+        pColInfoData->pData = tmp;
+        pColInfoData->varmeta.allocLen = len;
+      }
+
+      pColInfoData->varmeta.length = len;
+    } else {
+      n = blockDecompressColPart(TSDB_DATA_TYPE_NULL, pStart, pColInfoData->nullbitmap, BitmapLen(numOfRows));
+      if (n < 0) return NULL;
+      pStart += n;
+    }
+
+    int8_t cmprType = *(int8_t*)pStart;
+    pStart += sizeof(int8_t);
+
+    n = blockDecompressColPart(cmprType, pStart, pColInfoData->pData, len);
+    if (n < 0) return NULL;
+    pStart += n;
+
+    pColInfoData->hasNull = true;
+  }
+
+  pBlock->info.dataLoad = 1;
+  pBlock->info.rows = numOfRows;
+  ASSERT(pStart - pData == dataLen);
+  return pStart;
+}
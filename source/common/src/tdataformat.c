@@ -2504,6 +2504,84 @@ _exit:
   return code;
 }
 
+// Append all rows of a bind at once. It is used when the rows do not change the layout of the column, i.e. the
+// column has no NONE value and keeps the same bitmap, so the data, offsets and bitmap are extended in place: fixed-length
+// values are copied by one memcpy and the null flags are packed into the bitmap a byte at a time.
+static int32_t tColDataPutValuesByBind(SColData *pColData, TAOS_MULTI_BIND *pBind, uint8_t flag, int32_t numOfNull,
+                                       int32_t buffMaxLen) {
+  int32_t code = 0;
+  int32_t nRows = pBind->num;
+
+#define BIND_IS_NULL(i) (pBind->is_null && pBind->is_null[i])
+
+  if (flag & HAS_VALUE) {
+    if (IS_VAR_DATA_TYPE(pColData->type)) {
+      int64_t nData = 0;
+      for (int32_t i = 0; i < nRows; ++i) {
+        if (BIND_IS_NULL(i)) continue;
+        if (pBind->length[i] > buffMaxLen) {
+          uError("var data length too big, len:%d, max:%d", pBind->length[i], buffMaxLen);
+          return TSDB_CODE_INVALID_PARA;
+        }
+        nData += pBind->length[i];
+      }
+
+      code = tRealloc((uint8_t **)(&pColData->aOffset), ((int64_t)(pColData->nVal + nRows)) << 2);
+      if (code) return code;
+      code = tRealloc(&pColData->pData, pColData->nData + nData);
+      if (code) return code;
+
+      for (int32_t i = 0; i < nRows; ++i) {
+        pColData->aOffset[pColData->nVal + i] = pColData->nData;
+        if (!BIND_IS_NULL(i) && pBind->length[i] > 0) {
+          memcpy(pColData->pData + pColData->nData, (uint8_t *)pBind->buffer + pBind->buffer_length * i,
+                 pBind->length[i]);
+          pColData->nData += pBind->length[i];
+        }
+      }
+    } else {
+      int32_t nBytes = TYPE_BYTES[pColData->type];
+      code = tRealloc(&pColData->pData, pColData->nData + (int64_t)nBytes * nRows);
+      if (code) return code;
+
+      uint8_t *pData = pColData->pData + pColData->nData;
+      memcpy(pData, pBind->buffer, (int64_t)nBytes * nRows);
+      for (int32_t i = 0; numOfNull > 0 && i < nRows; ++i) {
+        if (BIND_IS_NULL(i)) memset(pData + (int64_t)nBytes * i, 0, nBytes);
+      }
+      pColData->nData += nBytes * nRows;
+    }
+  }
+
+  if (flag == (HAS_VALUE | HAS_NULL)) {
+    code = tRealloc(&pColData->pBitMap, BIT1_SIZE(pColData->nVal + nRows));
+    if (code) return code;
+
+    int32_t i = 0;
+    for (; i < nRows && MOD_8(pColData->nVal + i) != 0; ++i) {
+      SET_BIT1(pColData->pBitMap, pColData->nVal + i, BIND_IS_NULL(i) ? 0 : 1);
+    }
+    for (; i + 8 <= nRows; i += 8) {
+      uint8_t v = 0xff;
+      for (int32_t j = 0; numOfNull > 0 && j < 8; ++j) {
+        if (pBind->is_null[i + j]) v &= ~((uint8_t)1 << j);
+      }
+      pColData->pBitMap[DIV_8(pColData->nVal + i)] = v;
+    }
+    for (; i < nRows; ++i) {
+      SET_BIT1_EX(pColData->pBitMap, pColData->nVal + i, BIND_IS_NULL(i) ? 0 : 1);
+    }
+  }
+
+#undef BIND_IS_NULL
+
+  pColData->flag = flag;
+  pColData->numOfNull += numOfNull;
+  pColData->numOfValue += nRows - numOfNull;
+  pColData->nVal += nRows;
+  return code;
+}
+
 int32_t tColDataAddValueByBind(SColData *pColData, TAOS_MULTI_BIND *pBind, int32_t buffMaxLen) {
   int32_t code = 0;
 
@@ -2511,6 +2589,17 @@ int32_t tColDataAddValueByBind(SColData *pColData, TAOS_MULTI_BIND *pBind, int32
     ASSERT(pColData->type == pBind->buffer_type);
   }
 
+  int32_t numOfNull = 0;
+  for (int32_t i = 0; pBind->is_null && i < pBind->num; ++i) {
+    numOfNull += (pBind->is_null[i] != 0);
+  }
+
+  uint8_t flag = pColData->flag | (numOfNull > 0 ? HAS_NULL : 0) | (numOfNull < pBind->num ? HAS_VALUE : 0);
+  if ((pColData->flag == 0 || pColData->flag == flag) && (flag & HAS_NONE) == 0) {
+    return tColDataPutValuesByBind(pColData, pBind, flag, numOfNull, buffMaxLen);
+  }
+
+  // the bitmap of the column changes, append the rows one by one
   if (IS_VAR_DATA_TYPE(pColData->type)) {  // var-length data type
     for (int32_t i = 0; i < pBind->num; ++i) {
       if (pBind->is_null && pBind->is_null[i]) {
@@ -2525,38 +2614,13 @@ int32_t tColDataAddValueByBind(SColData *pColData, TAOS_MULTI_BIND *pBind, int32
       }
     }
   } else {  // fixed-length data type
-    bool allValue;
-    bool allNull;
-    if (pBind->is_null) {
-      bool same = (memcmp(pBind->is_null, pBind->is_null + 1, pBind->num - 1) == 0);
-      allNull = (same && pBind->is_null[0] != 0);
-      allValue = (same && pBind->is_null[0] == 0);
-    } else {
-      allNull = false;
-      allValue = true;
-    }
-
-    if (allValue) {
-      // optimize (todo)
-      for (int32_t i = 0; i < pBind->num; ++i) {
-        code = tColDataAppendValueImpl[pColData->flag][CV_FLAG_VALUE](
-            pColData, (uint8_t *)pBind->buffer + TYPE_BYTES[pColData->type] * i, pBind->buffer_length);
-      }
-    } else if (allNull) {
-      // optimize (todo)
-      for (int32_t i = 0; i < pBind->num; ++i) {
+    for (int32_t i = 0; i < pBind->num; ++i) {
+      if (pBind->is_null && pBind->is_null[i]) {
         code = tColDataAppendValueImpl[pColData->flag][CV_FLAG_NULL](pColData, NULL, 0);
         if (code) goto _exit;
-      }
-    } else {
-      for (int32_t i = 0; i < pBind->num; ++i) {
-        if (pBind->is_null[i]) {
-          code = tColDataAppendValueImpl[pColData->flag][CV_FLAG_NULL](pColData, NULL, 0);
-          if (code) goto _exit;
-        } else {
-          code = tColDataAppendValueImpl[pColData->flag][CV_FLAG_VALUE](
-              pColData, (uint8_t *)pBind->buffer + TYPE_BYTES[pColData->type] * i, pBind->buffer_length);
-        }
+      } else {
+        code = tColDataAppendValueImpl[pColData->flag][CV_FLAG_VALUE](
+            pColData, (uint8_t *)pBind->buffer + TYPE_BYTES[pColData->type] * i, pBind->buffer_length);
       }
     }
   }
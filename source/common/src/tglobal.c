@@ -20,6 +20,7 @@
 #include "tgrant.h"
 #include "tlog.h"
 #include "tmisce.h"
+#include "tpagedbuf.h"
 
 #if defined(CUS_NAME) || defined(CUS_PROMPT) || defined(CUS_EMAIL)
 #include "cus_name.h"
@@ -49,6 +50,7 @@ int32_t tsNumOfRpcThreads = 1;
 int32_t tsNumOfRpcSessions = 10000;
 int32_t tsTimeToGetAvailableConn = 500000;
 int32_t tsNumOfCommitThreads = 2;
+int32_t tsNumOfCommitFileThreads = 1;
 int32_t tsNumOfTaskQueueThreads = 4;
 int32_t tsNumOfMnodeQueryThreads = 4;
 int32_t tsNumOfMnodeFetchThreads = 1;
@@ -67,9 +69,16 @@ int32_t tsMaxStreamBackendCache = 128;  // M
 int32_t tsElectInterval = 25 * 1000;
 int32_t tsHeartbeatInterval = 1000;
 int32_t tsHeartbeatTimeout = 20 * 1000;
+int32_t tsSnapReplWindow = 8;      // snapshot blocks in flight to one replica
+bool    tsSnapReplCompress = true;  // compress snapshot blocks sent to replicas
 
 // vnode
 int64_t tsVndCommitMaxIntervalMs = 600 * 1000;
+int32_t tsTsdbPageCacheSize = 16;  // MB, per vnode, 0 means disabled
+int32_t tsTsdbReadAheadBlocks = 4;  // file blocks loaded ahead by each tsdb reader, 0 means disabled
+int32_t tsTsdbParallelDecmprSize = 256;  // KB, compressed column size of a block decompressed in parallel, 0 disabled
+int32_t tsQueryParallelScan = 4;    // time ranges a table scan is split into in one vnode, 0 or 1 means disabled
+int32_t tsRetentionSpeedLimit = 0;  // MB/s, copy budget of each vnode moving file sets to lower tiers, 0 unlimited
 
 // mnode
 int64_t tsMndSdbWriteDelta = 200;
@@ -99,6 +108,8 @@ char *tsSvrCrashReportUri = "/dcrashreport";
 char tsSmlTagName[TSDB_COL_NAME_LEN] = "_tag_null";
 char tsSmlChildTableName[TSDB_TABLE_NAME_LEN] = "";  // user defined child table name can be specified in tag value.
                                                      // If set to empty system will generate table name using MD5 hash.
+// threads parsing one large batch of lines in non-format mode, 1 means the lines are parsed by the caller only
+int32_t tsSmlParseThreads = 4;
 // true means that the name and order of cols in each line are the same(only for influx protocol)
 // bool    tsSmlDataFormat = false;
 // int32_t tsSmlBatchSize = 10000;
@@ -114,6 +125,7 @@ int32_t tsQueryRsmaTolerance = 1000;  // the tolerance time (ms) to judge from w
 bool    tsQueryPlannerTrace = false;
 int32_t tsQueryNodeChunkSize = 32 * 1024;
 bool    tsQueryUseNodeAllocator = true;
+int32_t tsQueryPlanCacheSize = 16;  // MB, 0 means the plan cache of the client is disabled
 bool    tsKeepColumnName = false;
 int32_t tsRedirectPeriod = 10;
 int32_t tsRedirectFactor = 2;
@@ -343,9 +355,11 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
   if (cfgAddBool(pCfg, "queryPlannerTrace", tsQueryPlannerTrace, true) != 0) return -1;
   if (cfgAddInt32(pCfg, "queryNodeChunkSize", tsQueryNodeChunkSize, 1024, 128 * 1024, true) != 0) return -1;
   if (cfgAddBool(pCfg, "queryUseNodeAllocator", tsQueryUseNodeAllocator, true) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryPlanCacheSize", tsQueryPlanCacheSize, 0, 1024, true) != 0) return -1;
   if (cfgAddBool(pCfg, "keepColumnName", tsKeepColumnName, true) != 0) return -1;
   if (cfgAddString(pCfg, "smlChildTableName", "", 1) != 0) return -1;
   if (cfgAddString(pCfg, "smlTagName", tsSmlTagName, 1) != 0) return -1;
+  if (cfgAddInt32(pCfg, "smlParseThreads", tsSmlParseThreads, 1, 64, 1) != 0) return -1;
   //  if (cfgAddBool(pCfg, "smlDataFormat", tsSmlDataFormat, 1) != 0) return -1;
   //  if (cfgAddInt32(pCfg, "smlBatchSize", tsSmlBatchSize, 1, INT32_MAX, true) != 0) return -1;
   if (cfgAddInt32(pCfg, "maxInsertBatchRows", tsMaxInsertBatchRows, 1, INT32_MAX, true) != 0) return -1;
@@ -392,6 +406,7 @@ static int32_t taosAddSystemCfg(SConfig *pCfg) {
   if (cfgAddBool(pCfg, "AVX", tsAVXEnable, 0) != 0) return -1;
   if (cfgAddBool(pCfg, "AVX2", tsAVX2Enable, 0) != 0) return -1;
   if (cfgAddBool(pCfg, "FMA", tsFMAEnable, 0) != 0) return -1;
+  if (cfgAddBool(pCfg, "AVX512", tsAVX512Enable, 0) != 0) return -1;
   if (cfgAddBool(pCfg, "SIMD-builtins", tsSIMDBuiltins, 0) != 0) return -1;
   if (cfgAddBool(pCfg, "tagFilterCache", tsTagFilterCache, 0) != 0) return -1;
 
@@ -446,6 +461,10 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   tsNumOfCommitThreads = TRANGE(tsNumOfCommitThreads, 2, 4);
   if (cfgAddInt32(pCfg, "numOfCommitThreads", tsNumOfCommitThreads, 1, 1024, 0) != 0) return -1;
 
+  tsNumOfCommitFileThreads = tsNumOfCores / 4;
+  tsNumOfCommitFileThreads = TRANGE(tsNumOfCommitFileThreads, 1, 16);
+  if (cfgAddInt32(pCfg, "numOfCommitFileThreads", tsNumOfCommitFileThreads, 1, 1024, 0) != 0) return -1;
+
   tsNumOfMnodeReadThreads = tsNumOfCores / 8;
   tsNumOfMnodeReadThreads = TRANGE(tsNumOfMnodeReadThreads, 1, 4);
   if (cfgAddInt32(pCfg, "numOfMnodeReadThreads", tsNumOfMnodeReadThreads, 1, 1024, 0) != 0) return -1;
@@ -488,6 +507,8 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "syncElectInterval", tsElectInterval, 10, 1000 * 60 * 24 * 2, 0) != 0) return -1;
   if (cfgAddInt32(pCfg, "syncHeartbeatInterval", tsHeartbeatInterval, 10, 1000 * 60 * 24 * 2, 0) != 0) return -1;
   if (cfgAddInt32(pCfg, "syncHeartbeatTimeout", tsHeartbeatTimeout, 10, 1000 * 60 * 24 * 2, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "syncSnapReplWindow", tsSnapReplWindow, 1, 64, 0) != 0) return -1;
+  if (cfgAddBool(pCfg, "syncSnapReplCompress", tsSnapReplCompress, 0) != 0) return -1;
 
   if (cfgAddInt64(pCfg, "vndCommitMaxInterval", tsVndCommitMaxIntervalMs, 1000, 1000 * 60 * 60, 0) != 0) return -1;
 
@@ -529,6 +550,13 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
 
   if (cfgAddBool(pCfg, "filterScalarMode", tsFilterScalarMode, 0) != 0) return -1;
   if (cfgAddInt32(pCfg, "maxStreamBackendCache", tsMaxStreamBackendCache, 16, 1024, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "tsdbPageCacheSize", tsTsdbPageCacheSize, 0, 65536, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "tsdbReadAheadBlocks", tsTsdbReadAheadBlocks, 0, 64, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "tsdbParallelDecmprSize", tsTsdbParallelDecmprSize, 0, 1048576, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryParallelScan", tsQueryParallelScan, 0, 64, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "retentionSpeedLimit", tsRetentionSpeedLimit, 0, 65536, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "pagedBufDirtyRatio", tsPagedBufDirtyRatio, 0, 100, 0) != 0) return -1;
+  if (cfgAddBool(pCfg, "pagedBufCompress", tsPagedBufCompress, 0) != 0) return -1;
 
   GRANT_CFG_ADD;
   return 0;
@@ -586,6 +614,14 @@ static int32_t taosUpdateServerCfg(SConfig *pCfg) {
     pItem->stype = stype;
   }
 
+  pItem = cfgGetItem(tsCfg, "numOfCommitFileThreads");
+  if (pItem != NULL && pItem->stype == CFG_STYPE_DEFAULT) {
+    tsNumOfCommitFileThreads = numOfCores / 4;
+    tsNumOfCommitFileThreads = TRANGE(tsNumOfCommitFileThreads, 1, 16);
+    pItem->i32 = tsNumOfCommitFileThreads;
+    pItem->stype = stype;
+  }
+
   pItem = cfgGetItem(tsCfg, "numOfMnodeReadThreads");
   if (pItem != NULL && pItem->stype == CFG_STYPE_DEFAULT) {
     tsNumOfMnodeReadThreads = numOfCores / 8;
@@ -775,6 +811,7 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
 
   tstrncpy(tsSmlChildTableName, cfgGetItem(pCfg, "smlChildTableName")->str, TSDB_TABLE_NAME_LEN);
   tstrncpy(tsSmlTagName, cfgGetItem(pCfg, "smlTagName")->str, TSDB_COL_NAME_LEN);
+  tsSmlParseThreads = cfgGetItem(pCfg, "smlParseThreads")->i32;
   //  tsSmlDataFormat = cfgGetItem(pCfg, "smlDataFormat")->bval;
 
   //  tsSmlBatchSize = cfgGetItem(pCfg, "smlBatchSize")->i32;
@@ -791,6 +828,7 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   tsQueryPlannerTrace = cfgGetItem(pCfg, "queryPlannerTrace")->bval;
   tsQueryNodeChunkSize = cfgGetItem(pCfg, "queryNodeChunkSize")->i32;
   tsQueryUseNodeAllocator = cfgGetItem(pCfg, "queryUseNodeAllocator")->bval;
+  tsQueryPlanCacheSize = cfgGetItem(pCfg, "queryPlanCacheSize")->i32;
   tsKeepColumnName = cfgGetItem(pCfg, "keepColumnName")->bval;
   tsUseAdapter = cfgGetItem(pCfg, "useAdapter")->bval;
   tsEnableCrashReport = cfgGetItem(pCfg, "crashReporting")->bval;
@@ -847,6 +885,7 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsTimeToGetAvailableConn = cfgGetItem(pCfg, "timeToGetAvailableConn")->i32;
 
   tsNumOfCommitThreads = cfgGetItem(pCfg, "numOfCommitThreads")->i32;
+  tsNumOfCommitFileThreads = cfgGetItem(pCfg, "numOfCommitFileThreads")->i32;
   tsNumOfMnodeReadThreads = cfgGetItem(pCfg, "numOfMnodeReadThreads")->i32;
   tsNumOfVnodeQueryThreads = cfgGetItem(pCfg, "numOfVnodeQueryThreads")->i32;
   tsRatioOfVnodeStreamThreads = cfgGetItem(pCfg, "ratioOfVnodeStreamThreads")->fval;
@@ -887,6 +926,8 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsElectInterval = cfgGetItem(pCfg, "syncElectInterval")->i32;
   tsHeartbeatInterval = cfgGetItem(pCfg, "syncHeartbeatInterval")->i32;
   tsHeartbeatTimeout = cfgGetItem(pCfg, "syncHeartbeatTimeout")->i32;
+  tsSnapReplWindow = cfgGetItem(pCfg, "syncSnapReplWindow")->i32;
+  tsSnapReplCompress = cfgGetItem(pCfg, "syncSnapReplCompress")->bval;
 
   tsVndCommitMaxIntervalMs = cfgGetItem(pCfg, "vndCommitMaxInterval")->i64;
 
@@ -908,6 +949,13 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
 
   tsFilterScalarMode = cfgGetItem(pCfg, "filterScalarMode")->bval;
   tsMaxStreamBackendCache = cfgGetItem(pCfg, "maxStreamBackendCache")->i32;
+  tsTsdbPageCacheSize = cfgGetItem(pCfg, "tsdbPageCacheSize")->i32;
+  tsTsdbReadAheadBlocks = cfgGetItem(pCfg, "tsdbReadAheadBlocks")->i32;
+  tsTsdbParallelDecmprSize = cfgGetItem(pCfg, "tsdbParallelDecmprSize")->i32;
+  tsQueryParallelScan = cfgGetItem(pCfg, "queryParallelScan")->i32;
+  tsRetentionSpeedLimit = cfgGetItem(pCfg, "retentionSpeedLimit")->i32;
+  tsPagedBufDirtyRatio = cfgGetItem(pCfg, "pagedBufDirtyRatio")->i32;
+  tsPagedBufCompress = cfgGetItem(pCfg, "pagedBufCompress")->bval;
 
   GRANT_CFG_GET;
   return 0;
@@ -1125,6 +1173,8 @@ int32_t taosApplyLocalCfg(SConfig *pCfg, char *name) {
         tsNumOfRpcSessions = cfgGetItem(pCfg, "numOfRpcSessions")->i32;
       } else if (strcasecmp("numOfCommitThreads", name) == 0) {
         tsNumOfCommitThreads = cfgGetItem(pCfg, "numOfCommitThreads")->i32;
+      } else if (strcasecmp("numOfCommitFileThreads", name) == 0) {
+        tsNumOfCommitFileThreads = cfgGetItem(pCfg, "numOfCommitFileThreads")->i32;
       } else if (strcasecmp("numOfMnodeReadThreads", name) == 0) {
         tsNumOfMnodeReadThreads = cfgGetItem(pCfg, "numOfMnodeReadThreads")->i32;
       } else if (strcasecmp("numOfVnodeQueryThreads", name) == 0) {
@@ -1198,6 +1248,8 @@ int32_t taosApplyLocalCfg(SConfig *pCfg, char *name) {
         tstrncpy(tsSmlChildTableName, cfgGetItem(pCfg, "smlChildTableName")->str, TSDB_TABLE_NAME_LEN);
       } else if (strcasecmp("smlTagName", name) == 0) {
         tstrncpy(tsSmlTagName, cfgGetItem(pCfg, "smlTagName")->str, TSDB_COL_NAME_LEN);
+      } else if (strcasecmp("smlParseThreads", name) == 0) {
+        tsSmlParseThreads = cfgGetItem(pCfg, "smlParseThreads")->i32;
         //      } else if (strcasecmp("smlDataFormat", name) == 0) {
         //        tsSmlDataFormat = cfgGetItem(pCfg, "smlDataFormat")->bval;
         //      } else if (strcasecmp("smlBatchSize", name) == 0) {
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <iostream>
+#include <tuple>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -10,6 +12,8 @@
 
 #include "taos.h"
 #include "tcommon.h"
+#include "tcompare.h"
+#include "tdataformat.h"
 #include "tdatablock.h"
 #include "tdef.h"
 #include "tvariant.h"
@@ -260,4 +264,268 @@ TEST(testCase, var_dataBlock_split_test) {
   }
 }
 
-#pragma GCC diagnostic pop
\ No newline at end of file
+namespace {
+int32_t sortTestInt(int32_t id) { return (id * 7) % 13 - 6; }
+int64_t sortTestBigint(int32_t id) { return (int64_t)((id * 31) % 17) * 1000000007LL - 5000000000LL; }
+
+// rows with the same tuple id must carry the same values after sorting
+SSDataBlock* createSortTestBlock(int32_t rows) {
+  SSDataBlock*    b = createDataBlock();
+  SColumnInfoData c0 = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  SColumnInfoData c1 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 34, 2);
+  SColumnInfoData c2 = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, 8, 3);
+  SColumnInfoData c3 = createColumnInfoData(TSDB_DATA_TYPE_UINT, 4, 4);
+  blockDataAppendColInfo(b, &c0);
+  blockDataAppendColInfo(b, &c1);
+  blockDataAppendColInfo(b, &c2);
+  blockDataAppendColInfo(b, &c3);
+  blockDataEnsureCapacity(b, rows);
+
+  char buf[64] = {0};
+  char varbuf[64] = {0};
+  for (int32_t i = 0; i < rows; ++i) {
+    int32_t v0 = sortTestInt(i);
+    int64_t v2 = sortTestBigint(i);
+    sprintf(buf, "device_%02d_%d", (i * 3) % 11, i % 4);
+    STR_TO_VARSTR(varbuf, buf);
+
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 0), i, (const char*)&v0, i % 5 == 0);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 1), i, varbuf, i % 7 == 0);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 2), i, (const char*)&v2, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 3), i, (const char*)&i, false);
+    b->info.rows++;
+  }
+  return b;
+}
+
+int32_t sortTestCompare(SSDataBlock* b, SArray* pOrderInfo, int32_t left, int32_t right) {
+  for (int32_t i = 0; i < taosArrayGetSize(pOrderInfo); ++i) {
+    SBlockOrderInfo* pOrder = (SBlockOrderInfo*)taosArrayGet(pOrderInfo, i);
+    SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(b->pDataBlock, pOrder->slotId);
+
+    bool leftNull = colDataIsNull(pCol, b->info.rows, left, NULL);
+    bool rightNull = colDataIsNull(pCol, b->info.rows, right, NULL);
+    if (leftNull && rightNull) continue;
+    if (leftNull) return pOrder->nullFirst ? -1 : 1;
+    if (rightNull) return pOrder->nullFirst ? 1 : -1;
+
+    __compar_fn_t fn = getKeyComparFunc(pCol->info.type, pOrder->order);
+    int32_t       ret = fn(colDataGetData(pCol, left), colDataGetData(pCol, right));
+    if (ret != 0) return ret;
+  }
+  return 0;
+}
+
+void checkSortTestBlock(SSDataBlock* b, SArray* pOrderInfo, int32_t rows) {
+  ASSERT_EQ(b->info.rows, rows);
+
+  std::vector<bool> seen(rows, false);
+  for (int32_t i = 0; i < rows; ++i) {
+    int32_t id = *(int32_t*)colDataGetData((SColumnInfoData*)taosArrayGet(b->pDataBlock, 3), i);
+    ASSERT_FALSE(seen[id]);
+    seen[id] = true;
+
+    SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+    ASSERT_EQ(colDataIsNull(p0, rows, i, NULL), id % 5 == 0);
+    if (id % 5 != 0) {
+      ASSERT_EQ(*(int32_t*)colDataGetData(p0, i), sortTestInt(id));
+    }
+    ASSERT_EQ(*(int64_t*)colDataGetData((SColumnInfoData*)taosArrayGet(b->pDataBlock, 2), i), sortTestBigint(id));
+
+    if (i > 0) {
+      ASSERT_LE(sortTestCompare(b, pOrderInfo, i - 1, i), 0);
+    }
+  }
+}
+}  // namespace
+
+TEST(testCase, Datablock_normalized_key_sort_test) {
+  const int32_t rows = 5000;
+
+  // slot, order, nullFirst of each order column
+  std::vector<std::vector<std::tuple<int32_t, int32_t, bool>>> cases = {
+      {{0, TSDB_ORDER_ASC, true}},
+      {{2, TSDB_ORDER_DESC, false}},
+      {{0, TSDB_ORDER_DESC, false}, {2, TSDB_ORDER_ASC, true}},
+      {{1, TSDB_ORDER_ASC, false}, {0, TSDB_ORDER_DESC, true}, {2, TSDB_ORDER_ASC, true}},
+      {{1, TSDB_ORDER_DESC, true}, {2, TSDB_ORDER_DESC, true}},
+      {{0, TSDB_ORDER_ASC, false}, {1, TSDB_ORDER_ASC, true}, {3, TSDB_ORDER_DESC, true}},
+  };
+
+  for (auto& c : cases) {
+    SArray* pOrderInfo = taosArrayInit(3, sizeof(SBlockOrderInfo));
+    for (auto& col : c) {
+      SBlockOrderInfo order = {std::get<2>(col), std::get<1>(col), std::get<0>(col), NULL};
+      taosArrayPush(pOrderInfo, &order);
+    }
+
+    SSDataBlock* b = createSortTestBlock(rows);
+    ASSERT_EQ(blockDataSort(b, pOrderInfo), 0);
+    checkSortTestBlock(b, pOrderInfo, rows);
+
+    blockDataDestroy(b);
+    taosArrayDestroy(pOrderInfo);
+  }
+}
+
+TEST(testCase, ColData_add_value_by_bind_test) {
+  // rows and null pattern of each bind: 0 no null, 1 all null, n every n-th row is null
+  std::vector<std::vector<std::pair<int32_t, int32_t>>> cases = {
+      {{21, 3}, {13, 2}, {40, 0}, {8, 1}},
+      {{16, 0}, {19, 5}, {7, 1}, {24, 4}},
+      {{9, 1}, {33, 0}, {17, 4}},
+      {{64, 0}, {64, 0}, {3, 1}},
+  };
+  std::vector<int8_t> types = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_DOUBLE, TSDB_DATA_TYPE_BINARY};
+  const int32_t       maxLen = 16;
+
+  for (auto type : types) {
+    for (auto& c : cases) {
+      SColData bindCol = {0};
+      SColData rowCol = {0};
+      tColDataInit(&bindCol, 1, type, 0);
+      tColDataInit(&rowCol, 1, type, 0);
+
+      int32_t rowIdx = 0;
+      for (auto& batch : c) {
+        int32_t           num = batch.first;
+        std::vector<char> buffer(num * maxLen);
+        std::vector<int32_t> length(num);
+        std::vector<char>    isNull(num);
+
+        for (int32_t i = 0; i < num; ++i, ++rowIdx) {
+          isNull[i] = (batch.second == 1) || (batch.second > 1 && i % batch.second == 0);
+
+          SColVal cv = {0};
+          cv.cid = 1;
+          cv.type = type;
+          cv.flag = isNull[i] ? CV_FLAG_NULL : CV_FLAG_VALUE;
+          if (type == TSDB_DATA_TYPE_INT) {
+            int32_t v = rowIdx * 7 + 1;
+            memcpy(&buffer[i * sizeof(int32_t)], &v, sizeof(v));
+            memcpy(&cv.value.val, &v, sizeof(v));
+          } else if (type == TSDB_DATA_TYPE_DOUBLE) {
+            double v = rowIdx * 0.5;
+            memcpy(&buffer[i * sizeof(double)], &v, sizeof(v));
+            memcpy(&cv.value.val, &v, sizeof(v));
+          } else {
+            length[i] = snprintf(&buffer[i * maxLen], maxLen, "v%d", rowIdx * 13);
+            cv.value.nData = length[i];
+            cv.value.pData = (uint8_t*)&buffer[i * maxLen];
+          }
+          ASSERT_EQ(tColDataAppendValue(&rowCol, &cv), 0);
+        }
+
+        TAOS_MULTI_BIND bind = {0};
+        bind.buffer_type = type;
+        bind.buffer = buffer.data();
+        bind.buffer_length = IS_VAR_DATA_TYPE(type) ? maxLen : tDataTypes[type].bytes;
+        bind.length = length.data();
+        bind.is_null = isNull.data();
+        bind.num = num;
+        ASSERT_EQ(tColDataAddValueByBind(&bindCol, &bind, maxLen), 0);
+      }
+
+      ASSERT_EQ(bindCol.flag, rowCol.flag);
+      ASSERT_EQ(bindCol.nVal, rowCol.nVal);
+      ASSERT_EQ(bindCol.numOfNull, rowCol.numOfNull);
+      ASSERT_EQ(bindCol.numOfValue, rowCol.numOfValue);
+      ASSERT_EQ(bindCol.nData, rowCol.nData);
+      for (int32_t i = 0; i < rowCol.nVal; ++i) {
+        SColVal cv1 = {0}, cv2 = {0};
+        tColDataGetValue(&bindCol, i, &cv1);
+        tColDataGetValue(&rowCol, i, &cv2);
+        ASSERT_EQ(cv1.flag, cv2.flag);
+        if (COL_VAL_IS_VALUE(&cv2) && IS_VAR_DATA_TYPE(type)) {
+          ASSERT_EQ(cv1.value.nData, cv2.value.nData);
+          ASSERT_EQ(memcmp(cv1.value.pData, cv2.value.pData, cv2.value.nData), 0);
+        } else if (COL_VAL_IS_VALUE(&cv2)) {
+          ASSERT_EQ(cv1.value.val, cv2.value.val);
+        }
+      }
+
+      tColDataDestroy(&bindCol);
+      tColDataDestroy(&rowCol);
+    }
+  }
+}
+
+TEST(testCase, Datablock_compress_encode_test) {
+  const int32_t rows = 4096;
+  int8_t        types[] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT,     TSDB_DATA_TYPE_BINARY, TSDB_DATA_TYPE_DOUBLE,
+                           TSDB_DATA_TYPE_BOOL,      TSDB_DATA_TYPE_UBIGINT, TSDB_DATA_TYPE_NCHAR,  TSDB_DATA_TYPE_FLOAT};
+  int32_t       bytes[] = {8, 4, 34, 8, 1, 8, 42, 4};
+  int32_t       numOfCols = sizeof(types) / sizeof(types[0]);
+
+  SSDataBlock* b = createDataBlock();
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData col = createColumnInfoData(types[i], bytes[i], i + 1);
+    blockDataAppendColInfo(b, &col);
+  }
+  blockDataEnsureCapacity(b, rows);
+
+  char buf[64] = {0};
+  char varBuf[64] = {0};
+  for (int32_t r = 0; r < rows; ++r) {
+    int64_t  ts = 1700000000000L + r * 1000;
+    int32_t  iv = r % 100;
+    double   dv = r * 0.5;
+    int8_t   bv = r & 1;
+    uint64_t uv = 18446744073709551000UL + r;
+    float    fv = r * 1.25f;
+    snprintf(buf, tListLen(buf), "dev_%d", r % 17);
+    STR_TO_VARSTR(varBuf, buf);
+
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 0), r, (const char*)&ts, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 1), r, (const char*)&iv, r % 9 == 0);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 2), r, varBuf, r % 5 == 0);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 3), r, (const char*)&dv, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 4), r, (const char*)&bv, r % 3 == 0);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 5), r, (const char*)&uv, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 6), r, varBuf, r % 4 == 0);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 7), r, (const char*)&fv, false);
+    b->info.rows++;
+  }
+
+  char*   raw = (char*)taosMemoryCalloc(1, blockGetEncodeSize(b));
+  int32_t rawLen = blockEncode(b, raw, numOfCols);
+
+  char*   cmpr = (char*)taosMemoryCalloc(1, blockCompressGetBound(raw));
+  int32_t cmprLen = blockCompressEncode(raw, cmpr);
+  ASSERT_GT(cmprLen, 0);
+  ASSERT_LT(cmprLen, rawLen);
+
+  // restore the plain layout
+  int32_t size = blockDecompressGetSize(cmpr);
+  ASSERT_EQ(size, rawLen);
+  char* plain = (char*)taosMemoryCalloc(1, size);
+  ASSERT_EQ(blockDecompressEncode(cmpr, plain), rawLen);
+  ASSERT_EQ(memcmp(raw, plain, rawLen), 0);
+
+  // decode into the columns directly
+  SSDataBlock* d = createOneDataBlock(b, false);
+  ASSERT_EQ(blockDecode(d, cmpr), cmpr + cmprLen);
+  ASSERT_EQ(d->info.rows, rows);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* p = (SColumnInfoData*)taosArrayGet(b->pDataBlock, i);
+    SColumnInfoData* q = (SColumnInfoData*)taosArrayGet(d->pDataBlock, i);
+    for (int32_t r = 0; r < rows; ++r) {
+      bool isNull = colDataIsNull(p, rows, r, NULL);
+      ASSERT_EQ(isNull, colDataIsNull(q, rows, r, NULL));
+      if (isNull) continue;
+
+      char*   v1 = colDataGetData(p, r);
+      char*   v2 = colDataGetData(q, r);
+      int32_t len = IS_VAR_DATA_TYPE(p->info.type) ? varDataTLen(v1) : p->info.bytes;
+      ASSERT_EQ(memcmp(v1, v2, len), 0);
+    }
+  }
+
+  blockDataDestroy(d);
+  blockDataDestroy(b);
+  taosMemoryFree(plain);
+  taosMemoryFree(cmpr);
+  taosMemoryFree(raw);
+}
+
+#pragma GCC diagnostic pop
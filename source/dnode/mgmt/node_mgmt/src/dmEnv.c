@@ -15,6 +15,7 @@
 
 #define _DEFAULT_SOURCE
 #include "dmMgmt.h"
+#include "tpagedbuf.h"
 
 static SDnode globalDnode = {0};
 
@@ -104,6 +105,7 @@ int32_t dmInit() {
   if (!dmCheckDiskSpace()) return -1;
   if (dmCheckRepeatInit(dmInstance()) != 0) return -1;
   if (dmInitSystem() != 0) return -1;
+  if (dBufInitIOPool() != 0) return -1;
   if (dmInitMonitor() != 0) return -1;
   if (dmInitDnode(dmInstance()) != 0) return -1;
 
@@ -130,6 +132,7 @@ void dmCleanup() {
   udfcClose();
   udfStopUdfd();
   taosStopCacheRefreshWorker();
+  dBufCleanupIOPool();
   dInfo("dnode env is cleaned up");
 
   taosCleanupCfg();
@@ -371,6 +371,11 @@ typedef struct {
   SVnodeGid vnodeGid[TSDB_MAX_REPLICA + TSDB_MAX_LEARNER_REPLICA];
   void*     pTsma;
   int32_t   numOfCachedTables;
+  int64_t   pageCacheHits;
+  int64_t   pageCacheMisses;
+  int64_t   migrateSize;
+  int64_t   migrateDone;
+  int64_t   migrateSpeed;
 } SVgObj;
 
 typedef struct {
@@ -481,6 +481,11 @@ static int32_t mndProcessStatusReq(SRpcMsg *pReq) {
       if (pVload->syncState == TAOS_SYNC_STATE_LEADER) {
         pVgroup->cacheUsage = pVload->cacheUsage;
         pVgroup->numOfCachedTables = pVload->numOfCachedTables;
+        pVgroup->pageCacheHits = pVload->pageCacheHits;
+        pVgroup->pageCacheMisses = pVload->pageCacheMisses;
+        pVgroup->migrateSize = pVload->migrateSize;
+        pVgroup->migrateDone = pVload->migrateDone;
+        pVgroup->migrateSpeed = pVload->migrateSpeed;
         pVgroup->numOfTables = pVload->numOfTables;
         pVgroup->numOfTimeSeries = pVload->numOfTimeSeries;
         pVgroup->totalStorage = pVload->totalStorage;
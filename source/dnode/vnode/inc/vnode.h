@@ -160,6 +160,8 @@ void        *tsdbGetIvtIdx(SMeta *pMeta);
 uint64_t     tsdbGetReaderMaxVersion(STsdbReader *pReader);
 void         tsdbReaderSetCloseFlag(STsdbReader *pReader);
 int64_t      tsdbGetLastTimestamp(SVnode *pVnode, void *pTableList, int32_t numOfTables, const char *pIdStr);
+int32_t      tsdbSplitTimeWindow(SVnode *pVnode, const STimeWindow *pWindow, int32_t maxParts, SArray *pWindows,
+                                 int64_t *pVersion);
 
 int32_t tsdbReuseCacherowsReader(void *pReader, void *pTableIdList, int32_t numOfTables);
 int32_t tsdbCacherowsReaderOpen(void *pVnode, int32_t type, void *pTableIdList, int32_t numOfTables, int32_t numOfCols,
@@ -173,6 +175,8 @@ void    tsdbCacheSetCapacity(SVnode *pVnode, size_t capacity);
 size_t  tsdbCacheGetCapacity(SVnode *pVnode);
 size_t  tsdbCacheGetUsage(SVnode *pVnode);
 int32_t tsdbCacheGetElems(SVnode *pVnode);
+void    tsdbPgCacheGetStat(SVnode *pVnode, int64_t *hits, int64_t *misses);
+void    tsdbGetMigrateStat(SVnode *pVnode, int64_t *size, int64_t *done, int64_t *speed);
 
 //// tq
 typedef struct SIdInfo {
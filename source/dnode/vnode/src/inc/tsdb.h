@@ -72,6 +72,7 @@ typedef struct SDiskDataBuilder SDiskDataBuilder;
 typedef struct SBlkInfo         SBlkInfo;
 typedef struct STsdbDataIter2   STsdbDataIter2;
 typedef struct STsdbFilterInfo  STsdbFilterInfo;
+typedef struct SColDecmprArena  SColDecmprArena;
 
 #define TSDBROW_ROW_FMT ((int8_t)0x0)
 #define TSDBROW_COL_FMT ((int8_t)0x1)
@@ -172,7 +173,13 @@ void    tBlockDataClear(SBlockData *pBlockData);
 void    tBlockDataGetColData(SBlockData *pBlockData, int16_t cid, SColData **ppColData);
 int32_t tCmprBlockData(SBlockData *pBlockData, int8_t cmprAlg, uint8_t **ppOut, int32_t *szOut, uint8_t *aBuf[],
                        int32_t aBufN[]);
-int32_t tDecmprBlockData(uint8_t *pIn, int32_t szIn, SBlockData *pBlockData, uint8_t *aBuf[]);
+int32_t tDecmprBlockData(uint8_t *pIn, int32_t szIn, SBlockData *pBlockData, uint8_t *aBuf[],
+                         SColDecmprArena *pArena);
+// SColDecmprArena
+void    tColDecmprArenaReset(SColDecmprArena *pArena);
+void    tColDecmprArenaDestroy(SColDecmprArena *pArena);
+int32_t tColDecmprArenaAdd(SColDecmprArena *pArena, int32_t offset, SBlockCol *pBlockCol, SColData *pColData);
+int32_t tColDecmprArenaRun(SColDecmprArena *pArena, uint8_t *pBase, int8_t cmprAlg, int32_t nVal);
 // SDiskDataHdr
 int32_t tPutDiskDataHdr(uint8_t *p, const SDiskDataHdr *pHdr);
 int32_t tGetDiskDataHdr(uint8_t *p, void *ph);
@@ -376,6 +383,14 @@ struct STsdb {
   SLRUCache       *biCache;
   TdThreadMutex    biMutex;
   SRocksCache      rCache;
+  SLRUCache       *pgCache;
+  int64_t          pgCacheHits;
+  int64_t          pgCacheMisses;
+  int64_t          migrateStart;  // ms, start time of the running or last tier migration
+  int64_t          migrateSize;   // bytes to move to lower tiers
+  int64_t          migrateDone;   // bytes moved
+  int64_t          migrateSpeed;  // bytes per second
+  STsdbFS          migrateFS;     // file sets copied to lower tiers, swapped in by tsdbDoRetention
 };
 
 struct TSDBKEY {
@@ -410,12 +425,21 @@ typedef struct SMemSkipList {
 struct STbData {
   tb_uid_t     suid;
   tb_uid_t     uid;
+  SRWLatch     latch;  // serializes writers of this table, readers never take it
   TSKEY        minKey;
   TSKEY        maxKey;
   SDelData    *pHead;
   SDelData    *pTail;
   SMemSkipList sl;
-  STbData     *next;
+};
+
+// open addressing table of STbData, only grows while the memtable lives and a grown table replaces the current one
+// as a whole, so lookups need no lock
+typedef struct STbDataHash STbDataHash;
+struct STbDataHash {
+  STbDataHash *pPrev;  // retired smaller table, may still be read by a concurrent lookup
+  int32_t      nBucket;
+  STbData     *aBucket[];
 };
 
 struct SMemTable {
@@ -429,11 +453,8 @@ struct SMemTable {
   TSKEY            maxKey;
   int64_t          nRow;
   int64_t          nDel;
-  struct {
-    int32_t   nTbData;
-    int32_t   nBucket;
-    STbData **aBucket;
-  };
+  int32_t          nTbData;
+  STbDataHash     *pHash;
 };
 
 struct TSDBROW {
@@ -464,11 +485,15 @@ struct SMapData {
   uint8_t *pData;
 };
 
+#define TSDB_COL_ENCODE_RAW  ((int8_t)0)
+#define TSDB_COL_ENCODE_DICT ((int8_t)1)
+
 struct SBlockCol {
   int16_t cid;
   int8_t  type;
   int8_t  smaOn;
   int8_t  flag;      // HAS_NONE|HAS_NULL|HAS_VALUE
+  int8_t  encode;    // TSDB_COL_ENCODE_RAW|TSDB_COL_ENCODE_DICT, value encoding of variant data type
   int32_t szOrigin;  // original column value size (only save for variant data type)
   int32_t szBitmap;  // bitmap size, 0 only for flag == HAS_VAL
   int32_t szOffset;  // offset size, 0 only for non-variant-length type
@@ -564,6 +589,9 @@ struct SDelIdx {
   int64_t  size;
 };
 
+#define TSDB_DISK_DATA_FMT_VER      0
+#define TSDB_DISK_DATA_FMT_VER_DICT 1  // some columns are dictionary encoded
+
 struct SDiskDataHdr {
   uint32_t delimiter;
   uint32_t fmtVer;
@@ -642,6 +670,7 @@ struct SRowMerger {
 };
 
 typedef struct {
+  STsdb    *pTsdb;
   char     *path;
   int32_t   szPage;
   int32_t   flag;
@@ -649,6 +678,7 @@ typedef struct {
   int64_t   pgno;
   uint8_t  *pBuf;
   int64_t   szFile;
+  int64_t   nCachePage;  // pages [1, nCachePage] are complete in the file set read, only they are cached
 } STsdbFD;
 
 struct SDelFWriter {
@@ -683,14 +713,33 @@ struct SDataFWriter {
   uint8_t *aBuf[4];
 };
 
+#define TSDB_DECMPR_MAX_TASKS 16
+
+typedef struct {
+  int32_t    offset;  // offset of the compressed column from the base of the block
+  SBlockCol  blockCol;
+  SColData  *pColData;
+} SColDecmprItem;
+
+// columns of a block to decompress, the buffers are kept from block to block
+struct SColDecmprArena {
+  uint8_t        *pBuf;  // compressed columns read from file
+  int64_t         szIn;
+  int32_t         nItem;
+  int32_t         nItemAlloc;
+  SColDecmprItem *aItem;
+  uint8_t        *aBuf[TSDB_DECMPR_MAX_TASKS];  // decompression buffer of each task
+};
+
 struct SDataFReader {
-  STsdb     *pTsdb;
-  SDFileSet *pSet;
-  STsdbFD   *pHeadFD;
-  STsdbFD   *pDataFD;
-  STsdbFD   *pSmaFD;
-  STsdbFD   *aSttFD[TSDB_MAX_STT_TRIGGER];
-  uint8_t   *aBuf[3];
+  STsdb          *pTsdb;
+  SDFileSet      *pSet;
+  STsdbFD        *pHeadFD;
+  STsdbFD        *pDataFD;
+  STsdbFD        *pSmaFD;
+  STsdbFD        *aSttFD[TSDB_MAX_STT_TRIGGER];
+  uint8_t        *aBuf[3];
+  SColDecmprArena arena;
 };
 
 // NOTE: do NOT change the order of the fields
@@ -836,6 +885,11 @@ typedef struct {
 
 int32_t tsdbOpenCache(STsdb *pTsdb);
 void    tsdbCloseCache(STsdb *pTsdb);
+
+// page cache
+bool tsdbPgCacheGet(STsdb *pTsdb, const char *path, int64_t pgno, uint8_t *pPage, int32_t szPage);
+void tsdbPgCachePut(STsdb *pTsdb, const char *path, int64_t pgno, const uint8_t *pPage, int32_t szPage);
+void tsdbPgCacheEvictFile(STsdb *pTsdb, const char *path);
 int32_t tsdbCacheUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSDBROW *row);
 int32_t tsdbCacheGetBatch(STsdb *pTsdb, tb_uid_t uid, SArray *pLastArray, SCacheRowsReader *pr, int8_t ltype);
 int32_t tsdbCacheGet(STsdb *pTsdb, tb_uid_t uid, SArray *pLastArray, SCacheRowsReader *pr, int8_t ltype);
@@ -898,9 +952,9 @@ static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
 
   pIter->pRow = &pIter->row;
   if (pIter->pNode->flag == TSDBROW_ROW_FMT) {
-    pIter->row = tsdbRowFromTSRow(pIter->pNode->version, pIter->pNode->pData);
+    pIter->row = tsdbRowFromTSRow(pIter->pNode->version, (SRow *)pIter->pNode->pData);
   } else if (pIter->pNode->flag == TSDBROW_COL_FMT) {
-    pIter->row = tsdbRowFromBlockData(pIter->pNode->pData, pIter->pNode->iRow);
+    pIter->row = tsdbRowFromBlockData((SBlockData *)pIter->pNode->pData, pIter->pNode->iRow);
   } else {
     ASSERT(0);
   }
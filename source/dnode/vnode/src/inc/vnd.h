@@ -105,6 +105,10 @@ int32_t vnodeSyncCommit(SVnode* pVnode);
 int32_t vnodeAsyncCommit(SVnode* pVnode);
 bool    vnodeShouldRollback(SVnode* pVnode);
 
+// vnodeRetention.c
+int32_t vnodeAsyncRentention(SVnode* pVnode, int64_t now);
+void    vnodeStopRentention(SVnode* pVnode);
+
 // vnodeSync.c
 int32_t vnodeSyncOpen(SVnode* pVnode, char* path);
 int32_t vnodeSyncStart(SVnode* pVnode);
@@ -189,6 +189,12 @@ typedef struct SMetaInfo {
 int32_t metaGetInfo(SMeta* pMeta, int64_t uid, SMetaInfo* pInfo, SMetaReader* pReader);
 
 // tsdb
+int32_t tsdbInit();
+void    tsdbCleanUp();
+int32_t tsdbPrefetchInit();
+void    tsdbPrefetchCleanUp();
+int32_t tsdbDecmprInit();
+void    tsdbDecmprCleanUp();
 int     tsdbOpen(SVnode* pVnode, STsdb** ppTsdb, const char* dir, STsdbKeepCfg* pKeepCfg, int8_t rollback);
 int     tsdbClose(STsdb** pTsdb);
 int32_t tsdbBegin(STsdb* pTsdb);
@@ -408,6 +414,9 @@ struct SVnode {
   int32_t       blockSec;
   int64_t       blockSeq;
   SQHandle*     pQuery;
+  TdThread      retentionThread;
+  int8_t        retentionRunning;
+  int8_t        retentionStop;
 };
 
 #define TD_VID(PVNODE) ((PVNODE)->config.vgId)
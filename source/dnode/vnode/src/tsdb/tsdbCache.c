@@ -48,6 +48,149 @@ static void tsdbCloseBICache(STsdb *pTsdb) {
   }
 }
 
+// page cache: verified file pages shared by all readers of the vnode, keyed by (pgno, file path)
+#define TSDB_PG_KEY_LEN (sizeof(int64_t) + TSDB_FILENAME_LEN)
+
+static int32_t tsdbOpenPgCache(STsdb *pTsdb) {
+  int32_t code = 0;
+  size_t  capacity = (size_t)tsTsdbPageCacheSize * 1024 * 1024;
+
+  if (capacity == 0) {
+    pTsdb->pgCache = NULL;
+    return code;
+  }
+
+  SLRUCache *pCache = taosLRUCacheInit(capacity, -1, .5);
+  if (pCache == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _err;
+  }
+
+  taosLRUCacheSetStrictCapacity(pCache, false);
+
+_err:
+  pTsdb->pgCache = pCache;
+  return code;
+}
+
+static void tsdbClosePgCache(STsdb *pTsdb) {
+  SLRUCache *pCache = pTsdb->pgCache;
+  if (pCache) {
+    tsdbDebug("vgId:%d, page cache closed, elems:%d hits:%" PRId64 " misses:%" PRId64, TD_VID(pTsdb->pVnode),
+              taosLRUCacheGetElems(pCache), pTsdb->pgCacheHits, pTsdb->pgCacheMisses);
+    taosLRUCacheEraseUnrefEntries(pCache);
+    taosLRUCacheCleanup(pCache);
+    pTsdb->pgCache = NULL;
+  }
+}
+
+static int32_t tsdbPgCacheKey(const char *path, int64_t pgno, char *key) {
+  int32_t len = (int32_t)strnlen(path, TSDB_FILENAME_LEN);
+  *(int64_t *)key = pgno;
+  memcpy(key + sizeof(int64_t), path, len);
+  return (int32_t)sizeof(int64_t) + len;
+}
+
+static void tsdbPgCacheDeleter(const void *key, size_t keyLen, void *value, void *ud) {
+  (void)key;
+  (void)keyLen;
+  (void)ud;
+  taosMemoryFree(value);
+}
+
+bool tsdbPgCacheGet(STsdb *pTsdb, const char *path, int64_t pgno, uint8_t *pPage, int32_t szPage) {
+  SLRUCache *pCache = pTsdb->pgCache;
+  if (pCache == NULL) return false;
+
+  char       key[TSDB_PG_KEY_LEN];
+  int32_t    keyLen = tsdbPgCacheKey(path, pgno, key);
+  LRUHandle *h = taosLRUCacheLookup(pCache, key, keyLen);
+  if (h == NULL) {
+    atomic_add_fetch_64(&pTsdb->pgCacheMisses, 1);
+    return false;
+  }
+
+  memcpy(pPage, taosLRUCacheValue(pCache, h), szPage);
+  taosLRUCacheRelease(pCache, h, false);
+  atomic_add_fetch_64(&pTsdb->pgCacheHits, 1);
+  return true;
+}
+
+void tsdbPgCachePut(STsdb *pTsdb, const char *path, int64_t pgno, const uint8_t *pPage, int32_t szPage) {
+  SLRUCache *pCache = pTsdb->pgCache;
+  if (pCache == NULL) return;
+
+  uint8_t *pValue = taosMemoryMalloc(szPage);
+  if (pValue == NULL) return;  // caching is best effort
+  memcpy(pValue, pPage, szPage);
+
+  char    key[TSDB_PG_KEY_LEN];
+  int32_t keyLen = tsdbPgCacheKey(path, pgno, key);
+
+  LRUStatus status = taosLRUCacheInsert(pCache, key, keyLen, pValue, szPage, tsdbPgCacheDeleter, NULL,
+                                        TAOS_LRU_PRIORITY_LOW, NULL);
+  if (status != TAOS_LRU_STATUS_OK && status != TAOS_LRU_STATUS_OK_OVERWRITTEN) {
+    tsdbTrace("vgId:%d, failed to cache page %" PRId64 " of %s, status:%d", TD_VID(pTsdb->pVnode), pgno, path, status);
+  }
+}
+
+static void tsdbPgCacheErase(STsdb *pTsdb, const char *path, int64_t pgno) {
+  SLRUCache *pCache = pTsdb->pgCache;
+  if (pCache == NULL) return;
+
+  char    key[TSDB_PG_KEY_LEN];
+  int32_t keyLen = tsdbPgCacheKey(path, pgno, key);
+  taosLRUCacheErase(pCache, key, keyLen);
+}
+
+typedef struct {
+  const char *path;
+  int32_t     len;
+  SArray     *aPgno;
+} SPgCacheEvictCtx;
+
+static int tsdbPgCacheCollect(const void *key, size_t keyLen, void *value, void *ud) {
+  SPgCacheEvictCtx *pCtx = (SPgCacheEvictCtx *)ud;
+  (void)value;
+
+  if (keyLen == sizeof(int64_t) + pCtx->len && memcmp((char *)key + sizeof(int64_t), pCtx->path, pCtx->len) == 0) {
+    if (taosArrayPush(pCtx->aPgno, key) == NULL) return -1;
+  }
+
+  return 0;
+}
+
+void tsdbPgCacheEvictFile(STsdb *pTsdb, const char *path) {
+  SLRUCache *pCache = pTsdb->pgCache;
+  if (pCache == NULL) return;
+
+  // entries cannot be erased from inside the apply functor since it runs under the shard lock, so collect first
+  SPgCacheEvictCtx ctx = {.path = path, .len = (int32_t)strnlen(path, TSDB_FILENAME_LEN)};
+  ctx.aPgno = taosArrayInit(64, sizeof(int64_t));
+  if (ctx.aPgno == NULL) {
+    taosLRUCacheEraseUnrefEntries(pCache);
+    return;
+  }
+
+  taosLRUCacheApply(pCache, tsdbPgCacheCollect, &ctx);
+  for (int32_t i = 0; i < taosArrayGetSize(ctx.aPgno); i++) {
+    tsdbPgCacheErase(pTsdb, path, *(int64_t *)taosArrayGet(ctx.aPgno, i));
+  }
+
+  tsdbTrace("vgId:%d, %d pages of %s evicted from page cache", TD_VID(pTsdb->pVnode),
+            (int32_t)taosArrayGetSize(ctx.aPgno), path);
+  taosArrayDestroy(ctx.aPgno);
+}
+
+void tsdbPgCacheGetStat(SVnode *pVnode, int64_t *hits, int64_t *misses) {
+  *hits = 0;
+  *misses = 0;
+  if (pVnode->pTsdb != NULL) {
+    *hits = atomic_load_64(&pVnode->pTsdb->pgCacheHits);
+    *misses = atomic_load_64(&pVnode->pTsdb->pgCacheMisses);
+  }
+}
+
 #define ROCKS_KEY_LEN (sizeof(tb_uid_t) + sizeof(int16_t) + sizeof(int8_t))
 
 typedef struct {
@@ -1203,6 +1346,11 @@ int32_t tsdbOpenCache(STsdb *pTsdb) {
     goto _err;
   }
 
+  code = tsdbOpenPgCache(pTsdb);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _err;
+  }
+
   taosLRUCacheSetStrictCapacity(pCache, false);
 
   taosThreadMutexInit(&pTsdb->lruMutex, NULL);
@@ -1227,6 +1375,7 @@ void tsdbCloseCache(STsdb *pTsdb) {
 
   tsdbCloseBICache(pTsdb);
   tsdbCloseRocksCache(pTsdb);
+  tsdbClosePgCache(pTsdb);
 }
 
 static void getTableCacheKey(tb_uid_t uid, int cacheType, char *key, int *len) {
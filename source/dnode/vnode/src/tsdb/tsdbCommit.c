@@ -14,6 +14,7 @@
  */
 
 #include "tsdb.h"
+#include "tsched.h"
 
 typedef enum { MEMORY_DATA_ITER = 0, STT_DATA_ITER } EDataIterT;
 
@@ -50,6 +51,11 @@ typedef struct {
   int8_t  sttTrigger;
   SArray *aTbDataP;  // memory
   STsdbFS fs;        // disk
+  // file sets are searched and upserted through pFS, which is shared by the
+  // committers of different file sets when they are committed in parallel
+  STsdbFS       *pFS;
+  TdThreadMutex *pFSMutex;
+  SDFileSet      rSet;
   // --------------
   TSKEY   nextKey;  // reset by each table commit
   int32_t commitFid;
@@ -100,6 +106,67 @@ static int32_t tsdbCommitDel(SCommitter *pCommitter);
 static int32_t tsdbCommitCache(SCommitter *pCommitter);
 static int32_t tsdbEndCommit(SCommitter *pCommitter, int32_t eno);
 static int32_t tsdbNextCommitRow(SCommitter *pCommitter);
+static int32_t tsdbCommitDataStart(SCommitter *pCommitter);
+static void    tsdbCommitDataEnd(SCommitter *pCommitter);
+static int32_t tsdbCommitFileData(SCommitter *pCommitter);
+
+// parallel commit of file sets ==================================================
+#define TSDB_COMMIT_QUEUE_SIZE 1024
+
+typedef struct {
+  int8_t      inited;
+  int32_t     nThreads;
+  SSchedQueue queue;
+} STsdbCommitMgmt;
+
+typedef struct {
+  SCommitter *pParent;
+  SCommitter  committer;
+  int32_t     fid;
+  int32_t     code;
+  tsem_t     *pDoneSem;
+} SCommitFileTask;
+
+static STsdbCommitMgmt tsdbCommitMgmt = {0};
+
+int32_t tsdbInit() {
+  int8_t old;
+  while (1) {
+    old = atomic_val_compare_exchange_8(&tsdbCommitMgmt.inited, 0, 2);
+    if (old != 2) break;
+  }
+
+  if (old == 0) {
+    tsdbCommitMgmt.nThreads = tsNumOfCommitFileThreads;
+    if (tsdbCommitMgmt.nThreads > 1 && taosInitScheduler(TSDB_COMMIT_QUEUE_SIZE, tsdbCommitMgmt.nThreads,
+                                                         "tsdb-commit", &tsdbCommitMgmt.queue) == NULL) {
+      tsdbError("failed to init tsdb commit queue, numOfThreads:%d", tsdbCommitMgmt.nThreads);
+      atomic_store_8(&tsdbCommitMgmt.inited, 0);
+      return -1;
+    }
+
+    tsdbInfo("tsdb module is initialized, numOfCommitFileThreads:%d", tsdbCommitMgmt.nThreads);
+    atomic_store_8(&tsdbCommitMgmt.inited, 1);
+  }
+
+  return 0;
+}
+
+void tsdbCleanUp() {
+  int8_t old;
+  while (1) {
+    old = atomic_val_compare_exchange_8(&tsdbCommitMgmt.inited, 1, 2);
+    if (old != 2) break;
+  }
+
+  if (old == 1) {
+    if (tsdbCommitMgmt.nThreads > 1) {
+      taosCleanUpScheduler(&tsdbCommitMgmt.queue);
+    }
+    tsdbInfo("tsdb module is cleaned up");
+    atomic_store_8(&tsdbCommitMgmt.inited, 0);
+  }
+}
 
 int32_t tRowInfoCmprFn(const void *p1, const void *p2) {
   SRowInfo *pInfo1 = (SRowInfo *)p1;
@@ -513,9 +580,15 @@ static int32_t tsdbCommitFileDataStart(SCommitter *pCommitter) {
 
   pCommitter->nextKey = TSKEY_MAX;
 
-  // Reader
+  // Reader, the file set is copied since the array may be changed by the committers of other file sets
   SDFileSet tDFileSet = {.fid = pCommitter->commitFid};
-  pRSet = (SDFileSet *)taosArraySearch(pCommitter->fs.aDFileSet, &tDFileSet, tDFileSetCmprFn, TD_EQ);
+  if (pCommitter->pFSMutex) taosThreadMutexLock(pCommitter->pFSMutex);
+  pRSet = (SDFileSet *)taosArraySearch(pCommitter->pFS->aDFileSet, &tDFileSet, tDFileSetCmprFn, TD_EQ);
+  if (pRSet) {
+    pCommitter->rSet = *pRSet;
+    pRSet = &pCommitter->rSet;
+  }
+  if (pCommitter->pFSMutex) taosThreadMutexUnlock(pCommitter->pFSMutex);
   if (pRSet) {
     code = tsdbDataFReaderOpen(&pCommitter->dReader.pReader, pTsdb, pRSet);
     TSDB_CHECK_CODE(code, lino, _exit);
@@ -746,7 +819,9 @@ static int32_t tsdbCommitFileDataEnd(SCommitter *pCommitter) {
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // upsert SDFileSet
-  code = tsdbFSUpsertFSet(&pCommitter->fs, &pCommitter->dWriter.pWriter->wSet);
+  if (pCommitter->pFSMutex) taosThreadMutexLock(pCommitter->pFSMutex);
+  code = tsdbFSUpsertFSet(pCommitter->pFS, &pCommitter->dWriter.pWriter->wSet);
+  if (pCommitter->pFSMutex) taosThreadMutexUnlock(pCommitter->pFSMutex);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // close and sync
@@ -843,6 +918,7 @@ static int32_t tsdbStartCommit(STsdb *pTsdb, SCommitter *pCommitter, SCommitInfo
   }
   code = tsdbFSCopy(pTsdb, &pCommitter->fs);
   TSDB_CHECK_CODE(code, lino, _exit);
+  pCommitter->pFS = &pCommitter->fs;
 
 _exit:
   if (code) {
@@ -936,16 +1012,169 @@ static void tsdbCommitDataEnd(SCommitter *pCommitter) {
   tDestroyTSchema(pCommitter->skmRow.pTSchema);
 }
 
+// find all file sets with data in memory, in ascending order
+static int32_t tsdbCommitGetFids(SCommitter *pCommitter, SArray *aFid) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  for (int32_t iTbData = 0; iTbData < taosArrayGetSize(pCommitter->aTbDataP); iTbData++) {
+    STbData    *pTbData = (STbData *)taosArrayGetP(pCommitter->aTbDataP, iTbData);
+    TSDBKEY     tKey = {.ts = pTbData->minKey, .version = VERSION_MIN};
+    STbDataIter iter = {0};
+
+    for (;;) {
+      tsdbTbDataIterOpen(pTbData, &tKey, 0, &iter);
+      TSDBROW *pRow = tsdbTbDataIterGet(&iter);
+      if (pRow == NULL) break;
+
+      int32_t fid = tsdbKeyFid(TSDBROW_TS(pRow), pCommitter->minutes, pCommitter->precision);
+      int32_t idx = taosArraySearchIdx(aFid, &fid, compareInt32Val, TD_GE);
+      if (idx < 0) {
+        idx = taosArrayGetSize(aFid);
+      }
+      if (idx == taosArrayGetSize(aFid) || *(int32_t *)taosArrayGet(aFid, idx) != fid) {
+        if (taosArrayInsert(aFid, idx, &fid) == NULL) {
+          code = TSDB_CODE_OUT_OF_MEMORY;
+          TSDB_CHECK_CODE(code, lino, _exit);
+        }
+      }
+
+      TSKEY minKey, maxKey;
+      tsdbFidKeyRange(fid, pCommitter->minutes, pCommitter->precision, &minKey, &maxKey);
+      if (maxKey >= pTbData->maxKey || maxKey == TSKEY_MAX) break;
+      tKey.ts = maxKey + 1;
+    }
+  }
+
+_exit:
+  if (code) {
+    tsdbError("vgId:%d, %s failed at line %d since %s", TD_VID(pCommitter->pTsdb->pVnode), __func__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
+static void tsdbCommitFileTask(SSchedMsg *pSchedMsg) {
+  SCommitFileTask *pTask = (SCommitFileTask *)pSchedMsg->ahandle;
+  SCommitter      *pParent = pTask->pParent;
+  SCommitter      *pCommitter = &pTask->committer;
+  int32_t          code = 0;
+  int32_t          lino = 0;
+
+  pCommitter->pTsdb = pParent->pTsdb;
+  pCommitter->commitID = pParent->commitID;
+  pCommitter->minutes = pParent->minutes;
+  pCommitter->precision = pParent->precision;
+  pCommitter->minRow = pParent->minRow;
+  pCommitter->maxRow = pParent->maxRow;
+  pCommitter->cmprAlg = pParent->cmprAlg;
+  pCommitter->sttTrigger = pParent->sttTrigger;
+  pCommitter->aTbDataP = pParent->aTbDataP;
+  pCommitter->pFS = pParent->pFS;
+  pCommitter->pFSMutex = pParent->pFSMutex;
+
+  code = tsdbCommitDataStart(pCommitter);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  TSKEY maxKey;
+  tsdbFidKeyRange(pTask->fid, pCommitter->minutes, pCommitter->precision, &pCommitter->nextKey, &maxKey);
+  code = tsdbCommitFileData(pCommitter);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  tsdbCommitDataEnd(pCommitter);
+  if (code) {
+    tsdbError("vgId:%d, %s failed at line %d since %s, fid:%d", TD_VID(pParent->pTsdb->pVnode), __func__, lino,
+              tstrerror(code), pTask->fid);
+  }
+  pTask->code = code;
+  tsem_post(pTask->pDoneSem);
+}
+
+// file sets have disjoint time ranges, so they are merged and written by different workers, each with its own
+// reader and writer, and the results are only upserted into the copied fs, which is installed in tsdbFinishCommit
+static int32_t tsdbCommitDataParallel(SCommitter *pCommitter, SArray *aFid) {
+  int32_t          code = 0;
+  int32_t          lino = 0;
+  int32_t          nFid = taosArrayGetSize(aFid);
+  int32_t          nTask = 0;
+  TdThreadMutex    fsMutex;
+  tsem_t           doneSem;
+  SCommitFileTask *aTask = taosMemoryCalloc(nFid, sizeof(SCommitFileTask));
+  if (aTask == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  taosThreadMutexInit(&fsMutex, NULL);
+  tsem_init(&doneSem, 0, 0);
+  pCommitter->pFSMutex = &fsMutex;
+
+  for (; nTask < nFid; nTask++) {
+    SCommitFileTask *pTask = &aTask[nTask];
+    pTask->pParent = pCommitter;
+    pTask->fid = *(int32_t *)taosArrayGet(aFid, nTask);
+    pTask->pDoneSem = &doneSem;
+
+    SSchedMsg schedMsg = {.fp = tsdbCommitFileTask, .ahandle = pTask};
+    if (taosScheduleTask(&tsdbCommitMgmt.queue, &schedMsg) != 0) {
+      code = TSDB_CODE_APP_ERROR;
+      break;
+    }
+  }
+
+  // wait for all scheduled tasks, even if some of them failed
+  for (int32_t iTask = 0; iTask < nTask; iTask++) {
+    tsem_wait(&doneSem);
+  }
+  for (int32_t iTask = 0; iTask < nTask; iTask++) {
+    if (code == 0) code = aTask[iTask].code;
+  }
+
+  pCommitter->pFSMutex = NULL;
+  tsem_destroy(&doneSem);
+  taosThreadMutexDestroy(&fsMutex);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  tsdbDebug("vgId:%d, %d file sets are committed in parallel", TD_VID(pCommitter->pTsdb->pVnode), nFid);
+
+_exit:
+  taosMemoryFree(aTask);
+  if (code) {
+    tsdbError("vgId:%d, %s failed at line %d since %s", TD_VID(pCommitter->pTsdb->pVnode), __func__, lino,
+              tstrerror(code));
+  }
+  return code;
+}
+
 static int32_t tsdbCommitData(SCommitter *pCommitter) {
   int32_t code = 0;
   int32_t lino = 0;
 
   STsdb     *pTsdb = pCommitter->pTsdb;
   SMemTable *pMemTable = pTsdb->imem;
+  SArray    *aFid = NULL;
 
   // check
   if (pMemTable->nRow == 0) goto _exit;
 
+  if (atomic_load_8(&tsdbCommitMgmt.inited) == 1 && tsdbCommitMgmt.nThreads > 1) {
+    aFid = taosArrayInit(0, sizeof(int32_t));
+    if (aFid == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+
+    code = tsdbCommitGetFids(pCommitter, aFid);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    if (taosArrayGetSize(aFid) > 1) {
+      code = tsdbCommitDataParallel(pCommitter, aFid);
+      TSDB_CHECK_CODE(code, lino, _exit);
+      goto _exit;
+    }
+  }
+
   // start ====================
   code = tsdbCommitDataStart(pCommitter);
   TSDB_CHECK_CODE(code, lino, _exit);
@@ -961,6 +1190,7 @@ static int32_t tsdbCommitData(SCommitter *pCommitter) {
   tsdbCommitDataEnd(pCommitter);
 
 _exit:
+  taosArrayDestroy(aFid);
   if (code) {
     tsdbError("vgId:%d, %s failed at line %d since %s", TD_VID(pTsdb->pVnode), __func__, lino, tstrerror(code));
   }
@@ -17,7 +17,10 @@
 #include "util/tsimplehash.h"
 
 #define MEM_MIN_HASH 1024
-#define SL_MAX_LEVEL 5
+#define SL_MAX_LEVEL 8
+
+// multiplicative hash, uids of child tables are often close to each other
+#define MEM_HASH_IDX(uid, nBucket) ((int32_t)(((uint64_t)(uid)*0x9E3779B97F4A7C15ull) >> 32) & ((nBucket)-1))
 
 // sizeof(SMemSkipListNode) + sizeof(SMemSkipListNode *) * (l) * 2
 #define SL_NODE_SIZE(l)               (sizeof(SMemSkipListNode) + ((l) << 4))
@@ -58,13 +61,13 @@ int32_t tsdbMemTableCreate(STsdb *pTsdb, SMemTable **ppMemTable) {
   pMemTable->nRow = 0;
   pMemTable->nDel = 0;
   pMemTable->nTbData = 0;
-  pMemTable->nBucket = MEM_MIN_HASH;
-  pMemTable->aBucket = (STbData **)taosMemoryCalloc(pMemTable->nBucket, sizeof(STbData *));
-  if (pMemTable->aBucket == NULL) {
+  pMemTable->pHash = (STbDataHash *)taosMemoryCalloc(1, sizeof(STbDataHash) + sizeof(STbData *) * MEM_MIN_HASH);
+  if (pMemTable->pHash == NULL) {
     code = TSDB_CODE_OUT_OF_MEMORY;
     taosMemoryFree(pMemTable);
     goto _err;
   }
+  pMemTable->pHash->nBucket = MEM_MIN_HASH;
   vnodeBufPoolRef(pMemTable->pPool);
 
   *ppMemTable = pMemTable;
@@ -78,30 +81,49 @@ _err:
 void tsdbMemTableDestroy(SMemTable *pMemTable, bool proactive) {
   if (pMemTable) {
     vnodeBufPoolUnRef(pMemTable->pPool, proactive);
-    taosMemoryFree(pMemTable->aBucket);
+    for (STbDataHash *pHash = pMemTable->pHash; pHash;) {
+      STbDataHash *pPrev = pHash->pPrev;
+      taosMemoryFree(pHash);
+      pHash = pPrev;
+    }
     taosMemoryFree(pMemTable);
   }
 }
 
-static FORCE_INLINE STbData *tsdbGetTbDataFromMemTableImpl(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid) {
-  STbData *pTbData = pMemTable->aBucket[TABS(uid) % pMemTable->nBucket];
+// the hash is kept at most half full, so the probe always ends at an empty bucket
+static FORCE_INLINE STbData *tsdbGetTbDataFromHash(STbDataHash *pHash, tb_uid_t uid) {
+  int32_t mask = pHash->nBucket - 1;
 
-  while (pTbData) {
-    if (pTbData->uid == uid) break;
-    pTbData = pTbData->next;
+  for (int32_t idx = MEM_HASH_IDX(uid, pHash->nBucket);; idx = (idx + 1) & mask) {
+    STbData *pTbData = (STbData *)atomic_load_ptr(&pHash->aBucket[idx]);
+    if (pTbData == NULL || pTbData->uid == uid) return pTbData;
   }
+}
 
-  return pTbData;
+static FORCE_INLINE STbData *tsdbGetTbDataFromMemTableImpl(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid) {
+  return tsdbGetTbDataFromHash((STbDataHash *)atomic_load_ptr(&pMemTable->pHash), uid);
 }
 
 STbData *tsdbGetTbDataFromMemTable(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid) {
-  STbData *pTbData;
+  return tsdbGetTbDataFromMemTableImpl(pMemTable, suid, uid);
+}
 
-  taosRLockLatch(&pMemTable->latch);
-  pTbData = tsdbGetTbDataFromMemTableImpl(pMemTable, suid, uid);
-  taosRUnLockLatch(&pMemTable->latch);
+static FORCE_INLINE void tsdbAtomicMin64(int64_t *ptr, int64_t val) {
+  int64_t old = atomic_load_64(ptr);
+  while (val < old) {
+    int64_t cur = atomic_val_compare_exchange_64(ptr, old, val);
+    if (cur == old) break;
+    old = cur;
+  }
+}
 
-  return pTbData;
+static FORCE_INLINE void tsdbAtomicMax64(int64_t *ptr, int64_t val) {
+  int64_t old = atomic_load_64(ptr);
+  while (val > old) {
+    int64_t cur = atomic_val_compare_exchange_64(ptr, old, val);
+    if (cur == old) break;
+    old = cur;
+  }
 }
 
 int32_t tsdbInsertTableData(STsdb *pTsdb, int64_t version, SSubmitTbData *pSubmitTbData, int32_t *affectedRows) {
@@ -126,8 +148,8 @@ int32_t tsdbInsertTableData(STsdb *pTsdb, int64_t version, SSubmitTbData *pSubmi
   if (code) goto _err;
 
   // update
-  pMemTable->minVer = TMIN(pMemTable->minVer, version);
-  pMemTable->maxVer = TMAX(pMemTable->maxVer, version);
+  tsdbAtomicMin64(&pMemTable->minVer, version);
+  tsdbAtomicMax64(&pMemTable->maxVer, version);
 
   return code;
 
@@ -170,6 +192,7 @@ int32_t tsdbDeleteTableData(STsdb *pTsdb, int64_t version, tb_uid_t suid, tb_uid
   pDelData->sKey = sKey;
   pDelData->eKey = eKey;
   pDelData->pNext = NULL;
+  taosWLockLatch(&pTbData->latch);
   if (pTbData->pHead == NULL) {
     ASSERT(pTbData->pTail == NULL);
     pTbData->pHead = pTbData->pTail = pDelData;
@@ -177,10 +200,11 @@ int32_t tsdbDeleteTableData(STsdb *pTsdb, int64_t version, tb_uid_t suid, tb_uid
     pTbData->pTail->pNext = pDelData;
     pTbData->pTail = pDelData;
   }
+  taosWUnLockLatch(&pTbData->latch);
 
-  pMemTable->nDel++;
-  pMemTable->minVer = TMIN(pMemTable->minVer, version);
-  pMemTable->maxVer = TMIN(pMemTable->maxVer, version);
+  atomic_add_fetch_64(&pMemTable->nDel, 1);
+  tsdbAtomicMin64(&pMemTable->minVer, version);
+  tsdbAtomicMax64(&pMemTable->maxVer, version);
   /*
   if (TSDB_CACHE_LAST_ROW(pMemTable->pTsdb->pVnode->config) && tsdbKeyCmprFn(&lastKey, &pTbData->maxKey) >= 0) {
     tsdbCacheDeleteLastrow(pTsdb->lruCache, pTbData->uid, eKey);
@@ -303,50 +327,50 @@ int64_t tsdbCountTbDataRows(STbData *pTbData) {
 }
 
 void tsdbMemTableCountRows(SMemTable *pMemTable, SSHashObj *pTableMap, int64_t *rowsNum) {
-  taosRLockLatch(&pMemTable->latch);
-  for (int32_t i = 0; i < pMemTable->nBucket; ++i) {
-    STbData *pTbData = pMemTable->aBucket[i];
-    while (pTbData) {
-      void *p = tSimpleHashGet(pTableMap, &pTbData->uid, sizeof(pTbData->uid));
-      if (p == NULL) {
-        pTbData = pTbData->next;
-        continue;
-      }
+  STbDataHash *pHash = (STbDataHash *)atomic_load_ptr(&pMemTable->pHash);
+  for (int32_t i = 0; i < pHash->nBucket; ++i) {
+    STbData *pTbData = (STbData *)atomic_load_ptr(&pHash->aBucket[i]);
+    if (pTbData == NULL) continue;
 
-      *rowsNum += tsdbCountTbDataRows(pTbData);
-      pTbData = pTbData->next;
-    }
+    void *p = tSimpleHashGet(pTableMap, &pTbData->uid, sizeof(pTbData->uid));
+    if (p == NULL) continue;
+
+    *rowsNum += tsdbCountTbDataRows(pTbData);
+  }
+}
+
+static FORCE_INLINE void tsdbTbDataHashPut(STbDataHash *pHash, STbData *pTbData) {
+  int32_t mask = pHash->nBucket - 1;
+  int32_t idx = MEM_HASH_IDX(pTbData->uid, pHash->nBucket);
+
+  while (pHash->aBucket[idx]) {
+    idx = (idx + 1) & mask;
   }
-  taosRUnLockLatch(&pMemTable->latch);
+  atomic_store_ptr(&pHash->aBucket[idx], pTbData);
 }
 
+// called with pMemTable->latch held. The old table is left untouched for lookups that are still probing it and
+// is only freed with the memtable.
 static int32_t tsdbMemTableRehash(SMemTable *pMemTable) {
   int32_t code = 0;
 
-  int32_t   nBucket = pMemTable->nBucket * 2;
-  STbData **aBucket = (STbData **)taosMemoryCalloc(nBucket, sizeof(STbData *));
-  if (aBucket == NULL) {
+  STbDataHash *pOld = pMemTable->pHash;
+  int32_t      nBucket = pOld->nBucket * 2;
+  STbDataHash *pHash = (STbDataHash *)taosMemoryCalloc(1, sizeof(STbDataHash) + sizeof(STbData *) * nBucket);
+  if (pHash == NULL) {
     code = TSDB_CODE_OUT_OF_MEMORY;
     goto _exit;
   }
+  pHash->pPrev = pOld;
+  pHash->nBucket = nBucket;
 
-  for (int32_t iBucket = 0; iBucket < pMemTable->nBucket; iBucket++) {
-    STbData *pTbData = pMemTable->aBucket[iBucket];
-
-    while (pTbData) {
-      STbData *pNext = pTbData->next;
-
-      int32_t idx = TABS(pTbData->uid) % nBucket;
-      pTbData->next = aBucket[idx];
-      aBucket[idx] = pTbData;
-
-      pTbData = pNext;
+  for (int32_t iBucket = 0; iBucket < pOld->nBucket; iBucket++) {
+    if (pOld->aBucket[iBucket]) {
+      tsdbTbDataHashPut(pHash, pOld->aBucket[iBucket]);
     }
   }
 
-  taosMemoryFree(pMemTable->aBucket);
-  pMemTable->nBucket = nBucket;
-  pMemTable->aBucket = aBucket;
+  atomic_store_ptr(&pMemTable->pHash, pHash);
 
 _exit:
   return code;
@@ -359,18 +383,37 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   STbData *pTbData = tsdbGetTbDataFromMemTableImpl(pMemTable, suid, uid);
   if (pTbData) goto _exit;
 
-  // create
+  // create, the creation of a table is serialized while lookups go on without lock
+  taosWLockLatch(&pMemTable->latch);
+
+  pTbData = tsdbGetTbDataFromHash(pMemTable->pHash, uid);
+  if (pTbData) {
+    taosWUnLockLatch(&pMemTable->latch);
+    goto _exit;
+  }
+
+  if ((pMemTable->nTbData + 1) * 2 > pMemTable->pHash->nBucket) {
+    code = tsdbMemTableRehash(pMemTable);
+    if (code) {
+      taosWUnLockLatch(&pMemTable->latch);
+      goto _err;
+    }
+  }
+
   SVBufPool *pPool = pMemTable->pTsdb->pVnode->inUse;
-  int8_t     maxLevel = pMemTable->pTsdb->pVnode->config.tsdbCfg.slLevel;
+  int8_t     maxLevel = TMIN(pMemTable->pTsdb->pVnode->config.tsdbCfg.slLevel, SL_MAX_LEVEL);
 
   ASSERT(pPool != NULL);
-  pTbData = vnodeBufPoolMallocAligned(pPool, sizeof(*pTbData) + SL_NODE_SIZE(maxLevel) * 2);
+  // head and tail are sized for SL_MAX_LEVEL so that the skiplist can grow its level as the table grows
+  pTbData = vnodeBufPoolMallocAligned(pPool, sizeof(*pTbData) + SL_NODE_SIZE(SL_MAX_LEVEL) * 2);
   if (pTbData == NULL) {
+    taosWUnLockLatch(&pMemTable->latch);
     code = TSDB_CODE_OUT_OF_MEMORY;
     goto _err;
   }
   pTbData->suid = suid;
   pTbData->uid = uid;
+  taosInitRWLatch(&pTbData->latch);
   pTbData->minKey = TSKEY_MAX;
   pTbData->maxKey = TSKEY_MIN;
   pTbData->pHead = NULL;
@@ -380,10 +423,10 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   pTbData->sl.maxLevel = maxLevel;
   pTbData->sl.level = 0;
   pTbData->sl.pHead = (SMemSkipListNode *)&pTbData[1];
-  pTbData->sl.pTail = (SMemSkipListNode *)POINTER_SHIFT(pTbData->sl.pHead, SL_NODE_SIZE(maxLevel));
-  pTbData->sl.pHead->level = maxLevel;
-  pTbData->sl.pTail->level = maxLevel;
-  for (int8_t iLevel = 0; iLevel < maxLevel; iLevel++) {
+  pTbData->sl.pTail = (SMemSkipListNode *)POINTER_SHIFT(pTbData->sl.pHead, SL_NODE_SIZE(SL_MAX_LEVEL));
+  pTbData->sl.pHead->level = SL_MAX_LEVEL;
+  pTbData->sl.pTail->level = SL_MAX_LEVEL;
+  for (int8_t iLevel = 0; iLevel < SL_MAX_LEVEL; iLevel++) {
     SL_NODE_FORWARD(pTbData->sl.pHead, iLevel) = pTbData->sl.pTail;
     SL_NODE_BACKWARD(pTbData->sl.pTail, iLevel) = pTbData->sl.pHead;
 
@@ -391,19 +434,7 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
     SL_NODE_FORWARD(pTbData->sl.pTail, iLevel) = NULL;
   }
 
-  taosWLockLatch(&pMemTable->latch);
-
-  if (pMemTable->nTbData >= pMemTable->nBucket) {
-    code = tsdbMemTableRehash(pMemTable);
-    if (code) {
-      taosWUnLockLatch(&pMemTable->latch);
-      goto _err;
-    }
-  }
-
-  int32_t idx = TABS(uid) % pMemTable->nBucket;
-  pTbData->next = pMemTable->aBucket[idx];
-  pMemTable->aBucket[idx] = pTbData;
+  tsdbTbDataHashPut(pMemTable->pHash, pTbData);
   pMemTable->nTbData++;
 
   taosWUnLockLatch(&pMemTable->latch);
@@ -497,6 +528,14 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *p
   }
 }
 
+// with p = 1/4 a skiplist of maxLevel levels is balanced up to 4^maxLevel nodes, raise the level as the table
+// grows instead of paying the full height for the many small tables. Called by the writer before it positions.
+static FORCE_INLINE void tsdbMemSkipListAdjustLevel(SMemSkipList *pSl, int64_t nAdd) {
+  while (pSl->maxLevel < SL_MAX_LEVEL && pSl->size + nAdd > (1ll << (pSl->maxLevel << 1))) {
+    pSl->maxLevel++;
+  }
+}
+
 static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
   int8_t level = 1;
   int8_t tlevel = TMIN(pSl->maxLevel, pSl->level + 1);
@@ -643,9 +682,12 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
   TSDBKEY           key = {.version = version, .ts = pBlockData->aTSKEY[0]};
   TSDBROW           lRow;  // last row
 
+  taosWLockLatch(&pTbData->latch);
+  tsdbMemSkipListAdjustLevel(&pTbData->sl, pBlockData->nRow);
+
   // first row
   tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
+  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _unlock;
   pTbData->minKey = TMIN(pTbData->minKey, key.ts);
   lRow = tRow;
 
@@ -663,7 +705,7 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
         tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
       }
 
-      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1))) goto _exit;
+      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1))) goto _unlock;
       lRow = tRow;
 
       ++tRow.iRow;
@@ -673,20 +715,27 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
   if (key.ts >= pTbData->maxKey) {
     pTbData->maxKey = key.ts;
   }
+  TSKEY minKey = pTbData->minKey;
+  TSKEY maxKey = pTbData->maxKey;
+  taosWUnLockLatch(&pTbData->latch);
 
   if (!TSDB_CACHE_NO(pMemTable->pTsdb->pVnode->config)) {
     tsdbCacheUpdate(pMemTable->pTsdb, pTbData->suid, pTbData->uid, &lRow);
   }
 
   // SMemTable
-  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
-  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
-  pMemTable->nRow += pBlockData->nRow;
+  tsdbAtomicMin64(&pMemTable->minKey, minKey);
+  tsdbAtomicMax64(&pMemTable->maxKey, maxKey);
+  atomic_add_fetch_64(&pMemTable->nRow, pBlockData->nRow);
 
   if (affectedRows) *affectedRows = pBlockData->nRow;
 
 _exit:
   return code;
+
+_unlock:
+  taosWUnLockLatch(&pTbData->latch);
+  return code;
 }
 
 static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
@@ -701,12 +750,15 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   int32_t           iRow = 0;
   TSDBROW           lRow;
 
+  taosWLockLatch(&pTbData->latch);
+  tsdbMemSkipListAdjustLevel(&pTbData->sl, nRow);
+
   // backward put first data
   tRow.pTSRow = aRow[iRow++];
   key.ts = tRow.pTSRow->ts;
   tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
   code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
-  if (code) goto _exit;
+  if (code) goto _unlock;
   lRow = tRow;
 
   pTbData->minKey = TMIN(pTbData->minKey, key.ts);
@@ -726,7 +778,7 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
       }
 
       code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1);
-      if (code) goto _exit;
+      if (code) goto _unlock;
 
       lRow = tRow;
 
@@ -737,18 +789,24 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   if (key.ts >= pTbData->maxKey) {
     pTbData->maxKey = key.ts;
   }
+  TSKEY minKey = pTbData->minKey;
+  TSKEY maxKey = pTbData->maxKey;
+  taosWUnLockLatch(&pTbData->latch);
+
   if (!TSDB_CACHE_NO(pMemTable->pTsdb->pVnode->config)) {
     tsdbCacheUpdate(pMemTable->pTsdb, pTbData->suid, pTbData->uid, &lRow);
   }
 
   // SMemTable
-  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
-  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
-  pMemTable->nRow += nRow;
+  tsdbAtomicMin64(&pMemTable->minKey, minKey);
+  tsdbAtomicMax64(&pMemTable->maxKey, maxKey);
+  atomic_add_fetch_64(&pMemTable->nRow, nRow);
 
   if (affectedRows) *affectedRows = nRow;
+  return code;
 
-_exit:
+_unlock:
+  taosWUnLockLatch(&pTbData->latch);
   return code;
 }
 
@@ -803,12 +861,11 @@ SArray *tsdbMemTableGetTbDataArray(SMemTable *pMemTable) {
   SArray *aTbDataP = taosArrayInit(pMemTable->nTbData, sizeof(STbData *));
   if (aTbDataP == NULL) goto _exit;
 
-  for (int32_t iBucket = 0; iBucket < pMemTable->nBucket; iBucket++) {
-    STbData *pTbData = pMemTable->aBucket[iBucket];
-
-    while (pTbData) {
+  STbDataHash *pHash = (STbDataHash *)atomic_load_ptr(&pMemTable->pHash);
+  for (int32_t iBucket = 0; iBucket < pHash->nBucket; iBucket++) {
+    STbData *pTbData = pHash->aBucket[iBucket];
+    if (pTbData) {
       taosArrayPush(aTbDataP, &pTbData);
-      pTbData = pTbData->next;
     }
   }
 
@@ -16,6 +16,7 @@
 #include "osDef.h"
 #include "tsdb.h"
 #include "tsimplehash.h"
+#include "tsched.h"
 
 #define ASCENDING_TRAVERSE(o) (o == TSDB_ORDER_ASC)
 #define getCurrentKeyInLastBlock(_r) ((_r)->currentKey)
@@ -95,6 +96,7 @@ typedef struct SIOCostSummary {
   //  double  getTbFromMemTime;
   //  double  getTbFromIMemTime;
   double initDelSkylineIterTime;
+  int64_t prefetchedBlocks;
 } SIOCostSummary;
 
 typedef struct SBlockLoadSuppInfo {
@@ -140,6 +142,35 @@ typedef struct SDataBlockIter {
   SSHashObj* pTableMap;
 } SDataBlockIter;
 
+typedef enum {
+  BLOCK_PREFETCH_IDLE = 0,
+  BLOCK_PREFETCH_PENDING,  // scheduled, the worker sets it ready and posts done when the block is loaded
+  BLOCK_PREFETCH_READY,
+} EBlockPrefetchStatus;
+
+typedef struct SBlockPrefetchSlot {
+  STsdb*        pTsdb;
+  SDFileSet*    pSet;
+  SDataFReader* pFReader;  // private reader, the file handles of the query thread are not thread safe
+  STSchema*     pSchema;
+  TABLEID       tid;
+  int16_t*      aColId;
+  int32_t       numOfCols;
+  int32_t       tbBlockIdx;
+  int32_t       iterIndex;  // position in the block iterator when it was scheduled
+  SDataBlk      block;
+  SBlockData    data;
+  int32_t       code;
+  int8_t        status;
+  bool          posted;  // the worker has scheduled a post of done which is not waited yet
+  tsem_t        done;
+} SBlockPrefetchSlot;
+
+typedef struct SBlockPrefetcher {
+  int32_t             numOfSlots;
+  SBlockPrefetchSlot* pSlots;
+} SBlockPrefetcher;
+
 typedef struct SFileBlockDumpInfo {
   int32_t totalRows;
   int32_t rowIndex;
@@ -219,6 +250,7 @@ struct STsdbReader {
   SBlockInfoBuf      blockInfoBuf;
   EContentData       step;
   STsdbReader*       innerReader[2];
+  SBlockPrefetcher*  pPrefetcher;
 };
 
 static SFileDataBlockInfo* getCurrentBlockInfo(SDataBlockIter* pBlockIter);
@@ -257,6 +289,7 @@ static void          initBlockDumpInfo(STsdbReader* pReader, SDataBlockIter* pBl
 static int32_t       getInitialDelIndex(const SArray* pDelSkyline, int32_t order);
 
 static STableBlockScanInfo* getTableBlockScanInfo(SSHashObj* pTableMap, uint64_t uid, const char* id);
+static void                 clearBlockPrefetch(STsdbReader* pReader);
 
 static bool outOfTimeWindow(int64_t ts, STimeWindow* pWindow) { return (ts > pWindow->ekey) || (ts < pWindow->skey); }
 
@@ -594,6 +627,7 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
 
   while (1) {
     if (pReader->pFileReader != NULL) {
+      clearBlockPrefetch(pReader);
       tsdbDataFReaderClose(&pReader->pFileReader);
     }
 
@@ -1442,6 +1476,279 @@ static FORCE_INLINE STSchema* getTableSchemaImpl(STsdbReader* pReader, uint64_t
   return pReader->pSchema;
 }
 
+// block prefetch: the next blocks of the iterator are loaded and decompressed on the tsdb-prefetch pool while the
+// current one is consumed by the query thread
+#define TSDB_PREFETCH_QUEUE_SIZE 10000
+
+typedef struct {
+  int8_t      inited;
+  int32_t     nThreads;
+  SSchedQueue queue;
+} STsdbPrefetchMgmt;
+
+static STsdbPrefetchMgmt tsdbPrefetchMgmt = {0};
+
+int32_t tsdbPrefetchInit() {
+  int8_t old;
+  while (1) {
+    old = atomic_val_compare_exchange_8(&tsdbPrefetchMgmt.inited, 0, 2);
+    if (old != 2) break;
+  }
+
+  if (old == 0) {
+    tsdbPrefetchMgmt.nThreads = 0;
+    if (tsTsdbReadAheadBlocks > 0) {
+      tsdbPrefetchMgmt.nThreads = (int32_t)(tsNumOfCores / 2);
+      tsdbPrefetchMgmt.nThreads = TRANGE(tsdbPrefetchMgmt.nThreads, 2, 16);
+      if (taosInitScheduler(TSDB_PREFETCH_QUEUE_SIZE, tsdbPrefetchMgmt.nThreads, "tsdb-prefetch",
+                            &tsdbPrefetchMgmt.queue) == NULL) {
+        tsdbError("failed to init tsdb prefetch queue, numOfThreads:%d", tsdbPrefetchMgmt.nThreads);
+        atomic_store_8(&tsdbPrefetchMgmt.inited, 0);
+        return -1;
+      }
+    }
+
+    tsdbInfo("tsdb prefetch is initialized, numOfThreads:%d readAheadBlocks:%d", tsdbPrefetchMgmt.nThreads,
+             tsTsdbReadAheadBlocks);
+    atomic_store_8(&tsdbPrefetchMgmt.inited, 1);
+  }
+
+  return 0;
+}
+
+void tsdbPrefetchCleanUp() {
+  int8_t old;
+  while (1) {
+    old = atomic_val_compare_exchange_8(&tsdbPrefetchMgmt.inited, 1, 2);
+    if (old != 2) break;
+  }
+
+  if (old == 1) {
+    if (tsdbPrefetchMgmt.nThreads > 0) {
+      taosCleanUpScheduler(&tsdbPrefetchMgmt.queue);
+    }
+    tsdbInfo("tsdb prefetch is cleaned up");
+    atomic_store_8(&tsdbPrefetchMgmt.inited, 0);
+  }
+}
+
+static void doPrefetchBlockTask(SSchedMsg* pMsg) {
+  SBlockPrefetchSlot* pSlot = (SBlockPrefetchSlot*)pMsg->ahandle;
+  int32_t             code = 0;
+
+  if (pSlot->pFReader != NULL && pSlot->pFReader->pSet != pSlot->pSet) {
+    tsdbDataFReaderClose(&pSlot->pFReader);
+  }
+
+  if (pSlot->pFReader == NULL) {
+    code = tsdbDataFReaderOpen(&pSlot->pFReader, pSlot->pTsdb, pSlot->pSet);
+  }
+
+  if (code == TSDB_CODE_SUCCESS) {
+    tBlockDataReset(&pSlot->data);
+    code = tBlockDataInit(&pSlot->data, &pSlot->tid, pSlot->pSchema, pSlot->aColId, pSlot->numOfCols);
+  }
+
+  if (code == TSDB_CODE_SUCCESS) {
+    code = tsdbReadDataBlock(pSlot->pFReader, &pSlot->block, &pSlot->data);
+  }
+
+  pSlot->code = code;
+  atomic_store_8(&pSlot->status, BLOCK_PREFETCH_READY);
+  tsem_post(&pSlot->done);
+}
+
+static SBlockPrefetcher* createBlockPrefetcher(int32_t numOfSlots) {
+  SBlockPrefetcher* pPrefetcher = taosMemoryCalloc(1, sizeof(SBlockPrefetcher));
+  if (pPrefetcher == NULL) {
+    return NULL;
+  }
+
+  pPrefetcher->pSlots = taosMemoryCalloc(numOfSlots, sizeof(SBlockPrefetchSlot));
+  if (pPrefetcher->pSlots == NULL) {
+    taosMemoryFree(pPrefetcher);
+    return NULL;
+  }
+
+  pPrefetcher->numOfSlots = numOfSlots;
+  for (int32_t i = 0; i < numOfSlots; ++i) {
+    tsem_init(&pPrefetcher->pSlots[i].done, 0, 0);
+  }
+
+  return pPrefetcher;
+}
+
+static void waitPrefetchSlot(SBlockPrefetchSlot* pSlot) {
+  if (pSlot->posted) {
+    tsem_wait(&pSlot->done);
+    pSlot->posted = false;
+  }
+}
+
+// wait for the in-flight loads and close the private readers, must be called before the file set of the reader or
+// its snapshot is released
+static void clearBlockPrefetch(STsdbReader* pReader) {
+  SBlockPrefetcher* pPrefetcher = pReader->pPrefetcher;
+  if (pPrefetcher == NULL) {
+    return;
+  }
+
+  for (int32_t i = 0; i < pPrefetcher->numOfSlots; ++i) {
+    SBlockPrefetchSlot* pSlot = &pPrefetcher->pSlots[i];
+    waitPrefetchSlot(pSlot);
+    pSlot->status = BLOCK_PREFETCH_IDLE;
+    if (pSlot->pFReader != NULL) {
+      tsdbDataFReaderClose(&pSlot->pFReader);
+    }
+  }
+}
+
+static void destroyBlockPrefetcher(STsdbReader* pReader) {
+  SBlockPrefetcher* pPrefetcher = pReader->pPrefetcher;
+  if (pPrefetcher == NULL) {
+    return;
+  }
+
+  clearBlockPrefetch(pReader);
+  for (int32_t i = 0; i < pPrefetcher->numOfSlots; ++i) {
+    tBlockDataDestroy(&pPrefetcher->pSlots[i].data);
+    tsem_destroy(&pPrefetcher->pSlots[i].done);
+  }
+
+  taosMemoryFree(pPrefetcher->pSlots);
+  taosMemoryFreeClear(pReader->pPrefetcher);
+}
+
+static bool isSamePrefetchBlock(SBlockPrefetchSlot* pSlot, STsdbReader* pReader, SFileDataBlockInfo* pBlockInfo,
+                                SDataBlk* pBlock) {
+  return atomic_load_8(&pSlot->status) != BLOCK_PREFETCH_IDLE && pSlot->pSet == pReader->status.pCurrentFileset &&
+         pSlot->tid.uid == pBlockInfo->uid && pSlot->tbBlockIdx == pBlockInfo->tbBlockIdx &&
+         pSlot->block.aSubBlock[0].offset == pBlock->aSubBlock[0].offset;
+}
+
+// take the prefetched copy of the current block if there is one, the buffers are swapped so no copy is needed
+static bool tryGetPrefetchedBlock(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData) {
+  SBlockPrefetcher* pPrefetcher = pReader->pPrefetcher;
+  if (pPrefetcher == NULL) {
+    return false;
+  }
+
+  SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(pBlockIter);
+  SDataBlk*           pBlock = &pBlockIter->block;
+  for (int32_t i = 0; i < pPrefetcher->numOfSlots; ++i) {
+    SBlockPrefetchSlot* pSlot = &pPrefetcher->pSlots[i];
+    if (!isSamePrefetchBlock(pSlot, pReader, pBlockInfo, pBlock)) {
+      continue;
+    }
+
+    waitPrefetchSlot(pSlot);
+    pSlot->status = BLOCK_PREFETCH_IDLE;
+    if (pSlot->code != TSDB_CODE_SUCCESS) {
+      return false;  // load it again in the query thread to report the error
+    }
+
+    SBlockData tmp = *pBlockData;
+    *pBlockData = pSlot->data;
+    pSlot->data = tmp;
+    pReader->cost.prefetchedBlocks += 1;
+    return true;
+  }
+
+  return false;
+}
+
+static SBlockPrefetchSlot* getIdlePrefetchSlot(SBlockPrefetcher* pPrefetcher, int32_t index, bool asc) {
+  for (int32_t i = 0; i < pPrefetcher->numOfSlots; ++i) {
+    SBlockPrefetchSlot* pSlot = &pPrefetcher->pSlots[i];
+    if (pSlot->status == BLOCK_PREFETCH_IDLE) {
+      return pSlot;
+    }
+
+    // a block which has been passed by the iterator is never used, e.g. it is skipped by its sma, the slot is reused
+    // once the worker is done with it
+    bool passed = asc ? (pSlot->iterIndex <= index) : (pSlot->iterIndex >= index);
+    if (passed && atomic_load_8(&pSlot->status) == BLOCK_PREFETCH_READY) {
+      waitPrefetchSlot(pSlot);
+      pSlot->status = BLOCK_PREFETCH_IDLE;
+      return pSlot;
+    }
+  }
+
+  return NULL;
+}
+
+static void doPrefetchFileBlocks(STsdbReader* pReader, SDataBlockIter* pBlockIter) {
+  if (tsTsdbReadAheadBlocks <= 0 || tsdbPrefetchMgmt.nThreads <= 0 || pReader->pSchema == NULL) {
+    return;
+  }
+
+  if (pReader->pPrefetcher == NULL) {
+    pReader->pPrefetcher = createBlockPrefetcher(tsTsdbReadAheadBlocks);
+    if (pReader->pPrefetcher == NULL) {
+      return;
+    }
+  }
+
+  SBlockPrefetcher*   pPrefetcher = pReader->pPrefetcher;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  bool                asc = ASCENDING_TRAVERSE(pBlockIter->order);
+  int32_t             step = asc ? 1 : -1;
+
+  for (int32_t k = 1; k <= pPrefetcher->numOfSlots; ++k) {
+    int32_t index = pBlockIter->index + k * step;
+    if (index < 0 || index >= pBlockIter->numOfBlocks) {
+      break;
+    }
+
+    SFileDataBlockInfo* pBlockInfo = taosArrayGet(pBlockIter->blockList, index);
+    STableBlockScanInfo* pScanInfo = getTableBlockScanInfo(pBlockIter->pTableMap, pBlockInfo->uid, pReader->idStr);
+    if (pScanInfo == NULL) {
+      break;
+    }
+
+    SDataBlk     block = {0};
+    SBlockIndex* pIndex = taosArrayGet(pScanInfo->pBlockList, pBlockInfo->tbBlockIdx);
+    tMapDataGetItemByIdx(&pScanInfo->mapData, pIndex->ordinalIndex, &block, tGetDataBlk);
+
+    bool scheduled = false;
+    for (int32_t i = 0; i < pPrefetcher->numOfSlots; ++i) {
+      if (isSamePrefetchBlock(&pPrefetcher->pSlots[i], pReader, pBlockInfo, &block)) {
+        scheduled = true;
+        break;
+      }
+    }
+
+    if (scheduled) {
+      continue;
+    }
+
+    SBlockPrefetchSlot* pSlot = getIdlePrefetchSlot(pPrefetcher, pBlockIter->index, asc);
+    if (pSlot == NULL) {
+      break;
+    }
+
+    pSlot->pTsdb = pReader->pTsdb;
+    pSlot->pSet = pReader->status.pCurrentFileset;
+    pSlot->pSchema = pReader->pSchema;
+    pSlot->tid = (TABLEID){.suid = pReader->suid, .uid = pBlockInfo->uid};
+    pSlot->aColId = &pSup->colId[1];
+    pSlot->numOfCols = pSup->numOfCols - 1;
+    pSlot->tbBlockIdx = pBlockInfo->tbBlockIdx;
+    pSlot->iterIndex = index;
+    pSlot->block = block;
+    pSlot->code = 0;
+    pSlot->status = BLOCK_PREFETCH_PENDING;
+    pSlot->posted = true;
+
+    SSchedMsg schedMsg = {.fp = doPrefetchBlockTask, .ahandle = pSlot};
+    if (taosScheduleTask(&tsdbPrefetchMgmt.queue, &schedMsg) != 0) {
+      pSlot->status = BLOCK_PREFETCH_IDLE;
+      pSlot->posted = false;
+      break;
+    }
+  }
+}
+
 static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
                                    uint64_t uid) {
   int32_t   code = 0;
@@ -1469,7 +1776,13 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   SFileBlockDumpInfo* pDumpInfo = &pReader->status.fBlockDumpInfo;
 
   SDataBlk* pBlock = getCurrentBlock(pBlockIter);
-  code = tsdbReadDataBlock(pReader->pFileReader, pBlock, pBlockData);
+  if (tryGetPrefetchedBlock(pReader, pBlockIter, pBlockData)) {
+    code = TSDB_CODE_SUCCESS;
+  } else {
+    code = tsdbReadDataBlock(pReader->pFileReader, pBlock, pBlockData);
+  }
+
+  doPrefetchFileBlocks(pReader, pBlockIter);
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%p error occurs in loading file block, global index:%d, table index:%d, brange:%" PRId64 "-%" PRId64
               ", rows:%d, code:%s %s",
@@ -4619,6 +4932,8 @@ void tsdbReaderClose(STsdbReader* pReader) {
     }
   }
 
+  destroyBlockPrefetcher(pReader);
+
   SBlockLoadSuppInfo* pSupInfo = &pReader->suppInfo;
 
   taosArrayDestroy(pSupInfo->pColAgg);
@@ -4684,11 +4999,11 @@ void tsdbReaderClose(STsdbReader* pReader) {
       ", fileBlocks-load-time:%.2f ms, "
       "build in-memory-block-time:%.2f ms, lastBlocks:%" PRId64 ", lastBlocks-time:%.2f ms, composed-blocks:%" PRId64
       ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,initDelSkylineIterTime:%.2f "
-      "ms, %s",
+      "ms, prefetched-blocks:%" PRId64 ", %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->lastBlockLoad, pCost->lastBlockLoadTime, pCost->composedBlocks,
       pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
-      pCost->initDelSkylineIterTime, pReader->idStr);
+      pCost->initDelSkylineIterTime, pCost->prefetchedBlocks, pReader->idStr);
 
   taosMemoryFree(pReader->idStr);
 
@@ -4706,6 +5021,9 @@ int32_t tsdbReaderSuspend(STsdbReader* pReader) {
   SReaderStatus*       pStatus = &pReader->status;
   STableBlockScanInfo* pBlockScanInfo = NULL;
 
+  // the prefetch readers hold files of the snapshot which is released below
+  clearBlockPrefetch(pReader);
+
   if (pStatus->loadFromFile) {
     SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(&pReader->status.blockIter);
     if (pBlockInfo != NULL) {
@@ -5274,6 +5592,7 @@ int32_t tsdbReaderReset(STsdbReader* pReader, SQueryTableDataCond* pCond) {
   memset(&pReader->suppInfo.tsColAgg, 0, sizeof(SColumnDataAgg));
 
   pReader->suppInfo.tsColAgg.colId = PRIMARYKEY_TIMESTAMP_COL_ID;
+  clearBlockPrefetch(pReader);
   tsdbDataFReaderClose(&pReader->pFileReader);
 
   int32_t numOfTables = tSimpleHashGetSize(pStatus->pTableMap);
@@ -5638,3 +5957,49 @@ int64_t tsdbGetLastTimestamp(SVnode* pVnode, void* pTableList, int32_t numOfTabl
 
   return 0;
 }
+
+// Split the query time window at file set boundaries into at most maxParts consecutive windows in ascending order.
+// The parts are disjoint and cover the whole window, so readers opened on them return exactly the rows of one reader
+// opened on the whole window. Memory table rows are assigned to the part that covers their timestamp.
+// The readers of the parts take their snapshots one by one, and take them again after a commit, so they are opened with
+// the data version returned in pVersion to read the same data.
+int32_t tsdbSplitTimeWindow(SVnode* pVnode, const STimeWindow* pWindow, int32_t maxParts, SArray* pWindows,
+                            int64_t* pVersion) {
+  STsdb*  pTsdb = pVnode->pTsdb;
+  SArray* pBounds = taosArrayInit(8, sizeof(TSKEY));
+  if (pBounds == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  taosThreadRwlockRdlock(&pTsdb->rwLock);
+  *pVersion = pVnode->state.applied;
+  int32_t numOfFileset = taosArrayGetSize(pTsdb->fs.aDFileSet);
+  for (int32_t i = 0; i < numOfFileset; ++i) {
+    SDFileSet* pSet = taosArrayGet(pTsdb->fs.aDFileSet, i);
+    TSKEY      skey = 0, ekey = 0;
+    tsdbFidKeyRange(pSet->fid, pTsdb->keepCfg.days, pTsdb->keepCfg.precision, &skey, &ekey);
+    if (skey > pWindow->skey && skey <= pWindow->ekey) {
+      taosArrayPush(pBounds, &skey);
+    }
+  }
+  taosThreadRwlockUnlock(&pTsdb->rwLock);
+
+  // keep every step-th boundary if there are more file sets than parts
+  int32_t numOfBounds = taosArrayGetSize(pBounds);
+  int32_t numOfParts = TMIN(numOfBounds + 1, TMAX(maxParts, 1));
+
+  STimeWindow w = {.skey = pWindow->skey};
+  for (int32_t i = 1; i < numOfParts; ++i) {
+    int32_t index = (int32_t)((int64_t)i * (numOfBounds + 1) / numOfParts) - 1;
+    TSKEY   bound = *(TSKEY*)taosArrayGet(pBounds, index);
+    w.ekey = bound - 1;
+    taosArrayPush(pWindows, &w);
+    w.skey = bound;
+  }
+
+  w.ekey = pWindow->ekey;
+  taosArrayPush(pWindows, &w);
+
+  taosArrayDestroy(pBounds);
+  return TSDB_CODE_SUCCESS;
+}
@@ -16,7 +16,9 @@
 #include "tsdb.h"
 
 // =============== PAGE-WISE FILE ===============
-static int32_t tsdbOpenFile(const char *path, int32_t szPage, int32_t flag, STsdbFD **ppFD) {
+// lSize is the logic size of the file in the file set a reader opens it for
+static int32_t tsdbOpenFile(STsdb *pTsdb, const char *path, int32_t szPage, int32_t flag, int64_t lSize,
+                            STsdbFD **ppFD) {
   int32_t  code = 0;
   STsdbFD *pFD = NULL;
 
@@ -28,10 +30,13 @@ static int32_t tsdbOpenFile(const char *path, int32_t szPage, int32_t flag, STsd
     goto _exit;
   }
 
+  pFD->pTsdb = pTsdb;
   pFD->path = (char *)&pFD[1];
   strcpy(pFD->path, path);
   pFD->szPage = szPage;
   pFD->flag = flag;
+  // the partial last page is rewritten when the file is appended, so it never goes to the page cache
+  pFD->nCachePage = (flag == TD_FILE_READ) ? lSize / PAGE_CONTENT_SIZE(szPage) : 0;
   pFD->pFD = taosOpenFile(path, flag);
   if (pFD->pFD == NULL) {
     code = TAOS_SYSTEM_ERROR(errno);
@@ -111,6 +116,13 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno) {
 
   // ASSERT(pgno <= pFD->szFile);
 
+  // only read-only handles go through the page cache, writers own their pages
+  bool useCache = (pgno <= pFD->nCachePage);
+  if (useCache && tsdbPgCacheGet(pFD->pTsdb, pFD->path, pgno, pFD->pBuf, pFD->szPage)) {
+    pFD->pgno = pgno;
+    goto _exit;
+  }
+
   // seek
   int64_t offset = PAGE_OFFSET(pgno, pFD->szPage);
   int64_t n = taosLSeekFile(pFD->pFD, offset, SEEK_SET);
@@ -135,6 +147,10 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno) {
     goto _exit;
   }
 
+  if (useCache) {
+    tsdbPgCachePut(pFD->pTsdb, pFD->path, pgno, pFD->pBuf, pFD->szPage);
+  }
+
   pFD->pgno = pgno;
 
 _exit:
@@ -251,7 +267,7 @@ int32_t tsdbDataFWriterOpen(SDataFWriter **ppWriter, STsdb *pTsdb, SDFileSet *pS
   // head
   flag = TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC;
   tsdbHeadFileName(pTsdb, pWriter->wSet.diskId, pWriter->wSet.fid, &pWriter->fHead, fname);
-  code = tsdbOpenFile(fname, szPage, flag, &pWriter->pHeadFD);
+  code = tsdbOpenFile(pTsdb, fname, szPage, flag, 0, &pWriter->pHeadFD);
   if (code) goto _err;
 
   code = tsdbWriteFile(pWriter->pHeadFD, 0, hdr, TSDB_FHDR_SIZE);
@@ -265,7 +281,7 @@ int32_t tsdbDataFWriterOpen(SDataFWriter **ppWriter, STsdb *pTsdb, SDFileSet *pS
     flag = TD_FILE_READ | TD_FILE_WRITE;
   }
   tsdbDataFileName(pTsdb, pWriter->wSet.diskId, pWriter->wSet.fid, &pWriter->fData, fname);
-  code = tsdbOpenFile(fname, szPage, flag, &pWriter->pDataFD);
+  code = tsdbOpenFile(pTsdb, fname, szPage, flag, 0, &pWriter->pDataFD);
   if (code) goto _err;
   if (pWriter->fData.size == 0) {
     code = tsdbWriteFile(pWriter->pDataFD, 0, hdr, TSDB_FHDR_SIZE);
@@ -280,7 +296,7 @@ int32_t tsdbDataFWriterOpen(SDataFWriter **ppWriter, STsdb *pTsdb, SDFileSet *pS
     flag = TD_FILE_READ | TD_FILE_WRITE;
   }
   tsdbSmaFileName(pTsdb, pWriter->wSet.diskId, pWriter->wSet.fid, &pWriter->fSma, fname);
-  code = tsdbOpenFile(fname, szPage, flag, &pWriter->pSmaFD);
+  code = tsdbOpenFile(pTsdb, fname, szPage, flag, 0, &pWriter->pSmaFD);
   if (code) goto _err;
   if (pWriter->fSma.size == 0) {
     code = tsdbWriteFile(pWriter->pSmaFD, 0, hdr, TSDB_FHDR_SIZE);
@@ -293,7 +309,7 @@ int32_t tsdbDataFWriterOpen(SDataFWriter **ppWriter, STsdb *pTsdb, SDFileSet *pS
   ASSERT(pWriter->fStt[pSet->nSttF - 1].size == 0);
   flag = TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC;
   tsdbSttFileName(pTsdb, pWriter->wSet.diskId, pWriter->wSet.fid, &pWriter->fStt[pSet->nSttF - 1], fname);
-  code = tsdbOpenFile(fname, szPage, flag, &pWriter->pSttFD);
+  code = tsdbOpenFile(pTsdb, fname, szPage, flag, 0, &pWriter->pSttFD);
   if (code) goto _err;
   code = tsdbWriteFile(pWriter->pSttFD, 0, hdr, TSDB_FHDR_SIZE);
   if (code) goto _err;
@@ -743,106 +759,127 @@ _exit:
   return code;
 }
 
-int32_t tsdbDFileSetCopy(STsdb *pTsdb, SDFileSet *pSetFrom, SDFileSet *pSetTo) {
+// tier migration ==============================
+// file sets are moved to a lower tier chunk by chunk. each chunk is paced to the retentionSpeedLimit budget and the
+// copy yields while queries of the vnode wait in the query or fetch queue, for at most TSDB_MIGRATE_MAX_YIELD times
+// a chunk so that it is never starved. the copy gives up when the vnode is closed
+#define TSDB_MIGRATE_CHUNK_SIZE (1024 * 1024)
+#define TSDB_MIGRATE_YIELD_MS   10
+#define TSDB_MIGRATE_MAX_YIELD  100
+
+static void tsdbMigrateYield(STsdb *pTsdb) {
+  SVnode *pVnode = pTsdb->pVnode;
+
+  if (pVnode->msgCb.qsizeFp == NULL) return;
+
+  for (int32_t i = 0; i < TSDB_MIGRATE_MAX_YIELD; i++) {
+    if (tmsgGetQueueSize(&pVnode->msgCb, TD_VID(pVnode), QUERY_QUEUE) == 0 &&
+        tmsgGetQueueSize(&pVnode->msgCb, TD_VID(pVnode), FETCH_QUEUE) == 0) {
+      break;
+    }
+    taosMsleep(TSDB_MIGRATE_YIELD_MS);
+  }
+}
+
+static void tsdbMigrateThrottle(int64_t size, int64_t elapsed) {
+  int32_t limit = tsRetentionSpeedLimit;
+
+  if (limit <= 0) return;
+
+  int64_t expected = size * 1000 / ((int64_t)limit * 1024 * 1024);
+  if (expected > elapsed) {
+    taosMsleep((int32_t)(expected - elapsed));
+  }
+}
+
+static int32_t tsdbMigrateFile(STsdb *pTsdb, const char *fNameFrom, const char *fNameTo, int64_t size) {
   int32_t   code = 0;
-  int64_t   n;
-  int64_t   size;
   TdFilePtr pOutFD = NULL;
-  TdFilePtr PInFD = NULL;
-  int32_t   szPage = pTsdb->pVnode->config.szPage;
-  char      fNameFrom[TSDB_FILENAME_LEN];
-  char      fNameTo[TSDB_FILENAME_LEN];
+  TdFilePtr pInFD = NULL;
 
-  // head
-  tsdbHeadFileName(pTsdb, pSetFrom->diskId, pSetFrom->fid, pSetFrom->pHeadF, fNameFrom);
-  tsdbHeadFileName(pTsdb, pSetTo->diskId, pSetTo->fid, pSetTo->pHeadF, fNameTo);
   pOutFD = taosCreateFile(fNameTo, TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
   if (pOutFD == NULL) {
     code = TAOS_SYSTEM_ERROR(errno);
-    goto _err;
+    goto _exit;
   }
-  PInFD = taosOpenFile(fNameFrom, TD_FILE_READ);
-  if (PInFD == NULL) {
+  pInFD = taosOpenFile(fNameFrom, TD_FILE_READ);
+  if (pInFD == NULL) {
     code = TAOS_SYSTEM_ERROR(errno);
-    goto _err;
+    goto _exit;
   }
-  n = taosFSendFile(pOutFD, PInFD, 0, tsdbLogicToFileSize(pSetFrom->pHeadF->size, szPage));
-  if (n < 0) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _err;
+
+  for (int64_t offset = 0; offset < size;) {
+    if (atomic_load_8(&pTsdb->pVnode->retentionStop)) {
+      code = TSDB_CODE_VND_STOPPED;
+      goto _exit;
+    }
+
+    tsdbMigrateYield(pTsdb);
+
+    int64_t start = taosGetTimestampMs();
+    int64_t chunk = TMIN(TSDB_MIGRATE_CHUNK_SIZE, size - offset);
+    int64_t pos = offset;
+    int64_t n = taosFSendFile(pOutFD, pInFD, &pos, chunk);
+    if (n < 0) {
+      code = TAOS_SYSTEM_ERROR(errno);
+      goto _exit;
+    } else if (n != chunk) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
+    offset += n;
+
+    int64_t now = taosGetTimestampMs();
+    int64_t done = atomic_add_fetch_64(&pTsdb->migrateDone, n);
+    atomic_store_64(&pTsdb->migrateSpeed, done * 1000 / TMAX(now - pTsdb->migrateStart, 1));
+
+    tsdbMigrateThrottle(n, now - start);
   }
+
+_exit:
   taosCloseFile(&pOutFD);
-  taosCloseFile(&PInFD);
+  taosCloseFile(&pInFD);
+  return code;
+}
+
+int32_t tsdbDFileSetCopy(STsdb *pTsdb, SDFileSet *pSetFrom, SDFileSet *pSetTo) {
+  int32_t code = 0;
+  int32_t lino = 0;
+  int32_t szPage = pTsdb->pVnode->config.tsdbPageSize;
+  char    fNameFrom[TSDB_FILENAME_LEN];
+  char    fNameTo[TSDB_FILENAME_LEN];
+
+  // head
+  tsdbHeadFileName(pTsdb, pSetFrom->diskId, pSetFrom->fid, pSetFrom->pHeadF, fNameFrom);
+  tsdbHeadFileName(pTsdb, pSetTo->diskId, pSetTo->fid, pSetTo->pHeadF, fNameTo);
+  code = tsdbMigrateFile(pTsdb, fNameFrom, fNameTo, tsdbLogicToFileSize(pSetFrom->pHeadF->size, szPage));
+  TSDB_CHECK_CODE(code, lino, _exit);
 
   // data
   tsdbDataFileName(pTsdb, pSetFrom->diskId, pSetFrom->fid, pSetFrom->pDataF, fNameFrom);
   tsdbDataFileName(pTsdb, pSetTo->diskId, pSetTo->fid, pSetTo->pDataF, fNameTo);
-  pOutFD = taosCreateFile(fNameTo, TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
-  if (pOutFD == NULL) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _err;
-  }
-  PInFD = taosOpenFile(fNameFrom, TD_FILE_READ);
-  if (PInFD == NULL) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _err;
-  }
-  n = taosFSendFile(pOutFD, PInFD, 0, tsdbLogicToFileSize(pSetFrom->pDataF->size, szPage));
-  if (n < 0) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _err;
-  }
-  taosCloseFile(&pOutFD);
-  taosCloseFile(&PInFD);
+  code = tsdbMigrateFile(pTsdb, fNameFrom, fNameTo, tsdbLogicToFileSize(pSetFrom->pDataF->size, szPage));
+  TSDB_CHECK_CODE(code, lino, _exit);
 
   // sma
   tsdbSmaFileName(pTsdb, pSetFrom->diskId, pSetFrom->fid, pSetFrom->pSmaF, fNameFrom);
   tsdbSmaFileName(pTsdb, pSetTo->diskId, pSetTo->fid, pSetTo->pSmaF, fNameTo);
-  pOutFD = taosCreateFile(fNameTo, TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
-  if (pOutFD == NULL) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _err;
-  }
-  PInFD = taosOpenFile(fNameFrom, TD_FILE_READ);
-  if (PInFD == NULL) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _err;
-  }
-  n = taosFSendFile(pOutFD, PInFD, 0, tsdbLogicToFileSize(pSetFrom->pSmaF->size, szPage));
-  if (n < 0) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _err;
-  }
-  taosCloseFile(&pOutFD);
-  taosCloseFile(&PInFD);
+  code = tsdbMigrateFile(pTsdb, fNameFrom, fNameTo, tsdbLogicToFileSize(pSetFrom->pSmaF->size, szPage));
+  TSDB_CHECK_CODE(code, lino, _exit);
 
   // stt
   for (int8_t iStt = 0; iStt < pSetFrom->nSttF; iStt++) {
     tsdbSttFileName(pTsdb, pSetFrom->diskId, pSetFrom->fid, pSetFrom->aSttF[iStt], fNameFrom);
     tsdbSttFileName(pTsdb, pSetTo->diskId, pSetTo->fid, pSetTo->aSttF[iStt], fNameTo);
-    pOutFD = taosCreateFile(fNameTo, TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
-    if (pOutFD == NULL) {
-      code = TAOS_SYSTEM_ERROR(errno);
-      goto _err;
-    }
-    PInFD = taosOpenFile(fNameFrom, TD_FILE_READ);
-    if (PInFD == NULL) {
-      code = TAOS_SYSTEM_ERROR(errno);
-      goto _err;
-    }
-    n = taosFSendFile(pOutFD, PInFD, 0, tsdbLogicToFileSize(pSetFrom->aSttF[iStt]->size, szPage));
-    if (n < 0) {
-      code = TAOS_SYSTEM_ERROR(errno);
-      goto _err;
-    }
-    taosCloseFile(&pOutFD);
-    taosCloseFile(&PInFD);
+    code = tsdbMigrateFile(pTsdb, fNameFrom, fNameTo, tsdbLogicToFileSize(pSetFrom->aSttF[iStt]->size, szPage));
+    TSDB_CHECK_CODE(code, lino, _exit);
   }
 
-  return code;
-
-_err:
-  tsdbError("vgId:%d, tsdb DFileSet copy failed since %s", TD_VID(pTsdb->pVnode), tstrerror(code));
+_exit:
+  if (code) {
+    tsdbError("vgId:%d, tsdb DFileSet copy failed at line %d since %s", TD_VID(pTsdb->pVnode), lino,
+              tstrerror(code));
+  }
   return code;
 }
 
@@ -865,23 +902,23 @@ int32_t tsdbDataFReaderOpen(SDataFReader **ppReader, STsdb *pTsdb, SDFileSet *pS
 
   // head
   tsdbHeadFileName(pTsdb, pSet->diskId, pSet->fid, pSet->pHeadF, fname);
-  code = tsdbOpenFile(fname, szPage, TD_FILE_READ, &pReader->pHeadFD);
+  code = tsdbOpenFile(pTsdb, fname, szPage, TD_FILE_READ, pSet->pHeadF->size, &pReader->pHeadFD);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // data
   tsdbDataFileName(pTsdb, pSet->diskId, pSet->fid, pSet->pDataF, fname);
-  code = tsdbOpenFile(fname, szPage, TD_FILE_READ, &pReader->pDataFD);
+  code = tsdbOpenFile(pTsdb, fname, szPage, TD_FILE_READ, pSet->pDataF->size, &pReader->pDataFD);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // sma
   tsdbSmaFileName(pTsdb, pSet->diskId, pSet->fid, pSet->pSmaF, fname);
-  code = tsdbOpenFile(fname, szPage, TD_FILE_READ, &pReader->pSmaFD);
+  code = tsdbOpenFile(pTsdb, fname, szPage, TD_FILE_READ, pSet->pSmaF->size, &pReader->pSmaFD);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // stt
   for (int32_t iStt = 0; iStt < pSet->nSttF; iStt++) {
     tsdbSttFileName(pTsdb, pSet->diskId, pSet->fid, pSet->aSttF[iStt], fname);
-    code = tsdbOpenFile(fname, szPage, TD_FILE_READ, &pReader->aSttFD[iStt]);
+    code = tsdbOpenFile(pTsdb, fname, szPage, TD_FILE_READ, pSet->aSttF[iStt]->size, &pReader->aSttFD[iStt]);
     TSDB_CHECK_CODE(code, lino, _exit);
   }
 
@@ -926,6 +963,7 @@ int32_t tsdbDataFReaderClose(SDataFReader **ppReader) {
   for (int32_t iBuf = 0; iBuf < sizeof((*ppReader)->aBuf) / sizeof(uint8_t *); iBuf++) {
     tFree((*ppReader)->aBuf[iBuf]);
   }
+  tColDecmprArenaDestroy(&(*ppReader)->arena);
   taosMemoryFree(*ppReader);
   *ppReader = NULL;
   return code;
@@ -1130,9 +1168,13 @@ static int32_t tsdbReadBlockDataImpl(SDataFReader *pReader, SBlockInfo *pBlkInfo
     if (code) goto _err;
   }
 
-  SBlockCol  blockCol = {.cid = 0};
-  SBlockCol *pBlockCol = &blockCol;
-  int32_t    n = 0;
+  SBlockCol        blockCol = {.cid = 0};
+  SBlockCol       *pBlockCol = &blockCol;
+  int32_t          n = 0;
+  SColDecmprArena *pArena = &pReader->arena;
+
+  // the file is read by this thread only, the columns read are decompressed together afterwards
+  tColDecmprArenaReset(pArena);
 
   for (int32_t iColData = 0; iColData < pBlockData->nColData; iColData++) {
     SColData *pColData = tBlockDataGetColDataByIdx(pBlockData, iColData);
@@ -1167,18 +1209,23 @@ static int32_t tsdbReadBlockDataImpl(SDataFReader *pReader, SBlockInfo *pBlkInfo
         int64_t offset = pBlkInfo->offset + pBlkInfo->szKey + hdr.szBlkCol + pBlockCol->offset;
         int32_t size = pBlockCol->szBitmap + pBlockCol->szOffset + pBlockCol->szValue;
 
-        code = tRealloc(&pReader->aBuf[1], size);
+        int32_t szIn = (int32_t)pArena->szIn;
+
+        code = tRealloc(&pArena->pBuf, szIn + size);
         if (code) goto _err;
 
-        code = tsdbReadFile(pFD, offset, pReader->aBuf[1], size);
+        code = tsdbReadFile(pFD, offset, pArena->pBuf + szIn, size);
         if (code) goto _err;
 
-        code = tsdbDecmprColData(pReader->aBuf[1], pBlockCol, hdr.cmprAlg, hdr.nRow, pColData, &pReader->aBuf[2]);
+        code = tColDecmprArenaAdd(pArena, szIn, pBlockCol, pColData);
         if (code) goto _err;
       }
     }
   }
 
+  code = tColDecmprArenaRun(pArena, pArena->pBuf, hdr.cmprAlg, hdr.nRow);
+  if (code) goto _err;
+
 _exit:
   return code;
 
@@ -1200,7 +1247,7 @@ int32_t tsdbReadDataBlockEx(SDataFReader *pReader, SDataBlk *pDataBlk, SBlockDat
   if (code) goto _err;
 
   // decmpr
-  code = tDecmprBlockData(pReader->aBuf[0], pBlockInfo->szBlock, pBlockData, &pReader->aBuf[1]);
+  code = tDecmprBlockData(pReader->aBuf[0], pBlockInfo->szBlock, pBlockData, &pReader->aBuf[1], &pReader->arena);
   if (code) goto _err;
 
   return code;
@@ -1252,7 +1299,8 @@ int32_t tsdbReadSttBlockEx(SDataFReader *pReader, int32_t iStt, SSttBlk *pSttBlk
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // decmpr
-  code = tDecmprBlockData(pReader->aBuf[0], pSttBlk->bInfo.szBlock, pBlockData, &pReader->aBuf[1]);
+  code = tDecmprBlockData(pReader->aBuf[0], pSttBlk->bInfo.szBlock, pBlockData, &pReader->aBuf[1],
+                          &pReader->arena);
   TSDB_CHECK_CODE(code, lino, _exit);
 
 _exit:
@@ -1281,8 +1329,8 @@ int32_t tsdbDelFWriterOpen(SDelFWriter **ppWriter, SDelFile *pFile, STsdb *pTsdb
   pDelFWriter->fDel = *pFile;
 
   tsdbDelFileName(pTsdb, pFile, fname);
-  code = tsdbOpenFile(fname, pTsdb->pVnode->config.tsdbPageSize, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE,
-                      &pDelFWriter->pWriteH);
+  code = tsdbOpenFile(pTsdb, fname, pTsdb->pVnode->config.tsdbPageSize, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE,
+                      0, &pDelFWriter->pWriteH);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // update header
@@ -1456,7 +1504,8 @@ int32_t tsdbDelFReaderOpen(SDelFReader **ppReader, SDelFile *pFile, STsdb *pTsdb
   pDelFReader->fDel = *pFile;
 
   tsdbDelFileName(pTsdb, pFile, fname);
-  code = tsdbOpenFile(fname, pTsdb->pVnode->config.tsdbPageSize, TD_FILE_READ, &pDelFReader->pReadH);
+  code = tsdbOpenFile(pTsdb, fname, pTsdb->pVnode->config.tsdbPageSize, TD_FILE_READ, pFile->size,
+                      &pDelFReader->pReadH);
   if (code) {
     taosMemoryFree(pDelFReader);
     goto _exit;
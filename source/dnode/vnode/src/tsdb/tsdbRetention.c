@@ -46,45 +46,196 @@ bool tsdbShouldDoRetention(STsdb *pTsdb, int64_t now) {
   return should;
 }
 
-int32_t tsdbDoRetention(STsdb *pTsdb, int64_t now) {
-  int32_t code = 0;
-  int32_t lino = 0;
-  STsdbFS fs = {0};
+static int64_t tsdbDFileSetSize(STsdb *pTsdb, SDFileSet *pSet) {
+  int32_t szPage = pTsdb->pVnode->config.tsdbPageSize;
+  int64_t size = tsdbLogicToFileSize(pSet->pHeadF->size, szPage) + tsdbLogicToFileSize(pSet->pDataF->size, szPage) +
+                 tsdbLogicToFileSize(pSet->pSmaF->size, szPage);
 
-  code = tsdbFSCopy(pTsdb, &fs);
+  for (int32_t iStt = 0; iStt < pSet->nSttF; iStt++) {
+    size += tsdbLogicToFileSize(pSet->aSttF[iStt]->size, szPage);
+  }
+
+  return size;
+}
+
+// reset the progress of tier migration shown in ins_vgroups
+static void tsdbMigrateBegin(STsdb *pTsdb, STsdbFS *pFS, int64_t now) {
+  int64_t size = 0;
+
+  for (int32_t iSet = 0; iSet < taosArrayGetSize(pFS->aDFileSet); iSet++) {
+    SDFileSet *pSet = (SDFileSet *)taosArrayGet(pFS->aDFileSet, iSet);
+    int32_t    expLevel = tsdbFidLevel(pSet->fid, &pTsdb->keepCfg, now);
+
+    if (expLevel > 0 && expLevel != pSet->diskId.level) {
+      size += tsdbDFileSetSize(pTsdb, pSet);
+    }
+  }
+
+  atomic_store_64(&pTsdb->migrateStart, taosGetTimestampMs());
+  atomic_store_64(&pTsdb->migrateDone, 0);
+  atomic_store_64(&pTsdb->migrateSpeed, 0);
+  atomic_store_64(&pTsdb->migrateSize, size);
+}
+
+void tsdbGetMigrateStat(SVnode *pVnode, int64_t *size, int64_t *done, int64_t *speed) {
+  *size = 0;
+  *done = 0;
+  *speed = 0;
+  if (pVnode->pTsdb != NULL) {
+    *size = atomic_load_64(&pVnode->pTsdb->migrateSize);
+    *done = atomic_load_64(&pVnode->pTsdb->migrateDone);
+    *speed = atomic_load_64(&pVnode->pTsdb->migrateSpeed);
+  }
+}
+
+static void tsdbDFileSetClear(SDFileSet *pSet) {
+  taosMemoryFree(pSet->pHeadF);
+  taosMemoryFree(pSet->pDataF);
+  taosMemoryFree(pSet->pSmaF);
+  for (int32_t iStt = 0; iStt < pSet->nSttF; iStt++) {
+    taosMemoryFree(pSet->aSttF[iStt]);
+  }
+}
+
+static void tsdbDFileSetRemove(STsdb *pTsdb, SDFileSet *pSet) {
+  char fname[TSDB_FILENAME_LEN];
+
+  tsdbHeadFileName(pTsdb, pSet->diskId, pSet->fid, pSet->pHeadF, fname);
+  (void)taosRemoveFile(fname);
+  tsdbDataFileName(pTsdb, pSet->diskId, pSet->fid, pSet->pDataF, fname);
+  (void)taosRemoveFile(fname);
+  tsdbSmaFileName(pTsdb, pSet->diskId, pSet->fid, pSet->pSmaF, fname);
+  (void)taosRemoveFile(fname);
+  for (int32_t iStt = 0; iStt < pSet->nSttF; iStt++) {
+    tsdbSttFileName(pTsdb, pSet->diskId, pSet->fid, pSet->aSttF[iStt], fname);
+    (void)taosRemoveFile(fname);
+  }
+}
+
+// a commit appends to the data and sma files in place, and rewrites the head and stt files
+static bool tsdbDFileSetIsSame(SDFileSet *pSet1, SDFileSet *pSet2) {
+  if (pSet1->pHeadF->commitID != pSet2->pHeadF->commitID || pSet1->pHeadF->size != pSet2->pHeadF->size) return false;
+  if (pSet1->pDataF->commitID != pSet2->pDataF->commitID || pSet1->pDataF->size != pSet2->pDataF->size) return false;
+  if (pSet1->pSmaF->commitID != pSet2->pSmaF->commitID || pSet1->pSmaF->size != pSet2->pSmaF->size) return false;
+  if (pSet1->nSttF != pSet2->nSttF) return false;
+  for (int32_t iStt = 0; iStt < pSet1->nSttF; iStt++) {
+    if (pSet1->aSttF[iStt]->commitID != pSet2->aSttF[iStt]->commitID) return false;
+  }
+  return true;
+}
+
+// remove the copies in migrateFS that were not swapped in
+void tsdbMigrateDiscard(STsdb *pTsdb) {
+  STsdbFS *pMoved = &pTsdb->migrateFS;
+
+  for (int32_t iSet = 0; iSet < taosArrayGetSize(pMoved->aDFileSet); iSet++) {
+    SDFileSet *pSet = (SDFileSet *)taosArrayGet(pMoved->aDFileSet, iSet);
+    tsdbDFileSetRemove(pTsdb, pSet);
+  }
+  tsdbFSDestroy(pMoved);
+}
+
+// copy the file sets to their lower tiers into migrateFS. it runs without holding canCommit, the files are referenced
+// so that the commits going on meanwhile don't remove them
+int32_t tsdbMigrate(STsdb *pTsdb, int64_t now) {
+  int32_t  code = 0;
+  int32_t  lino = 0;
+  STsdbFS  fsRef = {0};
+  STsdbFS  fs = {0};
+  STsdbFS *pMoved = &pTsdb->migrateFS;
+
+  taosThreadRwlockRdlock(&pTsdb->rwLock);
+  code = tsdbFSRef(pTsdb, &fsRef);
+  if (code == 0) {
+    code = tsdbFSCopy(pTsdb, &fs);
+  }
+  taosThreadRwlockUnlock(&pTsdb->rwLock);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  // copies left by a retention that did not get to swap them in
+  tsdbMigrateDiscard(pTsdb);
+  pMoved->aDFileSet = taosArrayInit(taosArrayGetSize(fs.aDFileSet), sizeof(SDFileSet));
+  if (pMoved->aDFileSet == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  tsdbMigrateBegin(pTsdb, &fs, now);
+
   for (int32_t iSet = 0; iSet < taosArrayGetSize(fs.aDFileSet); iSet++) {
     SDFileSet *pSet = (SDFileSet *)taosArrayGet(fs.aDFileSet, iSet);
     int32_t    expLevel = tsdbFidLevel(pSet->fid, &pTsdb->keepCfg, now);
     SDiskID    did;
 
-    if (expLevel < 0) {
-      taosMemoryFree(pSet->pHeadF);
-      taosMemoryFree(pSet->pDataF);
-      taosMemoryFree(pSet->pSmaF);
-      for (int32_t iStt = 0; iStt < pSet->nSttF; iStt++) {
-        taosMemoryFree(pSet->aSttF[iStt]);
-      }
-      taosArrayRemove(fs.aDFileSet, iSet);
-      iSet--;
-    } else {
-      if (expLevel == 0) continue;
-      if (tfsAllocDisk(pTsdb->pVnode->pTfs, expLevel, &did) < 0) {
-        code = terrno;
-        goto _exit;
-      }
+    if (expLevel <= 0) continue;
+    if (tfsAllocDisk(pTsdb->pVnode->pTfs, expLevel, &did) < 0) {
+      code = terrno;
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
 
-      if (did.level == pSet->diskId.level) continue;
+    if (did.level == pSet->diskId.level) continue;
 
-      // copy file to new disk (todo)
-      SDFileSet fSet = *pSet;
-      fSet.diskId = did;
+    // copy file to new disk
+    SDFileSet fSet = *pSet;
+    fSet.diskId = did;
 
-      code = tsdbDFileSetCopy(pTsdb, pSet, &fSet);
+    code = tsdbDFileSetCopy(pTsdb, pSet, &fSet);
+    if (code) {
+      tsdbDFileSetRemove(pTsdb, &fSet);
       TSDB_CHECK_CODE(code, lino, _exit);
+    }
 
-      code = tsdbFSUpsertFSet(&fs, &fSet);
+    if (taosArrayPush(pMoved->aDFileSet, &fSet) == NULL) {
+      tsdbDFileSetRemove(pTsdb, &fSet);
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+
+    // the files of the set belong to migrateFS now
+    *pSet = (SDFileSet){.diskId = pSet->diskId, .fid = pSet->fid};
+  }
+
+_exit:
+  // sets estimated to move may stay on their tier when the lower tier has no disk
+  atomic_store_64(&pTsdb->migrateSize, atomic_load_64(&pTsdb->migrateDone));
+  if (code) {
+    tsdbError("vgId:%d %s failed at line %d since %s", TD_VID(pTsdb->pVnode), __func__, lino, tstrerror(code));
+    tsdbMigrateDiscard(pTsdb);
+  } else {
+    tsdbInfo("vgId:%d %s done, %" PRId64 " bytes moved at %" PRId64 " bytes/s", TD_VID(pTsdb->pVnode), __func__,
+             atomic_load_64(&pTsdb->migrateDone), atomic_load_64(&pTsdb->migrateSpeed));
+  }
+  if (fsRef.aDFileSet) {
+    tsdbFSUnref(pTsdb, &fsRef);
+  }
+  tsdbFSDestroy(&fs);
+  return code;
+}
+
+// remove the expired file sets and swap in the copies of tsdbMigrate, with canCommit held. a set changed by a commit
+// while it was copied keeps its tier, its copy is removed and the next retention moves it again
+int32_t tsdbDoRetention(STsdb *pTsdb, int64_t now) {
+  int32_t  code = 0;
+  int32_t  lino = 0;
+  STsdbFS  fs = {0};
+  STsdbFS *pMoved = &pTsdb->migrateFS;
+
+  code = tsdbFSCopy(pTsdb, &fs);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  for (int32_t iSet = 0; iSet < taosArrayGetSize(fs.aDFileSet); iSet++) {
+    SDFileSet *pSet = (SDFileSet *)taosArrayGet(fs.aDFileSet, iSet);
+    int32_t    expLevel = tsdbFidLevel(pSet->fid, &pTsdb->keepCfg, now);
+
+    if (expLevel < 0) {
+      tsdbDFileSetClear(pSet);
+      taosArrayRemove(fs.aDFileSet, iSet);
+      iSet--;
+    } else if (pMoved->aDFileSet != NULL) {
+      SDFileSet *pMovedSet = (SDFileSet *)taosArraySearch(pMoved->aDFileSet, pSet, tDFileSetCmprFn, TD_EQ);
+      if (pMovedSet == NULL || !tsdbDFileSetIsSame(pSet, pMovedSet)) continue;
+
+      code = tsdbFSUpsertFSet(&fs, pMovedSet);
       TSDB_CHECK_CODE(code, lino, _exit);
     }
   }
@@ -93,12 +244,25 @@ int32_t tsdbDoRetention(STsdb *pTsdb, int64_t now) {
   code = tsdbFSPrepareCommit(pTsdb, &fs);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  // the copies swapped in are no longer removed by tsdbMigrateDiscard
+  for (int32_t iSet = 0; iSet < taosArrayGetSize(pMoved->aDFileSet); iSet++) {
+    SDFileSet *pMovedSet = (SDFileSet *)taosArrayGet(pMoved->aDFileSet, iSet);
+    SDFileSet *pSet = (SDFileSet *)taosArraySearch(fs.aDFileSet, pMovedSet, tDFileSetCmprFn, TD_EQ);
+
+    if (pSet != NULL && pSet->diskId.level == pMovedSet->diskId.level && pSet->diskId.id == pMovedSet->diskId.id) {
+      tsdbDFileSetClear(pMovedSet);
+      taosArrayRemove(pMoved->aDFileSet, iSet);
+      iSet--;
+    }
+  }
+
 _exit:
   if (code) {
     tsdbError("vgId:%d %s failed at line %d since %s", TD_VID(pTsdb->pVnode), __func__, lino, tstrerror(code));
   } else {
     tsdbInfo("vgId:%d %s done", TD_VID(pTsdb->pVnode), __func__);
   }
+  tsdbMigrateDiscard(pTsdb);
   tsdbFSDestroy(&fs);
   return code;
 }
@@ -1087,7 +1087,7 @@ static int32_t tsdbSnapWriteTimeSeriesData(STsdbSnapWriter* pWriter, SSnapDataHd
   int32_t code = 0;
   int32_t lino = 0;
 
-  code = tDecmprBlockData(pHdr->data, pHdr->size, &pWriter->inData, pWriter->aBuf);
+  code = tDecmprBlockData(pHdr->data, pHdr->size, &pWriter->inData, pWriter->aBuf, NULL);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   ASSERT(pWriter->inData.nRow > 0);
@@ -14,6 +14,7 @@
  */
 
 #include "tdataformat.h"
+#include "tsched.h"
 #include "tsdb.h"
 
 // SMapData =======================================================================
@@ -370,6 +371,8 @@ int32_t tGetSttBlk(uint8_t *p, void *ph) {
 }
 
 // SBlockCol ======================================================
+#define TSDB_BLOCK_COL_DICT ((int8_t)0x40)  // flag bit of a dictionary encoded column on disk
+
 int32_t tPutBlockCol(uint8_t *p, void *ph) {
   int32_t    n = 0;
   SBlockCol *pBlockCol = (SBlockCol *)ph;
@@ -379,7 +382,8 @@ int32_t tPutBlockCol(uint8_t *p, void *ph) {
   n += tPutI16v(p ? p + n : p, pBlockCol->cid);
   n += tPutI8(p ? p + n : p, pBlockCol->type);
   n += tPutI8(p ? p + n : p, pBlockCol->smaOn);
-  n += tPutI8(p ? p + n : p, pBlockCol->flag);
+  n += tPutI8(p ? p + n : p,
+               pBlockCol->flag | ((pBlockCol->encode == TSDB_COL_ENCODE_DICT) ? TSDB_BLOCK_COL_DICT : 0));
   n += tPutI32v(p ? p + n : p, pBlockCol->szOrigin);
 
   if (pBlockCol->flag != HAS_NULL) {
@@ -412,6 +416,9 @@ int32_t tGetBlockCol(uint8_t *p, void *ph) {
   n += tGetI8(p + n, &pBlockCol->flag);
   n += tGetI32v(p + n, &pBlockCol->szOrigin);
 
+  pBlockCol->encode = (pBlockCol->flag & TSDB_BLOCK_COL_DICT) ? TSDB_COL_ENCODE_DICT : TSDB_COL_ENCODE_RAW;
+  pBlockCol->flag &= ~TSDB_BLOCK_COL_DICT;
+
   ASSERT(pBlockCol->flag && (pBlockCol->flag != HAS_NONE));
 
   pBlockCol->szBitmap = 0;
@@ -1312,7 +1319,7 @@ int32_t tCmprBlockData(SBlockData *pBlockData, int8_t cmprAlg, uint8_t **ppOut,
   int32_t code = 0;
 
   SDiskDataHdr hdr = {.delimiter = TSDB_FILE_DLMT,
-                      .fmtVer = 0,
+                      .fmtVer = TSDB_DISK_DATA_FMT_VER,
                       .suid = pBlockData->suid,
                       .uid = pBlockData->uid,
                       .nRow = pBlockData->nRow,
@@ -1338,6 +1345,10 @@ int32_t tCmprBlockData(SBlockData *pBlockData, int8_t cmprAlg, uint8_t **ppOut,
       code = tsdbCmprColData(pColData, cmprAlg, &blockCol, &aBuf[0], aBufN[0], &aBuf[2]);
       if (code) goto _exit;
 
+      if (blockCol.encode == TSDB_COL_ENCODE_DICT) {
+        hdr.fmtVer = TSDB_DISK_DATA_FMT_VER_DICT;
+      }
+
       blockCol.offset = aBufN[0];
       aBufN[0] = aBufN[0] + blockCol.szBitmap + blockCol.szOffset + blockCol.szValue;
     }
@@ -1395,10 +1406,12 @@ _exit:
   return code;
 }
 
-int32_t tDecmprBlockData(uint8_t *pIn, int32_t szIn, SBlockData *pBlockData, uint8_t *aBuf[]) {
+int32_t tDecmprBlockData(uint8_t *pIn, int32_t szIn, SBlockData *pBlockData, uint8_t *aBuf[],
+                         SColDecmprArena *pArena) {
   int32_t code = 0;
 
   tBlockDataReset(pBlockData);
+  if (pArena) tColDecmprArenaReset(pArena);
 
   int32_t      n = 0;
   SDiskDataHdr hdr = {0};
@@ -1463,6 +1476,9 @@ int32_t tDecmprBlockData(uint8_t *pIn, int32_t szIn, SBlockData *pBlockData, uin
         code = tColDataAppendValue(pColData, &COL_VAL_NULL(blockCol.cid, blockCol.type));
         if (code) goto _exit;
       }
+    } else if (pArena) {
+      code = tColDecmprArenaAdd(pArena, blockCol.offset, &blockCol, pColData);
+      if (code) goto _exit;
     } else {
       code = tsdbDecmprColData(pIn + n + hdr.szBlkCol + blockCol.offset, &blockCol, hdr.cmprAlg, hdr.nRow, pColData,
                                &aBuf[0]);
@@ -1470,6 +1486,11 @@ int32_t tDecmprBlockData(uint8_t *pIn, int32_t szIn, SBlockData *pBlockData, uin
     }
   }
 
+  if (pArena) {
+    code = tColDecmprArenaRun(pArena, pIn + n + hdr.szBlkCol, hdr.cmprAlg, hdr.nRow);
+    if (code) goto _exit;
+  }
+
 _exit:
   return code;
 }
@@ -1601,12 +1622,224 @@ _exit:
   return code;
 }
 
+// dictionary encoding ==============================
+// a low cardinality variant data type column is saved as the dictionary of its distinct values and the bit-packed
+// dictionary codes of the rows. the offset part of the column holds the dictionary meta and the codes:
+// |<--nDict-->|<--szDict-->|<-nBit->|<--value offsets in dictionary-->|<------------codes------------>|
+// |<-int32_t->|<-int32_t-->|<int8_t>|<--------int32_t * nDict-------->|<--(nVal * nBit + 7) / 8 bytes-->|
+// and the value part holds the compressed dictionary values. NULL and NONE rows are coded as empty values.
+#define TSDB_COL_DICT_MAX       1024
+#define TSDB_COL_DICT_MIN_ROWS  64
+#define TSDB_COL_DICT_HASH_SIZE (TSDB_COL_DICT_MAX * 2)
+#define TSDB_COL_DICT_HDR_SIZE  (sizeof(int32_t) * 2 + sizeof(int8_t))
+
+typedef struct {
+  int32_t nDict;
+  int32_t szDict;
+  int32_t aOffset[TSDB_COL_DICT_MAX];  // offset of the value in SColData.pData
+  int32_t aLen[TSDB_COL_DICT_MAX];
+} STsdbColDict;
+
+static FORCE_INLINE int32_t tsdbColValLen(SColData *pColData, int32_t iVal) {
+  return ((iVal < pColData->nVal - 1) ? pColData->aOffset[iVal + 1] : pColData->nData) - pColData->aOffset[iVal];
+}
+
+// return false if the column has too many distinct values to be dictionary encoded
+static bool tsdbColDictBuild(SColData *pColData, STsdbColDict *pDict, uint16_t *aCode) {
+  int32_t  maxDict = TMIN(TSDB_COL_DICT_MAX, pColData->nVal / 4);
+  uint16_t aSlot[TSDB_COL_DICT_HASH_SIZE] = {0};  // dictionary index + 1, 0 for an empty slot
+
+  pDict->nDict = 0;
+  pDict->szDict = 0;
+  for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
+    int32_t  offset = pColData->aOffset[iVal];
+    int32_t  len = tsdbColValLen(pColData, iVal);
+    uint8_t *pVal = pColData->pData + offset;
+    uint32_t iSlot = MurmurHash3_32((const char *)pVal, len) & (TSDB_COL_DICT_HASH_SIZE - 1);
+
+    while (aSlot[iSlot]) {
+      int32_t iDict = aSlot[iSlot] - 1;
+      if (pDict->aLen[iDict] == len && memcmp(pColData->pData + pDict->aOffset[iDict], pVal, len) == 0) break;
+      iSlot = (iSlot + 1) & (TSDB_COL_DICT_HASH_SIZE - 1);
+    }
+
+    if (aSlot[iSlot] == 0) {
+      if (pDict->nDict >= maxDict) return false;
+
+      pDict->aOffset[pDict->nDict] = offset;
+      pDict->aLen[pDict->nDict] = len;
+      pDict->szDict += len;
+      aSlot[iSlot] = ++pDict->nDict;
+    }
+
+    aCode[iVal] = aSlot[iSlot] - 1;
+  }
+
+  return true;
+}
+
+static void tsdbColDictPackCodes(const uint16_t *aCode, int32_t nVal, int8_t nBit, uint8_t *p) {
+  if (nBit == 0) return;
+
+  uint64_t acc = 0;
+  int32_t  nAcc = 0;
+  for (int32_t iVal = 0; iVal < nVal; iVal++) {
+    acc |= ((uint64_t)aCode[iVal]) << nAcc;
+    nAcc += nBit;
+    while (nAcc >= 8) {
+      *(p++) = (uint8_t)acc;
+      acc >>= 8;
+      nAcc -= 8;
+    }
+  }
+  if (nAcc > 0) {
+    *p = (uint8_t)acc;
+  }
+}
+
+static int32_t tsdbCmprColDict(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol, uint8_t **ppOut,
+                               int32_t nOut, uint8_t **ppBuf) {
+  int32_t       code = 0;
+  uint8_t      *pDictVal = NULL;
+  STsdbColDict *pDict = NULL;
+
+  if (pColData->nVal < TSDB_COL_DICT_MIN_ROWS || pColData->nData == 0) goto _exit;
+
+  pDict = (STsdbColDict *)taosMemoryMalloc(sizeof(*pDict));
+  if (pDict == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  // codes are kept in ppBuf until packed
+  code = tRealloc(ppBuf, sizeof(uint16_t) * pColData->nVal);
+  if (code) goto _exit;
+
+  if (!tsdbColDictBuild(pColData, pDict, (uint16_t *)*ppBuf)) goto _exit;
+
+  int8_t  nBit = (pDict->nDict > 1) ? (int8_t)(32 - __builtin_clz((uint32_t)(pDict->nDict - 1))) : 0;
+  int32_t szCode = (int32_t)(((int64_t)pColData->nVal * nBit + 7) >> 3);
+  int32_t szMeta = TSDB_COL_DICT_HDR_SIZE + sizeof(int32_t) * pDict->nDict + szCode;
+  if (szMeta + pDict->szDict >= sizeof(int32_t) * pColData->nVal + pColData->nData) goto _exit;
+
+  // offset: dictionary meta and codes
+  code = tRealloc(ppOut, nOut + szMeta);
+  if (code) goto _exit;
+
+  uint8_t *p = *ppOut + nOut;
+  p += tPutI32(p, pDict->nDict);
+  p += tPutI32(p, pDict->szDict);
+  p += tPutI8(p, nBit);
+  for (int32_t iDict = 0, offset = 0; iDict < pDict->nDict; iDict++) {
+    p += tPutI32(p, offset);
+    offset += pDict->aLen[iDict];
+  }
+  tsdbColDictPackCodes((uint16_t *)*ppBuf, pColData->nVal, nBit, p);
+
+  // value: dictionary values
+  code = tRealloc(&pDictVal, pDict->szDict);
+  if (code) goto _exit;
+
+  for (int32_t iDict = 0, offset = 0; iDict < pDict->nDict; iDict++) {
+    memcpy(pDictVal + offset, pColData->pData + pDict->aOffset[iDict], pDict->aLen[iDict]);
+    offset += pDict->aLen[iDict];
+  }
+
+  code = tsdbCmprData(pDictVal, pDict->szDict, pColData->type, cmprAlg, ppOut, nOut + szMeta, &pBlockCol->szValue,
+                      ppBuf);
+  if (code) goto _exit;
+
+  pBlockCol->szOffset = szMeta;
+  pBlockCol->encode = TSDB_COL_ENCODE_DICT;
+
+_exit:
+  tFree(pDictVal);
+  taosMemoryFree(pDict);
+  return code;
+}
+
+static int32_t tsdbDecmprColDict(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, SColData *pColData,
+                                 uint8_t **ppBuf) {
+  int32_t  code = 0;
+  uint8_t *pDictVal = NULL;
+  int32_t *aDictOffset = NULL;
+  int32_t  nDict;
+  int32_t  szDict;
+  int8_t   nBit;
+
+  uint8_t *p = pIn;
+  p += tGetI32(p, &nDict);
+  p += tGetI32(p, &szDict);
+  p += tGetI8(p, &nBit);
+  if (nDict <= 0 || nDict > TSDB_COL_DICT_MAX || szDict <= 0 || nBit < 0 || nBit > 16 ||
+      TSDB_COL_DICT_HDR_SIZE + sizeof(int32_t) * nDict + (((int64_t)pColData->nVal * nBit + 7) >> 3) !=
+          pBlockCol->szOffset) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+  aDictOffset = (int32_t *)taosMemoryMalloc(sizeof(int32_t) * (nDict + 1));
+  if (aDictOffset == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+  for (int32_t iDict = 0; iDict < nDict; iDict++) {
+    p += tGetI32(p, &aDictOffset[iDict]);
+  }
+  aDictOffset[nDict] = szDict;
+
+  code = tsdbDecmprData(pIn + pBlockCol->szOffset, pBlockCol->szValue, pColData->type, cmprAlg, &pDictVal, szDict,
+                        ppBuf);
+  if (code) goto _exit;
+
+  code = tRealloc((uint8_t **)&pColData->aOffset, sizeof(int32_t) * pColData->nVal);
+  if (code) goto _exit;
+  code = tRealloc(&pColData->pData, pColData->nData);
+  if (code) goto _exit;
+
+  // unpack the codes and materialize the values
+  uint32_t mask = (1u << nBit) - 1;
+  uint64_t acc = 0;
+  int32_t  nAcc = 0;
+  int32_t  offset = 0;
+  for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
+    while (nAcc < nBit) {
+      acc |= ((uint64_t)(*(p++))) << nAcc;
+      nAcc += 8;
+    }
+    uint32_t iDict = (uint32_t)(acc & mask);
+    acc >>= nBit;
+    nAcc -= nBit;
+
+    int32_t len = (iDict < nDict) ? aDictOffset[iDict + 1] - aDictOffset[iDict] : -1;
+    if (len < 0 || offset + len > pColData->nData) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
+
+    pColData->aOffset[iVal] = offset;
+    memcpy(pColData->pData + offset, pDictVal + aDictOffset[iDict], len);
+    offset += len;
+  }
+
+  if (offset != pColData->nData) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+_exit:
+  tFree(pDictVal);
+  taosMemoryFree(aDictOffset);
+  return code;
+}
+
 int32_t tsdbCmprColData(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol, uint8_t **ppOut, int32_t nOut,
                         uint8_t **ppBuf) {
   int32_t code = 0;
 
   ASSERT(pColData->flag && (pColData->flag != HAS_NONE) && (pColData->flag != HAS_NULL));
 
+  pBlockCol->encode = TSDB_COL_ENCODE_RAW;
   pBlockCol->szBitmap = 0;
   pBlockCol->szOffset = 0;
   pBlockCol->szValue = 0;
@@ -1627,6 +1860,14 @@ int32_t tsdbCmprColData(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol
   }
   size += pBlockCol->szBitmap;
 
+  // dictionary encoded offset and value
+  if (IS_VAR_DATA_TYPE(pColData->type) && (pColData->flag & HAS_VALUE)) {
+    code = tsdbCmprColDict(pColData, cmprAlg, pBlockCol, ppOut, nOut + size, ppBuf);
+    if (code) goto _exit;
+
+    if (pBlockCol->encode == TSDB_COL_ENCODE_DICT) goto _exit;
+  }
+
   // offset
   if (IS_VAR_DATA_TYPE(pColData->type) && pColData->flag != (HAS_NULL | HAS_NONE)) {
     code = tsdbCmprData((uint8_t *)pColData->aOffset, sizeof(int32_t) * pColData->nVal, TSDB_DATA_TYPE_INT, cmprAlg,
@@ -1673,6 +1914,12 @@ int32_t tsdbDecmprColData(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, in
   }
   p += pBlockCol->szBitmap;
 
+  // dictionary encoded offset and value
+  if (pBlockCol->encode == TSDB_COL_ENCODE_DICT) {
+    code = tsdbDecmprColDict(p, pBlockCol, cmprAlg, pColData, ppBuf);
+    goto _exit;
+  }
+
   // offset
   if (pBlockCol->szOffset) {
     code = tsdbDecmprData(p, pBlockCol->szOffset, TSDB_DATA_TYPE_INT, cmprAlg, (uint8_t **)&pColData->aOffset,
@@ -1691,3 +1938,192 @@ int32_t tsdbDecmprColData(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, in
 _exit:
   return code;
 }
+
+// SColDecmprArena ==============================
+// columns of a large block are decompressed in parallel on the tsdb-decmpr pool, the caller thread takes the first
+// share of the columns and waits for the others
+#define TSDB_DECMPR_QUEUE_SIZE 10000
+#define TSDB_DECMPR_MIN_COLS   4
+
+typedef struct {
+  int8_t      inited;
+  int32_t     nThreads;
+  SSchedQueue queue;
+} STsdbDecmprMgmt;
+
+typedef struct {
+  SColDecmprItem *aItem;
+  int32_t         nItem;
+  uint8_t        *pBase;
+  int8_t          cmprAlg;
+  int32_t         nVal;
+  uint8_t       **ppBuf;
+  tsem_t         *pDone;
+  int32_t         code;
+} STsdbDecmprTask;
+
+static STsdbDecmprMgmt tsdbDecmprMgmt = {0};
+
+int32_t tsdbDecmprInit() {
+  int8_t old;
+  while (1) {
+    old = atomic_val_compare_exchange_8(&tsdbDecmprMgmt.inited, 0, 2);
+    if (old != 2) break;
+  }
+
+  if (old == 0) {
+    tsdbDecmprMgmt.nThreads = 0;
+    if (tsTsdbParallelDecmprSize > 0) {
+      tsdbDecmprMgmt.nThreads = (int32_t)(tsNumOfCores / 2);
+      tsdbDecmprMgmt.nThreads = TRANGE(tsdbDecmprMgmt.nThreads, 2, TSDB_DECMPR_MAX_TASKS - 1);
+      if (taosInitScheduler(TSDB_DECMPR_QUEUE_SIZE, tsdbDecmprMgmt.nThreads, "tsdb-decmpr", &tsdbDecmprMgmt.queue) ==
+          NULL) {
+        tsdbError("failed to init tsdb decmpr queue, numOfThreads:%d", tsdbDecmprMgmt.nThreads);
+        atomic_store_8(&tsdbDecmprMgmt.inited, 0);
+        return -1;
+      }
+    }
+
+    tsdbInfo("tsdb decmpr is initialized, numOfThreads:%d parallelDecmprSize:%dKB", tsdbDecmprMgmt.nThreads,
+             tsTsdbParallelDecmprSize);
+    atomic_store_8(&tsdbDecmprMgmt.inited, 1);
+  }
+
+  return 0;
+}
+
+void tsdbDecmprCleanUp() {
+  int8_t old;
+  while (1) {
+    old = atomic_val_compare_exchange_8(&tsdbDecmprMgmt.inited, 1, 2);
+    if (old != 2) break;
+  }
+
+  if (old == 1) {
+    if (tsdbDecmprMgmt.nThreads > 0) {
+      taosCleanUpScheduler(&tsdbDecmprMgmt.queue);
+    }
+    tsdbInfo("tsdb decmpr is cleaned up");
+    atomic_store_8(&tsdbDecmprMgmt.inited, 0);
+  }
+}
+
+void tColDecmprArenaReset(SColDecmprArena *pArena) {
+  pArena->szIn = 0;
+  pArena->nItem = 0;
+}
+
+void tColDecmprArenaDestroy(SColDecmprArena *pArena) {
+  tFree(pArena->pBuf);
+  for (int32_t iBuf = 0; iBuf < TSDB_DECMPR_MAX_TASKS; iBuf++) {
+    tFree(pArena->aBuf[iBuf]);
+  }
+  taosMemoryFreeClear(pArena->aItem);
+  pArena->nItemAlloc = 0;
+  tColDecmprArenaReset(pArena);
+}
+
+int32_t tColDecmprArenaAdd(SColDecmprArena *pArena, int32_t offset, SBlockCol *pBlockCol, SColData *pColData) {
+  if (pArena->nItem >= pArena->nItemAlloc) {
+    int32_t         nItemAlloc = pArena->nItemAlloc ? pArena->nItemAlloc << 1 : 32;
+    SColDecmprItem *aItem = taosMemoryRealloc(pArena->aItem, sizeof(SColDecmprItem) * nItemAlloc);
+    if (aItem == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    pArena->aItem = aItem;
+    pArena->nItemAlloc = nItemAlloc;
+  }
+
+  pArena->aItem[pArena->nItem++] = (SColDecmprItem){.offset = offset, .blockCol = *pBlockCol, .pColData = pColData};
+  pArena->szIn += pBlockCol->szBitmap + pBlockCol->szOffset + pBlockCol->szValue;
+  return 0;
+}
+
+static int32_t tsdbDecmprItems(SColDecmprItem *aItem, int32_t nItem, uint8_t *pBase, int8_t cmprAlg, int32_t nVal,
+                               uint8_t **ppBuf) {
+  int32_t code = 0;
+  for (int32_t iItem = 0; iItem < nItem; iItem++) {
+    SColDecmprItem *pItem = &aItem[iItem];
+    code = tsdbDecmprColData(pBase + pItem->offset, &pItem->blockCol, cmprAlg, nVal, pItem->pColData, ppBuf);
+    if (code) break;
+  }
+  return code;
+}
+
+static void tsdbDecmprTaskExec(SSchedMsg *pMsg) {
+  STsdbDecmprTask *pTask = (STsdbDecmprTask *)pMsg->ahandle;
+
+  pTask->code = tsdbDecmprItems(pTask->aItem, pTask->nItem, pTask->pBase, pTask->cmprAlg, pTask->nVal, pTask->ppBuf);
+  tsem_post(pTask->pDone);
+}
+
+int32_t tColDecmprArenaRun(SColDecmprArena *pArena, uint8_t *pBase, int8_t cmprAlg, int32_t nVal) {
+  int32_t code = 0;
+  int32_t nTask = 1;
+
+  if (tsdbDecmprMgmt.nThreads > 0 && pArena->nItem >= TSDB_DECMPR_MIN_COLS &&
+      pArena->szIn >= (int64_t)tsTsdbParallelDecmprSize * 1024) {
+    nTask = TMIN(pArena->nItem, tsdbDecmprMgmt.nThreads + 1);
+  }
+
+  if (nTask <= 1) {
+    return tsdbDecmprItems(pArena->aItem, pArena->nItem, pBase, cmprAlg, nVal, &pArena->aBuf[0]);
+  }
+
+  // split the columns into ranges of about the same compressed size, at least one column in each
+  STsdbDecmprTask aTask[TSDB_DECMPR_MAX_TASKS];
+  tsem_t          done;
+  int32_t         iItem = 0;
+  int64_t         szIn = 0;
+
+  for (int32_t iTask = 0; iTask < nTask; iTask++) {
+    STsdbDecmprTask *pTask = &aTask[iTask];
+    int64_t          szEnd = pArena->szIn * (iTask + 1) / nTask;
+
+    *pTask = (STsdbDecmprTask){.aItem = &pArena->aItem[iItem],
+                               .pBase = pBase,
+                               .cmprAlg = cmprAlg,
+                               .nVal = nVal,
+                               .ppBuf = &pArena->aBuf[iTask],
+                               .pDone = &done};
+    while (iItem < pArena->nItem) {
+      if (pTask->nItem > 0 && iTask < nTask - 1 && (szIn >= szEnd || pArena->nItem - iItem <= nTask - iTask - 1)) {
+        break;
+      }
+
+      SBlockCol *pBlockCol = &pArena->aItem[iItem].blockCol;
+      szIn += pBlockCol->szBitmap + pBlockCol->szOffset + pBlockCol->szValue;
+      pTask->nItem++;
+      iItem++;
+    }
+  }
+
+  tsem_init(&done, 0, 0);
+
+  int32_t nScheduled = 0;
+  for (int32_t iTask = 1; iTask < nTask; iTask++) {
+    SSchedMsg schedMsg = {.fp = tsdbDecmprTaskExec, .ahandle = &aTask[iTask]};
+    if (taosScheduleTask(&tsdbDecmprMgmt.queue, &schedMsg) == 0) {
+      nScheduled++;
+    } else {
+      tsdbDecmprTaskExec(&schedMsg);
+      tsem_wait(&done);
+    }
+  }
+
+  aTask[0].code = tsdbDecmprItems(aTask[0].aItem, aTask[0].nItem, pBase, cmprAlg, nVal, aTask[0].ppBuf);
+
+  for (int32_t i = 0; i < nScheduled; i++) {
+    tsem_wait(&done);
+  }
+  tsem_destroy(&done);
+
+  for (int32_t iTask = 0; iTask < nTask; iTask++) {
+    if (aTask[iTask].code) {
+      code = aTask[iTask].code;
+      break;
+    }
+  }
+
+  return code;
+}
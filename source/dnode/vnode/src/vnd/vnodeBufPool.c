@@ -40,21 +40,18 @@ static int vnodeBufPoolCreate(SVnode *pVnode, int32_t id, int64_t size, SVBufPoo
   pPool->node.pnext = &pPool->pTail;
   pPool->node.size = size;
 
-  if (VND_IS_RSMA(pVnode)) {
-    pPool->lock = taosMemoryMalloc(sizeof(TdThreadSpinlock));
-    if (!pPool->lock) {
-      taosMemoryFree(pPool);
-      terrno = TSDB_CODE_OUT_OF_MEMORY;
-      return -1;
-    }
-    if (taosThreadSpinInit(pPool->lock, 0) != 0) {
-      taosMemoryFree((void *)pPool->lock);
-      taosMemoryFree(pPool);
-      terrno = TAOS_SYSTEM_ERROR(errno);
-      return -1;
-    }
-  } else {
-    pPool->lock = NULL;
+  // writers of different tables allocate from the same pool concurrently
+  pPool->lock = taosMemoryMalloc(sizeof(TdThreadSpinlock));
+  if (!pPool->lock) {
+    taosMemoryFree(pPool);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+  if (taosThreadSpinInit(pPool->lock, 0) != 0) {
+    taosMemoryFree((void *)pPool->lock);
+    taosMemoryFree(pPool);
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    return -1;
   }
 
   *ppPool = pPool;
@@ -127,7 +124,7 @@ void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
   int            paddingLen = 0;
   ASSERT(pPool != NULL);
 
-  if (pPool->lock) taosThreadSpinLock(pPool->lock);
+  taosThreadSpinLock(pPool->lock);
 
   ptr = pPool->ptr;
   paddingLen = (((long)ptr + 7) & ~7) - (long)ptr;
@@ -143,7 +140,7 @@ void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
     pNode = taosMemoryMalloc(sizeof(*pNode) + size);
     if (pNode == NULL) {
       terrno = TSDB_CODE_OUT_OF_MEMORY;
-      if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
+      taosThreadSpinUnlock(pPool->lock);
       return NULL;
     }
 
@@ -156,7 +153,7 @@ void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
 
     pPool->size = pPool->size + sizeof(*pNode) + size;
   }
-  if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
+  taosThreadSpinUnlock(pPool->lock);
   return p;
 }
 
@@ -165,7 +162,7 @@ void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
   void          *p = NULL;
   ASSERT(pPool != NULL);
 
-  if (pPool->lock) taosThreadSpinLock(pPool->lock);
+  taosThreadSpinLock(pPool->lock);
   if (pPool->node.size >= pPool->ptr - pPool->node.data + size) {
     // allocate from the anchor node
     p = pPool->ptr;
@@ -176,7 +173,7 @@ void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
     pNode = taosMemoryMalloc(sizeof(*pNode) + size);
     if (pNode == NULL) {
       terrno = TSDB_CODE_OUT_OF_MEMORY;
-      if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
+      taosThreadSpinUnlock(pPool->lock);
       return NULL;
     }
 
@@ -189,7 +186,7 @@ void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
 
     pPool->size = pPool->size + sizeof(*pNode) + size;
   }
-  if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
+  taosThreadSpinUnlock(pPool->lock);
   return p;
 }
 
@@ -53,6 +53,7 @@ void initTsdbReaderAPI(TsdReader* pReader) {
   pReader->tsdReaderRetrieveBlockSMAInfo = tsdbRetrieveDatablockSMA;
 
   pReader->tsdReaderNotifyClosing = tsdbReaderSetCloseFlag;
+  pReader->tsdReaderSplitTimeWindow = (int32_t(*)(void*, const STimeWindow*, int32_t, SArray*, int64_t*))tsdbSplitTimeWindow;
   pReader->tsdReaderResetStatus = tsdbReaderReset;
 
   pReader->tsdReaderGetDataBlockDistInfo = tsdbGetFileBlocksDistInfo;
@@ -81,6 +81,18 @@ int vnodeInit(int nthreads) {
   if (tqInit() < 0) {
     return -1;
   }
+  if (tsdbInit() < 0) {
+    return -1;
+  }
+  if (tsdbPrefetchInit() < 0) {
+    return -1;
+  }
+  if (tsdbDecmprInit() < 0) {
+    return -1;
+  }
+  if (qInitParallelScanPool() < 0) {
+    return -1;
+  }
 
   return 0;
 }
@@ -110,6 +122,10 @@ void vnodeCleanup() {
   walCleanUp();
   tqCleanUp();
   smaCleanUp();
+  tsdbCleanUp();
+  tsdbPrefetchCleanUp();
+  tsdbDecmprCleanUp();
+  qCleanupParallelScanPool();
 }
 
 int vnodeScheduleTask(int (*execute)(void*), void* arg) {
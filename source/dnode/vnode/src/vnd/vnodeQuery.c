@@ -383,6 +383,8 @@ int32_t vnodeGetLoad(SVnode *pVnode, SVnodeLoad *pLoad) {
   pLoad->syncCanRead = state.canRead;
   pLoad->cacheUsage = tsdbCacheGetUsage(pVnode);
   pLoad->numOfCachedTables = tsdbCacheGetElems(pVnode);
+  tsdbPgCacheGetStat(pVnode, &pLoad->pageCacheHits, &pLoad->pageCacheMisses);
+  tsdbGetMigrateStat(pVnode, &pLoad->migrateSize, &pLoad->migrateDone, &pLoad->migrateSpeed);
   pLoad->numOfTables = metaGetTbNum(pVnode->pMeta);
   pLoad->numOfTimeSeries = metaGetTimeSeriesNum(pVnode->pMeta);
   pLoad->totalStorage = (int64_t)3 * 1073741824;
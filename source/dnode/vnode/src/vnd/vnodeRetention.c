@@ -23,6 +23,8 @@ typedef struct {
 } SRetentionInfo;
 
 extern bool    tsdbShouldDoRetention(STsdb *pTsdb, int64_t now);
+extern int32_t tsdbMigrate(STsdb *pTsdb, int64_t now);
+extern void    tsdbMigrateDiscard(STsdb *pTsdb);
 extern int32_t tsdbDoRetention(STsdb *pTsdb, int64_t now);
 extern int32_t tsdbCommitRetention(STsdb *pTsdb);
 
@@ -75,6 +77,7 @@ static int32_t vnodeRetentionTask(void *param) {
 
   if (vnodeSaveInfo(dir, &pInfo->info) < 0) {
     code = terrno;
+    tsdbMigrateDiscard(pVnode->pTsdb);
     TSDB_CHECK_CODE(code, lino, _exit);
   }
 
@@ -95,16 +98,46 @@ _exit:
     vInfo("vgId:%d %s done", TD_VID(pInfo->pVnode), __func__);
   }
   tsem_post(&pInfo->pVnode->canCommit);
-  taosMemoryFree(pInfo);
   return code;
 }
 
+// the files are copied to lower tiers without holding canCommit, so the commits go on meanwhile. it is taken only to
+// swap in the new file sets
+static void *vnodeRetentionThreadFp(void *param) {
+  SRetentionInfo *pInfo = (SRetentionInfo *)param;
+  SVnode         *pVnode = pInfo->pVnode;
+
+  setThreadName("vnode-retention");
+
+  if (tsdbMigrate(pVnode->pTsdb, pInfo->now) != TSDB_CODE_VND_STOPPED) {
+    if (vnodePrepareRentention(pVnode, pInfo) == 0) {
+      vnodeRetentionTask(pInfo);
+    } else {
+      tsdbMigrateDiscard(pVnode->pTsdb);
+    }
+  }
+
+  taosMemoryFree(pInfo);
+  atomic_store_8(&pVnode->retentionRunning, 0);
+  return NULL;
+}
+
 int32_t vnodeAsyncRentention(SVnode *pVnode, int64_t now) {
   int32_t code = 0;
   int32_t lino = 0;
 
+  if (atomic_load_8(&pVnode->retentionRunning)) {
+    vInfo("vgId:%d retention is running, skip it", TD_VID(pVnode));
+    return code;
+  }
+
   if (!tsdbShouldDoRetention(pVnode->pTsdb, now)) return code;
 
+  if (taosCheckPthreadValid(pVnode->retentionThread)) {
+    taosThreadJoin(pVnode->retentionThread, NULL);
+    taosThreadClear(&pVnode->retentionThread);
+  }
+
   SRetentionInfo *pInfo = (SRetentionInfo *)taosMemoryCalloc(1, sizeof(*pInfo));
   if (pInfo == NULL) {
     code = TSDB_CODE_OUT_OF_MEMORY;
@@ -114,17 +147,32 @@ int32_t vnodeAsyncRentention(SVnode *pVnode, int64_t now) {
   pInfo->pVnode = pVnode;
   pInfo->now = now;
 
-  code = vnodePrepareRentention(pVnode, pInfo);
-  TSDB_CHECK_CODE(code, lino, _exit);
+  atomic_store_8(&pVnode->retentionRunning, 1);
 
-  vnodeScheduleTask(vnodeRetentionTask, pInfo);
+  TdThreadAttr thAttr;
+  taosThreadAttrInit(&thAttr);
+  taosThreadAttrSetDetachState(&thAttr, PTHREAD_CREATE_JOINABLE);
+  if (taosThreadCreate(&pVnode->retentionThread, &thAttr, vnodeRetentionThreadFp, pInfo) != 0) {
+    atomic_store_8(&pVnode->retentionRunning, 0);
+    code = TAOS_SYSTEM_ERROR(errno);
+  }
+  taosThreadAttrDestroy(&thAttr);
+  TSDB_CHECK_CODE(code, lino, _exit);
 
 _exit:
   if (code) {
-    vError("vgId:%d %s failed at line %d since %s", TD_VID(pInfo->pVnode), __func__, lino, tstrerror(code));
+    vError("vgId:%d %s failed at line %d since %s", TD_VID(pVnode), __func__, lino, tstrerror(code));
     if (pInfo) taosMemoryFree(pInfo);
   } else {
-    vInfo("vgId:%d %s done", TD_VID(pInfo->pVnode), __func__);
+    vInfo("vgId:%d %s done", TD_VID(pVnode), __func__);
   }
   return 0;
-}
\ No newline at end of file
+}
+
+void vnodeStopRentention(SVnode *pVnode) {
+  if (taosCheckPthreadValid(pVnode->retentionThread)) {
+    atomic_store_8(&pVnode->retentionStop, 1);
+    taosThreadJoin(pVnode->retentionThread, NULL);
+    taosThreadClear(&pVnode->retentionThread);
+  }
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "tsdb.h"
+
+namespace {
+
+const int64_t startTs = 1600000000000;
+const int16_t varcharCid = PRIMARYKEY_TIMESTAMP_COL_ID + 1;
+const int16_t ncharCid = PRIMARYKEY_TIMESTAMP_COL_ID + 2;
+
+enum { ROW_VALUE = 0, ROW_NULL, ROW_NONE };
+
+// the value of each row of a column, values are the same in both columns
+typedef struct {
+  int32_t     kind;
+  std::string val;
+} STestVal;
+
+typedef std::vector<STestVal> STestCol;
+
+// nVal rows with nDistinct values, every nullStep-th row is null and every noneStep-th row is none
+STestCol makeTestCol(int32_t nVal, int32_t nDistinct, int32_t nullStep, int32_t noneStep) {
+  STestCol col(nVal);
+  for (int32_t iVal = 0; iVal < nVal; iVal++) {
+    if (nullStep && iVal % nullStep == nullStep - 1) {
+      col[iVal].kind = ROW_NULL;
+    } else if (noneStep && iVal % noneStep == noneStep - 1) {
+      col[iVal].kind = ROW_NONE;
+    } else {
+      col[iVal].kind = ROW_VALUE;
+      col[iVal].val = "value_of_dictionary_" + std::to_string(iVal % nDistinct);
+    }
+  }
+  return col;
+}
+
+// nchar values are kept as ucs4
+std::string toNchar(const std::string &val) {
+  std::string ucs4(val.size() * TSDB_NCHAR_SIZE, '\0');
+  for (size_t i = 0; i < val.size(); i++) {
+    ucs4[i * TSDB_NCHAR_SIZE] = val[i];
+  }
+  return ucs4;
+}
+
+STSchema *createSchema() {
+  SSchema aSchema[] = {
+      {.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = PRIMARYKEY_TIMESTAMP_COL_ID, .bytes = 8},
+      {.type = TSDB_DATA_TYPE_VARCHAR, .colId = varcharCid, .bytes = 64 + VARSTR_HEADER_SIZE},
+      {.type = TSDB_DATA_TYPE_NCHAR, .colId = ncharCid, .bytes = 64 * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE}};
+  return tBuildTSchema(aSchema, 3, 1);
+}
+
+SColVal makeColVal(int16_t cid, int8_t type, const STestVal &v, const std::string &val) {
+  if (v.kind == ROW_NULL) return COL_VAL_NULL(cid, type);
+  if (v.kind == ROW_NONE) return COL_VAL_NONE(cid, type);
+
+  SValue value;
+  value.nData = (uint32_t)val.size();
+  value.pData = (uint8_t *)val.data();
+  return COL_VAL_VALUE(cid, type, value);
+}
+
+int32_t buildBlockData(SBlockData *pBlockData, STSchema *pTSchema, const STestCol &col) {
+  TABLEID id = {.suid = 1, .uid = 100};
+  int32_t code = tBlockDataInit(pBlockData, &id, pTSchema, NULL, 0);
+  if (code) return code;
+
+  SArray *aColVal = taosArrayInit(3, sizeof(SColVal));
+  for (int32_t iVal = 0; iVal < (int32_t)col.size() && code == 0; iVal++) {
+    SValue      vTs = {.val = startTs + iVal};
+    std::string nchar = toNchar(col[iVal].val);
+    SColVal     cvTs = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, vTs);
+    SColVal     cvVarchar = makeColVal(varcharCid, TSDB_DATA_TYPE_VARCHAR, col[iVal], col[iVal].val);
+    SColVal     cvNchar = makeColVal(ncharCid, TSDB_DATA_TYPE_NCHAR, col[iVal], nchar);
+
+    taosArrayClear(aColVal);
+    taosArrayPush(aColVal, &cvTs);
+    taosArrayPush(aColVal, &cvVarchar);
+    taosArrayPush(aColVal, &cvNchar);
+
+    SRow *pRow = NULL;
+    code = tRowBuild(aColVal, pTSchema, &pRow);
+    if (code) break;
+
+    TSDBROW row = tsdbRowFromTSRow(iVal + 1, pRow);
+    code = tBlockDataAppendRow(pBlockData, &row, pTSchema, id.uid);
+    tRowDestroy(pRow);
+  }
+  taosArrayDestroy(aColVal);
+  return code;
+}
+
+// the encoding of each column of a compressed block, and the format version of the block
+void getBlockEncode(uint8_t *pBlock, uint32_t *fmtVer, std::vector<SBlockCol> &aBlockCol) {
+  SDiskDataHdr hdr = {0};
+  int32_t      n = tGetDiskDataHdr(pBlock, &hdr);
+  *fmtVer = hdr.fmtVer;
+
+  n += hdr.szUid + hdr.szVer + hdr.szKey;
+  for (int32_t nt = 0; nt < hdr.szBlkCol;) {
+    SBlockCol blockCol = {0};
+    nt += tGetBlockCol(pBlock + n + nt, &blockCol);
+    aBlockCol.push_back(blockCol);
+  }
+}
+
+void checkColData(SColData *pColData, int16_t cid, const STestCol &col) {
+  ASSERT_EQ(pColData->cid, cid);
+  ASSERT_EQ(pColData->nVal, (int32_t)col.size());
+
+  for (int32_t iVal = 0; iVal < (int32_t)col.size(); iVal++) {
+    SColVal colVal = {0};
+    tColDataGetValue(pColData, iVal, &colVal);
+
+    if (col[iVal].kind == ROW_NULL) {
+      ASSERT_TRUE(COL_VAL_IS_NULL(&colVal)) << "row " << iVal;
+    } else if (col[iVal].kind == ROW_NONE) {
+      ASSERT_TRUE(COL_VAL_IS_NONE(&colVal)) << "row " << iVal;
+    } else {
+      std::string expect = (cid == ncharCid) ? toNchar(col[iVal].val) : col[iVal].val;
+      ASSERT_TRUE(COL_VAL_IS_VALUE(&colVal)) << "row " << iVal;
+      ASSERT_EQ(std::string((char *)colVal.value.pData, colVal.value.nData), expect) << "row " << iVal;
+    }
+  }
+}
+
+// compresses a block of the rows, checks that the var columns take the expected encoding and that the rows come back
+void roundTrip(const STestCol &col, int8_t encode) {
+  STSchema *pTSchema = createSchema();
+  ASSERT_TRUE(pTSchema != NULL);
+
+  for (int8_t cmprAlg : {ONE_STAGE_COMP, TWO_STAGE_COMP}) {
+    SBlockData blockData = {0};
+    SBlockData decoded = {0};
+    uint8_t   *aBuf[4] = {0};
+    int32_t    aBufN[4] = {0};
+    uint8_t   *pOut = NULL;
+    int32_t    szOut = 0;
+
+    ASSERT_EQ(tBlockDataCreate(&blockData), 0);
+    ASSERT_EQ(tBlockDataCreate(&decoded), 0);
+    ASSERT_EQ(buildBlockData(&blockData, pTSchema, col), 0);
+    ASSERT_EQ(tCmprBlockData(&blockData, cmprAlg, &pOut, &szOut, aBuf, aBufN), 0);
+
+    uint32_t               fmtVer = 0;
+    std::vector<SBlockCol> aBlockCol;
+    getBlockEncode(pOut, &fmtVer, aBlockCol);
+    ASSERT_EQ(aBlockCol.size(), (size_t)2);
+    for (auto &blockCol : aBlockCol) {
+      ASSERT_EQ(blockCol.encode, encode) << "cid " << blockCol.cid << ", " << col.size() << " rows";
+    }
+    uint32_t expectVer = (encode == TSDB_COL_ENCODE_DICT) ? TSDB_DISK_DATA_FMT_VER_DICT : TSDB_DISK_DATA_FMT_VER;
+    ASSERT_EQ(fmtVer, expectVer);
+
+    ASSERT_EQ(tDecmprBlockData(pOut, szOut, &decoded, aBuf, NULL), 0);
+    ASSERT_EQ(decoded.nRow, (int32_t)col.size());
+    ASSERT_EQ(decoded.nColData, 2);
+    for (int32_t iRow = 0; iRow < decoded.nRow; iRow++) {
+      ASSERT_EQ(decoded.aTSKEY[iRow], startTs + iRow);
+      ASSERT_EQ(decoded.aVersion[iRow], iRow + 1);
+    }
+    checkColData(&decoded.aColData[0], varcharCid, col);
+    checkColData(&decoded.aColData[1], ncharCid, col);
+
+    tFree(pOut);
+    for (int32_t i = 0; i < 4; i++) {
+      tFree(aBuf[i]);
+    }
+    tBlockDataDestroy(&decoded);
+    tBlockDataDestroy(&blockData);
+  }
+
+  tDestroyTSchema(pTSchema);
+}
+
+}  // namespace
+
+TEST(tsdbBlockDataTest, dictWithNullAndNone) {
+  roundTrip(makeTestCol(1000, 7, 5, 0), TSDB_COL_ENCODE_DICT);
+  roundTrip(makeTestCol(1000, 7, 0, 3), TSDB_COL_ENCODE_DICT);
+  roundTrip(makeTestCol(1000, 7, 5, 3), TSDB_COL_ENCODE_DICT);
+}
+
+TEST(tsdbBlockDataTest, dictOfOneValue) {
+  // the codes take no bit
+  roundTrip(makeTestCol(200, 1, 0, 0), TSDB_COL_ENCODE_DICT);
+  roundTrip(makeTestCol(200, 1, 0, 7), TSDB_COL_ENCODE_DICT);
+}
+
+TEST(tsdbBlockDataTest, dictSizeLimit) {
+  roundTrip(makeTestCol(4096, 1024, 0, 0), TSDB_COL_ENCODE_DICT);
+  roundTrip(makeTestCol(8192, 1024, 0, 0), TSDB_COL_ENCODE_DICT);
+  roundTrip(makeTestCol(8192, 1025, 0, 0), TSDB_COL_ENCODE_RAW);
+}
+
+TEST(tsdbBlockDataTest, tooManyDistinctValues) {
+  // at most a quarter of the rows are distinct
+  roundTrip(makeTestCol(400, 100, 0, 0), TSDB_COL_ENCODE_DICT);
+  roundTrip(makeTestCol(400, 101, 0, 0), TSDB_COL_ENCODE_RAW);
+  roundTrip(makeTestCol(400, 101, 9, 0), TSDB_COL_ENCODE_RAW);
+}
+
+TEST(tsdbBlockDataTest, tooFewRows) {
+  roundTrip(makeTestCol(63, 1, 0, 0), TSDB_COL_ENCODE_RAW);
+  roundTrip(makeTestCol(63, 2, 5, 4), TSDB_COL_ENCODE_RAW);
+  roundTrip(makeTestCol(64, 1, 0, 0), TSDB_COL_ENCODE_DICT);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "tsdb.h"
+#include "vnd.h"
+
+namespace {
+
+const int32_t numOfWriters = 8;
+const int32_t numOfTablesPerWriter = 64;
+const int32_t numOfBatches = 8;
+const int32_t numOfRowsPerBatch = 50;
+const int64_t startTs = 1600000000000;
+
+// a vnode with only what the memtable touches, the buffer is small so that most allocations take a new pool node
+typedef struct {
+  SVnode    vnode;
+  STsdb     tsdb;
+  STSchema *pTSchema;
+} SMemTableEnv;
+
+SMemTableEnv *createEnv() {
+  SMemTableEnv *pEnv = static_cast<SMemTableEnv *>(taosMemoryCalloc(1, sizeof(SMemTableEnv)));
+  pEnv->vnode.config.vgId = 1;
+  pEnv->vnode.config.szBuf = 64 * 1024;
+  pEnv->vnode.config.tsdbCfg.slLevel = 5;
+  pEnv->vnode.config.cacheLast = 0;
+  taosThreadMutexInit(&pEnv->vnode.mutex, NULL);
+  taosThreadCondInit(&pEnv->vnode.poolNotEmpty, NULL);
+  if (vnodeOpenBufPool(&pEnv->vnode) != 0) {
+    return NULL;
+  }
+  pEnv->vnode.inUse = pEnv->vnode.freeList;
+  pEnv->vnode.freeList = pEnv->vnode.inUse->freeNext;
+  pEnv->vnode.inUse->freeNext = NULL;
+  pEnv->vnode.inUse->nRef = 1;
+
+  pEnv->tsdb.pVnode = &pEnv->vnode;
+
+  SSchema aSchema[] = {{.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = PRIMARYKEY_TIMESTAMP_COL_ID, .bytes = 8},
+                       {.type = TSDB_DATA_TYPE_BIGINT, .colId = PRIMARYKEY_TIMESTAMP_COL_ID + 1, .bytes = 8}};
+  pEnv->pTSchema = tBuildTSchema(aSchema, 2, 1);
+  return pEnv;
+}
+
+void destroyEnv(SMemTableEnv *pEnv) {
+  tDestroyTSchema(pEnv->pTSchema);
+  vnodeBufPoolUnRef(pEnv->vnode.inUse, false);
+  vnodeCloseBufPool(&pEnv->vnode);
+  taosThreadCondDestroy(&pEnv->vnode.poolNotEmpty);
+  taosThreadMutexDestroy(&pEnv->vnode.mutex);
+  taosMemoryFree(pEnv);
+}
+
+tb_uid_t tableUid(int32_t iWriter, int32_t iTable) { return 10000 + iTable * numOfWriters + iWriter; }
+
+// the value of a row is derived from its key, so that a row put into the wrong place or table is found
+int64_t rowValue(tb_uid_t uid, int64_t ts) { return uid * 1000000 + ts - startTs; }
+
+// batch j of a table holds the keys startTs + k * numOfBatches + j, so later batches are put between the rows of
+// earlier ones
+int32_t insertBatch(SMemTableEnv *pEnv, tb_uid_t uid, int32_t iBatch, int64_t version) {
+  SSubmitTbData submitTbData = {0};
+  submitTbData.suid = 1;
+  submitTbData.uid = uid;
+  submitTbData.sver = 1;
+  submitTbData.aRowP = taosArrayInit(numOfRowsPerBatch, sizeof(SRow *));
+
+  SArray *aColVal = taosArrayInit(2, sizeof(SColVal));
+  for (int32_t k = 0; k < numOfRowsPerBatch; ++k) {
+    int64_t ts = startTs + k * numOfBatches + iBatch;
+    SValue  vTs = {.val = ts};
+    SValue  vVal = {.val = rowValue(uid, ts)};
+
+    taosArrayClear(aColVal);
+    SColVal cvTs = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, vTs);
+    SColVal cvVal = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID + 1, TSDB_DATA_TYPE_BIGINT, vVal);
+    taosArrayPush(aColVal, &cvTs);
+    taosArrayPush(aColVal, &cvVal);
+
+    SRow *pRow = NULL;
+    if (tRowBuild(aColVal, pEnv->pTSchema, &pRow) != 0) {
+      return -1;
+    }
+    taosArrayPush(submitTbData.aRowP, &pRow);
+  }
+  taosArrayDestroy(aColVal);
+
+  int32_t affectedRows = 0;
+  int32_t code = tsdbInsertTableData(&pEnv->tsdb, version, &submitTbData, &affectedRows);
+  if (code == 0 && affectedRows != numOfRowsPerBatch) {
+    code = -1;
+  }
+
+  for (int32_t k = 0; k < taosArrayGetSize(submitTbData.aRowP); ++k) {
+    tRowDestroy(*(SRow **)taosArrayGet(submitTbData.aRowP, k));
+  }
+  taosArrayDestroy(submitTbData.aRowP);
+  return code;
+}
+
+// each writer owns its tables and writes them batch by batch, so the writers race on table creation, the hash
+// growing and the buffer pool, but never on the skiplist of one table
+void writerFn(SMemTableEnv *pEnv, int32_t iWriter, std::atomic<int32_t> *pFailed) {
+  for (int32_t iBatch = 0; iBatch < numOfBatches; ++iBatch) {
+    for (int32_t iTable = 0; iTable < numOfTablesPerWriter; ++iTable) {
+      int64_t version = (iBatch * numOfTablesPerWriter + iTable) * numOfWriters + iWriter + 1;
+      if (insertBatch(pEnv, tableUid(iWriter, iTable), iBatch, version) != 0) {
+        (*pFailed)++;
+        return;
+      }
+    }
+  }
+}
+
+void checkTable(SMemTable *pMemTable, tb_uid_t uid, int8_t backward) {
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pMemTable, 1, uid);
+  ASSERT_TRUE(pTbData != NULL);
+  ASSERT_EQ(pTbData->uid, uid);
+  ASSERT_EQ(pTbData->sl.size, numOfBatches * numOfRowsPerBatch);
+  ASSERT_EQ(pTbData->minKey, startTs);
+  ASSERT_EQ(pTbData->maxKey, startTs + numOfBatches * numOfRowsPerBatch - 1);
+
+  STbDataIter *pIter = NULL;
+  ASSERT_EQ(tsdbTbDataIterCreate(pTbData, NULL, backward, &pIter), 0);
+
+  int64_t expect = backward ? pTbData->maxKey : pTbData->minKey;
+  int32_t nRow = 0;
+  for (TSDBROW *pRow = tsdbTbDataIterGet(pIter); pRow; tsdbTbDataIterNext(pIter), pRow = tsdbTbDataIterGet(pIter)) {
+    ASSERT_EQ(TSDBROW_TS(pRow), expect);
+    expect += backward ? -1 : 1;
+    nRow++;
+  }
+  ASSERT_EQ(nRow, numOfBatches * numOfRowsPerBatch);
+
+  tsdbTbDataIterDestroy(pIter);
+}
+
+void checkTableValues(SMemTableEnv *pEnv, SMemTable *pMemTable, tb_uid_t uid) {
+  STbData     *pTbData = tsdbGetTbDataFromMemTable(pMemTable, 1, uid);
+  STbDataIter *pIter = NULL;
+  ASSERT_EQ(tsdbTbDataIterCreate(pTbData, NULL, 0, &pIter), 0);
+
+  for (TSDBROW *pRow = tsdbTbDataIterGet(pIter); pRow; tsdbTbDataIterNext(pIter), pRow = tsdbTbDataIterGet(pIter)) {
+    SColVal colVal = {0};
+    ASSERT_EQ(tRowGet(pRow->pTSRow, pEnv->pTSchema, 1, &colVal), 0);
+    ASSERT_EQ(colVal.value.val, rowValue(uid, TSDBROW_TS(pRow)));
+  }
+
+  tsdbTbDataIterDestroy(pIter);
+}
+
+}  // namespace
+
+TEST(tsdbMemTableTest, concurrentWriters) {
+  SMemTableEnv *pEnv = createEnv();
+  ASSERT_TRUE(pEnv != NULL);
+
+  SMemTable *pMemTable = NULL;
+  ASSERT_EQ(tsdbMemTableCreate(&pEnv->tsdb, &pMemTable), 0);
+  pEnv->tsdb.mem = pMemTable;
+
+  std::atomic<int32_t>     failed(0);
+  std::vector<std::thread> writers;
+  for (int32_t i = 0; i < numOfWriters; ++i) {
+    writers.emplace_back(writerFn, pEnv, i, &failed);
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  ASSERT_EQ(failed.load(), 0);
+
+  // nothing is lost or counted twice
+  int32_t numOfTables = numOfWriters * numOfTablesPerWriter;
+  int64_t numOfRows = (int64_t)numOfTables * numOfBatches * numOfRowsPerBatch;
+  ASSERT_EQ(pMemTable->nTbData, numOfTables);
+  ASSERT_EQ(pMemTable->nRow, numOfRows);
+  ASSERT_EQ(pMemTable->minKey, startTs);
+  ASSERT_EQ(pMemTable->maxKey, startTs + numOfBatches * numOfRowsPerBatch - 1);
+  ASSERT_EQ(pMemTable->minVer, 1);
+  ASSERT_EQ(pMemTable->maxVer, (int64_t)numOfBatches * numOfTablesPerWriter * numOfWriters);
+
+  for (int32_t iWriter = 0; iWriter < numOfWriters; ++iWriter) {
+    for (int32_t iTable = 0; iTable < numOfTablesPerWriter; ++iTable) {
+      tb_uid_t uid = tableUid(iWriter, iTable);
+      checkTable(pMemTable, uid, 0);
+      checkTable(pMemTable, uid, 1);
+      checkTableValues(pEnv, pMemTable, uid);
+    }
+  }
+  ASSERT_TRUE(tsdbGetTbDataFromMemTable(pMemTable, 1, tableUid(numOfWriters, numOfTablesPerWriter)) == NULL);
+
+  tsdbMemTableDestroy(pMemTable, false);
+  destroyEnv(pEnv);
+}
+
+#pragma GCC diagnostic pop
@@ -1627,6 +1627,28 @@ _return:
 }
 
 
+int32_t catalogGetUserAuthVersion(SCatalog* pCtg, const char* user, int32_t* version) {
+  CTG_API_ENTER();
+
+  if (NULL == pCtg || NULL == user || NULL == version) {
+    CTG_API_LEAVE(TSDB_CODE_CTG_INVALID_INPUT);
+  }
+
+  *version = CTG_DEFAULT_INVALID_VERSION;
+
+  SCtgUserAuth* pUser = (SCtgUserAuth*)taosHashGet(pCtg->userCache, user, strlen(user));
+  if (NULL == pUser) {
+    ctgDebug("user not in cache, user:%s", user);
+    CTG_API_LEAVE(TSDB_CODE_SUCCESS);
+  }
+
+  CTG_LOCK(CTG_READ, &pUser->lock);
+  *version = pUser->userAuth.version;
+  CTG_UNLOCK(CTG_READ, &pUser->lock);
+
+  CTG_API_LEAVE(TSDB_CODE_SUCCESS);
+}
+
 int32_t catalogGetServerVersion(SCatalog* pCtg, SRequestConnInfo* pConn, char** pVersion) {
   CTG_API_ENTER();
 
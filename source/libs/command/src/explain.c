@@ -759,6 +759,10 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->writeBytes > 0 && execInfo->verboseLen >= sizeof(SSortExecInfo)) {
+          EXPLAIN_ROW_APPEND("  Spill: write:%.2f Kb read:%.2f Kb stall:%.2f ms", pExecInfo->writeBytes / 1024.0,
+                             pExecInfo->readBytes / 1024.0, pExecInfo->stallTime / 1000.0);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1113,6 +1117,10 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->writeBytes > 0 && execInfo->verboseLen >= sizeof(SSortExecInfo)) {
+          EXPLAIN_ROW_APPEND("  Spill: write:%.2f Kb read:%.2f Kb stall:%.2f ms", pExecInfo->writeBytes / 1024.0,
+                             pExecInfo->readBytes / 1024.0, pExecInfo->stallTime / 1000.0);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1332,6 +1340,10 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->writeBytes > 0 && execInfo->verboseLen >= sizeof(SSortExecInfo)) {
+          EXPLAIN_ROW_APPEND("  Spill: write:%.2f Kb read:%.2f Kb stall:%.2f ms", pExecInfo->writeBytes / 1024.0,
+                             pExecInfo->readBytes / 1024.0, pExecInfo->stallTime / 1000.0);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
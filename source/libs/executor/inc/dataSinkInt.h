@@ -39,6 +39,7 @@ typedef void (*FGetDataLength)(struct SDataSinkHandle* pHandle, int64_t* pLen, b
 typedef int32_t (*FGetDataBlock)(struct SDataSinkHandle* pHandle, SOutputData* pOutput);
 typedef int32_t (*FDestroyDataSinker)(struct SDataSinkHandle* pHandle);
 typedef int32_t (*FGetCacheSize)(struct SDataSinkHandle* pHandle, uint64_t* size);
+typedef void (*FSetCompressSize)(struct SDataSinkHandle* pHandle, int32_t compressSize);
 
 typedef struct SDataSinkHandle {
   FPutDataBlock      fPut;
@@ -47,6 +48,7 @@ typedef struct SDataSinkHandle {
   FGetDataBlock      fGetData;
   FDestroyDataSinker fDestroy;
   FGetCacheSize      fGetCacheSize;
+  FSetCompressSize   fSetCompressSize;
 } SDataSinkHandle;
 
 int32_t createDataDispatcher(SDataSinkManager* pManager, const SDataSinkNode* pDataSink, DataSinkHandle* pHandle);
@@ -211,6 +211,31 @@ typedef struct STableScanBase {
   TsdReader     readerAPI;
 } STableScanBase;
 
+// one time range of a parallel table scan, read by its own tsdb reader on the table scan pool
+typedef struct STableScanSegment {
+  STimeWindow   window;
+  STsdbReader*  dataReader;
+  SSDataBlock*  pResBlock;  // filled by the reader, copied for every produced block
+  SArray*       pBlocks;    // SArray<SSDataBlock*>, produced and not consumed yet
+  int64_t       bufSize;    // bytes of the blocks in pBlocks
+  TdThreadMutex lock;
+  TdThreadCond  cond;
+  int32_t       code;
+  bool          running;    // a scan task is scheduled or running
+  bool          completed;  // the reader is exhausted or failed
+  struct STableScanParallel* pParallel;
+} STableScanSegment;
+
+typedef struct STableScanParallel {
+  SArray*      pSegments;  // SArray<STableScanSegment*>, in ascending time order
+  int32_t      current;    // number of segments consumed
+  int32_t      order;
+  SSDataBlock* pBlock;     // block returned to the upstream operator
+  TsdReader*   pAPI;
+  const char*  idStr;
+  int8_t       closing;
+} STableScanParallel;
+
 typedef struct STableScanInfo {
   STableScanBase  base;
   SScanInfo       scanInfo;
@@ -224,6 +249,7 @@ typedef struct STableScanInfo {
   int8_t          assignBlockUid;
   bool            hasGroupByTag;
   bool            countOnly;
+  STableScanParallel* pParallel;  // not NULL if the time range is scanned by several readers concurrently
 //  TsdReader    readerAPI;
 } STableScanInfo;
 
@@ -416,6 +442,7 @@ typedef struct SIntervalAggOperatorInfo {
   EOPTR_EXEC_MODEL   execModel;          // operator execution model [batch model|stream model]
   STimeWindowAggSupp twAggSup;
   SArray*            pPrevValues;  //  SArray<SGroupKeys> used to keep the previous not null value for interpolation.
+  SArray*            pWinRanges;   //  SArray<SIntervalWinRange>, the time windows of the current block
 } SIntervalAggOperatorInfo;
 
 typedef struct SMergeAlignedIntervalAggOperatorInfo {
@@ -603,6 +630,8 @@ bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
 
 void applyAggFunctionOnPartialTuples(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfoData* pTimeWindowData,
                                      int32_t offset, int32_t forwardStep, int32_t numOfTotal, int32_t numOfOutput);
+void applyAggFunctionOnTuples(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfoData* pTimeWindowData,
+                              int32_t offset, int32_t forwardStep, int32_t numOfTotal);
 
 int32_t extractDataBlockFromFetchRsp(SSDataBlock* pRes, char* pData, SArray* pColList, char** pNextStart);
 void    updateLoadRemoteInfo(SLoadRemoteDataInfo* pInfo, int64_t numOfRows, int32_t dataLen, int64_t startTs,
@@ -679,6 +708,14 @@ void doClearBufferedBlocks(SStreamScanInfo* pInfo);
 
 uint64_t calcGroupId(char* pData, int32_t len);
 
+// the parts of a time window returned by tsdReaderSplitTimeWindow are scanned concurrently, the blocks are returned in
+// the same order as by one reader on the whole window
+int32_t createParallelTableScan(TsdReader* pAPI, void* pVnode, const SQueryTableDataCond* pCond, STableKeyInfo* pList,
+                                int32_t num, SSDataBlock* pResBlock, const SArray* pWindows, int64_t version,
+                                const char* idStr, STableScanParallel** ppParallel);
+int32_t nextParallelTableScanBlock(STableScanParallel* pParallel, SSDataBlock** ppBlock);
+void    destroyParallelTableScan(STableScanParallel* pParallel);
+
 #ifdef __cplusplus
 }
 #endif
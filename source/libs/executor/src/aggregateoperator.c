@@ -516,48 +516,54 @@ int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo
 void applyAggFunctionOnPartialTuples(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfoData* pTimeWindowData,
                                      int32_t offset, int32_t forwardStep, int32_t numOfTotal, int32_t numOfOutput) {
   for (int32_t k = 0; k < numOfOutput; ++k) {
-    // keep it temporarily
-    SFunctionCtxStatus status = {0};
-    functionCtxSave(&pCtx[k], &status);
+    applyAggFunctionOnTuples(taskInfo, &pCtx[k], pTimeWindowData, offset, forwardStep, numOfTotal);
+  }
+}
 
-    pCtx[k].input.startRowIndex = offset;
-    pCtx[k].input.numOfRows = forwardStep;
+// apply one function on the rows [offset, offset + forwardStep) of the input block
+void applyAggFunctionOnTuples(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfoData* pTimeWindowData,
+                              int32_t offset, int32_t forwardStep, int32_t numOfTotal) {
+  // keep it temporarily
+  SFunctionCtxStatus status = {0};
+  functionCtxSave(pCtx, &status);
 
-    // not a whole block involved in query processing, statistics data can not be used
-    // NOTE: the original value of isSet have been changed here
-    if (pCtx[k].input.colDataSMAIsSet && forwardStep < numOfTotal) {
-      pCtx[k].input.colDataSMAIsSet = false;
-    }
+  pCtx->input.startRowIndex = offset;
+  pCtx->input.numOfRows = forwardStep;
 
-    if (pCtx[k].isPseudoFunc) {
-      SResultRowEntryInfo* pEntryInfo = GET_RES_INFO(&pCtx[k]);
+  // not a whole block involved in query processing, statistics data can not be used
+  // NOTE: the original value of isSet have been changed here
+  if (pCtx->input.colDataSMAIsSet && forwardStep < numOfTotal) {
+    pCtx->input.colDataSMAIsSet = false;
+  }
 
-      char* p = GET_ROWCELL_INTERBUF(pEntryInfo);
+  if (pCtx->isPseudoFunc) {
+    SResultRowEntryInfo* pEntryInfo = GET_RES_INFO(pCtx);
 
-      SColumnInfoData idata = {0};
-      idata.info.type = TSDB_DATA_TYPE_BIGINT;
-      idata.info.bytes = tDataTypes[TSDB_DATA_TYPE_BIGINT].bytes;
-      idata.pData = p;
+    char* p = GET_ROWCELL_INTERBUF(pEntryInfo);
 
-      SScalarParam out = {.columnData = &idata};
-      SScalarParam tw = {.numOfRows = 5, .columnData = pTimeWindowData};
-      pCtx[k].sfp.process(&tw, 1, &out);
-      pEntryInfo->numOfRes = 1;
-    } else {
-      int32_t code = TSDB_CODE_SUCCESS;
-      if (functionNeedToExecute(&pCtx[k]) && pCtx[k].fpSet.process != NULL) {
-        code = pCtx[k].fpSet.process(&pCtx[k]);
-
-        if (code != TSDB_CODE_SUCCESS) {
-          qError("%s apply functions error, code: %s", GET_TASKID(taskInfo), tstrerror(code));
-          taskInfo->code = code;
-          T_LONG_JMP(taskInfo->env, code);
-        }
-      }
+    SColumnInfoData idata = {0};
+    idata.info.type = TSDB_DATA_TYPE_BIGINT;
+    idata.info.bytes = tDataTypes[TSDB_DATA_TYPE_BIGINT].bytes;
+    idata.pData = p;
+
+    SScalarParam out = {.columnData = &idata};
+    SScalarParam tw = {.numOfRows = 5, .columnData = pTimeWindowData};
+    pCtx->sfp.process(&tw, 1, &out);
+    pEntryInfo->numOfRes = 1;
+  } else {
+    int32_t code = TSDB_CODE_SUCCESS;
+    if (functionNeedToExecute(pCtx) && pCtx->fpSet.process != NULL) {
+      code = pCtx->fpSet.process(pCtx);
 
-      // restore it
-      functionCtxRestore(&pCtx[k], &status);
+      if (code != TSDB_CODE_SUCCESS) {
+        qError("%s apply functions error, code: %s", GET_TASKID(taskInfo), tstrerror(code));
+        taskInfo->code = code;
+        T_LONG_JMP(taskInfo->env, code);
+      }
     }
+
+    // restore it
+    functionCtxRestore(pCtx, &status);
   }
 }
 
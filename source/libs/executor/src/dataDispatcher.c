@@ -48,6 +48,7 @@ typedef struct SDataDispatchHandle {
   bool                queryEnd;
   uint64_t            useconds;
   uint64_t            cachedSize;
+  int32_t             compressSize;  // -1 means the blocks are not compressed
   TdThreadMutex       mutex;
 } SDataDispatchHandle;
 
@@ -60,6 +61,54 @@ typedef struct SDataDispatchHandle {
 // The length of bitmap is decided by number of rows of this data block, and the length of each column data is
 // recorded in the first segment, next to the struct header
 // clang-format on
+
+// replace the encoded block by its column compressed form when it gets smaller, the block is kept as it is on failure
+static void compressDataCacheEntry(SDataDispatchBuf* pBuf) {
+  SDataCacheEntry* pEntry = (SDataCacheEntry*)pBuf->pData;
+  int32_t          allocSize = sizeof(SDataCacheEntry) + blockCompressGetBound(pEntry->data);
+
+  SDataCacheEntry* pCmprEntry = taosMemoryMalloc(allocSize);
+  if (pCmprEntry == NULL) {
+    return;
+  }
+
+  int32_t dataLen = blockCompressEncode(pEntry->data, pCmprEntry->data);
+  if (dataLen >= pEntry->dataLen) {
+    taosMemoryFree(pCmprEntry);
+    return;
+  }
+
+  qDebug("sink block compressed, rows:%d, cols:%d, len:%d, compressed len:%d", pEntry->numOfRows, pEntry->numOfCols,
+         pEntry->dataLen, dataLen);
+
+  pCmprEntry->compressed = 1;
+  pCmprEntry->numOfRows = pEntry->numOfRows;
+  pCmprEntry->numOfCols = pEntry->numOfCols;
+  pCmprEntry->dataLen = dataLen;
+
+  taosMemoryFree(pBuf->pData);
+  pBuf->pData = (char*)pCmprEntry;
+  pBuf->allocSize = allocSize;
+  pBuf->useSize = sizeof(SDataCacheEntry) + dataLen;
+}
+
+// the block is compressed when any of its columns reaches the compress size
+static bool needCompressDataCacheEntry(SDataDispatchHandle* pHandle, SDataCacheEntry* pEntry) {
+  if (pHandle->compressSize < 0) {
+    return false;
+  }
+
+  int32_t* colSizes = (int32_t*)(pEntry->data + blockDataGetSerialMetaSize(pEntry->numOfCols) -
+                                 pEntry->numOfCols * sizeof(int32_t));
+  for (int32_t i = 0; i < pEntry->numOfCols; ++i) {
+    if (htonl(colSizes[i]) >= pHandle->compressSize) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 static void toDataCacheEntry(SDataDispatchHandle* pHandle, const SInputData* pInput, SDataDispatchBuf* pBuf) {
   int32_t numOfCols = 0;
   SNode*  pNode;
@@ -82,6 +131,11 @@ static void toDataCacheEntry(SDataDispatchHandle* pHandle, const SInputData* pIn
 
   pBuf->useSize += pEntry->dataLen;
 
+  if (needCompressDataCacheEntry(pHandle, pEntry)) {
+    compressDataCacheEntry(pBuf);
+    pEntry = (SDataCacheEntry*)pBuf->pData;
+  }
+
   atomic_add_fetch_64(&pHandle->cachedSize, pEntry->dataLen);
   atomic_add_fetch_64(&gDataSinkStat.cachedSize, pEntry->dataLen);
 }
@@ -236,6 +290,11 @@ static int32_t getCacheSize(struct SDataSinkHandle* pHandle, uint64_t* size) {
   return TSDB_CODE_SUCCESS;
 }
 
+static void setCompressSize(struct SDataSinkHandle* pHandle, int32_t compressSize) {
+  SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
+  pDispatcher->compressSize = compressSize;
+}
+
 int32_t createDataDispatcher(SDataSinkManager* pManager, const SDataSinkNode* pDataSink, DataSinkHandle* pHandle) {
   SDataDispatchHandle* dispatcher = taosMemoryCalloc(1, sizeof(SDataDispatchHandle));
   if (NULL == dispatcher) {
@@ -248,10 +307,12 @@ int32_t createDataDispatcher(SDataSinkManager* pManager, const SDataSinkNode* pD
   dispatcher->sink.fGetData = getDataBlock;
   dispatcher->sink.fDestroy = destroyDataSinker;
   dispatcher->sink.fGetCacheSize = getCacheSize;
+  dispatcher->sink.fSetCompressSize = setCompressSize;
   dispatcher->pManager = pManager;
   dispatcher->pSchema = pDataSink->pInputDataBlockDesc;
   dispatcher->status = DS_BUF_EMPTY;
   dispatcher->queryEnd = false;
+  dispatcher->compressSize = -1;
   dispatcher->pDataBlocks = taosOpenQueue();
   taosThreadMutexInit(&dispatcher->mutex, NULL);
   if (NULL == dispatcher->pDataBlocks) {
@@ -74,6 +74,13 @@ int32_t dsGetCacheSize(DataSinkHandle handle, uint64_t* pSize) {
   return pHandleImpl->fGetCacheSize(pHandleImpl, pSize);
 }
 
+void dsSetCompressSize(DataSinkHandle handle, int32_t compressSize) {
+  SDataSinkHandle* pHandleImpl = (SDataSinkHandle*)handle;
+  if (pHandleImpl->fSetCompressSize) {
+    pHandleImpl->fSetCompressSize(pHandleImpl, compressSize);
+  }
+}
+
 void dsScheduleProcess(void* ahandle, void* pItem) {
   // todo
 }
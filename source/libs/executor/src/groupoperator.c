@@ -28,16 +28,53 @@
 #include "thash.h"
 #include "ttypes.h"
 
+// blocks with fewer rows are aggregated row by row
+#define GROUPBY_BATCH_MIN_ROWS 64
+
+#define GROUP_KEY_LAYOUT_BYTES 0  // keys are compared as the serialized bytes built by buildGroupKeys
+#define GROUP_KEY_LAYOUT_INT   1  // single fixed width key of at most 8 bytes, compared as an integer
+
+typedef struct SGroupBatchSlot {
+  uint64_t value;      // key value of the integer layout
+  uint32_t hash;
+  int32_t  keyOffset;  // key of the byte layout in SGroupbyBatchInfo.pKeyBuf
+  int32_t  keyLen;
+  int32_t  firstRow;
+  int32_t  numOfRows;
+  int32_t  start;  // start position in the selection vector
+} SGroupBatchSlot;
+
+// The per block scratch of the batched group by aggregation: every row is mapped to the slot of its group with one
+// pass over the block, and the rows of each group are then fed to the aggregate functions in one call.
+typedef struct SGroupbyBatchInfo {
+  int32_t           layout;
+  int32_t           capacity;  // rows
+  int32_t           numOfSlots;
+  int32_t           bucketMask;
+  int32_t*          pBucket;     // open addressing table, slot index + 1 and 0 for empty buckets
+  uint32_t*         pHash;       // hash of every row
+  uint64_t*         pValue;      // key value of every row of the integer layout
+  int32_t*          pRowSlot;    // group slot of every row
+  int32_t*          pSelection;  // row indexes ordered by group
+  SGroupBatchSlot*  pSlots;
+  SColumnInfoData** pKeyCols;      // group by columns of the current block
+  char*             pKeyBuf;       // distinct keys of the byte layout
+  int32_t           keyBufLen;
+  int32_t           keyBufCap;
+  SSDataBlock*      pGatherBlock;  // rows of the input block ordered by the selection vector
+} SGroupbyBatchInfo;
+
 typedef struct SGroupbyOperatorInfo {
-  SOptrBasicInfo binfo;
-  SAggSupporter  aggSup;
-  SArray*        pGroupCols;     // group by columns, SArray<SColumn>
-  SArray*        pGroupColVals;  // current group column values, SArray<SGroupKeys>
-  bool           isInit;         // denote if current val is initialized or not
-  char*          keyBuf;         // group by keys for hash
-  int32_t        groupKeyLen;    // total group by column width
-  SGroupResInfo  groupResInfo;
-  SExprSupp      scalarSup;
+  SOptrBasicInfo    binfo;
+  SAggSupporter     aggSup;
+  SArray*           pGroupCols;     // group by columns, SArray<SColumn>
+  SArray*           pGroupColVals;  // current group column values, SArray<SGroupKeys>
+  bool              isInit;         // denote if current val is initialized or not
+  char*             keyBuf;         // group by keys for hash
+  int32_t           groupKeyLen;    // total group by column width
+  SGroupResInfo     groupResInfo;
+  SExprSupp         scalarSup;
+  SGroupbyBatchInfo batch;
 } SGroupbyOperatorInfo;
 
 // The sort in partition may be needed later.
@@ -64,6 +101,19 @@ static int32_t  setGroupResultOutputBuf(SOperatorInfo* pOperator, SOptrBasicInfo
                                         int16_t bytes, uint64_t groupId, SDiskbasedBuf* pBuf, SAggSupporter* pAggSup);
 static SArray*  extractColumnInfo(SNodeList* pNodeList);
 
+static void destroyGroupbyBatchInfo(SGroupbyBatchInfo* pBatch) {
+  taosMemoryFreeClear(pBatch->pBucket);
+  taosMemoryFreeClear(pBatch->pHash);
+  taosMemoryFreeClear(pBatch->pValue);
+  taosMemoryFreeClear(pBatch->pRowSlot);
+  taosMemoryFreeClear(pBatch->pSelection);
+  taosMemoryFreeClear(pBatch->pSlots);
+  taosMemoryFreeClear(pBatch->pKeyCols);
+  taosMemoryFreeClear(pBatch->pKeyBuf);
+  pBatch->pGatherBlock = blockDataDestroy(pBatch->pGatherBlock);
+  pBatch->capacity = 0;
+}
+
 static void freeGroupKey(void* param) {
   SGroupKeys* pKey = (SGroupKeys*)param;
   taosMemoryFree(pKey->pData);
@@ -83,6 +133,7 @@ static void destroyGroupOperatorInfo(void* param) {
 
   cleanupGroupResInfo(&pInfo->groupResInfo);
   cleanupAggSup(&pInfo->aggSup);
+  destroyGroupbyBatchInfo(&pInfo->batch);
   taosMemoryFreeClear(param);
 }
 
@@ -344,6 +395,382 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   }
 }
 
+static bool isGroupbyBatchApplicable(const SGroupbyOperatorInfo* pInfo, const SSDataBlock* pBlock) {
+  // blocks with only the SMA loaded and json keys, which may raise an error per row, stay on the row by row path
+  if (pBlock->info.rows < GROUPBY_BATCH_MIN_ROWS || pBlock->pBlockAgg != NULL) {
+    return false;
+  }
+
+  int32_t numOfGroupCols = taosArrayGetSize(pInfo->pGroupCols);
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumn* pCol = taosArrayGet(pInfo->pGroupCols, i);
+    if (pCol->type == TSDB_DATA_TYPE_JSON || pCol->slotId >= taosArrayGetSize(pBlock->pDataBlock)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static int32_t ensureGroupbyBatchCapacity(SGroupbyBatchInfo* pBatch, int32_t rows) {
+  if (pBatch->capacity >= rows) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t numOfBuckets = 1;
+  while (numOfBuckets < rows * 2) {
+    numOfBuckets <<= 1;
+  }
+
+  taosMemoryFreeClear(pBatch->pBucket);
+  taosMemoryFreeClear(pBatch->pHash);
+  taosMemoryFreeClear(pBatch->pValue);
+  taosMemoryFreeClear(pBatch->pRowSlot);
+  taosMemoryFreeClear(pBatch->pSelection);
+  taosMemoryFreeClear(pBatch->pSlots);
+  pBatch->capacity = 0;
+
+  pBatch->pBucket = taosMemoryMalloc(numOfBuckets * sizeof(int32_t));
+  pBatch->pHash = taosMemoryMalloc(rows * sizeof(uint32_t));
+  pBatch->pValue = taosMemoryMalloc(rows * sizeof(uint64_t));
+  pBatch->pRowSlot = taosMemoryMalloc(rows * sizeof(int32_t));
+  pBatch->pSelection = taosMemoryMalloc(rows * sizeof(int32_t));
+  pBatch->pSlots = taosMemoryMalloc(rows * sizeof(SGroupBatchSlot));
+  if (pBatch->pBucket == NULL || pBatch->pHash == NULL || pBatch->pValue == NULL || pBatch->pRowSlot == NULL ||
+      pBatch->pSelection == NULL || pBatch->pSlots == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pBatch->capacity = rows;
+  pBatch->bucketMask = numOfBuckets - 1;
+  return TSDB_CODE_SUCCESS;
+}
+
+// the same key layout as recordNewGroupKeys + buildGroupKeys, built from the block directly
+static int32_t buildGroupKeysFromBlock(char* pKey, SColumnInfoData** pKeyCols, int32_t numOfGroupCols, int32_t rows,
+                                       int32_t rowIndex) {
+  char* isNull = pKey;
+  char* pStart = pKey + sizeof(int8_t) * numOfGroupCols;
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumnInfoData* pColInfoData = pKeyCols[i];
+    if (colDataIsNull(pColInfoData, rows, rowIndex, NULL)) {
+      isNull[i] = 1;
+      continue;
+    }
+
+    isNull[i] = 0;
+    char* val = colDataGetData(pColInfoData, rowIndex);
+    if (IS_VAR_DATA_TYPE(pColInfoData->info.type)) {
+      varDataCopy(pStart, val);
+      pStart += varDataTLen(val);
+    } else {
+      memcpy(pStart, val, pColInfoData->info.bytes);
+      pStart += pColInfoData->info.bytes;
+    }
+  }
+
+  return (int32_t)(pStart - pKey);
+}
+
+static int32_t newGroupBatchSlot(SGroupbyBatchInfo* pBatch, int32_t rowIndex, uint32_t hash, uint64_t value,
+                                 const char* pKey, int32_t keyLen) {
+  if (pKey != NULL) {
+    if (pBatch->keyBufLen + keyLen > pBatch->keyBufCap) {
+      int32_t cap = TMAX(pBatch->keyBufCap * 2, pBatch->keyBufLen + keyLen + 1024);
+      char*   p = taosMemoryRealloc(pBatch->pKeyBuf, cap);
+      if (p == NULL) {
+        return -1;
+      }
+      pBatch->pKeyBuf = p;
+      pBatch->keyBufCap = cap;
+    }
+    memcpy(pBatch->pKeyBuf + pBatch->keyBufLen, pKey, keyLen);
+  }
+
+  SGroupBatchSlot* pSlot = &pBatch->pSlots[pBatch->numOfSlots];
+  pSlot->value = value;
+  pSlot->hash = hash;
+  pSlot->keyOffset = pBatch->keyBufLen;
+  pSlot->keyLen = keyLen;
+  pSlot->firstRow = rowIndex;
+  pSlot->numOfRows = 0;
+  pSlot->start = 0;
+
+  pBatch->keyBufLen += (pKey != NULL) ? keyLen : 0;
+  return pBatch->numOfSlots++;
+}
+
+static void loadGroupKeyValues(const SColumnInfoData* pCol, int32_t rows, uint64_t* pValue, uint32_t* pHash) {
+  switch (pCol->info.bytes) {
+    case sizeof(int8_t):
+      for (int32_t j = 0; j < rows; ++j) pValue[j] = ((uint8_t*)pCol->pData)[j];
+      break;
+    case sizeof(int16_t):
+      for (int32_t j = 0; j < rows; ++j) pValue[j] = ((uint16_t*)pCol->pData)[j];
+      break;
+    case sizeof(int32_t):
+      for (int32_t j = 0; j < rows; ++j) pValue[j] = ((uint32_t*)pCol->pData)[j];
+      break;
+    default:
+      for (int32_t j = 0; j < rows; ++j) pValue[j] = ((uint64_t*)pCol->pData)[j];
+      break;
+  }
+
+  // fibonacci hashing, the loop has no dependency between rows and is vectorized by the compiler
+  for (int32_t j = 0; j < rows; ++j) {
+    pHash[j] = (uint32_t)((pValue[j] * 0x9E3779B97F4A7C15ULL) >> 32);
+  }
+}
+
+// map every row of the block to the slot of its group, returns the number of runs of adjacent rows in the same group
+static int32_t assignGroupBatchSlots(SGroupbyOperatorInfo* pInfo, SSDataBlock* pBlock, SColumnInfoData** pKeyCols,
+                                     int32_t numOfGroupCols) {
+  SGroupbyBatchInfo* pBatch = &pInfo->batch;
+  int32_t            rows = pBlock->info.rows;
+  int32_t            runs = 0;
+  int32_t            prevSlot = -1;
+  int32_t            nullSlot = -1;
+
+  pBatch->numOfSlots = 0;
+  pBatch->keyBufLen = 0;
+  memset(pBatch->pBucket, 0, (pBatch->bucketMask + 1) * sizeof(int32_t));
+
+  if (pBatch->layout == GROUP_KEY_LAYOUT_INT) {
+    SColumnInfoData* pCol = pKeyCols[0];
+    loadGroupKeyValues(pCol, rows, pBatch->pValue, pBatch->pHash);
+
+    for (int32_t j = 0; j < rows; ++j) {
+      int32_t slot = -1;
+      if (pCol->hasNull && colDataIsNull_f(pCol->nullbitmap, j)) {
+        if (nullSlot < 0) {
+          nullSlot = newGroupBatchSlot(pBatch, j, 0, 0, NULL, 0);
+        }
+        slot = nullSlot;
+      } else {
+        uint32_t hash = pBatch->pHash[j];
+        uint64_t value = pBatch->pValue[j];
+        int32_t  b = hash & pBatch->bucketMask;
+        while (pBatch->pBucket[b] != 0) {
+          SGroupBatchSlot* pSlot = &pBatch->pSlots[pBatch->pBucket[b] - 1];
+          if (pSlot->value == value && pSlot->hash == hash) {
+            slot = pBatch->pBucket[b] - 1;
+            break;
+          }
+          b = (b + 1) & pBatch->bucketMask;
+        }
+        if (slot < 0) {
+          slot = newGroupBatchSlot(pBatch, j, hash, value, NULL, 0);
+          pBatch->pBucket[b] = slot + 1;
+        }
+      }
+
+      pBatch->pRowSlot[j] = slot;
+      pBatch->pSlots[slot].numOfRows += 1;
+      runs += (slot != prevSlot);
+      prevSlot = slot;
+    }
+  } else {
+    for (int32_t j = 0; j < rows; ++j) {
+      int32_t  len = buildGroupKeysFromBlock(pInfo->keyBuf, pKeyCols, numOfGroupCols, rows, j);
+      uint32_t hash = MurmurHash3_32(pInfo->keyBuf, len);
+      pBatch->pHash[j] = hash;
+
+      int32_t slot = -1;
+      int32_t b = hash & pBatch->bucketMask;
+      while (pBatch->pBucket[b] != 0) {
+        SGroupBatchSlot* pSlot = &pBatch->pSlots[pBatch->pBucket[b] - 1];
+        if (pSlot->hash == hash && pSlot->keyLen == len &&
+            memcmp(pBatch->pKeyBuf + pSlot->keyOffset, pInfo->keyBuf, len) == 0) {
+          slot = pBatch->pBucket[b] - 1;
+          break;
+        }
+        b = (b + 1) & pBatch->bucketMask;
+      }
+      if (slot < 0) {
+        slot = newGroupBatchSlot(pBatch, j, hash, 0, pInfo->keyBuf, len);
+        if (slot < 0) {
+          return -1;
+        }
+        pBatch->pBucket[b] = slot + 1;
+      }
+
+      pBatch->pRowSlot[j] = slot;
+      pBatch->pSlots[slot].numOfRows += 1;
+      runs += (slot != prevSlot);
+      prevSlot = slot;
+    }
+  }
+
+  return runs;
+}
+
+static int32_t gatherBlockRows(SSDataBlock* pDst, const SSDataBlock* pSrc, const int32_t* pIndex) {
+  int32_t rows = pSrc->info.rows;
+  int32_t code = blockDataEnsureCapacity(pDst, rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  size_t numOfCols = taosArrayGetSize(pSrc->pDataBlock);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pDstCol = taosArrayGet(pDst->pDataBlock, i);
+    SColumnInfoData* pSrcCol = taosArrayGet(pSrc->pDataBlock, i);
+    pDstCol->hasNull = pSrcCol->hasNull;
+
+    if (IS_VAR_DATA_TYPE(pSrcCol->info.type)) {
+      // share the payload layout of the source column, only the offsets are reordered
+      if (pDstCol->varmeta.allocLen < pSrcCol->varmeta.length) {
+        char* p = taosMemoryRealloc(pDstCol->pData, pSrcCol->varmeta.length);
+        if (p == NULL) {
+          return TSDB_CODE_OUT_OF_MEMORY;
+        }
+        pDstCol->pData = p;
+        pDstCol->varmeta.allocLen = pSrcCol->varmeta.length;
+      }
+      if (pSrcCol->varmeta.length > 0) {
+        memcpy(pDstCol->pData, pSrcCol->pData, pSrcCol->varmeta.length);
+      }
+      pDstCol->varmeta.length = pSrcCol->varmeta.length;
+
+      for (int32_t j = 0; j < rows; ++j) {
+        pDstCol->varmeta.offset[j] = pSrcCol->varmeta.offset[pIndex[j]];
+      }
+      continue;
+    }
+
+    int32_t bytes = pSrcCol->info.bytes;
+    switch (bytes) {
+      case sizeof(int8_t):
+        for (int32_t j = 0; j < rows; ++j) ((int8_t*)pDstCol->pData)[j] = ((int8_t*)pSrcCol->pData)[pIndex[j]];
+        break;
+      case sizeof(int16_t):
+        for (int32_t j = 0; j < rows; ++j) ((int16_t*)pDstCol->pData)[j] = ((int16_t*)pSrcCol->pData)[pIndex[j]];
+        break;
+      case sizeof(int32_t):
+        for (int32_t j = 0; j < rows; ++j) ((int32_t*)pDstCol->pData)[j] = ((int32_t*)pSrcCol->pData)[pIndex[j]];
+        break;
+      case sizeof(int64_t):
+        for (int32_t j = 0; j < rows; ++j) ((int64_t*)pDstCol->pData)[j] = ((int64_t*)pSrcCol->pData)[pIndex[j]];
+        break;
+      default:
+        for (int32_t j = 0; j < rows; ++j) {
+          memcpy(pDstCol->pData + j * bytes, pSrcCol->pData + pIndex[j] * bytes, bytes);
+        }
+        break;
+    }
+
+    memset(pDstCol->nullbitmap, 0, BitmapLen(rows));
+    if (pSrcCol->hasNull) {
+      for (int32_t j = 0; j < rows; ++j) {
+        if (colDataIsNull_f(pSrcCol->nullbitmap, pIndex[j])) {
+          colDataSetNull_f(pDstCol->nullbitmap, j);
+        }
+      }
+    }
+  }
+
+  uint32_t capacity = pDst->info.capacity;
+  pDst->info = pSrc->info;
+  pDst->info.capacity = capacity;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void applyAggOnGroupRows(SOperatorInfo* pOperator, SSDataBlock* pBlock, SColumnInfoData** pKeyCols,
+                                int32_t numOfGroupCols, int32_t keyRow, int32_t rowIndex, int32_t numOfRows,
+                                int32_t totalRows) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SqlFunctionCtx*       pCtx = pOperator->exprSupp.pCtx;
+
+  int32_t len = buildGroupKeysFromBlock(pInfo->keyBuf, pKeyCols, numOfGroupCols, pBlock->info.rows, keyRow);
+  int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pInfo->keyBuf, len,
+                                        pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
+  if (ret != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
+  }
+
+  applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, numOfRows, totalRows,
+                                  pOperator->exprSupp.numOfExprs);
+  doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, totalRows, rowIndex);
+}
+
+// Aggregate a block by mapping all rows to their groups first. If the rows of a group are scattered over the block,
+// they are gathered by group so that each group is aggregated with a single call of the aggregate functions.
+static void doHashGroupbyAggBatch(SOperatorInfo* pOperator, SSDataBlock* pBlock, int32_t order, int32_t scanFlag) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupbyBatchInfo*    pBatch = &pInfo->batch;
+  int32_t               rows = pBlock->info.rows;
+  int32_t               numOfGroupCols = taosArrayGetSize(pInfo->pGroupCols);
+
+  int32_t code = ensureGroupbyBatchCapacity(pBatch, rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  if (pBatch->pKeyCols == NULL) {
+    pBatch->pKeyCols = taosMemoryCalloc(numOfGroupCols, POINTER_BYTES);
+    if (pBatch->pKeyCols == NULL) {
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+    }
+  }
+
+  SColumnInfoData** pKeyCols = pBatch->pKeyCols;
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumn* pCol = taosArrayGet(pInfo->pGroupCols, i);
+    pKeyCols[i] = taosArrayGet(pBlock->pDataBlock, pCol->slotId);
+  }
+
+  int32_t runs = assignGroupBatchSlots(pInfo, pBlock, pKeyCols, numOfGroupCols);
+  if (runs < 0) {
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+  }
+
+  // the groups are (almost) clustered, gathering the rows does not save any call
+  if (runs <= pBatch->numOfSlots * 2) {
+    int32_t start = 0;
+    for (int32_t j = 1; j <= rows; ++j) {
+      if (j == rows || pBatch->pRowSlot[j] != pBatch->pRowSlot[start]) {
+        applyAggOnGroupRows(pOperator, pBlock, pKeyCols, numOfGroupCols, start, start, j - start, rows);
+        start = j;
+      }
+    }
+    return;
+  }
+
+  // build the selection vector by a stable counting sort on the group slot
+  int32_t start = 0;
+  for (int32_t s = 0; s < pBatch->numOfSlots; ++s) {
+    pBatch->pSlots[s].start = start;
+    start += pBatch->pSlots[s].numOfRows;
+  }
+  for (int32_t j = 0; j < rows; ++j) {
+    pBatch->pSelection[pBatch->pSlots[pBatch->pRowSlot[j]].start++] = j;
+  }
+
+  if (pBatch->pGatherBlock == NULL ||
+      taosArrayGetSize(pBatch->pGatherBlock->pDataBlock) != taosArrayGetSize(pBlock->pDataBlock)) {
+    blockDataDestroy(pBatch->pGatherBlock);
+    pBatch->pGatherBlock = createOneDataBlock(pBlock, false);
+    if (pBatch->pGatherBlock == NULL) {
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+    }
+  }
+
+  code = gatherBlockRows(pBatch->pGatherBlock, pBlock, pBatch->pSelection);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  setInputDataBlock(&pOperator->exprSupp, pBatch->pGatherBlock, order, scanFlag, true);
+  for (int32_t s = 0; s < pBatch->numOfSlots; ++s) {
+    SGroupBatchSlot* pSlot = &pBatch->pSlots[s];
+    int32_t          rowIndex = pSlot->start - pSlot->numOfRows;
+    applyAggOnGroupRows(pOperator, pBlock, pKeyCols, numOfGroupCols, pSlot->firstRow, rowIndex, pSlot->numOfRows,
+                        rows);
+  }
+}
+
 static SSDataBlock* buildGroupResultDataBlock(SOperatorInfo* pOperator) {
   SGroupbyOperatorInfo* pInfo = pOperator->info;
 
@@ -407,7 +834,11 @@ static SSDataBlock* hashGroupbyAggregate(SOperatorInfo* pOperator) {
       }
     }
 
-    doHashGroupbyAgg(pOperator, pBlock);
+    if (isGroupbyBatchApplicable(pInfo, pBlock)) {
+      doHashGroupbyAggBatch(pOperator, pBlock, order, scanFlag);
+    } else {
+      doHashGroupbyAgg(pOperator, pBlock);
+    }
   }
 
   pOperator->status = OP_RES_TO_RETURN;
@@ -464,6 +895,13 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
     goto _error;
   }
 
+  if (taosArrayGetSize(pInfo->pGroupCols) == 1) {
+    SColumn* pCol = taosArrayGet(pInfo->pGroupCols, 0);
+    if (!IS_VAR_DATA_TYPE(pCol->type) && pCol->type != TSDB_DATA_TYPE_JSON && pCol->bytes <= sizeof(int64_t)) {
+      pInfo->batch.layout = GROUP_KEY_LAYOUT_INT;
+    }
+  }
+
   int32_t    num = 0;
   SExprInfo* pExprInfo = createExprInfo(pAggNode->pAggFuncs, pAggNode->pGroupKeys, &num);
   code = initAggSup(&pOperator->exprSupp, &pInfo->aggSup, pExprInfo, num, pInfo->groupKeyLen, pTaskInfo->id.str,
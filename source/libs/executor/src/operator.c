@@ -241,6 +241,17 @@ static ERetType doStopDataReader(SOperatorInfo* pOperator, STraverParam* pParam,
     if (pInfo->base.dataReader != NULL) {
       pAPI->tsdReader.tsdReaderNotifyClosing(pInfo->base.dataReader);
     }
+
+    if (pInfo->pParallel != NULL) {
+      atomic_store_8(&pInfo->pParallel->closing, 1);
+      int32_t numOfSegments = taosArrayGetSize(pInfo->pParallel->pSegments);
+      for (int32_t i = 0; i < numOfSegments; ++i) {
+        STableScanSegment* pSeg = taosArrayGetP(pInfo->pParallel->pSegments, i);
+        if (pSeg->dataReader != NULL) {
+          pAPI->tsdReader.tsdReaderNotifyClosing(pSeg->dataReader);
+        }
+      }
+    }
     return OPTR_FN_RET_ABORT;
   } else if (pOperator->operatorType == QUERY_NODE_PHYSICAL_PLAN_STREAM_SCAN) {
     SStreamScanInfo* pInfo = pOperator->info;
@@ -36,6 +36,8 @@
 #include "querytask.h"
 
 #include "storageapi.h"
+#include "tglobal.h"
+#include "tsched.h"
 #include "wal.h"
 
 int32_t scanDebug = 0;
@@ -44,6 +46,8 @@ int32_t scanDebug = 0;
 #define SET_REVERSE_SCAN_FLAG(_info) ((_info)->scanFlag = REVERSE_SCAN)
 #define SWITCH_ORDER(n)              (((n) = ((n) == TSDB_ORDER_ASC) ? TSDB_ORDER_DESC : TSDB_ORDER_ASC))
 #define STREAM_SCAN_OP_NAME          "StreamScanOperator"
+#define TABLE_SCAN_QUEUE_SIZE        10000
+#define TABLE_SCAN_SEGMENT_BUF_SIZE  (16 * 1048576)  // bytes buffered by one time range before its scan task yields
 
 typedef struct STableMergeScanExecInfo {
   SFileBlockLoadRecorder blockRecorder;
@@ -655,6 +659,383 @@ void setTbNameColData(const SSDataBlock* pBlock, SColumnInfoData* pColInfoData,
   colDataDestroy(&infoData);
 }
 
+static SSchedQueue tableScanQueue = {0};
+static int32_t     tableScanThreads = 0;
+
+int32_t qInitParallelScanPool() {
+  if (tableScanThreads > 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t numOfThreads = (int32_t)tsNumOfCores;
+  TRANGE(numOfThreads, 2, 64);
+  if (taosInitScheduler(TABLE_SCAN_QUEUE_SIZE, numOfThreads, "query-scan", &tableScanQueue) == NULL) {
+    qError("failed to init table scan pool, numOfThreads:%d", numOfThreads);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  tableScanThreads = numOfThreads;
+  return TSDB_CODE_SUCCESS;
+}
+
+void qCleanupParallelScanPool() {
+  if (tableScanThreads > 0) {
+    tableScanThreads = 0;
+    taosCleanUpScheduler(&tableScanQueue);
+  }
+}
+
+// The time ranges are read completely by the scan tasks, so only a single pass scan that loads every data block and
+// returns one group benefits from it. Other scans keep using one reader.
+static bool tableScanCanRunParallel(SOperatorInfo* pOperator) {
+  STableScanInfo* pInfo = pOperator->info;
+  SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
+
+  if (tsQueryParallelScan <= 1 || tableScanThreads <= 0 || pTaskInfo->execModel != OPTR_EXEC_MODEL_BATCH ||
+      pInfo->countOnly) {
+    return false;
+  }
+
+  if (pInfo->base.cond.type != TIMEWINDOW_RANGE_CONTAINED ||
+      pInfo->base.dataBlockLoadFlag != FUNC_DATA_REQUIRED_DATA_LOAD ||
+      pInfo->scanInfo.numOfAsc + pInfo->scanInfo.numOfDesc != 1) {
+    return false;
+  }
+
+  return tableListGetOutputGroups(pInfo->base.pTableListInfo) == 1 && pInfo->base.readHandle.vnode != NULL &&
+         pInfo->base.readerAPI.tsdReaderSplitTimeWindow != NULL;
+}
+
+static void doScanTableSegment(SSchedMsg* pMsg) {
+  STableScanSegment*  pSeg = pMsg->ahandle;
+  STableScanParallel* pParallel = pSeg->pParallel;
+  TsdReader*          pAPI = pParallel->pAPI;
+  int32_t             code = TSDB_CODE_SUCCESS;
+  bool                hasNext = true;
+
+  while (!atomic_load_8(&pParallel->closing)) {
+    taosThreadMutexLock(&pSeg->lock);
+    int64_t bufSize = pSeg->bufSize;
+    taosThreadMutexUnlock(&pSeg->lock);
+    if (bufSize >= TABLE_SCAN_SEGMENT_BUF_SIZE) {
+      break;
+    }
+
+    code = pAPI->tsdNextDataBlock(pSeg->dataReader, &hasNext);
+    if (code != TSDB_CODE_SUCCESS || !hasNext) {
+      break;
+    }
+
+    SSDataBlock* p = pAPI->tsdReaderRetrieveDataBlock(pSeg->dataReader, NULL);
+    if (p == NULL) {
+      code = terrno;
+      break;
+    }
+
+    SSDataBlock* pBlock = createOneDataBlock(p, true);
+    if (pBlock == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      break;
+    }
+
+    taosThreadMutexLock(&pSeg->lock);
+    taosArrayPush(pSeg->pBlocks, &pBlock);
+    pSeg->bufSize += blockDataGetSize(pBlock);
+    taosThreadCondSignal(&pSeg->cond);
+    taosThreadMutexUnlock(&pSeg->lock);
+  }
+
+  taosThreadMutexLock(&pSeg->lock);
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s failed to scan time range %" PRId64 "-%" PRId64 ", code:%s", pParallel->idStr, pSeg->window.skey,
+           pSeg->window.ekey, tstrerror(code));
+    pSeg->code = code;
+    pSeg->completed = true;
+  } else if (!hasNext) {
+    pSeg->completed = true;
+  }
+  pSeg->running = false;
+  taosThreadCondSignal(&pSeg->cond);
+  taosThreadMutexUnlock(&pSeg->lock);
+}
+
+// the lock of the segment is held by the caller
+static void scheduleSegmentScan(STableScanSegment* pSeg) {
+  if (pSeg->running || pSeg->completed) {
+    return;
+  }
+
+  SSchedMsg schedMsg = {.fp = doScanTableSegment, .ahandle = pSeg};
+  pSeg->running = true;
+  if (taosScheduleTask(&tableScanQueue, &schedMsg) != 0) {
+    pSeg->running = false;
+    pSeg->code = TSDB_CODE_QRY_SYS_ERROR;
+    pSeg->completed = true;
+  }
+}
+
+// wait for the next block of the time range, NULL is returned if it is exhausted or the scan is closing
+static int32_t takeSegmentBlock(STableScanParallel* pParallel, STableScanSegment* pSeg, SSDataBlock** ppBlock) {
+  *ppBlock = NULL;
+
+  taosThreadMutexLock(&pSeg->lock);
+  while (taosArrayGetSize(pSeg->pBlocks) == 0 && !pSeg->completed && !atomic_load_8(&pParallel->closing)) {
+    scheduleSegmentScan(pSeg);
+    if (pSeg->running) {
+      taosThreadCondWait(&pSeg->cond, &pSeg->lock);
+    }
+  }
+
+  int32_t code = pSeg->code;
+  if (taosArrayGetSize(pSeg->pBlocks) > 0) {
+    *ppBlock = taosArrayGetP(pSeg->pBlocks, 0);
+    taosArrayRemove(pSeg->pBlocks, 0);
+    pSeg->bufSize -= blockDataGetSize(*ppBlock);
+    code = TSDB_CODE_SUCCESS;
+
+    // keep the buffer filled while the upstream operators work on this block
+    if (pSeg->bufSize <= TABLE_SCAN_SEGMENT_BUF_SIZE / 2) {
+      scheduleSegmentScan(pSeg);
+    }
+  }
+  taosThreadMutexUnlock(&pSeg->lock);
+
+  return code;
+}
+
+void destroyParallelTableScan(STableScanParallel* pParallel) {
+  if (pParallel == NULL) {
+    return;
+  }
+
+  atomic_store_8(&pParallel->closing, 1);
+
+  int32_t numOfSegments = taosArrayGetSize(pParallel->pSegments);
+  for (int32_t i = 0; i < numOfSegments; ++i) {
+    STableScanSegment* pSeg = taosArrayGetP(pParallel->pSegments, i);
+
+    taosThreadMutexLock(&pSeg->lock);
+    while (pSeg->running) {
+      taosThreadCondWait(&pSeg->cond, &pSeg->lock);
+    }
+    taosThreadMutexUnlock(&pSeg->lock);
+
+    pParallel->pAPI->tsdReaderClose(pSeg->dataReader);
+    blockDataDestroy(pSeg->pResBlock);
+
+    int32_t numOfBlocks = taosArrayGetSize(pSeg->pBlocks);
+    for (int32_t j = 0; j < numOfBlocks; ++j) {
+      blockDataDestroy(taosArrayGetP(pSeg->pBlocks, j));
+    }
+    taosArrayDestroy(pSeg->pBlocks);
+
+    taosThreadCondDestroy(&pSeg->cond);
+    taosThreadMutexDestroy(&pSeg->lock);
+    taosMemoryFree(pSeg);
+  }
+
+  taosArrayDestroy(pParallel->pSegments);
+  blockDataDestroy(pParallel->pBlock);
+  taosMemoryFree(pParallel);
+}
+
+int32_t createParallelTableScan(TsdReader* pAPI, void* pVnode, const SQueryTableDataCond* pCond, STableKeyInfo* pList,
+                                int32_t num, SSDataBlock* pResBlock, const SArray* pWindows, int64_t version,
+                                const char* idStr, STableScanParallel** ppParallel) {
+  int32_t numOfWindows = taosArrayGetSize(pWindows);
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  *ppParallel = NULL;
+  STableScanParallel* pParallel = taosMemoryCalloc(1, sizeof(STableScanParallel));
+  if (pParallel == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pParallel->pAPI = pAPI;
+  pParallel->idStr = idStr;
+  pParallel->order = pCond->order;
+  pParallel->pSegments = taosArrayInit(numOfWindows, POINTER_BYTES);
+  if (pParallel->pSegments == NULL) {
+    taosMemoryFree(pParallel);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  // all readers read up to the same version, as if the data were read by one reader
+  SQueryTableDataCond cond = *pCond;
+  if (cond.endVersion == -1 || cond.endVersion > version) {
+    cond.endVersion = version;
+  }
+
+  for (int32_t i = 0; i < numOfWindows && code == TSDB_CODE_SUCCESS; ++i) {
+    STableScanSegment* pSeg = taosMemoryCalloc(1, sizeof(STableScanSegment));
+    if (pSeg == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      break;
+    }
+
+    pSeg->window = *(STimeWindow*)taosArrayGet(pWindows, i);
+    pSeg->pParallel = pParallel;
+    taosThreadMutexInit(&pSeg->lock, NULL);
+    taosThreadCondInit(&pSeg->cond, NULL);
+    taosArrayPush(pParallel->pSegments, &pSeg);
+
+    pSeg->pBlocks = taosArrayInit(4, POINTER_BYTES);
+    pSeg->pResBlock = createOneDataBlock(pResBlock, false);
+    if (pSeg->pBlocks == NULL || pSeg->pResBlock == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      break;
+    }
+
+    cond.twindows = pSeg->window;
+    code = pAPI->tsdReaderOpen(pVnode, &cond, pList, num, pSeg->pResBlock, (void**)&pSeg->dataReader, idStr, false,
+                               NULL);
+  }
+
+  if (code != TSDB_CODE_SUCCESS) {
+    destroyParallelTableScan(pParallel);
+    return code;
+  }
+
+  // all parts are scanned at once, each one runs ahead of the consumer until its buffer is full
+  for (int32_t i = 0; i < numOfWindows; ++i) {
+    STableScanSegment* pSeg = taosArrayGetP(pParallel->pSegments, i);
+    taosThreadMutexLock(&pSeg->lock);
+    scheduleSegmentScan(pSeg);
+    taosThreadMutexUnlock(&pSeg->lock);
+  }
+
+  *ppParallel = pParallel;
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t nextParallelTableScanBlock(STableScanParallel* pParallel, SSDataBlock** ppBlock) {
+  int32_t numOfSegments = taosArrayGetSize(pParallel->pSegments);
+
+  *ppBlock = NULL;
+  pParallel->pBlock = blockDataDestroy(pParallel->pBlock);
+
+  while (pParallel->current < numOfSegments) {
+    // the time ranges are disjoint, returning them one after another keeps the row order of a single reader
+    int32_t index = (pParallel->order == TSDB_ORDER_ASC) ? pParallel->current : numOfSegments - 1 - pParallel->current;
+    STableScanSegment* pSeg = taosArrayGetP(pParallel->pSegments, index);
+
+    int32_t code = takeSegmentBlock(pParallel, pSeg, &pParallel->pBlock);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+
+    if (pParallel->pBlock != NULL) {
+      *ppBlock = pParallel->pBlock;
+      return TSDB_CODE_SUCCESS;
+    }
+
+    pParallel->current += 1;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// Split the query time window at file set boundaries and open one reader for each part. pInfo->pParallel is left NULL
+// if the window can not be split, e.g. all data is in one file set.
+static int32_t openParallelTableScan(SOperatorInfo* pOperator, STableKeyInfo* pList, int32_t num) {
+  STableScanInfo* pInfo = pOperator->info;
+  SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
+  TsdReader*      pAPI = &pInfo->base.readerAPI;
+
+  SArray* pWindows = taosArrayInit(tsQueryParallelScan, sizeof(STimeWindow));
+  if (pWindows == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int64_t version = -1;
+  int32_t code = pAPI->tsdReaderSplitTimeWindow(pInfo->base.readHandle.vnode, &pInfo->base.cond.twindows,
+                                                tsQueryParallelScan, pWindows, &version);
+  int32_t numOfWindows = taosArrayGetSize(pWindows);
+  if (code == TSDB_CODE_SUCCESS && numOfWindows > 1) {
+    code = createParallelTableScan(pAPI, pInfo->base.readHandle.vnode, &pInfo->base.cond, pList, num, pInfo->pResBlock,
+                                   pWindows, version, GET_TASKID(pTaskInfo), &pInfo->pParallel);
+  }
+
+  taosArrayDestroy(pWindows);
+  if (code != TSDB_CODE_SUCCESS || pInfo->pParallel == NULL) {
+    return code;
+  }
+
+  STableScanSegment* pFirst = taosArrayGetP(pInfo->pParallel->pSegments, 0);
+  if (pFirst->pResBlock->info.capacity > pOperator->resultInfo.capacity) {
+    pOperator->resultInfo.capacity = pFirst->pResBlock->info.capacity;
+  }
+
+  qDebug("%s table scan is split into %d time ranges, tables:%d", GET_TASKID(pTaskInfo), numOfWindows, num);
+  return TSDB_CODE_SUCCESS;
+}
+
+static SSDataBlock* doParallelTableScan(SOperatorInfo* pOperator) {
+  STableScanInfo*         pInfo = pOperator->info;
+  SExecTaskInfo*          pTaskInfo = pOperator->pTaskInfo;
+  STableScanParallel*     pParallel = pInfo->pParallel;
+  SFileBlockLoadRecorder* pCost = &pInfo->base.readRecorder;
+
+  int64_t st = taosGetTimestampUs();
+
+  while (pOperator->status != OP_EXEC_DONE) {
+    SSDataBlock* pBlock = NULL;
+    int32_t      code = nextParallelTableScanBlock(pParallel, &pBlock);
+    if (code != TSDB_CODE_SUCCESS) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    if (isTaskKilled(pTaskInfo)) {
+      T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
+    }
+
+    if (pBlock == NULL) {
+      break;
+    }
+
+    pCost->totalBlocks += 1;
+    pCost->loadBlocks += 1;
+    pCost->totalRows += pBlock->info.rows;
+    pCost->totalCheckedRows += pBlock->info.rows;
+
+    if (!processBlockWithProbability(&pInfo->sample)) {
+      continue;
+    }
+
+    if (pBlock->info.id.uid) {
+      pBlock->info.id.groupId = getTableGroupId(pInfo->base.pTableListInfo, pBlock->info.id.uid);
+    }
+
+    doSetTagColumnData(&pInfo->base, pBlock, pTaskInfo, pBlock->info.rows);
+
+    if (pOperator->exprSupp.pFilterInfo != NULL) {
+      int64_t st1 = taosGetTimestampUs();
+      doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pInfo->base.matchInfo);
+      pCost->filterTime += (taosGetTimestampUs() - st1) / 1000.0;
+
+      if (pBlock->info.rows == 0) {
+        pCost->filterOutBlocks += 1;
+        continue;
+      }
+    }
+
+    if (applyLimitOffset(&pInfo->base.limitInfo, pBlock, pTaskInfo)) {
+      setOperatorCompleted(pOperator);
+    }
+
+    if (pBlock->info.rows == 0) {
+      continue;
+    }
+
+    pOperator->resultInfo.totalRows = pCost->totalRows;
+    pCost->elapsedTime += (taosGetTimestampUs() - st) / 1000.0;
+    pOperator->cost.totalCost = pCost->elapsedTime;
+    return pBlock;
+  }
+
+  return NULL;
+}
+
 static SSDataBlock* doTableScanImpl(SOperatorInfo* pOperator) {
   STableScanInfo* pTableScanInfo = pOperator->info;
   SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
@@ -726,6 +1107,10 @@ static SSDataBlock* doGroupedTableScan(SOperatorInfo* pOperator) {
   SExecTaskInfo*  pTaskInfo = pOperator->pTaskInfo;
   SStorageAPI* pAPI = &pTaskInfo->storageAPI;
 
+  if (pTableScanInfo->pParallel != NULL) {
+    return doParallelTableScan(pOperator);
+  }
+
   // The read handle is not initialized yet, since no qualified tables exists
   if (pTableScanInfo->base.dataReader == NULL || pOperator->status == OP_EXEC_DONE) {
     return NULL;
@@ -832,14 +1217,23 @@ static SSDataBlock* doTableScan(SOperatorInfo* pOperator) {
       tableListGetGroupList(pInfo->base.pTableListInfo, pInfo->currentGroupId, &pList, &num);
       ASSERT(pInfo->base.dataReader == NULL);
 
-      int32_t code = pAPI->tsdReader.tsdReaderOpen(pInfo->base.readHandle.vnode, &pInfo->base.cond, pList, num, pInfo->pResBlock,
-                                    (void**)&pInfo->base.dataReader, GET_TASKID(pTaskInfo), pInfo->countOnly, &pInfo->pIgnoreTables);
-      if (code != TSDB_CODE_SUCCESS) {
-        T_LONG_JMP(pTaskInfo->env, code);
+      if (tableScanCanRunParallel(pOperator)) {
+        int32_t code = openParallelTableScan(pOperator, pList, num);
+        if (code != TSDB_CODE_SUCCESS) {
+          T_LONG_JMP(pTaskInfo->env, code);
+        }
       }
 
-      if (pInfo->pResBlock->info.capacity > pOperator->resultInfo.capacity) {
-        pOperator->resultInfo.capacity = pInfo->pResBlock->info.capacity;
+      if (pInfo->pParallel == NULL) {
+        int32_t code = pAPI->tsdReader.tsdReaderOpen(pInfo->base.readHandle.vnode, &pInfo->base.cond, pList, num, pInfo->pResBlock,
+                                      (void**)&pInfo->base.dataReader, GET_TASKID(pTaskInfo), pInfo->countOnly, &pInfo->pIgnoreTables);
+        if (code != TSDB_CODE_SUCCESS) {
+          T_LONG_JMP(pTaskInfo->env, code);
+        }
+
+        if (pInfo->pResBlock->info.capacity > pOperator->resultInfo.capacity) {
+          pOperator->resultInfo.capacity = pInfo->pResBlock->info.capacity;
+        }
       }
     }
 
@@ -901,6 +1295,7 @@ static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
 
 static void destroyTableScanOperatorInfo(void* param) {
   STableScanInfo* pTableScanInfo = (STableScanInfo*)param;
+  destroyParallelTableScan(pTableScanInfo->pParallel);
   blockDataDestroy(pTableScanInfo->pResBlock);
   taosHashCleanup(pTableScanInfo->pIgnoreTables);
   destroyTableScanBase(&pTableScanInfo->base, &pTableScanInfo->base.readerAPI);
@@ -2851,6 +3246,7 @@ int32_t stopGroupTableMergeScan(SOperatorInfo* pOperator) {
   pInfo->sortExecInfo.loops += sortExecInfo.loops;
   pInfo->sortExecInfo.readBytes += sortExecInfo.readBytes;
   pInfo->sortExecInfo.writeBytes += sortExecInfo.writeBytes;
+  pInfo->sortExecInfo.stallTime += sortExecInfo.stallTime;
 
   for (int32_t i = 0; i < numOfTable; ++i) {
     STableMergeScanSortSourceParam* param = taosArrayGet(pInfo->sortSourceParams, i);
@@ -69,6 +69,14 @@ typedef struct SPullWindowInfo {
   STimeWindow calWin;
 } SPullWindowInfo;
 
+// the rows of one time window in the current block, and the result row of the window
+typedef struct SIntervalWinRange {
+  STimeWindow        win;
+  SResultRowPosition pos;
+  int32_t            startPos;
+  int32_t            numOfRows;
+} SIntervalWinRange;
+
 typedef struct SOpenWindowInfo {
   SResultRowPosition pos;
   uint64_t           groupId;
@@ -874,9 +882,94 @@ bool needDeleteWindowBuf(STimeWindow* pWin, STimeWindowAggSupp* pTwSup) {
   return pTwSup->maxTs != INT64_MIN && pWin->ekey < pTwSup->maxTs - pTwSup->deleteMark;
 }
 
+// Without interpolation the windows of a block do not depend on each other. The boundaries and the result rows of all
+// the windows are set up first, then each function runs over all the windows in turn, so that one kernel and its input
+// column stay hot instead of switching between the functions for every window.
+static void hashIntervalAggOnWindows(SOperatorInfo* pOperatorInfo, SResultRowInfo* pResultRowInfo, SSDataBlock* pBlock,
+                                     int32_t scanFlag) {
+  SIntervalAggOperatorInfo* pInfo = (SIntervalAggOperatorInfo*)pOperatorInfo->info;
+
+  SExecTaskInfo* pTaskInfo = pOperatorInfo->pTaskInfo;
+  SExprSupp*     pSup = &pOperatorInfo->exprSupp;
+  SDiskbasedBuf* pResultBuf = pInfo->aggSup.pResultBuf;
+
+  int32_t     startPos = 0;
+  int32_t     numOfOutput = pSup->numOfExprs;
+  int64_t*    tsCols = extractTsCol(pBlock, pInfo);
+  uint64_t    tableGroupId = pBlock->info.id.groupId;
+  bool        ascScan = (pInfo->inputOrder == TSDB_ORDER_ASC);
+  TSKEY       ts = getStartTsKey(&pBlock->info.window, tsCols);
+  SResultRow* pResult = NULL;
+
+  taosArrayClear(pInfo->pWinRanges);
+
+  STimeWindow win = getActiveTimeWindow(pResultBuf, pResultRowInfo, ts, &pInfo->interval, pInfo->inputOrder);
+  while (startPos >= 0) {
+    int32_t code = setTimeWindowOutputBuf(pResultRowInfo, &win, (scanFlag == MAIN_SCAN), &pResult, tableGroupId,
+                                          pSup->pCtx, numOfOutput, pSup->rowEntryInfoOffset, &pInfo->aggSup, pTaskInfo);
+    if (code != TSDB_CODE_SUCCESS || pResult == NULL) {
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+    }
+
+    // only the position is kept, the page of the result row may be evicted by the result rows of the later windows
+    TSKEY             ekey = ascScan ? win.ekey : win.skey;
+    SIntervalWinRange range = {.win = win, .pos = {.pageId = pResult->pageId, .offset = pResult->offset}};
+    range.startPos = startPos;
+    range.numOfRows =
+        getNumOfRowsInTimeWindow(&pBlock->info, tsCols, startPos, ekey, binarySearchForKey, NULL, pInfo->inputOrder);
+    if (taosArrayPush(pInfo->pWinRanges, &range) == NULL) {
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+    }
+
+    int32_t prevEndPos = range.numOfRows - 1 + startPos;
+    startPos = getNextQualifiedWindow(&pInfo->interval, &win, &pBlock->info, tsCols, prevEndPos, pInfo->inputOrder);
+  }
+
+  // the page of the current result row stays referenced as it is on the per window path, the others are released
+  int32_t numOfWins = taosArrayGetSize(pInfo->pWinRanges);
+  for (int32_t k = 0; k < numOfOutput; ++k) {
+    SqlFunctionCtx* pCtx = &pSup->pCtx[k];
+    SFilePage*      pPage = NULL;
+    int32_t         pageId = -1;
+
+    for (int32_t i = 0; i < numOfWins; ++i) {
+      SIntervalWinRange* pRange = taosArrayGet(pInfo->pWinRanges, i);
+      if (pPage == NULL || pageId != pRange->pos.pageId) {
+        if (pPage != NULL && pageId != pResultRowInfo->cur.pageId) {
+          releaseBufPage(pResultBuf, pPage);
+        }
+
+        pageId = pRange->pos.pageId;
+        pPage = getBufPage(pResultBuf, pageId);
+        if (pPage == NULL) {
+          qError("failed to get buffer, code:%s, %s", tstrerror(terrno), GET_TASKID(pTaskInfo));
+          T_LONG_JMP(pTaskInfo->env, terrno);
+        }
+        setBufPageDirty(pPage, true);
+      }
+
+      pResult = (SResultRow*)((char*)pPage + pRange->pos.offset);
+      pCtx->resultInfo = getResultEntryInfo(pResult, k, pSup->rowEntryInfoOffset);
+      if (pCtx->isPseudoFunc) {
+        updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &pRange->win, true);
+      }
+      applyAggFunctionOnTuples(pTaskInfo, pCtx, &pInfo->twAggSup.timeWindowData, pRange->startPos, pRange->numOfRows,
+                               pBlock->info.rows);
+    }
+
+    if (pPage != NULL && pageId != pResultRowInfo->cur.pageId) {
+      releaseBufPage(pResultBuf, pPage);
+    }
+  }
+}
+
 static void hashIntervalAgg(SOperatorInfo* pOperatorInfo, SResultRowInfo* pResultRowInfo, SSDataBlock* pBlock,
                             int32_t scanFlag) {
   SIntervalAggOperatorInfo* pInfo = (SIntervalAggOperatorInfo*)pOperatorInfo->info;
+  if (!pInfo->timeWindowInterpo) {
+    hashIntervalAggOnWindows(pOperatorInfo, pResultRowInfo, pBlock, scanFlag);
+    return;
+  }
 
   SExecTaskInfo* pTaskInfo = pOperatorInfo->pTaskInfo;
   SExprSupp*     pSup = &pOperatorInfo->exprSupp;
@@ -1486,6 +1579,7 @@ void destroyIntervalOperatorInfo(void* param) {
   tdListFree(pInfo->binfo.resultRowInfo.openWindow);
 
   pInfo->pInterpCols = taosArrayDestroy(pInfo->pInterpCols);
+  pInfo->pWinRanges = taosArrayDestroy(pInfo->pWinRanges);
   taosArrayDestroyEx(pInfo->pPrevValues, freeItem);
 
   pInfo->pPrevValues = NULL;
@@ -1679,6 +1773,11 @@ SOperatorInfo* createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPh
     }
   }
 
+  pInfo->pWinRanges = taosArrayInit(4, sizeof(SIntervalWinRange));
+  if (pInfo->pWinRanges == NULL) {
+    goto _error;
+  }
+
   initResultRowInfo(&pInfo->binfo.resultRowInfo);
   setOperatorInfo(pOperator, "TimeIntervalAggOperator", QUERY_NODE_PHYSICAL_PLAN_HASH_INTERVAL, true, OP_NOT_OPENED,
                   pInfo, pTaskInfo);
@@ -258,6 +258,14 @@ static void setCurrentSourceDone(SSortSource* pSource, SSortHandle* pHandle) {
   ++pHandle->numOfCompletedSources;
 }
 
+// the next page of a source is needed once the current one is merged, read it ahead in background
+static void prefetchNextSourcePage(SSortHandle* pHandle, SSortSource* pSource) {
+  int32_t next = pSource->pageIndex + 1;
+  if (next < taosArrayGetSize(pSource->pageIdList)) {
+    dBufPrefetchPages(pHandle->pBuf, taosArrayGet(pSource->pageIdList, next), 1);
+  }
+}
+
 static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32_t startIndex, int32_t endIndex,
                               SSortHandle* pHandle) {
   pParam->pSources = taosArrayGet(pSources, startIndex);
@@ -306,6 +314,7 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
       }
 
       releaseBufPage(pHandle->pBuf, pPage);
+      prefetchNextSourcePage(pHandle, pSource);
     }
   } else {
     qDebug("start init for the multiway merge sort, %s", pHandle->idStr);
@@ -378,6 +387,7 @@ static int32_t adjustMergeTreeForNextTuple(SSortSource* pSource, SMultiwayMergeT
         }
 
         releaseBufPage(pHandle->pBuf, pPage);
+        prefetchNextSourcePage(pHandle, pSource);
       }
     } else {
       int64_t st = taosGetTimestampUs();      
@@ -921,6 +931,7 @@ SSortExecInfo tsortGetSortExecInfo(SSortHandle* pHandle) {
       SDiskbasedBufStatis st = getDBufStatis(pHandle->pBuf);
       info.writeBytes = st.flushBytes;
       info.readBytes = st.loadBytes;
+      info.stallTime = st.stallTime;
     }
   }
 
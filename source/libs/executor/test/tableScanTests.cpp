@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#include "os.h"
+
+#include "executor.h"
+#include "executorInt.h"
+#include "tdatablock.h"
+
+namespace {
+
+// a tsdb reader on the rows [0, numOfRows) of one table, one row per timestamp, 100 rows per block
+const int64_t numOfRows = 4000;
+const int32_t rowsPerBlock = 100;
+const int64_t failKey = -1000;  // the reader of the time range starting at it fails
+
+typedef struct SDummyReader {
+  STimeWindow  w;
+  int32_t      order;
+  int64_t      next;
+  SSDataBlock* pResBlock;
+} SDummyReader;
+
+int64_t openedVersion = 0;
+
+int32_t dummyReaderOpen(void* pVnode, SQueryTableDataCond* pCond, void* pTableList, int32_t numOfTables,
+                        SSDataBlock* pResBlock, void** ppReader, const char* idstr, bool countOnly,
+                        SHashObj** pIgnoreTables) {
+  SDummyReader* p = static_cast<SDummyReader*>(taosMemoryCalloc(1, sizeof(SDummyReader)));
+  p->w = pCond->twindows;
+  p->order = pCond->order;
+  p->next = (pCond->order == TSDB_ORDER_ASC) ? TMAX(p->w.skey, 0) : TMIN(p->w.ekey, numOfRows - 1);
+  p->pResBlock = pResBlock;
+  blockDataEnsureCapacity(pResBlock, rowsPerBlock);
+
+  openedVersion = pCond->endVersion;
+  *ppReader = p;
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t dummyNextDataBlock(SDummyReader* p, bool* hasNext) {
+  if (p->w.skey == failKey) {
+    return TSDB_CODE_FAILED;
+  }
+
+  blockDataCleanup(p->pResBlock);
+  SColumnInfoData* pCol = static_cast<SColumnInfoData*>(taosArrayGet(p->pResBlock->pDataBlock, 0));
+
+  int32_t rows = 0;
+  bool    asc = (p->order == TSDB_ORDER_ASC);
+  while (rows < rowsPerBlock && p->next >= TMAX(p->w.skey, 0) && p->next <= TMIN(p->w.ekey, numOfRows - 1)) {
+    colDataSetVal(pCol, rows++, reinterpret_cast<const char*>(&p->next), false);
+    p->next += asc ? 1 : -1;
+  }
+
+  p->pResBlock->info.rows = rows;
+  *hasNext = (rows > 0);
+  return TSDB_CODE_SUCCESS;
+}
+
+SSDataBlock* dummyRetrieveDataBlock(SDummyReader* p, SArray* pIdList) { return p->pResBlock; }
+
+void dummyReaderClose(SDummyReader* p) { taosMemoryFree(p); }
+
+TsdReader getDummyReaderAPI() {
+  TsdReader api = {0};
+  api.tsdReaderOpen = dummyReaderOpen;
+  api.tsdNextDataBlock = reinterpret_cast<int32_t (*)()>(dummyNextDataBlock);
+  api.tsdReaderRetrieveDataBlock = reinterpret_cast<SSDataBlock* (*)()>(dummyRetrieveDataBlock);
+  api.tsdReaderClose = reinterpret_cast<void (*)()>(dummyReaderClose);
+  return api;
+}
+
+SArray* createWindows(int64_t skey, int64_t step, int32_t num) {
+  SArray* pWindows = taosArrayInit(num, sizeof(STimeWindow));
+  for (int32_t i = 0; i < num; ++i) {
+    STimeWindow w = {.skey = skey + i * step, .ekey = skey + (i + 1) * step - 1};
+    taosArrayPush(pWindows, &w);
+  }
+  return pWindows;
+}
+
+SSDataBlock* createTsBlock() {
+  SSDataBlock*    pBlock = createDataBlock();
+  SColumnInfoData colInfo = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), 1);
+  blockDataAppendColInfo(pBlock, &colInfo);
+  return pBlock;
+}
+
+bool allSegmentsCompleted(STableScanParallel* pParallel) {
+  bool completed = true;
+  for (int32_t i = 0; i < taosArrayGetSize(pParallel->pSegments); ++i) {
+    STableScanSegment* pSeg = static_cast<STableScanSegment*>(taosArrayGetP(pParallel->pSegments, i));
+    taosThreadMutexLock(&pSeg->lock);
+    completed = completed && pSeg->completed && !pSeg->running;
+    taosThreadMutexUnlock(&pSeg->lock);
+  }
+  return completed;
+}
+
+// every row is returned once, in the order of the scan, whether the time ranges are read ahead or not
+void parallelScanTest(int32_t order, int32_t numOfWindows, bool waitReadAhead) {
+  TsdReader           api = getDummyReaderAPI();
+  SQueryTableDataCond cond = {0};
+  cond.order = order;
+  cond.endVersion = -1;
+
+  // the last time range has no data
+  SArray*      pWindows = createWindows(0, (numOfRows + numOfWindows - 2) / (numOfWindows - 1), numOfWindows);
+  SSDataBlock* pResBlock = createTsBlock();
+
+  STableScanParallel* pParallel = NULL;
+  ASSERT_EQ(createParallelTableScan(&api, NULL, &cond, NULL, 0, pResBlock, pWindows, 100, "parallelScanTest",
+                                    &pParallel),
+            TSDB_CODE_SUCCESS);
+  ASSERT_TRUE(pParallel != NULL);
+  ASSERT_EQ(openedVersion, 100);
+
+  // the time ranges after the current one keep running until their buffers are full
+  if (waitReadAhead) {
+    for (int32_t i = 0; i < 1000 && !allSegmentsCompleted(pParallel); ++i) {
+      taosMsleep(10);
+    }
+    ASSERT_TRUE(allSegmentsCompleted(pParallel));
+  }
+
+  int64_t      expect = (order == TSDB_ORDER_ASC) ? 0 : numOfRows - 1;
+  int64_t      total = 0;
+  SSDataBlock* pBlock = NULL;
+  while (true) {
+    ASSERT_EQ(nextParallelTableScanBlock(pParallel, &pBlock), TSDB_CODE_SUCCESS);
+    if (pBlock == NULL) {
+      break;
+    }
+
+    SColumnInfoData* pCol = static_cast<SColumnInfoData*>(taosArrayGet(pBlock->pDataBlock, 0));
+    for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+      ASSERT_EQ(*reinterpret_cast<int64_t*>(colDataGetData(pCol, i)), expect);
+      expect += (order == TSDB_ORDER_ASC) ? 1 : -1;
+    }
+    total += pBlock->info.rows;
+  }
+
+  ASSERT_EQ(total, numOfRows);
+  ASSERT_EQ(nextParallelTableScanBlock(pParallel, &pBlock), TSDB_CODE_SUCCESS);
+  ASSERT_TRUE(pBlock == NULL);
+
+  destroyParallelTableScan(pParallel);
+  blockDataDestroy(pResBlock);
+  taosArrayDestroy(pWindows);
+}
+
+}  // namespace
+
+TEST(tableScanTest, parallelScanOrder) {
+  ASSERT_EQ(qInitParallelScanPool(), TSDB_CODE_SUCCESS);
+
+  parallelScanTest(TSDB_ORDER_ASC, 2, false);
+  parallelScanTest(TSDB_ORDER_ASC, 5, false);
+  parallelScanTest(TSDB_ORDER_DESC, 2, false);
+  parallelScanTest(TSDB_ORDER_DESC, 5, false);
+}
+
+TEST(tableScanTest, parallelScanReadAhead) {
+  ASSERT_EQ(qInitParallelScanPool(), TSDB_CODE_SUCCESS);
+
+  parallelScanTest(TSDB_ORDER_ASC, 5, true);
+  parallelScanTest(TSDB_ORDER_DESC, 5, true);
+}
+
+TEST(tableScanTest, parallelScanError) {
+  ASSERT_EQ(qInitParallelScanPool(), TSDB_CODE_SUCCESS);
+
+  TsdReader           api = getDummyReaderAPI();
+  SQueryTableDataCond cond = {0};
+  cond.order = TSDB_ORDER_ASC;
+  cond.endVersion = 50;
+
+  // the first time range has no data, the error of the second one is returned once it is the current one
+  SArray*      pWindows = createWindows(failKey - numOfRows, numOfRows, 2);
+  SSDataBlock* pResBlock = createTsBlock();
+
+  STableScanParallel* pParallel = NULL;
+  ASSERT_EQ(createParallelTableScan(&api, NULL, &cond, NULL, 0, pResBlock, pWindows, 100, "parallelScanError",
+                                    &pParallel),
+            TSDB_CODE_SUCCESS);
+  ASSERT_EQ(openedVersion, 50);
+
+  SSDataBlock* pBlock = NULL;
+  ASSERT_EQ(nextParallelTableScanBlock(pParallel, &pBlock), TSDB_CODE_FAILED);
+
+  destroyParallelTableScan(pParallel);
+  blockDataDestroy(pResBlock);
+  taosArrayDestroy(pWindows);
+  qCleanupParallelScanPool();
+}
+
+#pragma GCC diagnostic pop
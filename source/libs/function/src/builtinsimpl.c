@@ -321,16 +321,27 @@ typedef struct SGroupKeyInfo {
     }                                                                    \
   } while (0)
 
-#define LIST_ADD_N(_res, _col, _start, _rows, _t, numOfElem)             \
-  do {                                                                   \
-    _t* d = (_t*)(_col->pData);                                          \
-    for (int32_t i = (_start); i < (_rows) + (_start); ++i) {            \
-      if (((_col)->hasNull) && colDataIsNull_f((_col)->nullbitmap, i)) { \
-        continue;                                                        \
-      };                                                                 \
-      (_res) += (d)[i];                                                  \
-      (numOfElem)++;                                                     \
-    }                                                                    \
+// sum up in a local of the result type _rt, so the loop does not store to the result buffer on every row, and split the
+// no null case out of the loop so that it can be vectorized. The rows are still added in order, from the current sum.
+#define LIST_ADD_N(_res, _rt, _col, _start, _rows, _t, numOfElem)    \
+  do {                                                               \
+    const _t* d = (const _t*)((_col)->pData);                        \
+    _rt       s = (_res);                                            \
+    if (!(_col)->hasNull) {                                          \
+      for (int32_t i = (_start); i < (_rows) + (_start); ++i) {      \
+        s += d[i];                                                   \
+      }                                                              \
+      (numOfElem) += (_rows);                                        \
+    } else {                                                         \
+      for (int32_t i = (_start); i < (_rows) + (_start); ++i) {      \
+        if (colDataIsNull_f((_col)->nullbitmap, i)) {                \
+          continue;                                                  \
+        }                                                            \
+        s += d[i];                                                   \
+        (numOfElem)++;                                               \
+      }                                                              \
+    }                                                                \
+    (_res) = s;                                                      \
   } while (0)
 
 #define LIST_SUB_N(_res, _col, _start, _rows, _t, numOfElem)             \
@@ -606,28 +617,28 @@ int32_t sumFunction(SqlFunctionCtx* pCtx) {
 
     if (IS_SIGNED_NUMERIC_TYPE(type) || type == TSDB_DATA_TYPE_BOOL) {
       if (type == TSDB_DATA_TYPE_TINYINT || type == TSDB_DATA_TYPE_BOOL) {
-        LIST_ADD_N(pSumRes->isum, pCol, start, numOfRows, int8_t, numOfElem);
+        LIST_ADD_N(pSumRes->isum, int64_t, pCol, start, numOfRows, int8_t, numOfElem);
       } else if (type == TSDB_DATA_TYPE_SMALLINT) {
-        LIST_ADD_N(pSumRes->isum, pCol, start, numOfRows, int16_t, numOfElem);
+        LIST_ADD_N(pSumRes->isum, int64_t, pCol, start, numOfRows, int16_t, numOfElem);
       } else if (type == TSDB_DATA_TYPE_INT) {
-        LIST_ADD_N(pSumRes->isum, pCol, start, numOfRows, int32_t, numOfElem);
+        LIST_ADD_N(pSumRes->isum, int64_t, pCol, start, numOfRows, int32_t, numOfElem);
       } else if (type == TSDB_DATA_TYPE_BIGINT) {
-        LIST_ADD_N(pSumRes->isum, pCol, start, numOfRows, int64_t, numOfElem);
+        LIST_ADD_N(pSumRes->isum, int64_t, pCol, start, numOfRows, int64_t, numOfElem);
       }
     } else if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
       if (type == TSDB_DATA_TYPE_UTINYINT) {
-        LIST_ADD_N(pSumRes->usum, pCol, start, numOfRows, uint8_t, numOfElem);
+        LIST_ADD_N(pSumRes->usum, uint64_t, pCol, start, numOfRows, uint8_t, numOfElem);
       } else if (type == TSDB_DATA_TYPE_USMALLINT) {
-        LIST_ADD_N(pSumRes->usum, pCol, start, numOfRows, uint16_t, numOfElem);
+        LIST_ADD_N(pSumRes->usum, uint64_t, pCol, start, numOfRows, uint16_t, numOfElem);
       } else if (type == TSDB_DATA_TYPE_UINT) {
-        LIST_ADD_N(pSumRes->usum, pCol, start, numOfRows, uint32_t, numOfElem);
+        LIST_ADD_N(pSumRes->usum, uint64_t, pCol, start, numOfRows, uint32_t, numOfElem);
       } else if (type == TSDB_DATA_TYPE_UBIGINT) {
-        LIST_ADD_N(pSumRes->usum, pCol, start, numOfRows, uint64_t, numOfElem);
+        LIST_ADD_N(pSumRes->usum, uint64_t, pCol, start, numOfRows, uint64_t, numOfElem);
       }
     } else if (type == TSDB_DATA_TYPE_DOUBLE) {
-      LIST_ADD_N(pSumRes->dsum, pCol, start, numOfRows, double, numOfElem);
+      LIST_ADD_N(pSumRes->dsum, double, pCol, start, numOfRows, double, numOfElem);
     } else if (type == TSDB_DATA_TYPE_FLOAT) {
-      LIST_ADD_N(pSumRes->dsum, pCol, start, numOfRows, float, numOfElem);
+      LIST_ADD_N(pSumRes->dsum, double, pCol, start, numOfRows, float, numOfElem);
     }
   }
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TD_INDEX_BITMAP_H_
+#define _TD_INDEX_BITMAP_H_
+
+#include "os.h"
+#include "tarray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * compressed uid bitmap, roaring style
+ *
+ * uids are split by the high 48 bits into containers that are kept sorted by key, the low 16 bits of
+ * the uids are stored in the container either as a sorted uint16_t array (sparse) or as a 65536 bits
+ * bitmap (dense), the container switches between the two forms according to its cardinality
+ */
+#define IDX_BM_ARRAY_MAX_CARD 4096
+#define IDX_BM_BITMAP_WORDS   1024
+
+typedef enum { IDX_BM_ARRAY = 0, IDX_BM_BITMAP } EIdxBmContainerType;
+
+typedef struct SIdxBmContainer {
+  uint64_t key;   // high 48 bits of the uid
+  int8_t   type;  // EIdxBmContainerType
+  int32_t  card;  // number of uids in the container
+  int32_t  cap;   // capacity of the array container
+  union {
+    uint16_t* vals;   // IDX_BM_ARRAY, sorted
+    uint64_t* words;  // IDX_BM_BITMAP, IDX_BM_BITMAP_WORDS words
+  };
+} SIdxBmContainer;
+
+typedef struct SIdxBitmap {
+  int32_t          num;
+  int32_t          cap;
+  SIdxBmContainer* pCont;
+} SIdxBitmap;
+
+SIdxBitmap* idxBitmapCreate();
+void        idxBitmapDestroy(SIdxBitmap* pBm);
+void        idxBitmapClear(SIdxBitmap* pBm);
+SIdxBitmap* idxBitmapClone(const SIdxBitmap* pBm);
+
+int32_t idxBitmapAdd(SIdxBitmap* pBm, uint64_t uid);
+bool    idxBitmapContains(const SIdxBitmap* pBm, uint64_t uid);
+int64_t idxBitmapCardinality(const SIdxBitmap* pBm);
+
+/*
+ * add all uids of the array(element is uint64_t) into the bitmap, the array needn't be sorted
+ */
+int32_t idxBitmapAddArray(SIdxBitmap* pBm, const SArray* uids);
+
+/*
+ * append the uids in ascending order to the array(element is uint64_t)
+ */
+int32_t idxBitmapToArray(const SIdxBitmap* pBm, SArray* uids);
+
+/*
+ * in place set operations, the result is saved in pDst
+ */
+int32_t idxBitmapAnd(SIdxBitmap* pDst, const SIdxBitmap* pSrc);
+int32_t idxBitmapOr(SIdxBitmap* pDst, const SIdxBitmap* pSrc);
+int32_t idxBitmapAndNot(SIdxBitmap* pDst, const SIdxBitmap* pSrc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TD_INDEX_BITMAP_H_*/
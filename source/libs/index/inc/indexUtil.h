@@ -59,7 +59,7 @@ extern "C" {
     }                                                 \
   }
 
-/* multi sorted result intersection
+/* multi result intersection, the inputs needn't be sorted and the output is sorted and unique
  * input: [1, 2, 4, 5]
  *        [2, 3, 4, 5]
  *        [1, 4, 5]
@@ -67,7 +67,7 @@ extern "C" {
  */
 void iIntersection(SArray *in, SArray *out);
 
-/* multi sorted result union
+/* multi result union, the inputs needn't be sorted and the output is sorted and unique
  * input: [1, 2, 4, 5]
  *        [2, 3, 4, 5]
  *        [1, 4, 5]
@@ -458,13 +458,7 @@ static void idxInterRsltDestroy(SArray* results) {
 }
 
 static int idxMergeFinalResults(SArray* in, EIndexOperatorType oType, SArray* out) {
-  // refactor, merge interResults into fResults by oType
-  for (int i = 0; i < taosArrayGetSize(in); i--) {
-    SArray* t = taosArrayGetP(in, i);
-    taosArraySort(t, uidCompare);
-    taosArrayRemoveDuplicate(t, uidCompare, NULL);
-  }
-
+  // merge interResults into fResults by oType, the bitmap based merge needs neither sort nor dedup
   if (oType == MUST) {
     iIntersection(in, out);
   } else if (oType == SHOULD) {
@@ -0,0 +1,680 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "indexBitmap.h"
+#include "taoserror.h"
+
+#define IDX_BM_KEY(uid) ((uid) >> 16)
+#define IDX_BM_LOW(uid) ((uint16_t)((uid)&0xFFFF))
+
+#define IDX_BM_TEST_BIT(words, v) (((words)[(v) >> 6] >> ((v)&63)) & 1)
+#define IDX_BM_SET_BIT(words, v)  ((words)[(v) >> 6] |= ((uint64_t)1 << ((v)&63)))
+#define IDX_BM_CLR_BIT(words, v)  ((words)[(v) >> 6] &= ~((uint64_t)1 << ((v)&63)))
+
+static FORCE_INLINE int32_t idxBmPopcnt(uint64_t w) {
+#ifdef WINDOWS
+  w = w - ((w >> 1) & 0x5555555555555555ULL);
+  w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+  w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int32_t)((w * 0x0101010101010101ULL) >> 56);
+#else
+  return __builtin_popcountll(w);
+#endif
+}
+
+static int32_t idxBmWordsCard(const uint64_t* words) {
+  int32_t card = 0;
+  for (int32_t i = 0; i < IDX_BM_BITMAP_WORDS; ++i) {
+    card += idxBmPopcnt(words[i]);
+  }
+  return card;
+}
+
+// word wise set operations of two bitmap containers, return the cardinality of the result
+static int32_t idxBmWordsAnd(uint64_t* dst, const uint64_t* src) {
+#if __AVX2__
+  if (tsAVX2Enable && tsSIMDBuiltins) {
+    for (int32_t i = 0; i < IDX_BM_BITMAP_WORDS; i += 4) {
+      __m256i a = _mm256_loadu_si256((__m256i*)(dst + i));
+      __m256i b = _mm256_loadu_si256((__m256i*)(src + i));
+      _mm256_storeu_si256((__m256i*)(dst + i), _mm256_and_si256(a, b));
+    }
+    return idxBmWordsCard(dst);
+  }
+#endif
+
+  int32_t card = 0;
+  for (int32_t i = 0; i < IDX_BM_BITMAP_WORDS; ++i) {
+    dst[i] &= src[i];
+    card += idxBmPopcnt(dst[i]);
+  }
+  return card;
+}
+
+static int32_t idxBmWordsOr(uint64_t* dst, const uint64_t* src) {
+#if __AVX2__
+  if (tsAVX2Enable && tsSIMDBuiltins) {
+    for (int32_t i = 0; i < IDX_BM_BITMAP_WORDS; i += 4) {
+      __m256i a = _mm256_loadu_si256((__m256i*)(dst + i));
+      __m256i b = _mm256_loadu_si256((__m256i*)(src + i));
+      _mm256_storeu_si256((__m256i*)(dst + i), _mm256_or_si256(a, b));
+    }
+    return idxBmWordsCard(dst);
+  }
+#endif
+
+  int32_t card = 0;
+  for (int32_t i = 0; i < IDX_BM_BITMAP_WORDS; ++i) {
+    dst[i] |= src[i];
+    card += idxBmPopcnt(dst[i]);
+  }
+  return card;
+}
+
+static int32_t idxBmWordsAndNot(uint64_t* dst, const uint64_t* src) {
+#if __AVX2__
+  if (tsAVX2Enable && tsSIMDBuiltins) {
+    for (int32_t i = 0; i < IDX_BM_BITMAP_WORDS; i += 4) {
+      __m256i a = _mm256_loadu_si256((__m256i*)(dst + i));
+      __m256i b = _mm256_loadu_si256((__m256i*)(src + i));
+      _mm256_storeu_si256((__m256i*)(dst + i), _mm256_andnot_si256(b, a));
+    }
+    return idxBmWordsCard(dst);
+  }
+#endif
+
+  int32_t card = 0;
+  for (int32_t i = 0; i < IDX_BM_BITMAP_WORDS; ++i) {
+    dst[i] &= ~src[i];
+    card += idxBmPopcnt(dst[i]);
+  }
+  return card;
+}
+
+/*
+ * container
+ */
+static void idxBmContFree(SIdxBmContainer* pCont) {
+  if (pCont->type == IDX_BM_ARRAY) {
+    taosMemoryFreeClear(pCont->vals);
+  } else {
+    taosMemoryFreeClear(pCont->words);
+  }
+  pCont->card = 0;
+  pCont->cap = 0;
+}
+
+// the lower bound of v in the array container
+static FORCE_INLINE int32_t idxBmArraySearch(const uint16_t* vals, int32_t s, int32_t e, uint16_t v) {
+  while (s < e) {
+    int32_t m = s + ((e - s) >> 1);
+    if (vals[m] < v) {
+      s = m + 1;
+    } else {
+      e = m;
+    }
+  }
+  return s;
+}
+
+static int32_t idxBmArrayReserve(SIdxBmContainer* pCont, int32_t cap) {
+  if (pCont->cap >= cap) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t newCap = TMAX(pCont->cap * 2, 16);
+  newCap = TMIN(TMAX(newCap, cap), IDX_BM_ARRAY_MAX_CARD);
+  uint16_t* p = taosMemoryRealloc(pCont->vals, newCap * sizeof(uint16_t));
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pCont->vals = p;
+  pCont->cap = newCap;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t idxBmArrayToBitmap(SIdxBmContainer* pCont) {
+  uint64_t* words = taosMemoryCalloc(IDX_BM_BITMAP_WORDS, sizeof(uint64_t));
+  if (words == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < pCont->card; ++i) {
+    IDX_BM_SET_BIT(words, pCont->vals[i]);
+  }
+
+  taosMemoryFree(pCont->vals);
+  pCont->type = IDX_BM_BITMAP;
+  pCont->words = words;
+  pCont->cap = 0;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t idxBmBitmapToArray(SIdxBmContainer* pCont) {
+  uint16_t* vals = taosMemoryMalloc(TMAX(pCont->card, 1) * sizeof(uint16_t));
+  if (vals == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t n = 0;
+  for (int32_t i = 0; i < IDX_BM_BITMAP_WORDS; ++i) {
+    uint64_t w = pCont->words[i];
+    while (w != 0) {
+      vals[n++] = (uint16_t)((i << 6) + BUILDIN_CTZL(w));
+      w &= w - 1;
+    }
+  }
+
+  taosMemoryFree(pCont->words);
+  pCont->type = IDX_BM_ARRAY;
+  pCont->vals = vals;
+  pCont->cap = TMAX(pCont->card, 1);
+  return TSDB_CODE_SUCCESS;
+}
+
+// keep the dense container as bitmap and the sparse one as array
+static int32_t idxBmContShrink(SIdxBmContainer* pCont) {
+  if (pCont->type == IDX_BM_BITMAP && pCont->card > 0 && pCont->card <= IDX_BM_ARRAY_MAX_CARD) {
+    return idxBmBitmapToArray(pCont);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t idxBmContAdd(SIdxBmContainer* pCont, uint16_t v) {
+  if (pCont->type == IDX_BM_BITMAP) {
+    if (!IDX_BM_TEST_BIT(pCont->words, v)) {
+      IDX_BM_SET_BIT(pCont->words, v);
+      pCont->card++;
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // append is the common case, since the uids are mostly added in order
+  int32_t pos = pCont->card;
+  if (pCont->card > 0 && pCont->vals[pCont->card - 1] >= v) {
+    pos = idxBmArraySearch(pCont->vals, 0, pCont->card, v);
+    if (pCont->vals[pos] == v) {
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
+  if (pCont->card >= IDX_BM_ARRAY_MAX_CARD) {
+    int32_t code = idxBmArrayToBitmap(pCont);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    IDX_BM_SET_BIT(pCont->words, v);
+    pCont->card++;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = idxBmArrayReserve(pCont, pCont->card + 1);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  if (pos < pCont->card) {
+    memmove(pCont->vals + pos + 1, pCont->vals + pos, (pCont->card - pos) * sizeof(uint16_t));
+  }
+  pCont->vals[pos] = v;
+  pCont->card++;
+  return TSDB_CODE_SUCCESS;
+}
+
+static bool idxBmContContains(const SIdxBmContainer* pCont, uint16_t v) {
+  if (pCont->type == IDX_BM_BITMAP) {
+    return IDX_BM_TEST_BIT(pCont->words, v);
+  }
+
+  int32_t pos = idxBmArraySearch(pCont->vals, 0, pCont->card, v);
+  return pos < pCont->card && pCont->vals[pos] == v;
+}
+
+static int32_t idxBmContClone(SIdxBmContainer* pDst, const SIdxBmContainer* pSrc) {
+  *pDst = *pSrc;
+  if (pSrc->type == IDX_BM_BITMAP) {
+    pDst->words = taosMemoryMalloc(IDX_BM_BITMAP_WORDS * sizeof(uint64_t));
+    if (pDst->words == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    memcpy(pDst->words, pSrc->words, IDX_BM_BITMAP_WORDS * sizeof(uint64_t));
+  } else {
+    pDst->cap = TMAX(pSrc->card, 1);
+    pDst->vals = taosMemoryMalloc(pDst->cap * sizeof(uint16_t));
+    if (pDst->vals == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    memcpy(pDst->vals, pSrc->vals, pSrc->card * sizeof(uint16_t));
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t idxBmContAnd(SIdxBmContainer* pDst, const SIdxBmContainer* pSrc) {
+  if (pDst->type == IDX_BM_BITMAP && pSrc->type == IDX_BM_BITMAP) {
+    pDst->card = idxBmWordsAnd(pDst->words, pSrc->words);
+    return idxBmContShrink(pDst);
+  }
+
+  if (pDst->type == IDX_BM_BITMAP) {
+    // the result can't be larger than the array, so it is an array as well
+    uint16_t* vals = taosMemoryMalloc(TMAX(pSrc->card, 1) * sizeof(uint16_t));
+    if (vals == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    int32_t n = 0;
+    for (int32_t i = 0; i < pSrc->card; ++i) {
+      vals[n] = pSrc->vals[i];
+      n += IDX_BM_TEST_BIT(pDst->words, pSrc->vals[i]);
+    }
+
+    taosMemoryFree(pDst->words);
+    pDst->type = IDX_BM_ARRAY;
+    pDst->vals = vals;
+    pDst->cap = TMAX(pSrc->card, 1);
+    pDst->card = n;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t n = 0;
+  if (pSrc->type == IDX_BM_BITMAP) {
+    for (int32_t i = 0; i < pDst->card; ++i) {
+      pDst->vals[n] = pDst->vals[i];
+      n += IDX_BM_TEST_BIT(pSrc->words, pDst->vals[i]);
+    }
+  } else {
+    // gallop in the larger array when the sizes differ a lot
+    const uint16_t* a = pDst->vals;
+    const uint16_t* b = pSrc->vals;
+    int32_t         i = 0, j = 0;
+    if (pSrc->card > (pDst->card << 5)) {
+      for (; i < pDst->card && j < pSrc->card; ++i) {
+        j = idxBmArraySearch(b, j, pSrc->card, a[i]);
+        if (j < pSrc->card && b[j] == a[i]) {
+          pDst->vals[n++] = a[i];
+        }
+      }
+    } else {
+      while (i < pDst->card && j < pSrc->card) {
+        if (a[i] < b[j]) {
+          ++i;
+        } else if (a[i] > b[j]) {
+          ++j;
+        } else {
+          pDst->vals[n++] = a[i];
+          ++i;
+          ++j;
+        }
+      }
+    }
+  }
+
+  pDst->card = n;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t idxBmContOr(SIdxBmContainer* pDst, const SIdxBmContainer* pSrc) {
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  if (pDst->type == IDX_BM_ARRAY && pSrc->type == IDX_BM_ARRAY) {
+    if (pDst->card + pSrc->card > IDX_BM_ARRAY_MAX_CARD) {
+      code = idxBmArrayToBitmap(pDst);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    } else {
+      uint16_t* vals = taosMemoryMalloc(TMAX(pDst->card + pSrc->card, 1) * sizeof(uint16_t));
+      if (vals == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+
+      int32_t i = 0, j = 0, n = 0;
+      while (i < pDst->card && j < pSrc->card) {
+        uint16_t a = pDst->vals[i], b = pSrc->vals[j];
+        vals[n++] = (a <= b) ? a : b;
+        i += (a <= b);
+        j += (b <= a);
+      }
+      while (i < pDst->card) vals[n++] = pDst->vals[i++];
+      while (j < pSrc->card) vals[n++] = pSrc->vals[j++];
+
+      taosMemoryFree(pDst->vals);
+      pDst->vals = vals;
+      pDst->cap = TMAX(pDst->card + pSrc->card, 1);
+      pDst->card = n;
+      return TSDB_CODE_SUCCESS;
+    }
+  } else if (pDst->type == IDX_BM_ARRAY) {
+    code = idxBmArrayToBitmap(pDst);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  if (pSrc->type == IDX_BM_BITMAP) {
+    pDst->card = idxBmWordsOr(pDst->words, pSrc->words);
+  } else {
+    for (int32_t i = 0; i < pSrc->card; ++i) {
+      IDX_BM_SET_BIT(pDst->words, pSrc->vals[i]);
+    }
+    pDst->card = idxBmWordsCard(pDst->words);
+  }
+  return idxBmContShrink(pDst);
+}
+
+static int32_t idxBmContAndNot(SIdxBmContainer* pDst, const SIdxBmContainer* pSrc) {
+  if (pDst->type == IDX_BM_BITMAP) {
+    if (pSrc->type == IDX_BM_BITMAP) {
+      pDst->card = idxBmWordsAndNot(pDst->words, pSrc->words);
+    } else {
+      for (int32_t i = 0; i < pSrc->card; ++i) {
+        pDst->card -= IDX_BM_TEST_BIT(pDst->words, pSrc->vals[i]);
+        IDX_BM_CLR_BIT(pDst->words, pSrc->vals[i]);
+      }
+    }
+    return idxBmContShrink(pDst);
+  }
+
+  int32_t n = 0;
+  if (pSrc->type == IDX_BM_BITMAP) {
+    for (int32_t i = 0; i < pDst->card; ++i) {
+      pDst->vals[n] = pDst->vals[i];
+      n += !IDX_BM_TEST_BIT(pSrc->words, pDst->vals[i]);
+    }
+  } else {
+    int32_t i = 0, j = 0;
+    while (i < pDst->card) {
+      uint16_t v = pDst->vals[i];
+      while (j < pSrc->card && pSrc->vals[j] < v) ++j;
+      if (j >= pSrc->card || pSrc->vals[j] != v) {
+        pDst->vals[n++] = v;
+      }
+      ++i;
+    }
+  }
+
+  pDst->card = n;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t idxBmContToArray(const SIdxBmContainer* pCont, SArray* uids) {
+  uint64_t high = pCont->key << 16;
+  if (pCont->type == IDX_BM_ARRAY) {
+    for (int32_t i = 0; i < pCont->card; ++i) {
+      uint64_t uid = high | pCont->vals[i];
+      if (taosArrayPush(uids, &uid) == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  for (int32_t i = 0; i < IDX_BM_BITMAP_WORDS; ++i) {
+    uint64_t w = pCont->words[i];
+    while (w != 0) {
+      uint64_t uid = high | (uint64_t)((i << 6) + BUILDIN_CTZL(w));
+      if (taosArrayPush(uids, &uid) == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+      w &= w - 1;
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * bitmap
+ */
+static int32_t idxBitmapReserve(SIdxBitmap* pBm, int32_t cap) {
+  if (pBm->cap >= cap) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t          newCap = TMAX(TMAX(pBm->cap * 2, 4), cap);
+  SIdxBmContainer* p = taosMemoryRealloc(pBm->pCont, newCap * sizeof(SIdxBmContainer));
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pBm->pCont = p;
+  pBm->cap = newCap;
+  return TSDB_CODE_SUCCESS;
+}
+
+// the lower bound of the key in the containers
+static int32_t idxBitmapSearch(const SIdxBitmap* pBm, uint64_t key) {
+  int32_t s = 0, e = pBm->num;
+  while (s < e) {
+    int32_t m = s + ((e - s) >> 1);
+    if (pBm->pCont[m].key < key) {
+      s = m + 1;
+    } else {
+      e = m;
+    }
+  }
+  return s;
+}
+
+static void idxBitmapRemoveEmpty(SIdxBitmap* pBm) {
+  int32_t n = 0;
+  for (int32_t i = 0; i < pBm->num; ++i) {
+    if (pBm->pCont[i].card == 0) {
+      idxBmContFree(&pBm->pCont[i]);
+    } else {
+      pBm->pCont[n++] = pBm->pCont[i];
+    }
+  }
+  pBm->num = n;
+}
+
+SIdxBitmap* idxBitmapCreate() {
+  SIdxBitmap* pBm = taosMemoryCalloc(1, sizeof(SIdxBitmap));
+  if (pBm == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+  }
+  return pBm;
+}
+
+void idxBitmapClear(SIdxBitmap* pBm) {
+  if (pBm == NULL) {
+    return;
+  }
+  for (int32_t i = 0; i < pBm->num; ++i) {
+    idxBmContFree(&pBm->pCont[i]);
+  }
+  pBm->num = 0;
+}
+
+void idxBitmapDestroy(SIdxBitmap* pBm) {
+  if (pBm == NULL) {
+    return;
+  }
+  idxBitmapClear(pBm);
+  taosMemoryFree(pBm->pCont);
+  taosMemoryFree(pBm);
+}
+
+SIdxBitmap* idxBitmapClone(const SIdxBitmap* pBm) {
+  SIdxBitmap* pDst = idxBitmapCreate();
+  if (pDst == NULL || idxBitmapReserve(pDst, pBm->num) != TSDB_CODE_SUCCESS) {
+    idxBitmapDestroy(pDst);
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < pBm->num; ++i) {
+    if (idxBmContClone(&pDst->pCont[i], &pBm->pCont[i]) != TSDB_CODE_SUCCESS) {
+      idxBitmapDestroy(pDst);
+      return NULL;
+    }
+    pDst->num++;
+  }
+  return pDst;
+}
+
+int32_t idxBitmapAdd(SIdxBitmap* pBm, uint64_t uid) {
+  uint64_t key = IDX_BM_KEY(uid);
+
+  int32_t pos = pBm->num;
+  if (pBm->num > 0 && pBm->pCont[pBm->num - 1].key >= key) {
+    pos = (pBm->pCont[pBm->num - 1].key == key) ? pBm->num - 1 : idxBitmapSearch(pBm, key);
+  }
+
+  if (pos == pBm->num || pBm->pCont[pos].key != key) {
+    int32_t code = idxBitmapReserve(pBm, pBm->num + 1);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    if (pos < pBm->num) {
+      memmove(pBm->pCont + pos + 1, pBm->pCont + pos, (pBm->num - pos) * sizeof(SIdxBmContainer));
+    }
+    memset(&pBm->pCont[pos], 0, sizeof(SIdxBmContainer));
+    pBm->pCont[pos].key = key;
+    pBm->pCont[pos].type = IDX_BM_ARRAY;
+    pBm->num++;
+  }
+
+  return idxBmContAdd(&pBm->pCont[pos], IDX_BM_LOW(uid));
+}
+
+int32_t idxBitmapAddArray(SIdxBitmap* pBm, const SArray* uids) {
+  int32_t sz = (int32_t)taosArrayGetSize(uids);
+  for (int32_t i = 0; i < sz; ++i) {
+    int32_t code = idxBitmapAdd(pBm, *(uint64_t*)taosArrayGet(uids, i));
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+bool idxBitmapContains(const SIdxBitmap* pBm, uint64_t uid) {
+  int32_t pos = idxBitmapSearch(pBm, IDX_BM_KEY(uid));
+  if (pos >= pBm->num || pBm->pCont[pos].key != IDX_BM_KEY(uid)) {
+    return false;
+  }
+  return idxBmContContains(&pBm->pCont[pos], IDX_BM_LOW(uid));
+}
+
+int64_t idxBitmapCardinality(const SIdxBitmap* pBm) {
+  int64_t card = 0;
+  for (int32_t i = 0; i < pBm->num; ++i) {
+    card += pBm->pCont[i].card;
+  }
+  return card;
+}
+
+int32_t idxBitmapToArray(const SIdxBitmap* pBm, SArray* uids) {
+  if (taosArrayEnsureCap(uids, taosArrayGetSize(uids) + idxBitmapCardinality(pBm)) != 0) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < pBm->num; ++i) {
+    int32_t code = idxBmContToArray(&pBm->pCont[i], uids);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t idxBitmapAnd(SIdxBitmap* pDst, const SIdxBitmap* pSrc) {
+  int32_t i = 0, j = 0;
+  while (i < pDst->num) {
+    SIdxBmContainer* pCont = &pDst->pCont[i];
+    if (j < pSrc->num && pSrc->pCont[j].key < pCont->key) {
+      j = idxBitmapSearch(pSrc, pCont->key);
+    }
+
+    if (j < pSrc->num && pSrc->pCont[j].key == pCont->key) {
+      int32_t code = idxBmContAnd(pCont, &pSrc->pCont[j]);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    } else {
+      pCont->card = 0;
+    }
+    ++i;
+  }
+
+  idxBitmapRemoveEmpty(pDst);
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t idxBitmapOr(SIdxBitmap* pDst, const SIdxBitmap* pSrc) {
+  if (pSrc->num == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // merge the containers into a new container list
+  int32_t          cap = pDst->num + pSrc->num;
+  SIdxBmContainer* pCont = taosMemoryMalloc(cap * sizeof(SIdxBmContainer));
+  if (pCont == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t i = 0, j = 0, n = 0;
+  while (i < pDst->num || j < pSrc->num) {
+    if (j >= pSrc->num || (i < pDst->num && pDst->pCont[i].key < pSrc->pCont[j].key)) {
+      pCont[n++] = pDst->pCont[i++];
+    } else if (i >= pDst->num || pSrc->pCont[j].key < pDst->pCont[i].key) {
+      code = idxBmContClone(&pCont[n], &pSrc->pCont[j++]);
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+      n++;
+    } else {
+      pCont[n] = pDst->pCont[i++];
+      code = idxBmContOr(&pCont[n++], &pSrc->pCont[j++]);
+      if (code != TSDB_CODE_SUCCESS) {
+        break;
+      }
+    }
+  }
+
+  if (code != TSDB_CODE_SUCCESS) {
+    // the containers not merged yet are still owned by pDst
+    while (i < pDst->num) {
+      pCont[n++] = pDst->pCont[i++];
+    }
+  }
+
+  taosMemoryFree(pDst->pCont);
+  pDst->pCont = pCont;
+  pDst->num = n;
+  pDst->cap = cap;
+  return code;
+}
+
+int32_t idxBitmapAndNot(SIdxBitmap* pDst, const SIdxBitmap* pSrc) {
+  int32_t j = 0;
+  for (int32_t i = 0; i < pDst->num && j < pSrc->num; ++i) {
+    SIdxBmContainer* pCont = &pDst->pCont[i];
+    if (pSrc->pCont[j].key < pCont->key) {
+      j = idxBitmapSearch(pSrc, pCont->key);
+    }
+
+    if (j < pSrc->num && pSrc->pCont[j].key == pCont->key) {
+      int32_t code = idxBmContAndNot(pCont, &pSrc->pCont[j]);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    }
+  }
+
+  idxBitmapRemoveEmpty(pDst);
+  return TSDB_CODE_SUCCESS;
+}
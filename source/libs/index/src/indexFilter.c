@@ -15,6 +15,7 @@
 
 #include "filter.h"
 #include "index.h"
+#include "indexBitmap.h"
 #include "indexComm.h"
 #include "indexInt.h"
 #include "nodes.h"
@@ -66,9 +67,10 @@ typedef union {
   } while (0);
 
 typedef struct SIFParam {
-  SHashObj *pFilter;
-  SArray   *result;
-  char     *condValue;
+  SHashObj   *pFilter;
+  SArray     *result;
+  SIdxBitmap *bitmap;  // result of logic condition, converted to uid list only at the end
+  char       *condValue;
 
   SIdxFltStatus status;
   uint8_t       colValType;
@@ -117,6 +119,8 @@ static FORCE_INLINE void sifFreeParam(SIFParam *param) {
   if (param == NULL) return;
 
   taosArrayDestroy(param->result);
+  idxBitmapDestroy(param->bitmap);
+  param->bitmap = NULL;
   taosMemoryFree(param->condValue);
   param->condValue = NULL;
   taosHashCleanup(param->pFilter);
@@ -850,6 +854,63 @@ _return:
   return code;
 }
 
+/*
+ * merge the results of the logic condition params as bitmaps, AND only intersects the params evaluated by index,
+ * since the others are not reliable, and falls back to union if there is no such param
+ */
+static int32_t sifMergeLogicResult(ELogicConditionType type, SIFParam *params, int32_t nParam, SIFParam *output) {
+  if (type == LOGIC_COND_TYPE_NOT) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t nIndexed = 0;
+  for (int32_t m = 0; m < nParam; m++) {
+    nIndexed += (params[m].status != SFLT_NOT_INDEX);
+  }
+  bool intersect = (type == LOGIC_COND_TYPE_AND && nIndexed > 0);
+
+  output->bitmap = idxBitmapCreate();
+  if (output->bitmap == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t     code = TSDB_CODE_SUCCESS;
+  SIdxBitmap *tmp = NULL;
+  bool        first = true;
+  for (int32_t m = 0; m < nParam; m++) {
+    SIFParam *p = &params[m];
+    if (intersect && p->status == SFLT_NOT_INDEX) {
+      continue;
+    }
+
+    const SIdxBitmap *pBm = p->bitmap;
+    if (pBm == NULL) {
+      if (tmp == NULL && (tmp = idxBitmapCreate()) == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        break;
+      }
+      idxBitmapClear(tmp);
+      if ((code = idxBitmapAddArray(tmp, p->result)) != TSDB_CODE_SUCCESS) {
+        break;
+      }
+      pBm = tmp;
+    }
+
+    code = (intersect && !first) ? idxBitmapAnd(output->bitmap, pBm) : idxBitmapOr(output->bitmap, pBm);
+    if (code != TSDB_CODE_SUCCESS || (intersect && output->bitmap->num == 0)) {
+      break;
+    }
+    first = false;
+  }
+  idxBitmapDestroy(tmp);
+
+  // the result is not reliable if any param of OR or all params of AND are not evaluated by index
+  if ((type == LOGIC_COND_TYPE_OR && nIndexed < nParam) || (type == LOGIC_COND_TYPE_AND && nIndexed == 0)) {
+    output->status = SFLT_NOT_INDEX;
+  }
+  return code;
+}
+
 static int32_t sifExecLogic(SLogicConditionNode *node, SIFCtx *ctx, SIFParam *output) {
   if (NULL == node->pParameterList || node->pParameterList->length <= 0) {
     indexError("invalid logic parameter list, list:%p, paramNum:%d", node->pParameterList,
@@ -862,17 +923,7 @@ static int32_t sifExecLogic(SLogicConditionNode *node, SIFCtx *ctx, SIFParam *ou
   SIF_ERR_RET(sifInitParamList(&params, node->pParameterList, ctx));
 
   if (ctx->noExec == false) {
-    for (int32_t m = 0; m < node->pParameterList->length; m++) {
-      if (node->condType == LOGIC_COND_TYPE_AND) {
-        taosArrayAddAll(output->result, params[m].result);
-      } else if (node->condType == LOGIC_COND_TYPE_OR) {
-        taosArrayAddAll(output->result, params[m].result);
-      } else if (node->condType == LOGIC_COND_TYPE_NOT) {
-        // taosArrayAddAll(output->result, params[m].result);
-      }
-      taosArraySort(output->result, idxUidCompare);
-      taosArrayRemoveDuplicate(output->result, idxUidCompare, NULL);
-    }
+    SIF_ERR_JRET(sifMergeLogicResult(node->condType, params, node->pParameterList->length, output));
   } else {
     for (int32_t m = 0; m < node->pParameterList->length; m++) {
       output->status = sifMergeCond(node->condType, output->status, params[m].status);
@@ -999,7 +1050,9 @@ static int32_t sifCalculate(SNode *pNode, SIFParam *pDst) {
       indexError("no valid res in hash, node:(%p), type(%d)", (void *)&pNode, nodeType(pNode));
       SIF_ERR_RET(TSDB_CODE_APP_ERROR);
     }
-    if (res->result != NULL) {
+    if (res->bitmap != NULL) {
+      code = idxBitmapToArray(res->bitmap, pDst->result);
+    } else if (res->result != NULL) {
       taosArrayAddAll(pDst->result, res->result);
     }
     pDst->status = res->status;
@@ -14,13 +14,9 @@
  */
 #include "indexUtil.h"
 #include "index.h"
+#include "indexBitmap.h"
 #include "tcompare.h"
 
-typedef struct MergeIndex {
-  int idx;
-  int len;
-} MergeIndex;
-
 static FORCE_INLINE int iBinarySearch(SArray *arr, int s, int e, uint64_t k) {
   uint64_t v;
   int32_t  m;
@@ -36,84 +32,80 @@ static FORCE_INLINE int iBinarySearch(SArray *arr, int s, int e, uint64_t k) {
   return s;
 }
 
+static SIdxBitmap *idxBitmapFromArray(SArray *uids) {
+  SIdxBitmap *pBm = idxBitmapCreate();
+  if (pBm == NULL) {
+    return NULL;
+  }
+  if (idxBitmapAddArray(pBm, uids) != TSDB_CODE_SUCCESS) {
+    idxBitmapDestroy(pBm);
+    return NULL;
+  }
+  return pBm;
+}
+
 void iIntersection(SArray *in, SArray *out) {
   int32_t sz = (int32_t)taosArrayGetSize(in);
   if (sz <= 0) {
     return;
   }
-  MergeIndex *mi = taosMemoryCalloc(sz, sizeof(MergeIndex));
-  for (int i = 0; i < sz; i++) {
-    SArray *t = taosArrayGetP(in, i);
-    mi[i].len = (int32_t)taosArrayGetSize(t);
-    mi[i].idx = 0;
-  }
-
-  SArray *base = taosArrayGetP(in, 0);
-  for (int i = 0; i < taosArrayGetSize(base); i++) {
-    uint64_t tgt = *(uint64_t *)taosArrayGet(base, i);
-    bool     has = true;
-    for (int j = 1; j < taosArrayGetSize(in); j++) {
-      SArray *oth = taosArrayGetP(in, j);
-      int     mid = iBinarySearch(oth, mi[j].idx, mi[j].len - 1, tgt);
-      if (mid >= 0 && mid < mi[j].len) {
-        uint64_t val = *(uint64_t *)taosArrayGet(oth, mid);
-        has = (val == tgt ? true : false);
-        mi[j].idx = mid;
-      } else {
-        has = false;
-      }
+
+  // start from the shortest list, the result can't be larger than it
+  int32_t base = 0;
+  for (int i = 1; i < sz; i++) {
+    if (taosArrayGetSize(taosArrayGetP(in, i)) < taosArrayGetSize(taosArrayGetP(in, base))) {
+      base = i;
+    }
+  }
+
+  SIdxBitmap *rslt = idxBitmapFromArray(taosArrayGetP(in, base));
+  if (rslt == NULL) {
+    indexError("failed to build bitmap for intersection, reason:%s", tstrerror(TSDB_CODE_OUT_OF_MEMORY));
+    return;
+  }
+
+  for (int i = 0; i < sz && rslt->num > 0; i++) {
+    if (i == base) {
+      continue;
     }
-    if (has == true) {
-      taosArrayPush(out, &tgt);
+    SIdxBitmap *oth = idxBitmapFromArray(taosArrayGetP(in, i));
+    if (oth == NULL || idxBitmapAnd(rslt, oth) != TSDB_CODE_SUCCESS) {
+      indexError("failed to intersect bitmap, reason:%s", tstrerror(TSDB_CODE_OUT_OF_MEMORY));
+      idxBitmapDestroy(oth);
+      idxBitmapDestroy(rslt);
+      return;
     }
+    idxBitmapDestroy(oth);
   }
-  taosMemoryFreeClear(mi);
+
+  idxBitmapToArray(rslt, out);
+  idxBitmapDestroy(rslt);
 }
 void iUnion(SArray *in, SArray *out) {
   int32_t sz = (int32_t)taosArrayGetSize(in);
   if (sz <= 0) {
     return;
   }
-  if (sz == 1) {
-    taosArrayAddAll(out, taosArrayGetP(in, 0));
+
+  SIdxBitmap *rslt = idxBitmapFromArray(taosArrayGetP(in, 0));
+  if (rslt == NULL) {
+    indexError("failed to build bitmap for union, reason:%s", tstrerror(TSDB_CODE_OUT_OF_MEMORY));
     return;
   }
 
-  MergeIndex *mi = taosMemoryCalloc(sz, sizeof(MergeIndex));
-  for (int i = 0; i < sz; i++) {
-    SArray *t = taosArrayGetP(in, i);
-    mi[i].len = (int32_t)taosArrayGetSize(t);
-    mi[i].idx = 0;
-  }
-  while (1) {
-    uint64_t mVal = UINT64_MAX;
-    int      mIdx = -1;
-
-    for (int j = 0; j < sz; j++) {
-      SArray *t = taosArrayGetP(in, j);
-      if (mi[j].idx >= mi[j].len) {
-        continue;
-      }
-      uint64_t cVal = *(uint64_t *)taosArrayGet(t, mi[j].idx);
-      if (cVal < mVal) {
-        mVal = cVal;
-        mIdx = j;
-      }
-    }
-    if (mIdx != -1) {
-      mi[mIdx].idx++;
-      if (taosArrayGetSize(out) > 0) {
-        uint64_t lVal = *(uint64_t *)taosArrayGetLast(out);
-        if (lVal == mVal) {
-          continue;
-        }
-      }
-      taosArrayPush(out, &mVal);
-    } else {
-      break;
+  for (int i = 1; i < sz; i++) {
+    SIdxBitmap *oth = idxBitmapFromArray(taosArrayGetP(in, i));
+    if (oth == NULL || idxBitmapOr(rslt, oth) != TSDB_CODE_SUCCESS) {
+      indexError("failed to union bitmap, reason:%s", tstrerror(TSDB_CODE_OUT_OF_MEMORY));
+      idxBitmapDestroy(oth);
+      idxBitmapDestroy(rslt);
+      return;
     }
+    idxBitmapDestroy(oth);
   }
-  taosMemoryFreeClear(mi);
+
+  idxBitmapToArray(rslt, out);
+  idxBitmapDestroy(rslt);
 }
 
 void iExcept(SArray *total, SArray *except) {
@@ -184,19 +176,16 @@ void idxTRsltDestroy(SIdxTRslt *tr) {
   taosMemoryFree(tr);
 }
 void idxTRsltMergeTo(SIdxTRslt *tr, SArray *result) {
-  taosArraySort(tr->total, uidCompare);
-  taosArraySort(tr->add, uidCompare);
-  taosArraySort(tr->del, uidCompare);
-
-  if (taosArrayGetSize(tr->total) == 0 || taosArrayGetSize(tr->add) == 0) {
-    SArray *t = taosArrayGetSize(tr->total) == 0 ? tr->add : tr->total;
-    taosArrayAddAll(result, t);
+  // (total + add) - del, the lists needn't be sorted
+  SIdxBitmap *rslt = idxBitmapFromArray(tr->total);
+  SIdxBitmap *del = idxBitmapFromArray(tr->del);
+  if (rslt == NULL || del == NULL || idxBitmapAddArray(rslt, tr->add) != TSDB_CODE_SUCCESS ||
+      idxBitmapAndNot(rslt, del) != TSDB_CODE_SUCCESS) {
+    indexError("failed to merge temp result, reason:%s", tstrerror(TSDB_CODE_OUT_OF_MEMORY));
   } else {
-    SArray *arrs = taosArrayInit(2, sizeof(void *));
-    taosArrayPush(arrs, &tr->total);
-    taosArrayPush(arrs, &tr->add);
-    iUnion(arrs, result);
-    taosArrayDestroy(arrs);
+    idxBitmapToArray(rslt, result);
   }
-  iExcept(result, tr->del);
+
+  idxBitmapDestroy(rslt);
+  idxBitmapDestroy(del);
 }
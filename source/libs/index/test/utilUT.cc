@@ -1,10 +1,14 @@
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <iterator>
 #include <iostream>
+#include <random>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
 #include "index.h"
+#include "indexBitmap.h"
 #include "indexCache.h"
 #include "indexComm.h"
 #include "indexFst.h"
@@ -365,3 +369,112 @@ TEST_F(UtilEnv, testDictComm) {
     EXPECT_EQ(COMMON_INPUTS[v], i);
   }
 }
+
+// sparse and dense containers, and the uids near the container and the uint64 boundary
+static std::set<uint64_t> genBitmapTestUids(std::mt19937_64 &rng, int32_t nDense, int32_t nSparse) {
+  std::set<uint64_t> uids;
+  uint64_t           denseBase = (rng() % 16) << 16;
+  for (int32_t i = 0; i < nDense; i++) {
+    uids.insert(denseBase + rng() % 20000);
+  }
+  for (int32_t i = 0; i < nSparse; i++) {
+    uids.insert(rng() % (1ULL << 24));
+  }
+  uids.insert(UINT64_MAX);
+  uids.insert((1ULL << 16) - 1);
+  uids.insert(1ULL << 16);
+  return uids;
+}
+static SIdxBitmap *genBitmap(const std::set<uint64_t> &uids) {
+  // add in reverse order to exercise the insertion in the middle of the containers
+  SIdxBitmap *pBm = idxBitmapCreate();
+  for (auto it = uids.rbegin(); it != uids.rend(); ++it) {
+    EXPECT_EQ(idxBitmapAdd(pBm, *it), 0);
+  }
+  return pBm;
+}
+static void checkBitmap(SIdxBitmap *pBm, const std::set<uint64_t> &expect) {
+  EXPECT_EQ(idxBitmapCardinality(pBm), (int64_t)expect.size());
+
+  SArray *uids = taosArrayInit(8, sizeof(uint64_t));
+  EXPECT_EQ(idxBitmapToArray(pBm, uids), 0);
+  ASSERT_EQ(taosArrayGetSize(uids), expect.size());
+
+  int32_t i = 0;
+  for (auto uid : expect) {
+    EXPECT_EQ(*(uint64_t *)taosArrayGet(uids, i++), uid);
+    EXPECT_TRUE(idxBitmapContains(pBm, uid));
+  }
+  taosArrayDestroy(uids);
+}
+TEST_F(UtilEnv, bitmapSetOper) {
+  std::mt19937_64 rng(20230801);
+  int32_t         cases[][4] = {{0, 10, 0, 10}, {10000, 100, 0, 3000}, {15000, 2000, 12000, 500}, {0, 5000, 8000, 0}};
+
+  for (auto &c : cases) {
+    std::set<uint64_t> a = genBitmapTestUids(rng, c[0], c[1]);
+    std::set<uint64_t> b = genBitmapTestUids(rng, c[2], c[3]);
+
+    std::set<uint64_t> andRslt, orRslt, andNotRslt;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::inserter(andRslt, andRslt.begin()));
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::inserter(orRslt, orRslt.begin()));
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::inserter(andNotRslt, andNotRslt.begin()));
+
+    SIdxBitmap *pA = genBitmap(a);
+    SIdxBitmap *pB = genBitmap(b);
+    checkBitmap(pA, a);
+
+    SIdxBitmap *pAnd = idxBitmapClone(pA);
+    EXPECT_EQ(idxBitmapAnd(pAnd, pB), 0);
+    checkBitmap(pAnd, andRslt);
+
+    SIdxBitmap *pOr = idxBitmapClone(pA);
+    EXPECT_EQ(idxBitmapOr(pOr, pB), 0);
+    checkBitmap(pOr, orRslt);
+
+    SIdxBitmap *pAndNot = idxBitmapClone(pA);
+    EXPECT_EQ(idxBitmapAndNot(pAndNot, pB), 0);
+    checkBitmap(pAndNot, andNotRslt);
+
+    idxBitmapDestroy(pA);
+    idxBitmapDestroy(pB);
+    idxBitmapDestroy(pAnd);
+    idxBitmapDestroy(pOr);
+    idxBitmapDestroy(pAndNot);
+  }
+}
+TEST_F(UtilEnv, bitmapUnsortedMerge) {
+  clearSourceArray(src);
+  clearFinalArray(rslt);
+
+  uint64_t arr1[] = {9, 1, 70000, 5, 1, UINT64_MAX};
+  uint64_t arr2[] = {70000, 5, 2, UINT64_MAX, 9};
+  uint64_t arr3[] = {UINT64_MAX, 9, 70000, 3};
+  SArray  *f = (SArray *)taosArrayGetP(src, 0);
+  for (int i = 0; i < sizeof(arr1) / sizeof(arr1[0]); i++) {
+    taosArrayPush(f, &arr1[i]);
+  }
+  f = (SArray *)taosArrayGetP(src, 1);
+  for (int i = 0; i < sizeof(arr2) / sizeof(arr2[0]); i++) {
+    taosArrayPush(f, &arr2[i]);
+  }
+  f = (SArray *)taosArrayGetP(src, 2);
+  for (int i = 0; i < sizeof(arr3) / sizeof(arr3[0]); i++) {
+    taosArrayPush(f, &arr3[i]);
+  }
+
+  iIntersection(src, rslt);
+  uint64_t expectAnd[] = {9, 70000, UINT64_MAX};
+  ASSERT_EQ(taosArrayGetSize(rslt), sizeof(expectAnd) / sizeof(expectAnd[0]));
+  for (int i = 0; i < taosArrayGetSize(rslt); i++) {
+    EXPECT_EQ(*(uint64_t *)taosArrayGet(rslt, i), expectAnd[i]);
+  }
+
+  clearFinalArray(rslt);
+  iUnion(src, rslt);
+  uint64_t expectOr[] = {1, 2, 3, 5, 9, 70000, UINT64_MAX};
+  ASSERT_EQ(taosArrayGetSize(rslt), sizeof(expectOr) / sizeof(expectOr[0]));
+  for (int i = 0; i < taosArrayGetSize(rslt); i++) {
+    EXPECT_EQ(*(uint64_t *)taosArrayGet(rslt, i), expectOr[i]);
+  }
+}
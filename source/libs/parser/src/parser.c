@@ -48,6 +48,89 @@ bool qIsInsertValuesSql(const char* pStr, size_t length) {
   return false;
 }
 
+static bool isUncacheableToken(const char* z, uint32_t n, uint32_t type) {
+  switch (type) {
+    // the result depends on the time or the session
+    case TK_NOW:
+    case TK_TODAY:
+    case TK_TIMEZONE:
+    case TK_DATABASE:
+    case TK_USER:
+    case TK_CURRENT_USER:
+    case TK_CLIENT_VERSION:
+    case TK_SERVER_VERSION:
+    case TK_SERVER_STATUS:
+    // the plan depends on the cache model of the database, which has no version in the catalog
+    case TK_LAST:
+    case TK_LAST_ROW:
+    case TK_NK_QUESTION:
+    case TK_NK_ILLEGAL:
+      return true;
+    case TK_NK_ID:
+      return 4 == n && 0 == strncasecmp(z, "rand", n);
+    default:
+      break;
+  }
+  return false;
+}
+
+bool qNormalizeQuerySql(const char* pStr, size_t length, char* pBuf, int32_t* pLen) {
+  *pLen = 0;
+  if (NULL == pStr) {
+    return false;
+  }
+
+  int32_t  len = 0;
+  bool     first = true;
+  bool     space = false;
+  bool     end = false;
+  uint32_t type = 0;
+  for (size_t pos = 0; pos < length && '\0' != pStr[pos];) {
+    const char* z = pStr + pos;
+    uint32_t    n = tGetToken(z, &type);
+    if (0 == n || pos + n > length) {
+      return false;
+    }
+    pos += n;
+
+    if (TK_NK_SPACE == type || TK_NK_COMMENT == type) {
+      space = true;
+      continue;
+    }
+    if (end) {
+      // multiple statements are never cached
+      return false;
+    }
+    if (TK_NK_SEMI == type) {
+      end = true;
+      continue;
+    }
+    if (first && TK_SELECT != type) {
+      return false;
+    }
+    if (isUncacheableToken(z, n, type)) {
+      return false;
+    }
+
+    if (space && !first) {
+      pBuf[len++] = ' ';
+    }
+    if (TK_NK_STRING == type || (TK_NK_ID == type && '`' == z[0])) {
+      memcpy(pBuf + len, z, n);
+    } else {
+      for (uint32_t i = 0; i < n; ++i) {
+        pBuf[len + i] = tolower(z[i]);
+      }
+    }
+    len += n;
+    first = false;
+    space = false;
+  }
+
+  *pLen = len;
+  return !first;
+}
+
 static int32_t analyseSemantic(SParseContext* pCxt, SQuery* pQuery, SParseMetaCache* pMetaCache) {
   int32_t code = authenticate(pCxt, pQuery, pMetaCache);
 
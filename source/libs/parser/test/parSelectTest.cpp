@@ -14,6 +14,7 @@
  */
 
 #include "parTestUtil.h"
+#include "parser.h"
 
 using namespace std;
 
@@ -467,6 +468,54 @@ TEST_F(ParserSelectTest, withoutFromSemanticCheck) {
   run("SELECT TBNAME", TSDB_CODE_PAR_INVALID_TBNAME);
 }
 
+static string normalizeQuerySql(const string& sql) {
+  string  buf(sql.length() + 1, '\0');
+  int32_t len = 0;
+  if (!qNormalizeQuerySql(sql.c_str(), sql.length(), &buf[0], &len)) {
+    return "<uncacheable>";
+  }
+  return buf.substr(0, len);
+}
+
+TEST_F(ParserSelectTest, normalizeQuerySql) {
+  // keywords and identifiers are lower-cased, blanks are collapsed
+  EXPECT_EQ(normalizeQuerySql("SELECT  C1,\tSum(C2)\nFROM T1   WHERE c1 > 10"),
+            "select c1, sum(c2) from t1 where c1 > 10");
+  EXPECT_EQ(normalizeQuerySql("select c1, SUM(c2) from t1 where C1 > 10"),
+            normalizeQuerySql("SELECT C1, sum(C2) FROM T1 WHERE c1 > 10"));
+  EXPECT_NE(normalizeQuerySql("select c1 from t1 where c1 > 10"), normalizeQuerySql("select c1 from t1 where c1 > 11"));
+
+  // backquoted identifiers and string literals are case sensitive
+  EXPECT_EQ(normalizeQuerySql("SELECT `C1` FROM `T1`"), "select `C1` from `T1`");
+  EXPECT_NE(normalizeQuerySql("select `C1` from t1"), normalizeQuerySql("select `c1` from t1"));
+  EXPECT_EQ(normalizeQuerySql("SELECT * FROM T1 WHERE C3 = 'AbC  d' OR c3 = \"X\""),
+            "select * from t1 where c3 = 'AbC  d' or c3 = \"X\"");
+  EXPECT_NE(normalizeQuerySql("select * from t1 where c3 = 'a'"), normalizeQuerySql("select * from t1 where c3 = 'A'"));
+
+  // comments are dropped
+  EXPECT_EQ(normalizeQuerySql("select /* all */ * from t1 -- tail"), "select * from t1");
+  EXPECT_EQ(normalizeQuerySql("select/*x*/c1 from t1"), "select c1 from t1");
+
+  // one trailing semicolon is allowed, multiple statements are never cached
+  EXPECT_EQ(normalizeQuerySql("select * from t1;  "), "select * from t1");
+  EXPECT_EQ(normalizeQuerySql("select * from t1; select * from t2"), "<uncacheable>");
+
+  // only select statements
+  EXPECT_EQ(normalizeQuerySql("insert into t1 values (now, 1)"), "<uncacheable>");
+  EXPECT_EQ(normalizeQuerySql("show databases"), "<uncacheable>");
+
+  // the result depends on the time, the session or the cache model
+  EXPECT_EQ(normalizeQuerySql("select * from t1 where ts > NOW - 1d"), "<uncacheable>");
+  EXPECT_EQ(normalizeQuerySql("select * from t1 where ts > today()"), "<uncacheable>");
+  EXPECT_EQ(normalizeQuerySql("select database()"), "<uncacheable>");
+  EXPECT_EQ(normalizeQuerySql("select LAST(c1) from t1"), "<uncacheable>");
+  EXPECT_EQ(normalizeQuerySql("select last_row(c1) from t1"), "<uncacheable>");
+  EXPECT_EQ(normalizeQuerySql("select rand() from t1"), "<uncacheable>");
+  EXPECT_EQ(normalizeQuerySql("select * from t1 where c1 > ?"), "<uncacheable>");
+
+  EXPECT_EQ(normalizeQuerySql(""), "<uncacheable>");
+}
+
 TEST_F(ParserSelectTest, joinSemanticCheck) {
   useDb("root", "test");
 
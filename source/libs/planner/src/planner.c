@@ -150,6 +150,156 @@ int32_t qMsgToSubplan(const char* pStr, int32_t len, SSubplan** pSubplan) {
   return nodesMsgToNode(pStr, len, (SNode**)pSubplan);
 }
 
+typedef struct SQueryPlanMsgHead {
+  int32_t planLen;
+  int32_t numOfSubplans;
+  int32_t numOfLinks;
+} SQueryPlanMsgHead;
+
+static int32_t collectQueryPlanSubplans(const SQueryPlan* pPlan, SArray* pSubplans) {
+  SNode* pGroup = NULL;
+  FOREACH(pGroup, pPlan->pSubplans) {
+    SNode* pSubplan = NULL;
+    FOREACH(pSubplan, ((SNodeListNode*)pGroup)->pNodeList) {
+      if (NULL == taosArrayPush(pSubplans, &pSubplan)) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+    }
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t getSubplanIndex(SArray* pSubplans, SNode* pSubplan) {
+  int32_t num = taosArrayGetSize(pSubplans);
+  for (int32_t i = 0; i < num; ++i) {
+    if (taosArrayGetP(pSubplans, i) == pSubplan) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// the msg of the query plan does not carry the links between subplans and the statistics of the scan subplans, they
+// are appended after the plan as the index of the subplans in the order of execution level
+int32_t qQueryPlanToMsg(const SQueryPlan* pPlan, char** pStr, int32_t* pLen) {
+  SQueryPlanMsgHead head = {0};
+  SArray*           pSubplans = taosArrayInit(pPlan->numOfSubplans, POINTER_BYTES);
+  SArray*           pLinks = taosArrayInit(pPlan->numOfSubplans, sizeof(int32_t) * 2);
+  char*             pPlanMsg = NULL;
+  int32_t           code = (NULL == pSubplans || NULL == pLinks) ? TSDB_CODE_OUT_OF_MEMORY : TSDB_CODE_SUCCESS;
+  if (TSDB_CODE_SUCCESS == code) {
+    code = collectQueryPlanSubplans(pPlan, pSubplans);
+  }
+  head.numOfSubplans = taosArrayGetSize(pSubplans);
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < head.numOfSubplans; ++i) {
+    SSubplan* pSubplan = taosArrayGetP(pSubplans, i);
+    SNode*    pChild = NULL;
+    FOREACH(pChild, pSubplan->pChildren) {
+      int32_t link[2] = {i, getSubplanIndex(pSubplans, pChild)};
+      if (link[1] < 0) {
+        code = TSDB_CODE_PLAN_INTERNAL_ERROR;
+        break;
+      }
+      if (NULL == taosArrayPush(pLinks, link)) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        break;
+      }
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = nodesNodeToMsg((const SNode*)pPlan, &pPlanMsg, &head.planLen);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    head.numOfLinks = taosArrayGetSize(pLinks);
+    *pLen = sizeof(head) + head.planLen + head.numOfSubplans * sizeof(int32_t) + head.numOfLinks * sizeof(int32_t) * 2;
+    *pStr = taosMemoryMalloc(*pLen);
+    if (NULL == *pStr) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    char* p = *pStr;
+    memcpy(p, &head, sizeof(head));
+    p += sizeof(head);
+    memcpy(p, pPlanMsg, head.planLen);
+    p += head.planLen;
+    for (int32_t i = 0; i < head.numOfSubplans; ++i) {
+      int32_t tableNum = ((SSubplan*)taosArrayGetP(pSubplans, i))->execNodeStat.tableNum;
+      memcpy(p, &tableNum, sizeof(int32_t));
+      p += sizeof(int32_t);
+    }
+    if (head.numOfLinks > 0) {
+      memcpy(p, TARRAY_DATA(pLinks), head.numOfLinks * sizeof(int32_t) * 2);
+    }
+  }
+
+  taosMemoryFree(pPlanMsg);
+  taosArrayDestroy(pSubplans);
+  taosArrayDestroy(pLinks);
+  return code;
+}
+
+static int32_t linkQueryPlanSubplans(SQueryPlan* pPlan, uint64_t queryId, const SQueryPlanMsgHead* pHead,
+                                     const char* pExt) {
+  SArray* pSubplans = taosArrayInit(pHead->numOfSubplans, POINTER_BYTES);
+  if (NULL == pSubplans) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  int32_t code = collectQueryPlanSubplans(pPlan, pSubplans);
+  if (TSDB_CODE_SUCCESS == code && taosArrayGetSize(pSubplans) != pHead->numOfSubplans) {
+    code = TSDB_CODE_PLAN_INTERNAL_ERROR;
+  }
+
+  pPlan->queryId = queryId;
+  pPlan->explainInfo.mode = EXPLAIN_MODE_DISABLE;
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < pHead->numOfSubplans; ++i) {
+    SSubplan* pSubplan = taosArrayGetP(pSubplans, i);
+    pSubplan->id.queryId = queryId;
+    memcpy(&pSubplan->execNodeStat.tableNum, pExt, sizeof(int32_t));
+    pExt += sizeof(int32_t);
+  }
+  for (int32_t i = 0; TSDB_CODE_SUCCESS == code && i < pHead->numOfLinks; ++i) {
+    int32_t link[2] = {0};
+    memcpy(link, pExt, sizeof(link));
+    pExt += sizeof(link);
+    if (link[0] < 0 || link[0] >= pHead->numOfSubplans || link[1] < 0 || link[1] >= pHead->numOfSubplans) {
+      code = TSDB_CODE_PLAN_INTERNAL_ERROR;
+      break;
+    }
+    SSubplan* pParent = taosArrayGetP(pSubplans, link[0]);
+    SSubplan* pChild = taosArrayGetP(pSubplans, link[1]);
+    code = nodesListMakeAppend(&pParent->pChildren, (SNode*)pChild);
+    if (TSDB_CODE_SUCCESS == code) {
+      code = nodesListMakeAppend(&pChild->pParents, (SNode*)pParent);
+    }
+  }
+
+  taosArrayDestroy(pSubplans);
+  return code;
+}
+
+int32_t qMsgToQueryPlan(const char* pStr, int32_t len, uint64_t queryId, SQueryPlan** pPlan) {
+  SQueryPlanMsgHead head = {0};
+  if (len < (int32_t)sizeof(head)) {
+    return TSDB_CODE_PLAN_INTERNAL_ERROR;
+  }
+  memcpy(&head, pStr, sizeof(head));
+  int32_t extLen = head.numOfSubplans * sizeof(int32_t) + head.numOfLinks * sizeof(int32_t) * 2;
+  if (len != (int32_t)sizeof(head) + head.planLen + extLen) {
+    return TSDB_CODE_PLAN_INTERNAL_ERROR;
+  }
+
+  int32_t code = nodesMsgToNode(pStr + sizeof(head), head.planLen, (SNode**)pPlan);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = linkQueryPlanSubplans(*pPlan, queryId, &head, pStr + sizeof(head) + head.planLen);
+  }
+  if (TSDB_CODE_SUCCESS != code) {
+    nodesDestroyNode((SNode*)*pPlan);
+    *pPlan = NULL;
+  }
+  return code;
+}
+
 SQueryPlan* qStringToQueryPlan(const char* pStr) {
   SQueryPlan* pPlan = NULL;
   if (TSDB_CODE_SUCCESS != nodesStringToNode(pStr, (SNode**)&pPlan)) {
@@ -233,6 +233,7 @@ class PlannerTestBaseImpl {
       unique_ptr<SQueryPlan, void (*)(SQueryPlan*)> plan(pPlan, (void (*)(SQueryPlan*))nodesDestroyNode);
 
       checkPlanMsg((SNode*)pPlan);
+      checkQueryPlanMsg(pPlan);
 
       dump(g_dumpModule);
     } catch (...) {
@@ -477,6 +478,25 @@ class PlannerTestBaseImpl {
     return str;
   }
 
+  void checkQueryPlanMsg(const SQueryPlan* pPlan) {
+    char*   pStr = NULL;
+    int32_t len = 0;
+    DO_WITH_THROW(qQueryPlanToMsg, pPlan, &pStr, &len)
+
+    SQueryPlan* pNewPlan = NULL;
+    char*       pNewStr = NULL;
+    int32_t     newlen = 0;
+    DO_WITH_THROW(qMsgToQueryPlan, pStr, len, pPlan->queryId, &pNewPlan)
+    DO_WITH_THROW(qQueryPlanToMsg, pNewPlan, &pNewStr, &newlen)
+    if (newlen != len || 0 != memcmp(pStr, pNewStr, len)) {
+      cout << "qQueryPlanToMsg error!!!!!!!!!!!!!! len = " << len << ", newlen = " << newlen << endl;
+    }
+    qDestroyQueryPlan(pNewPlan);
+    taosMemoryFreeClear(pNewStr);
+
+    taosMemoryFreeClear(pStr);
+  }
+
   void checkPlanMsg(const SNode* pRoot) {
     char*   pStr = NULL;
     int32_t len = 0;
@@ -38,6 +38,8 @@ extern "C" {
 
 #define FILTER_RM_UNIT_MIN_ROWS 100
 
+#define FILTER_BITMAP_MAX_IN_VALUES 8
+
 enum {
   FLD_TYPE_COLUMN = 1,
   FLD_TYPE_VALUE = 2,
@@ -267,6 +269,8 @@ struct SFilterInfo {
   int8_t           *blkUnitRes;
   void             *pTable;
   SArray           *blkList;
+  uint64_t         *bitmapBuf;    // selection bitmaps of the rows, see filterExecuteImpl
+  int32_t           bitmapWords;  // words of each bitmap in bitmapBuf
 
   SFilterPCtx pctx;
 };
@@ -1855,6 +1855,7 @@ void filterFreeInfo(SFilterInfo *info) {
   taosMemoryFreeClear(info->cunits);
   taosMemoryFreeClear(info->blkUnitRes);
   taosMemoryFreeClear(info->blkUnits);
+  taosMemoryFreeClear(info->bitmapBuf);
 
   for (int32_t i = 0; i < FLD_TYPE_MAX; ++i) {
     for (uint32_t f = 0; f < info->fields[i].num; ++f) {
@@ -3219,6 +3220,535 @@ bool filterExecuteImplMisc(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes
   return all;
 }
 
+// the result of a unit on a single row, used by the units without a bitmap kernel
+static bool filterExecuteUnitOnRow(SFilterComUnit *cunit, int32_t i) {
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+  uint8_t          optr = cunit->optr;
+
+  if (colDataIsNull(pCol, 0, i, NULL)) {
+    return optr == OP_TYPE_IS_NULL;
+  }
+
+  if (optr == OP_TYPE_IS_NOT_NULL) {
+    return true;
+  } else if (optr == OP_TYPE_IS_NULL) {
+    return false;
+  }
+
+  void *colData = colDataGetData(pCol, i);
+  if (cunit->rfunc >= 0) {
+    return (*gRangeCompare[cunit->rfunc])(colData, colData, cunit->valData, cunit->valData2, gDataCompare[cunit->func]);
+  }
+
+  // match/nmatch for nchar type need convert from ucs4 to mbs
+  if (cunit->dataType == TSDB_DATA_TYPE_NCHAR && (optr == OP_TYPE_MATCH || optr == OP_TYPE_NMATCH)) {
+    bool    res = false;
+    char   *newColData = taosMemoryCalloc(cunit->dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE, 1);
+    int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
+    if (len < 0) {
+      qError("castConvert1 taosUcs4ToMbs error");
+    } else {
+      varDataSetLen(newColData, len);
+      res = filterDoCompare(gDataCompare[cunit->func], optr, newColData, cunit->valData);
+    }
+    taosMemoryFreeClear(newColData);
+    return res;
+  }
+
+  return filterDoCompare(gDataCompare[cunit->func], optr, colData, cunit->valData);
+}
+
+static bool filterExecuteImplByRow(SFilterInfo *info, int32_t numOfRows, int8_t *p, int32_t *numOfQualified) {
+  bool all = true;
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    p[i] = 0;
+    for (uint32_t g = 0; g < info->groupNum && p[i] == 0; ++g) {
+      SFilterGroup *group = &info->groups[g];
+      p[i] = (group->unitNum > 0);
+      for (uint32_t u = 0; u < group->unitNum && p[i]; ++u) {
+        p[i] = filterExecuteUnitOnRow(&info->cunits[group->unitIdxs[u]], i);
+      }
+    }
+
+    if (p[i] == 0) {
+      all = false;
+    } else {
+      (*numOfQualified) += 1;
+    }
+  }
+
+  return all;
+}
+
+/*
+ * Bitmap based execution. Each unit is evaluated over the whole block into a selection bitmap with the same layout
+ * as the null bitmap of a column, so the nulls are removed with a bytewise and. The units of a group are combined by
+ * and, the groups by or, and a group stops as soon as no row is left in it.
+ */
+enum {
+  FLT_BITMAP_RANGE = 0,
+  FLT_BITMAP_FLOAT_RANGE,
+  FLT_BITMAP_IN,
+};
+
+typedef struct SFltBitmapKernel {
+  int8_t   kind;
+  bool     empty;  // no value is in the range
+  int64_t  lo;     // closed range of the integer types, unsigned bigint is mapped to keep the order
+  int64_t  hi;
+  double   dlo;    // range of the float types, compared with the same tolerance as compareDoubleVal
+  double   dhi;
+  int8_t   loMin;  // the minimum result of comparing with dlo, -1 if there is no lower bound
+  int8_t   hiMax;  // the maximum result of comparing with dhi, 1 if there is no upper bound
+  int32_t  numOfIn;
+  uint64_t in[FILTER_BITMAP_MAX_IN_VALUES];
+} SFltBitmapKernel;
+
+typedef void (*_flt_range_kernel_fn_t)(const void *pData, int32_t numOfRows, int64_t lo, int64_t hi, uint8_t *bits);
+typedef void (*_flt_in_kernel_fn_t)(const void *pData, int32_t numOfRows, const uint64_t *in, int32_t numOfIn,
+                                    uint8_t *bits);
+
+#define FLT_BITMAP_KEY(_v)         ((int64_t)(_v))
+#define FLT_BITMAP_UBIGINT_KEY(_v) ((int64_t)((uint64_t)(_v) ^ ((uint64_t)1 << 63)))
+
+#define FLT_DEFINE_RANGE_KERNEL(_name, _t, _key)                                                   \
+  static void _name(const void *pData, int32_t numOfRows, int64_t lo, int64_t hi, uint8_t *bits) { \
+    const _t *v = (const _t *)pData;                                                               \
+    for (int32_t i = 0; i < numOfRows; i += 8) {                                                   \
+      int32_t n = TMIN(8, numOfRows - i);                                                          \
+      uint8_t b = 0;                                                                               \
+      for (int32_t j = 0; j < n; ++j) {                                                            \
+        int64_t x = _key(v[i + j]);                                                                \
+        b |= (uint8_t)((x >= lo) & (x <= hi)) << (7 - j);                                          \
+      }                                                                                            \
+      bits[i >> 3] = b;                                                                            \
+    }                                                                                              \
+  }
+
+FLT_DEFINE_RANGE_KERNEL(fltRangeBitmapInt8, int8_t, FLT_BITMAP_KEY)
+FLT_DEFINE_RANGE_KERNEL(fltRangeBitmapInt16, int16_t, FLT_BITMAP_KEY)
+FLT_DEFINE_RANGE_KERNEL(fltRangeBitmapInt32, int32_t, FLT_BITMAP_KEY)
+FLT_DEFINE_RANGE_KERNEL(fltRangeBitmapInt64, int64_t, FLT_BITMAP_KEY)
+FLT_DEFINE_RANGE_KERNEL(fltRangeBitmapUint8, uint8_t, FLT_BITMAP_KEY)
+FLT_DEFINE_RANGE_KERNEL(fltRangeBitmapUint16, uint16_t, FLT_BITMAP_KEY)
+FLT_DEFINE_RANGE_KERNEL(fltRangeBitmapUint32, uint32_t, FLT_BITMAP_KEY)
+FLT_DEFINE_RANGE_KERNEL(fltRangeBitmapUint64, uint64_t, FLT_BITMAP_UBIGINT_KEY)
+
+// in on a small set compares the raw bytes, which is what the hash set of in does
+#define FLT_DEFINE_IN_KERNEL(_name, _t)                                                                         \
+  static void _name(const void *pData, int32_t numOfRows, const uint64_t *in, int32_t numOfIn, uint8_t *bits) { \
+    const _t *v = (const _t *)pData;                                                                            \
+    for (int32_t i = 0; i < numOfRows; i += 8) {                                                                \
+      int32_t n = TMIN(8, numOfRows - i);                                                                       \
+      uint8_t b = 0;                                                                                            \
+      for (int32_t j = 0; j < n; ++j) {                                                                         \
+        uint64_t x = v[i + j];                                                                                  \
+        uint8_t  hit = 0;                                                                                       \
+        for (int32_t k = 0; k < numOfIn; ++k) {                                                                 \
+          hit |= (x == in[k]);                                                                                  \
+        }                                                                                                       \
+        b |= hit << (7 - j);                                                                                    \
+      }                                                                                                         \
+      bits[i >> 3] = b;                                                                                         \
+    }                                                                                                           \
+  }
+
+FLT_DEFINE_IN_KERNEL(fltInBitmap1, uint8_t)
+FLT_DEFINE_IN_KERNEL(fltInBitmap2, uint16_t)
+FLT_DEFINE_IN_KERNEL(fltInBitmap4, uint32_t)
+FLT_DEFINE_IN_KERNEL(fltInBitmap8, uint64_t)
+
+// same as compareFloatVal/compareDoubleVal
+#define FLT_DEFINE_FLOAT_COMPARE(_name, _t)         \
+  static FORCE_INLINE int32_t _name(_t p1, _t p2) { \
+    if (isnan(p1) && isnan(p2)) {                   \
+      return 0;                                     \
+    }                                               \
+    if (isnan(p1)) {                                \
+      return -1;                                    \
+    }                                               \
+    if (isnan(p2)) {                                \
+      return 1;                                     \
+    }                                               \
+    if (FLT_EQUAL(p1, p2)) {                        \
+      return 0;                                     \
+    }                                               \
+    return FLT_GREATER(p1, p2) ? 1 : -1;            \
+  }
+
+#define FLT_DEFINE_FLOAT_RANGE_KERNEL(_name, _t, _cmp)                                                        \
+  static void _name(const void *pData, int32_t numOfRows, const SFltBitmapKernel *k, uint8_t *bits) {         \
+    const _t *v = (const _t *)pData;                                                                          \
+    _t        lo = (_t)k->dlo;                                                                                \
+    _t        hi = (_t)k->dhi;                                                                                \
+    for (int32_t i = 0; i < numOfRows; i += 8) {                                                              \
+      int32_t n = TMIN(8, numOfRows - i);                                                                     \
+      uint8_t b = 0;                                                                                          \
+      for (int32_t j = 0; j < n; ++j) {                                                                       \
+        b |= (uint8_t)((_cmp(v[i + j], lo) >= k->loMin) & (_cmp(v[i + j], hi) <= k->hiMax)) << (7 - j);       \
+      }                                                                                                       \
+      bits[i >> 3] = b;                                                                                       \
+    }                                                                                                         \
+  }
+
+FLT_DEFINE_FLOAT_COMPARE(fltCompareFloat, float)
+FLT_DEFINE_FLOAT_COMPARE(fltCompareDouble, double)
+FLT_DEFINE_FLOAT_RANGE_KERNEL(fltRangeBitmapFloat, float, fltCompareFloat)
+FLT_DEFINE_FLOAT_RANGE_KERNEL(fltRangeBitmapDouble, double, fltCompareDouble)
+
+#if __AVX2__
+#define FLT_R2(n) n, n + 2 * 64, n + 1 * 64, n + 3 * 64
+#define FLT_R4(n) FLT_R2(n), FLT_R2(n + 2 * 16), FLT_R2(n + 1 * 16), FLT_R2(n + 3 * 16)
+#define FLT_R6(n) FLT_R4(n), FLT_R4(n + 2 * 4), FLT_R4(n + 1 * 4), FLT_R4(n + 3 * 4)
+
+// movemask puts the first row in the lowest bit, while the bitmap keeps it in the highest one
+static const uint8_t fltBitReverse[256] = {FLT_R6(0), FLT_R6(2), FLT_R6(1), FLT_R6(3)};
+
+static void fltRangeBitmapInt64AVX2(const void *pData, int32_t numOfRows, int64_t lo, int64_t hi, uint8_t *bits) {
+  const int64_t *v = (const int64_t *)pData;
+  __m256i        vlo = _mm256_set1_epi64x(lo);
+  __m256i        vhi = _mm256_set1_epi64x(hi);
+  int32_t        i = 0;
+
+  for (; i + 8 <= numOfRows; i += 8) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(v + i));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(v + i + 4));
+    __m256i oa = _mm256_or_si256(_mm256_cmpgt_epi64(vlo, a), _mm256_cmpgt_epi64(a, vhi));
+    __m256i ob = _mm256_or_si256(_mm256_cmpgt_epi64(vlo, b), _mm256_cmpgt_epi64(b, vhi));
+    int32_t m = _mm256_movemask_pd(_mm256_castsi256_pd(oa)) | (_mm256_movemask_pd(_mm256_castsi256_pd(ob)) << 4);
+    bits[i >> 3] = fltBitReverse[(uint8_t)~m];
+  }
+
+  if (i < numOfRows) {
+    fltRangeBitmapInt64(v + i, numOfRows - i, lo, hi, bits + (i >> 3));
+  }
+}
+
+static void fltRangeBitmapInt32AVX2(const void *pData, int32_t numOfRows, int64_t lo, int64_t hi, uint8_t *bits) {
+  const int32_t *v = (const int32_t *)pData;
+  int32_t        i = 0;
+
+  if (lo > INT32_MAX || hi < INT32_MIN) {
+    memset(bits, 0, BitmapLen(numOfRows));
+    return;
+  }
+
+  __m256i vlo = _mm256_set1_epi32((int32_t)TMAX(lo, INT32_MIN));
+  __m256i vhi = _mm256_set1_epi32((int32_t)TMIN(hi, INT32_MAX));
+  for (; i + 8 <= numOfRows; i += 8) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(v + i));
+    __m256i o = _mm256_or_si256(_mm256_cmpgt_epi32(vlo, a), _mm256_cmpgt_epi32(a, vhi));
+    bits[i >> 3] = fltBitReverse[(uint8_t)~_mm256_movemask_ps(_mm256_castsi256_ps(o))];
+  }
+
+  if (i < numOfRows) {
+    fltRangeBitmapInt32(v + i, numOfRows - i, lo, hi, bits + (i >> 3));
+  }
+}
+#endif
+
+static _flt_range_kernel_fn_t fltGetRangeBitmapKernel(int32_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      return fltRangeBitmapInt8;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return fltRangeBitmapInt16;
+    case TSDB_DATA_TYPE_INT:
+#if __AVX2__
+      if (tsAVX2Enable && tsSIMDBuiltins) {
+        return fltRangeBitmapInt32AVX2;
+      }
+#endif
+      return fltRangeBitmapInt32;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+#if __AVX2__
+      if (tsAVX2Enable && tsSIMDBuiltins) {
+        return fltRangeBitmapInt64AVX2;
+      }
+#endif
+      return fltRangeBitmapInt64;
+    case TSDB_DATA_TYPE_UTINYINT:
+      return fltRangeBitmapUint8;
+    case TSDB_DATA_TYPE_USMALLINT:
+      return fltRangeBitmapUint16;
+    case TSDB_DATA_TYPE_UINT:
+      return fltRangeBitmapUint32;
+    case TSDB_DATA_TYPE_UBIGINT:
+      return fltRangeBitmapUint64;
+    default:
+      return NULL;
+  }
+}
+
+static _flt_in_kernel_fn_t fltGetInBitmapKernel(int32_t bytes) {
+  switch (bytes) {
+    case 1:
+      return fltInBitmap1;
+    case 2:
+      return fltInBitmap2;
+    case 4:
+      return fltInBitmap4;
+    case 8:
+      return fltInBitmap8;
+    default:
+      return NULL;
+  }
+}
+
+static int64_t fltGetBitmapKey(int32_t type, const void *pVal) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      return *(int8_t *)pVal;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return *(int16_t *)pVal;
+    case TSDB_DATA_TYPE_INT:
+      return *(int32_t *)pVal;
+    case TSDB_DATA_TYPE_UTINYINT:
+      return *(uint8_t *)pVal;
+    case TSDB_DATA_TYPE_USMALLINT:
+      return *(uint16_t *)pVal;
+    case TSDB_DATA_TYPE_UINT:
+      return *(uint32_t *)pVal;
+    case TSDB_DATA_TYPE_UBIGINT:
+      return FLT_BITMAP_UBIGINT_KEY(*(uint64_t *)pVal);
+    default:
+      return *(int64_t *)pVal;
+  }
+}
+
+static uint64_t fltGetInBitmapValue(int32_t bytes, const void *pVal) {
+  switch (bytes) {
+    case 1:
+      return *(uint8_t *)pVal;
+    case 2:
+      return *(uint16_t *)pVal;
+    case 4:
+      return *(uint32_t *)pVal;
+    default:
+      return *(uint64_t *)pVal;
+  }
+}
+
+static bool fltPrepareInBitmapKernel(SFilterComUnit *cunit, int32_t bytes, SFltBitmapKernel *k) {
+  SHashObj *pHash = (SHashObj *)cunit->valData;
+  if (pHash == NULL || taosHashGetSize(pHash) > FILTER_BITMAP_MAX_IN_VALUES || fltGetInBitmapKernel(bytes) == NULL) {
+    return false;
+  }
+
+  void *pIter = taosHashIterate(pHash, NULL);
+  while (pIter != NULL) {
+    size_t keyLen = 0;
+    void  *key = taosHashGetKey(pIter, &keyLen);
+    if (keyLen != bytes) {
+      taosHashCancelIterate(pHash, pIter);
+      return false;
+    }
+
+    k->in[k->numOfIn++] = fltGetInBitmapValue(bytes, key);
+    pIter = taosHashIterate(pHash, pIter);
+  }
+
+  k->kind = FLT_BITMAP_IN;
+  return true;
+}
+
+// Returns false if the unit can not be evaluated by the bitmap kernels.
+static bool fltPrepareBitmapKernel(SFilterComUnit *cunit, SFltBitmapKernel *k) {
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+  int32_t          type = pCol->info.type;
+
+  memset(k, 0, sizeof(*k));
+  if (type != cunit->dataType || (!IS_NUMERIC_TYPE(type) && type != TSDB_DATA_TYPE_BOOL &&
+                                  type != TSDB_DATA_TYPE_TIMESTAMP)) {
+    return false;
+  }
+
+  // not equal and not in are executed in scalar mode, they never come here
+  if (cunit->optr == OP_TYPE_IN) {
+    return fltPrepareInBitmapKernel(cunit, tDataTypes[type].bytes, k);
+  }
+
+  void *pLow = NULL, *pHigh = NULL;
+  bool  hasLow = false, hasHigh = false;
+  bool  lowInclude = true, highInclude = true;
+  switch (cunit->rfunc) {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+      pLow = cunit->valData;
+      pHigh = cunit->valData2;
+      hasLow = hasHigh = true;
+      lowInclude = (cunit->rfunc >= 2);
+      highInclude = (cunit->rfunc & 1);
+      break;
+    case 4:
+    case 5:
+      pLow = cunit->valData;
+      hasLow = true;
+      lowInclude = (cunit->rfunc == 5);
+      break;
+    case 6:
+    case 7:
+      pHigh = cunit->valData;
+      hasHigh = true;
+      highInclude = (cunit->rfunc == 7);
+      break;
+    default:
+      if (cunit->optr != OP_TYPE_EQUAL) {
+        return false;
+      }
+      pLow = pHigh = cunit->valData;
+      hasLow = hasHigh = true;
+      break;
+  }
+
+  // the value is not a constant
+  if ((hasLow && pLow == NULL) || (hasHigh && pHigh == NULL)) {
+    return false;
+  }
+
+  if (IS_FLOAT_TYPE(type)) {
+    k->kind = FLT_BITMAP_FLOAT_RANGE;
+    if (hasLow) {
+      k->dlo = (type == TSDB_DATA_TYPE_FLOAT) ? GET_FLOAT_VAL(pLow) : GET_DOUBLE_VAL(pLow);
+    }
+    if (hasHigh) {
+      k->dhi = (type == TSDB_DATA_TYPE_FLOAT) ? GET_FLOAT_VAL(pHigh) : GET_DOUBLE_VAL(pHigh);
+    }
+    k->loMin = hasLow ? (lowInclude ? 0 : 1) : -1;
+    k->hiMax = hasHigh ? (highInclude ? 0 : -1) : 1;
+    return true;
+  }
+
+  k->kind = FLT_BITMAP_RANGE;
+  k->lo = INT64_MIN;
+  k->hi = INT64_MAX;
+  if (hasLow) {
+    k->lo = fltGetBitmapKey(type, pLow);
+    if (!lowInclude) {
+      k->empty = (k->lo == INT64_MAX);
+      k->lo += !k->empty;
+    }
+  }
+  if (hasHigh) {
+    k->hi = fltGetBitmapKey(type, pHigh);
+    if (!highInclude) {
+      k->empty = k->empty || (k->hi == INT64_MIN);
+      k->hi -= (k->hi != INT64_MIN);
+    }
+  }
+  k->empty = k->empty || (k->lo > k->hi);
+  return true;
+}
+
+static void fltBitmapClearTail(uint64_t *pBits, int32_t numOfRows, int32_t words) {
+  uint8_t *bits = (uint8_t *)pBits;
+  int32_t  len = BitmapLen(numOfRows);
+  if (numOfRows & 7) {
+    bits[len - 1] &= (uint8_t)(0xFF << (8 - (numOfRows & 7)));
+  }
+  memset(bits + len, 0, words * sizeof(uint64_t) - len);
+}
+
+static FORCE_INLINE int32_t fltBitmapPopcount(uint64_t x) {
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int32_t)((x * 0x0101010101010101ULL) >> 56);
+}
+
+static int32_t fltBitmapCount(const uint64_t *pBits, int32_t words) {
+  int32_t num = 0;
+  for (int32_t i = 0; i < words; ++i) {
+    num += fltBitmapPopcount(pBits[i]);
+  }
+  return num;
+}
+
+static bool fltBitmapIsEmpty(const uint64_t *pBits, int32_t words) {
+  uint64_t any = 0;
+  for (int32_t i = 0; i < words; ++i) {
+    any |= pBits[i];
+  }
+  return any == 0;
+}
+
+static void filterExecuteUnitBitmap(SFilterComUnit *cunit, int32_t numOfRows, uint64_t *pBits, int32_t words) {
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+  uint8_t         *bits = (uint8_t *)pBits;
+  uint8_t         *nullBits = (uint8_t *)pCol->nullbitmap;
+  int32_t          len = BitmapLen(numOfRows);
+  SFltBitmapKernel k;
+
+  if (!IS_VAR_DATA_TYPE(pCol->info.type) && (cunit->optr == OP_TYPE_IS_NULL || cunit->optr == OP_TYPE_IS_NOT_NULL)) {
+    if (pCol->hasNull) {
+      memcpy(bits, nullBits, len);
+    } else {
+      memset(bits, 0, len);
+    }
+    if (cunit->optr == OP_TYPE_IS_NOT_NULL) {
+      for (int32_t i = 0; i < len; ++i) {
+        bits[i] = ~bits[i];
+      }
+    }
+    fltBitmapClearTail(pBits, numOfRows, words);
+    return;
+  }
+
+  if (!fltPrepareBitmapKernel(cunit, &k)) {
+    memset(pBits, 0, words * sizeof(uint64_t));
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      if (filterExecuteUnitOnRow(cunit, i)) {
+        bits[i >> 3] |= (uint8_t)(1u << (7u - BitPos(i)));
+      }
+    }
+    return;
+  }
+
+  if (k.empty) {
+    memset(bits, 0, len);
+  } else if (k.kind == FLT_BITMAP_IN) {
+    (*fltGetInBitmapKernel(pCol->info.bytes))(pCol->pData, numOfRows, k.in, k.numOfIn, bits);
+  } else if (k.kind == FLT_BITMAP_FLOAT_RANGE) {
+    if (pCol->info.type == TSDB_DATA_TYPE_FLOAT) {
+      fltRangeBitmapFloat(pCol->pData, numOfRows, &k, bits);
+    } else {
+      fltRangeBitmapDouble(pCol->pData, numOfRows, &k, bits);
+    }
+  } else {
+    (*fltGetRangeBitmapKernel(pCol->info.type))(pCol->pData, numOfRows, k.lo, k.hi, bits);
+  }
+
+  if (pCol->hasNull) {
+    for (int32_t i = 0; i < len; ++i) {
+      bits[i] &= ~nullBits[i];
+    }
+  }
+
+  fltBitmapClearTail(pBits, numOfRows, words);
+}
+
+static int32_t fltEnsureBitmapBuf(SFilterInfo *info, int32_t words) {
+  if (info->bitmapWords >= words) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // the result, the group and the unit bitmap
+  uint64_t *pBuf = taosMemoryRealloc(info->bitmapBuf, 3 * words * sizeof(uint64_t));
+  if (pBuf == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  info->bitmapBuf = pBuf;
+  info->bitmapWords = words;
+  return TSDB_CODE_SUCCESS;
+}
+
 bool filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis, int16_t numOfCols,
                        int32_t *numOfQualified) {
   SFilterInfo *info = (SFilterInfo *)pinfo;
@@ -3229,75 +3759,52 @@ bool filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SC
   }
 
   int8_t *p = (int8_t *)pRes->pData;
+  int32_t words = (numOfRows + 63) / 64;
+  if (fltEnsureBitmapBuf(info, words) != TSDB_CODE_SUCCESS) {
+    return filterExecuteImplByRow(info, numOfRows, p, numOfQualified);
+  }
 
-  for (int32_t i = 0; i < numOfRows; ++i) {
-    // FILTER_UNIT_CLR_F(info);
-
-    for (uint32_t g = 0; g < info->groupNum; ++g) {
-      SFilterGroup *group = &info->groups[g];
-      for (uint32_t u = 0; u < group->unitNum; ++u) {
-        uint32_t        uidx = group->unitIdxs[u];
-        SFilterComUnit *cunit = &info->cunits[uidx];
-        void           *colData = NULL;
-        bool            isNull = colDataIsNull((SColumnInfoData *)(cunit->colData), 0, i, NULL);
-        // if (FILTER_UNIT_GET_F(info, uidx)) {
-        //   p[i] = FILTER_UNIT_GET_R(info, uidx);
-        // } else {
-        uint8_t optr = cunit->optr;
-
-        if (!isNull) {
-          colData = colDataGetData((SColumnInfoData *)(cunit->colData), i);
-        }
-
-        if (colData == NULL || isNull) {
-          p[i] = optr == OP_TYPE_IS_NULL ? true : false;
-        } else {
-          if (optr == OP_TYPE_IS_NOT_NULL) {
-            p[i] = 1;
-          } else if (optr == OP_TYPE_IS_NULL) {
-            p[i] = 0;
-          } else if (cunit->rfunc >= 0) {
-            p[i] = (*gRangeCompare[cunit->rfunc])(colData, colData, cunit->valData, cunit->valData2,
-                                                  gDataCompare[cunit->func]);
-          } else {
-            if (cunit->dataType == TSDB_DATA_TYPE_NCHAR &&
-                (cunit->optr == OP_TYPE_MATCH || cunit->optr == OP_TYPE_NMATCH)) {
-              char   *newColData = taosMemoryCalloc(cunit->dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE, 1);
-              int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
-              if (len < 0) {
-                qError("castConvert1 taosUcs4ToMbs error");
-              } else {
-                varDataSetLen(newColData, len);
-                p[i] = filterDoCompare(gDataCompare[cunit->func], cunit->optr, newColData, cunit->valData);
-              }
-              taosMemoryFreeClear(newColData);
-            } else {
-              p[i] = filterDoCompare(gDataCompare[cunit->func], cunit->optr, colData, cunit->valData);
-            }
-          }
+  uint64_t *pResBits = info->bitmapBuf;
+  uint64_t *pGroupBits = pResBits + words;
+  uint64_t *pUnitBits = pGroupBits + words;
+  int32_t   numOfSelected = 0;
 
-          // FILTER_UNIT_SET_R(info, uidx, p[i]);
-          // FILTER_UNIT_SET_F(info, uidx);
-        }
+  memset(pResBits, 0, words * sizeof(uint64_t));
+  for (uint32_t g = 0; g < info->groupNum && numOfSelected < numOfRows; ++g) {
+    SFilterGroup *group = &info->groups[g];
+    bool          empty = (group->unitNum == 0);
 
-        if (p[i] == 0) {
-          break;
+    for (uint32_t u = 0; u < group->unitNum && !empty; ++u) {
+      SFilterComUnit *cunit = &info->cunits[group->unitIdxs[u]];
+      if (u == 0) {
+        filterExecuteUnitBitmap(cunit, numOfRows, pGroupBits, words);
+      } else {
+        filterExecuteUnitBitmap(cunit, numOfRows, pUnitBits, words);
+        for (int32_t i = 0; i < words; ++i) {
+          pGroupBits[i] &= pUnitBits[i];
         }
       }
 
-      if (p[i]) {
-        break;
-      }
+      empty = fltBitmapIsEmpty(pGroupBits, words);
     }
 
-    if (p[i] == 0) {
-      all = false;
-    } else {
-      (*numOfQualified) += 1;
+    if (empty) {
+      continue;
     }
+
+    for (int32_t i = 0; i < words; ++i) {
+      pResBits[i] |= pGroupBits[i];
+    }
+    numOfSelected = fltBitmapCount(pResBits, words);
   }
 
-  return all;
+  const uint8_t *bits = (const uint8_t *)pResBits;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    p[i] = (bits[i >> 3] >> (7 - BitPos(i))) & 1;
+  }
+
+  (*numOfQualified) += numOfSelected;
+  return numOfSelected == numOfRows;
 }
 
 int32_t filterSetExecFunc(SFilterInfo *info) {
@@ -3326,6 +3833,11 @@ int32_t filterSetExecFunc(SFilterInfo *info) {
     return TSDB_CODE_SUCCESS;
   }
 
+  if (!IS_VAR_DATA_TYPE(info->cunits[0].dataType)) {
+    info->func = filterExecuteImpl;
+    return TSDB_CODE_SUCCESS;
+  }
+
   if (info->cunits[0].rfunc >= 0) {
     info->func = filterExecuteImplRange;
     return TSDB_CODE_SUCCESS;
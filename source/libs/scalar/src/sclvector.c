@@ -1006,6 +1006,180 @@ enum {
   VECTOR_UN_CONVERT = 0x2,
 };
 
+/*
+ * Type specialized kernels of the arithmetic operators. The output of +, -, * and / is always double, so a kernel is
+ * generated for each combination of the operand types, which the compiler turns into branch free, vectorized loops
+ * instead of two indirect calls per row. Null rows are computed as well and masked by the combined null bitmap.
+ */
+enum {
+  SCL_MATH_ADD = 0,
+  SCL_MATH_SUB,
+  SCL_MATH_MULTI,
+  SCL_MATH_DIV,
+  SCL_MATH_MAX,
+};
+
+typedef void (*_math_col_kernel_fn_t)(const void *pLeft, const void *pRight, SColumnInfoData *pOutputCol,
+                                      int32_t numOfRows);
+typedef void (*_math_const_kernel_fn_t)(const void *pCol, double v, SColumnInfoData *pOutputCol, int32_t numOfRows);
+
+#define SCL_MATH_TYPES_L(_fn, ...)                                                                          \
+  _fn(BOOL, bool, __VA_ARGS__) _fn(TINYINT, int8_t, __VA_ARGS__) _fn(SMALLINT, int16_t, __VA_ARGS__)        \
+  _fn(INT, int32_t, __VA_ARGS__) _fn(BIGINT, int64_t, __VA_ARGS__) _fn(TIMESTAMP, int64_t, __VA_ARGS__)     \
+  _fn(UTINYINT, uint8_t, __VA_ARGS__) _fn(USMALLINT, uint16_t, __VA_ARGS__) _fn(UINT, uint32_t, __VA_ARGS__) \
+  _fn(UBIGINT, uint64_t, __VA_ARGS__) _fn(FLOAT, float, __VA_ARGS__) _fn(DOUBLE, double, __VA_ARGS__)
+
+#define SCL_MATH_TYPES_R(_fn, ...)                                                                          \
+  _fn(BOOL, bool, __VA_ARGS__) _fn(TINYINT, int8_t, __VA_ARGS__) _fn(SMALLINT, int16_t, __VA_ARGS__)        \
+  _fn(INT, int32_t, __VA_ARGS__) _fn(BIGINT, int64_t, __VA_ARGS__) _fn(TIMESTAMP, int64_t, __VA_ARGS__)     \
+  _fn(UTINYINT, uint8_t, __VA_ARGS__) _fn(USMALLINT, uint16_t, __VA_ARGS__) _fn(UINT, uint32_t, __VA_ARGS__) \
+  _fn(UBIGINT, uint64_t, __VA_ARGS__) _fn(FLOAT, float, __VA_ARGS__) _fn(DOUBLE, double, __VA_ARGS__)
+
+// the divide kernels also set the rows divided by 0 to NULL, just like the row by row implementation
+#define SCL_MATH_MARK_DIV_ZERO_ADD(_p, _n)
+#define SCL_MATH_MARK_DIV_ZERO_SUB(_p, _n)
+#define SCL_MATH_MARK_DIV_ZERO_MULTI(_p, _n)
+#define SCL_MATH_MARK_DIV_ZERO_DIV(_p, _n)   \
+  for (int32_t i = 0; i < (_n); ++i) {       \
+    if ((_p)[i] == 0) {                      \
+      colDataSetNULL(pOutputCol, i);         \
+    }                                        \
+  }
+
+#define SCL_DEFINE_MATH_COL_KERNEL(_rn, _rt, _ln, _lt, _opn, _op)                                                   \
+  static void vectorMath##_opn##_##_ln##_##_rn(const void *pLeft, const void *pRight, SColumnInfoData *pOutputCol, \
+                                               int32_t numOfRows) {                                              \
+    const _lt *l = (const _lt *)pLeft;                                                                            \
+    const _rt *r = (const _rt *)pRight;                                                                           \
+    double    *o = (double *)pOutputCol->pData;                                                                   \
+    for (int32_t i = 0; i < numOfRows; ++i) {                                                                     \
+      o[i] = (double)l[i] _op(double) r[i];                                                                       \
+    }                                                                                                             \
+    SCL_MATH_MARK_DIV_ZERO_##_opn(r, numOfRows)                                                                   \
+  }
+
+#define SCL_DEFINE_MATH_CONST_KERNEL(_cn, _ct, _opn, _op)                                                           \
+  static void vectorMath##_opn##_##_cn##_Const(const void *pCol, double v, SColumnInfoData *pOutputCol,           \
+                                               int32_t numOfRows) {                                              \
+    const _ct *c = (const _ct *)pCol;                                                                             \
+    double    *o = (double *)pOutputCol->pData;                                                                   \
+    for (int32_t i = 0; i < numOfRows; ++i) {                                                                     \
+      o[i] = (double)c[i] _op v;                                                                                  \
+    }                                                                                                             \
+  }                                                                                                               \
+  static void vectorMath##_opn##_Const_##_cn(const void *pCol, double v, SColumnInfoData *pOutputCol,           \
+                                               int32_t numOfRows) {                                              \
+    const _ct *c = (const _ct *)pCol;                                                                             \
+    double    *o = (double *)pOutputCol->pData;                                                                   \
+    for (int32_t i = 0; i < numOfRows; ++i) {                                                                     \
+      o[i] = v _op(double) c[i];                                                                                  \
+    }                                                                                                             \
+    SCL_MATH_MARK_DIV_ZERO_##_opn(c, numOfRows)                                                                   \
+  }
+
+#define SCL_DEFINE_MATH_COL_KERNELS(_ln, _lt, _opn, _op) \
+  SCL_MATH_TYPES_R(SCL_DEFINE_MATH_COL_KERNEL, _ln, _lt, _opn, _op)
+#define SCL_DEFINE_MATH_KERNELS(_opn, _op)                  \
+  SCL_MATH_TYPES_L(SCL_DEFINE_MATH_COL_KERNELS, _opn, _op) \
+  SCL_MATH_TYPES_L(SCL_DEFINE_MATH_CONST_KERNEL, _opn, _op)
+
+SCL_DEFINE_MATH_KERNELS(ADD, +)
+SCL_DEFINE_MATH_KERNELS(SUB, -)
+SCL_DEFINE_MATH_KERNELS(MULTI, *)
+SCL_DEFINE_MATH_KERNELS(DIV, /)
+
+#define SCL_MATH_COL_ENTRY(_rn, _rt, _ln, _lt, _opn) \
+  [SCL_MATH_##_opn][TSDB_DATA_TYPE_##_ln][TSDB_DATA_TYPE_##_rn] = vectorMath##_opn##_##_ln##_##_rn,
+#define SCL_MATH_COL_ENTRIES(_ln, _lt, _opn) SCL_MATH_TYPES_R(SCL_MATH_COL_ENTRY, _ln, _lt, _opn)
+#define SCL_MATH_COL_CONST_ENTRY(_cn, _ct, _opn) \
+  [SCL_MATH_##_opn][TSDB_DATA_TYPE_##_cn] = vectorMath##_opn##_##_cn##_Const,
+#define SCL_MATH_CONST_COL_ENTRY(_cn, _ct, _opn) \
+  [SCL_MATH_##_opn][TSDB_DATA_TYPE_##_cn] = vectorMath##_opn##_Const_##_cn,
+
+static const _math_col_kernel_fn_t gMathColKernels[SCL_MATH_MAX][TSDB_DATA_TYPE_MAX][TSDB_DATA_TYPE_MAX] = {
+    SCL_MATH_TYPES_L(SCL_MATH_COL_ENTRIES, ADD) SCL_MATH_TYPES_L(SCL_MATH_COL_ENTRIES, SUB)
+    SCL_MATH_TYPES_L(SCL_MATH_COL_ENTRIES, MULTI) SCL_MATH_TYPES_L(SCL_MATH_COL_ENTRIES, DIV)};
+
+static const _math_const_kernel_fn_t gMathColConstKernels[SCL_MATH_MAX][TSDB_DATA_TYPE_MAX] = {
+    SCL_MATH_TYPES_L(SCL_MATH_COL_CONST_ENTRY, ADD) SCL_MATH_TYPES_L(SCL_MATH_COL_CONST_ENTRY, SUB)
+    SCL_MATH_TYPES_L(SCL_MATH_COL_CONST_ENTRY, MULTI) SCL_MATH_TYPES_L(SCL_MATH_COL_CONST_ENTRY, DIV)};
+
+static const _math_const_kernel_fn_t gMathConstColKernels[SCL_MATH_MAX][TSDB_DATA_TYPE_MAX] = {
+    SCL_MATH_TYPES_L(SCL_MATH_CONST_COL_ENTRY, ADD) SCL_MATH_TYPES_L(SCL_MATH_CONST_COL_ENTRY, SUB)
+    SCL_MATH_TYPES_L(SCL_MATH_CONST_COL_ENTRY, MULTI) SCL_MATH_TYPES_L(SCL_MATH_CONST_COL_ENTRY, DIV)};
+
+// or the null bitmap of the input column into the output column
+static void vectorMathMergeNullBitmap(SColumnInfoData *pOutputCol, const SColumnInfoData *pInputCol,
+                                      int32_t numOfRows) {
+  if (!pInputCol->hasNull) {
+    return;
+  }
+
+  char   *dst = pOutputCol->nullbitmap;
+  char   *src = pInputCol->nullbitmap;
+  int32_t len = BitmapLen(numOfRows);
+  char    any = 0;
+  for (int32_t i = 0; i < len; ++i) {
+    dst[i] |= src[i];
+    any |= src[i];
+  }
+
+  if (any) {
+    pOutputCol->hasNull = true;
+  }
+}
+
+// Returns false if the operands are not supported by the specialized kernels, and the caller falls back to the row by
+// row implementation. Operands converted from var data keep their null flags in the original column, so they always
+// fall back.
+static bool vectorMathByKernel(int32_t op, SScalarParam *pLeft, SScalarParam *pRight, SColumnInfoData *pLeftCol,
+                               SColumnInfoData *pRightCol, SColumnInfoData *pOutputCol, int32_t _ord) {
+  int32_t leftType = pLeftCol->info.type;
+  int32_t rightType = pRightCol->info.type;
+  int32_t leftRows = pLeft->numOfRows;
+  int32_t rightRows = pRight->numOfRows;
+  if (_ord != TSDB_ORDER_ASC || pOutputCol->info.type != TSDB_DATA_TYPE_DOUBLE || pLeftCol != pLeft->columnData ||
+      pRightCol != pRight->columnData || leftType < 0 || leftType >= TSDB_DATA_TYPE_MAX || rightType < 0 ||
+      rightType >= TSDB_DATA_TYPE_MAX) {
+    return false;
+  }
+
+  if (leftRows == rightRows) {
+    _math_col_kernel_fn_t fp = gMathColKernels[op][leftType][rightType];
+    if (fp == NULL) {
+      return false;
+    }
+
+    fp(pLeftCol->pData, pRightCol->pData, pOutputCol, leftRows);
+    vectorMathMergeNullBitmap(pOutputCol, pLeftCol, leftRows);
+    vectorMathMergeNullBitmap(pOutputCol, pRightCol, leftRows);
+    return true;
+  }
+
+  SColumnInfoData *pConstCol = (leftRows == 1) ? pLeftCol : pRightCol;
+  SColumnInfoData *pCol = (leftRows == 1) ? pRightCol : pLeftCol;
+  int32_t          numOfRows = (leftRows == 1) ? rightRows : leftRows;
+  if (leftRows != 1 && rightRows != 1) {
+    return false;
+  }
+
+  _math_const_kernel_fn_t fp =
+      (leftRows == 1) ? gMathConstColKernels[op][rightType] : gMathColConstKernels[op][leftType];
+  if (fp == NULL || getVectorDoubleValueFn(pConstCol->info.type) == NULL) {
+    return false;
+  }
+
+  double v = getVectorDoubleValueFn(pConstCol->info.type)(pConstCol->pData, 0);
+  if (colDataIsNull_s(pConstCol, 0) || (op == SCL_MATH_DIV && pConstCol == pRightCol && v == 0)) {
+    colDataSetNNULL(pOutputCol, 0, numOfRows);
+    return true;
+  }
+
+  fp(pCol->pData, v, pOutputCol, numOfRows);
+  vectorMathMergeNullBitmap(pOutputCol, pCol, numOfRows);
+  return true;
+}
+
 // TODO not correct for descending order scan
 static void vectorMathAddHelper(SColumnInfoData *pLeftCol, SColumnInfoData *pRightCol, SColumnInfoData *pOutputCol,
                                 int32_t numOfRows, int32_t step, int32_t i) {
@@ -1117,7 +1291,7 @@ void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
         *output = getVectorBigintValueFnLeft(pLeftCol->pData, i) + getVectorBigintValueFnRight(pRightCol->pData, i);
       }
     }
-  } else {
+  } else if (!vectorMathByKernel(SCL_MATH_ADD, pLeft, pRight, pLeftCol, pRightCol, pOutputCol, _ord)) {
     double              *output = (double *)pOutputCol->pData;
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
     _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
@@ -1218,7 +1392,7 @@ void vectorMathSub(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
         *output = getVectorBigintValueFnLeft(pLeftCol->pData, i) - getVectorBigintValueFnRight(pRightCol->pData, i);
       }
     }
-  } else {
+  } else if (!vectorMathByKernel(SCL_MATH_SUB, pLeft, pRight, pLeftCol, pRightCol, pOutputCol, _ord)) {
     double              *output = (double *)pOutputCol->pData;
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
     _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
@@ -1274,6 +1448,12 @@ void vectorMathMultiply(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam
   SColumnInfoData *pLeftCol = vectorConvertVarToDouble(pLeft, &leftConvert);
   SColumnInfoData *pRightCol = vectorConvertVarToDouble(pRight, &rightConvert);
 
+  if (vectorMathByKernel(SCL_MATH_MULTI, pLeft, pRight, pLeftCol, pRightCol, pOutputCol, _ord)) {
+    doReleaseVec(pLeftCol, leftConvert);
+    doReleaseVec(pRightCol, rightConvert);
+    return;
+  }
+
   _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
   _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
@@ -1307,6 +1487,12 @@ void vectorMathDivide(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *p
   SColumnInfoData *pLeftCol = vectorConvertVarToDouble(pLeft, &leftConvert);
   SColumnInfoData *pRightCol = vectorConvertVarToDouble(pRight, &rightConvert);
 
+  if (vectorMathByKernel(SCL_MATH_DIV, pLeft, pRight, pLeftCol, pRightCol, pOutputCol, _ord)) {
+    doReleaseVec(pLeftCol, leftConvert);
+    doReleaseVec(pRightCol, rightConvert);
+    return;
+  }
+
   _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
   _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
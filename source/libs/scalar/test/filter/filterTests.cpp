@@ -14,6 +14,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <functional>
 #include <iostream>
 
 #pragma GCC diagnostic push
@@ -36,6 +37,7 @@
 #include "filterInt.h"
 #include "nodes.h"
 #include "scalar.h"
+#include "sclInt.h"
 #include "stub.h"
 #include "taos.h"
 #include "tdatablock.h"
@@ -1341,6 +1343,305 @@ TEST(scalarModelogicTest, diff_columns_or_and_or) {
 }
 #endif
 
+namespace {
+
+const int32_t flttBitmapRowNums[] = {1, 5, 8, 31, 32, 33, 63, 64, 65, 100, 1027, 4099};
+
+// every 13th row is null, and for the float types every 11th value is a NaN
+void flttMakeBitmapColumn(SNode **pNode, SSDataBlock **block, int32_t type, int32_t rowNum) {
+  int32_t bytes = tDataTypes[type].bytes;
+  char   *values = (char *)taosMemoryCalloc(rowNum, bytes);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    int64_t v = (i * 7919) % 41 - 20;
+    char   *p = values + i * bytes;
+    switch (type) {
+      case TSDB_DATA_TYPE_BOOL:
+        *(bool *)p = (v > 0);
+        break;
+      case TSDB_DATA_TYPE_TINYINT:
+        *(int8_t *)p = (int8_t)v;
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        *(int16_t *)p = (int16_t)v;
+        break;
+      case TSDB_DATA_TYPE_INT:
+        *(int32_t *)p = (int32_t)v;
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        *(int64_t *)p = v;
+        break;
+      case TSDB_DATA_TYPE_UTINYINT:
+        *(uint8_t *)p = (uint8_t)(v + 20);
+        break;
+      case TSDB_DATA_TYPE_USMALLINT:
+        *(uint16_t *)p = (uint16_t)(v + 20);
+        break;
+      case TSDB_DATA_TYPE_UINT:
+        *(uint32_t *)p = (uint32_t)(v + 20);
+        break;
+      case TSDB_DATA_TYPE_UBIGINT:
+        *(uint64_t *)p = (uint64_t)(v + 20);
+        break;
+      case TSDB_DATA_TYPE_FLOAT:
+        *(float *)p = (i % 11 == 3) ? NAN : v / 4.0f;
+        break;
+      case TSDB_DATA_TYPE_DOUBLE:
+        *(double *)p = (i % 11 == 3) ? NAN : v / 4.0;
+        break;
+      default:
+        break;
+    }
+  }
+
+  flttMakeColumnNode(pNode, block, type, bytes, rowNum, values);
+  taosMemoryFree(values);
+
+  SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGetLast((*block)->pDataBlock);
+  for (int32_t i = 0; i < rowNum; i += 13) {
+    colDataSetNULL(pCol, i);
+  }
+}
+
+// a constant of the column type, unsigned columns hold the values shifted by 20
+void flttMakeBitmapValueNode(SNode **pNode, int32_t type, double v) {
+  int64_t iv = (int64_t)v;
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL: {
+      bool b = (iv > 0);
+      flttMakeValueNode(pNode, type, &b);
+      break;
+    }
+    case TSDB_DATA_TYPE_TINYINT: {
+      int8_t t = (int8_t)iv;
+      flttMakeValueNode(pNode, type, &t);
+      break;
+    }
+    case TSDB_DATA_TYPE_SMALLINT: {
+      int16_t t = (int16_t)iv;
+      flttMakeValueNode(pNode, type, &t);
+      break;
+    }
+    case TSDB_DATA_TYPE_INT: {
+      int32_t t = (int32_t)iv;
+      flttMakeValueNode(pNode, type, &t);
+      break;
+    }
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      flttMakeValueNode(pNode, type, &iv);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT: {
+      uint8_t t = (uint8_t)(iv + 20);
+      flttMakeValueNode(pNode, type, &t);
+      break;
+    }
+    case TSDB_DATA_TYPE_USMALLINT: {
+      uint16_t t = (uint16_t)(iv + 20);
+      flttMakeValueNode(pNode, type, &t);
+      break;
+    }
+    case TSDB_DATA_TYPE_UINT: {
+      uint32_t t = (uint32_t)(iv + 20);
+      flttMakeValueNode(pNode, type, &t);
+      break;
+    }
+    case TSDB_DATA_TYPE_UBIGINT: {
+      uint64_t t = (uint64_t)(iv + 20);
+      flttMakeValueNode(pNode, type, &t);
+      break;
+    }
+    case TSDB_DATA_TYPE_FLOAT: {
+      float f = (float)v;
+      flttMakeValueNode(pNode, type, &f);
+      break;
+    }
+    case TSDB_DATA_TYPE_DOUBLE:
+      flttMakeValueNode(pNode, type, &v);
+      break;
+    default:
+      break;
+  }
+}
+
+SNode *flttMakeBitmapOpNode(int32_t type, EOperatorType opType, double v) {
+  SNode *pCol = NULL, *pVal = NULL, *pOp = NULL;
+  flttMakeColumnNode(&pCol, NULL, type, tDataTypes[type].bytes, 0, NULL);
+  if (opType != OP_TYPE_IS_NULL && opType != OP_TYPE_IS_NOT_NULL) {
+    flttMakeBitmapValueNode(&pVal, type, v);
+  }
+  flttMakeOpNode(&pOp, opType, TSDB_DATA_TYPE_BOOL, pCol, pVal);
+  return pOp;
+}
+
+// the range between lo and hi, each end closed or open
+SNode *flttMakeBitmapRangeNode(int32_t type, double lo, bool loClosed, double hi, bool hiClosed) {
+  SNode *list[2] = {0};
+  SNode *pLogic = NULL;
+  list[0] = flttMakeBitmapOpNode(type, loClosed ? OP_TYPE_GREATER_EQUAL : OP_TYPE_GREATER_THAN, lo);
+  list[1] = flttMakeBitmapOpNode(type, hiClosed ? OP_TYPE_LOWER_EQUAL : OP_TYPE_LOWER_THAN, hi);
+  flttMakeLogicNode(&pLogic, LOGIC_COND_TYPE_AND, list, 2);
+  return pLogic;
+}
+
+SNode *flttMakeBitmapInNode(int32_t type, EOperatorType opType, const std::vector<double> &values) {
+  SNode     *pCol = NULL, *pList = NULL, *pOp = NULL;
+  SNodeList *list = nodesMakeList();
+  for (double v : values) {
+    SNode *pVal = NULL;
+    flttMakeBitmapValueNode(&pVal, type, v);
+    nodesListAppend(list, pVal);
+  }
+  flttMakeColumnNode(&pCol, NULL, type, tDataTypes[type].bytes, 0, NULL);
+  flttMakeListNode(&pList, list, type);
+  flttMakeOpNode(&pOp, opType, TSDB_DATA_TYPE_BOOL, pCol, pList);
+  return pOp;
+}
+
+// the filter keeps a row only where the scalar operators give true, a null result drops the row. The filter leaves
+// not equal and not in to the scalar operators, the other conditions are evaluated by the units of the filter.
+void flttCheckBitmapWithScalar(const std::function<SNode *()> &makeCond, int32_t type, const char *desc,
+                               bool scalarMode = false) {
+  for (int32_t rowNum : flttBitmapRowNums) {
+    SNode       *pColNode = NULL;
+    SSDataBlock *src = NULL;
+    flttMakeBitmapColumn(&pColNode, &src, type, rowNum);
+    nodesDestroyNode(pColNode);
+
+    SNode       *pScalarCond = makeCond();
+    SArray      *blockList = taosArrayInit(1, POINTER_BYTES);
+    SScalarParam expect = {0};
+    SDataType    resType = {.type = TSDB_DATA_TYPE_BOOL, .bytes = sizeof(bool)};
+    taosArrayPush(blockList, &src);
+    ASSERT_EQ(sclCreateColumnInfoData(&resType, rowNum, &expect), 0);
+    ASSERT_EQ(scalarCalculate(pScalarCond, blockList, &expect), 0);
+
+    SNode       *pCond = makeCond();
+    SFilterInfo *filter = NULL;
+    ASSERT_EQ(filterInitFromNode(pCond, &filter, 0), 0);
+    ASSERT_EQ(filter->scalarMode, scalarMode) << desc << ", type " << tDataTypes[type].name;
+    SFilterColumnParam param = {(int32_t)taosArrayGetSize(src->pDataBlock), src->pDataBlock};
+    ASSERT_EQ(filterSetDataFromSlotId(filter, &param), 0);
+
+    SColumnInfoData *pRes = NULL;
+    int32_t          status = 0;
+    filterExecute(filter, src, &pRes, NULL, (int16_t)taosArrayGetSize(src->pDataBlock), &status);
+    ASSERT_TRUE(pRes != NULL);
+
+    int32_t numOfQualified = 0;
+    for (int32_t i = 0; i < rowNum; ++i) {
+      bool e = !colDataIsNull_s(expect.columnData, i) && *(bool *)colDataGetData(expect.columnData, i);
+      ASSERT_EQ(((int8_t *)pRes->pData)[i], (int8_t)e)
+          << desc << ", type " << tDataTypes[type].name << ", row " << i << " of " << rowNum;
+      numOfQualified += e;
+    }
+    int32_t expectStatus = (numOfQualified == rowNum) ? FILTER_RESULT_ALL_QUALIFIED
+                           : (numOfQualified == 0)    ? FILTER_RESULT_NONE_QUALIFIED
+                                                      : FILTER_RESULT_PARTIAL_QUALIFIED;
+    ASSERT_EQ(status, expectStatus);
+
+    colDataDestroy(pRes);
+    taosMemoryFree(pRes);
+    colDataDestroy(expect.columnData);
+    taosMemoryFree(expect.columnData);
+    filterFreeInfo(filter);
+    nodesDestroyNode(pCond);
+    nodesDestroyNode(pScalarCond);
+    taosArrayDestroy(blockList);
+    blockDataDestroy(src);
+  }
+}
+
+void flttBitmapTest(const std::vector<int32_t> &types) {
+  const EOperatorType ops[] = {OP_TYPE_GREATER_THAN, OP_TYPE_GREATER_EQUAL, OP_TYPE_LOWER_THAN,
+                               OP_TYPE_LOWER_EQUAL,  OP_TYPE_EQUAL,         OP_TYPE_NOT_EQUAL};
+
+  for (int32_t type : types) {
+    for (EOperatorType op : ops) {
+      for (double v : {-21.0, -3.0, 0.0, 2.0, 20.0}) {
+        flttCheckBitmapWithScalar([=]() { return flttMakeBitmapOpNode(type, op, v); }, type, "compare",
+                                  op == OP_TYPE_NOT_EQUAL);
+      }
+    }
+
+    // open and closed ends, and ranges with no value in them
+    for (int32_t ends = 0; ends < 4; ++ends) {
+      bool loClosed = (ends & 2), hiClosed = (ends & 1);
+      flttCheckBitmapWithScalar([=]() { return flttMakeBitmapRangeNode(type, -5.0, loClosed, 7.0, hiClosed); },
+                                type, "range");
+      flttCheckBitmapWithScalar([=]() { return flttMakeBitmapRangeNode(type, 3.0, loClosed, 3.0, hiClosed); },
+                                type, "point range");
+      flttCheckBitmapWithScalar([=]() { return flttMakeBitmapRangeNode(type, 4.0, loClosed, -4.0, hiClosed); },
+                                type, "empty range");
+    }
+
+    std::vector<double> in = {-20.0, -7.0, 0.0, 5.0, 13.0};
+    std::vector<double> inMax(FILTER_BITMAP_MAX_IN_VALUES);
+    for (int32_t i = 0; i < FILTER_BITMAP_MAX_IN_VALUES; ++i) {
+      inMax[i] = i * 3 - 10;
+    }
+    for (EOperatorType op : {OP_TYPE_IN, OP_TYPE_NOT_IN}) {
+      flttCheckBitmapWithScalar([=]() { return flttMakeBitmapInNode(type, op, in); }, type, "in",
+                                op == OP_TYPE_NOT_IN);
+      flttCheckBitmapWithScalar([=]() { return flttMakeBitmapInNode(type, op, inMax); }, type, "in max values",
+                                op == OP_TYPE_NOT_IN);
+    }
+
+    for (EOperatorType op : {OP_TYPE_IS_NULL, OP_TYPE_IS_NOT_NULL}) {
+      flttCheckBitmapWithScalar([=]() { return flttMakeBitmapOpNode(type, op, 0); }, type, "null");
+    }
+
+    // a null check and a range in one group, and two groups
+    flttCheckBitmapWithScalar(
+        [=]() {
+          SNode *list[2] = {flttMakeBitmapOpNode(type, OP_TYPE_IS_NOT_NULL, 0),
+                            flttMakeBitmapRangeNode(type, -10.0, true, 10.0, false)};
+          SNode *pLogic = NULL;
+          flttMakeLogicNode(&pLogic, LOGIC_COND_TYPE_AND, list, 2);
+          return pLogic;
+        },
+        type, "not null and range");
+    flttCheckBitmapWithScalar(
+        [=]() {
+          SNode *list[2] = {flttMakeBitmapOpNode(type, OP_TYPE_LOWER_THAN, -15.0),
+                            flttMakeBitmapRangeNode(type, 0.0, false, 10.0, true)};
+          SNode *pLogic = NULL;
+          flttMakeLogicNode(&pLogic, LOGIC_COND_TYPE_OR, list, 2);
+          return pLogic;
+        },
+        type, "or of ranges");
+  }
+}
+
+// runs the test with the avx2 kernels when the cpu has them, and with the plain kernels
+void flttBitmapTestWithSIMD(const std::vector<int32_t> &types) {
+  char sse42 = 0, avx = 0, avx2 = 0, fma = 0, avx512 = 0;
+  taosGetCpuInstructions(&sse42, &avx, &avx2, &fma, &avx512);
+
+  char simd = tsSIMDBuiltins, avx2Enable = tsAVX2Enable;
+  for (int32_t useSIMD = 0; useSIMD <= (avx2 ? 1 : 0); ++useSIMD) {
+    tsSIMDBuiltins = useSIMD;
+    tsAVX2Enable = useSIMD;
+    flttBitmapTest(types);
+  }
+  tsSIMDBuiltins = simd;
+  tsAVX2Enable = avx2Enable;
+}
+
+}  // namespace
+
+TEST(bitmapFilterTest, integer) {
+  flttBitmapTestWithSIMD({TSDB_DATA_TYPE_BOOL, TSDB_DATA_TYPE_TINYINT, TSDB_DATA_TYPE_SMALLINT, TSDB_DATA_TYPE_INT,
+                          TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_TIMESTAMP});
+}
+
+TEST(bitmapFilterTest, unsignedInteger) {
+  flttBitmapTestWithSIMD(
+      {TSDB_DATA_TYPE_UTINYINT, TSDB_DATA_TYPE_USMALLINT, TSDB_DATA_TYPE_UINT, TSDB_DATA_TYPE_UBIGINT});
+}
+
+TEST(bitmapFilterTest, floatWithNaN) { flttBitmapTestWithSIMD({TSDB_DATA_TYPE_FLOAT, TSDB_DATA_TYPE_DOUBLE}); }
+
 template <class SignedT, class UnsignedT>
 int32_t compareSignedWithUnsigned(SignedT l, UnsignedT r) {
   if (l < 0) return -1;
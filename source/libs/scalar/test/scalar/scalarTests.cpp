@@ -36,6 +36,7 @@
 #include "nodes.h"
 #include "parUtil.h"
 #include "scalar.h"
+#include "sclvector.h"
 #include "stub.h"
 #include "taos.h"
 #include "tdatablock.h"
@@ -3631,6 +3632,61 @@ TEST(ScalarFunctionTest, powFunction_column) {
   taosMemoryFree(pInput);
 }
 
+TEST(ScalarFunctionTest, arithmetic_kernel_null_and_zero) {
+  SScalarParam *pLeft, *pRight, *pConst, *pOutput;
+  int32_t       rowNum = 5;
+  int32_t       leftv[5] = {10, -4, 7, 9, 100};
+  int16_t       rightv[5] = {2, 0, -7, 3, 8};
+  int16_t       constv = 4;
+
+  scltMakeDataBlock(&pLeft, TSDB_DATA_TYPE_INT, 0, rowNum, false);
+  scltMakeDataBlock(&pRight, TSDB_DATA_TYPE_SMALLINT, 0, rowNum, false);
+  scltMakeDataBlock(&pConst, TSDB_DATA_TYPE_SMALLINT, &constv, 1, true);
+  scltMakeDataBlock(&pOutput, TSDB_DATA_TYPE_DOUBLE, 0, rowNum, false);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    colDataSetVal(pLeft->columnData, i, (const char *)&leftv[i], false);
+    colDataSetVal(pRight->columnData, i, (const char *)&rightv[i], false);
+  }
+  colDataSetNULL(pLeft->columnData, 2);
+  colDataSetNULL(pRight->columnData, 3);
+
+  // column / column, the rows with a null operand or divided by 0 are null
+  getBinScalarOperatorFn(OP_TYPE_DIV)(pLeft, pRight, pOutput, TSDB_ORDER_ASC);
+  bool   isNull[5] = {false, true, true, true, false};
+  double divRes[5] = {5, 0, 0, 0, 12.5};
+  for (int32_t i = 0; i < rowNum; ++i) {
+    ASSERT_EQ(colDataIsNull_s(pOutput->columnData, i), isNull[i]);
+    if (!isNull[i]) {
+      ASSERT_EQ(*((double *)colDataGetData(pOutput->columnData, i)), divRes[i]);
+    }
+  }
+  scltDestroyDataBlock(pOutput);
+
+  // constant - column
+  scltMakeDataBlock(&pOutput, TSDB_DATA_TYPE_DOUBLE, 0, rowNum, false);
+  getBinScalarOperatorFn(OP_TYPE_SUB)(pConst, pRight, pOutput, TSDB_ORDER_ASC);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    ASSERT_EQ(colDataIsNull_s(pOutput->columnData, i), i == 3);
+    if (i != 3) {
+      ASSERT_EQ(*((double *)colDataGetData(pOutput->columnData, i)), (double)constv - rightv[i]);
+    }
+  }
+  scltDestroyDataBlock(pOutput);
+
+  // column / null constant
+  scltMakeDataBlock(&pOutput, TSDB_DATA_TYPE_DOUBLE, 0, rowNum, false);
+  colDataSetNULL(pConst->columnData, 0);
+  getBinScalarOperatorFn(OP_TYPE_DIV)(pLeft, pConst, pOutput, TSDB_ORDER_ASC);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    ASSERT_TRUE(colDataIsNull_s(pOutput->columnData, i));
+  }
+
+  scltDestroyDataBlock(pLeft);
+  scltDestroyDataBlock(pRight);
+  scltDestroyDataBlock(pConst);
+  scltDestroyDataBlock(pOutput);
+}
+
 int main(int argc, char **argv) {
   taosSeedRand(taosGetTimestampSec());
   testing::InitGoogleTest(&argc, argv);
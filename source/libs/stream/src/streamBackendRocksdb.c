@@ -103,6 +103,9 @@ void* streamBackendInit(const char* path) {
   rocksdb_options_set_info_log_level(opts, 0);
   uint32_t dbLimit = nextPow2(tsMaxStreamBackendCache);
   rocksdb_options_set_db_write_buffer_size(opts, dbLimit << 20);
+  // whole key bloom in memtable, most state reads are point gets of windows that are not flushed yet
+  rocksdb_options_set_memtable_prefix_bloom_size_ratio(opts, 0.1);
+  rocksdb_options_set_memtable_whole_key_filtering(opts, 1);
 
   pHandle->env = env;
   pHandle->dbOpt = opts;
@@ -671,6 +674,23 @@ rocksdb_compactionfilter_t* compactFilteFactoryCreateFilter(void* arg, rocksdb_c
   return filter;
 }
 
+/*
+ * every state cf shares the backend block cache. Index and filter blocks are charged to that cache as well, with high
+ * priority, and the ones of L0 stay pinned: the windows of a stream are mostly read right after they are flushed.
+ */
+static rocksdb_block_based_table_options_t* streamStateCreateTableOpt(SBackendHandle* handle) {
+  rocksdb_block_based_table_options_t* tableOpt = rocksdb_block_based_options_create();
+  rocksdb_block_based_options_set_block_cache(tableOpt, handle->cache);
+
+  rocksdb_filterpolicy_t* filter = rocksdb_filterpolicy_create_bloom(15);
+  rocksdb_block_based_options_set_filter_policy(tableOpt, filter);
+
+  rocksdb_block_based_options_set_cache_index_and_filter_blocks(tableOpt, 1);
+  rocksdb_block_based_options_set_cache_index_and_filter_blocks_with_high_priority(tableOpt, 1);
+  rocksdb_block_based_options_set_pin_l0_filter_and_index_blocks_in_cache(tableOpt, 1);
+  return tableOpt;
+}
+
 void destroyRocksdbCfInst(RocksdbCfInst* inst) {
   int cfLen = sizeof(ginitDict) / sizeof(ginitDict[0]);
   for (int i = 0; i < cfLen; i++) {
@@ -704,12 +724,7 @@ int32_t streamStateOpenBackendCf(void* backend, char* name, char** cfs, int32_t
     cfOpts[i] = rocksdb_options_create_copy(handle->dbOpt);
     if (i == 0) continue;
     if (3 == sscanf(cf, "0x%" PRIx64 "-%d_%s", &streamId, &taskId, funcname)) {
-      rocksdb_block_based_table_options_t* tableOpt = rocksdb_block_based_options_create();
-      rocksdb_block_based_options_set_block_cache(tableOpt, handle->cache);
-
-      rocksdb_filterpolicy_t* filter = rocksdb_filterpolicy_create_bloom(15);
-      rocksdb_block_based_options_set_filter_policy(tableOpt, filter);
-
+      rocksdb_block_based_table_options_t* tableOpt = streamStateCreateTableOpt(handle);
       rocksdb_options_set_block_based_table_factory((rocksdb_options_t*)cfOpts[i], tableOpt);
       params[i].tableOpt = tableOpt;
 
@@ -778,12 +793,7 @@ int32_t streamStateOpenBackendCf(void* backend, char* name, char** cfs, int32_t
     for (int i = 0; i < cfLen; i++) {
       if (inst->cfOpt[i] == NULL) {
         rocksdb_options_t*                   opt = rocksdb_options_create_copy(handle->dbOpt);
-        rocksdb_block_based_table_options_t* tableOpt = rocksdb_block_based_options_create();
-        rocksdb_block_based_options_set_block_cache(tableOpt, handle->cache);
-
-        rocksdb_filterpolicy_t* filter = rocksdb_filterpolicy_create_bloom(15);
-        rocksdb_block_based_options_set_filter_policy(tableOpt, filter);
-
+        rocksdb_block_based_table_options_t* tableOpt = streamStateCreateTableOpt(handle);
         rocksdb_options_set_block_based_table_factory((rocksdb_options_t*)opt, tableOpt);
 
         SCfInit* cfPara = &ginitDict[i];
@@ -839,13 +849,7 @@ int streamStateOpenBackend(void* backend, SStreamState* pState) {
   const rocksdb_options_t** cfOpt = taosMemoryCalloc(cfLen, sizeof(rocksdb_options_t*));
   for (int i = 0; i < cfLen; i++) {
     cfOpt[i] = rocksdb_options_create_copy(handle->dbOpt);
-    // refactor later
-    rocksdb_block_based_table_options_t* tableOpt = rocksdb_block_based_options_create();
-    rocksdb_block_based_options_set_block_cache(tableOpt, handle->cache);
-
-    rocksdb_filterpolicy_t* filter = rocksdb_filterpolicy_create_bloom(15);
-    rocksdb_block_based_options_set_filter_policy(tableOpt, filter);
-
+    rocksdb_block_based_table_options_t* tableOpt = streamStateCreateTableOpt(handle);
     rocksdb_options_set_block_based_table_factory((rocksdb_options_t*)cfOpt[i], tableOpt);
 
     param[i].tableOpt = tableOpt;
@@ -1064,10 +1068,11 @@ rocksdb_iterator_t* streamStateIterCreate(SStreamState* pState, const char* cfNa
     int32_t                         klen = ginitDict[i].enFunc((void*)key, buf);                                       \
     rocksdb_column_family_handle_t* pHandle =                                                                          \
         ((rocksdb_column_family_handle_t**)pState->pTdbState->pHandle)[ginitDict[i].idx];                              \
-    rocksdb_t*             db = pState->pTdbState->rocksdb;                                                            \
-    rocksdb_readoptions_t* opts = pState->pTdbState->readOpts;                                                         \
-    size_t                 len = 0;                                                                                    \
-    char*                  val = rocksdb_get_cf(db, opts, pHandle, (const char*)buf, klen, (size_t*)&len, &err);       \
+    rocksdb_t*               db = pState->pTdbState->rocksdb;                                                          \
+    rocksdb_readoptions_t*   opts = pState->pTdbState->readOpts;                                                       \
+    size_t                   len = 0;                                                                                  \
+    rocksdb_pinnableslice_t* pSlice = rocksdb_get_pinned_cf(db, opts, pHandle, (const char*)buf, klen, &err);          \
+    const char*              val = pSlice == NULL ? NULL : rocksdb_pinnableslice_value(pSlice, &len);                  \
     if (val == NULL || len == 0) {                                                                                     \
       if (err == NULL) {                                                                                               \
         qTrace("streamState str: %s failed to read from %s_%s, err: not exist", toString, pState->pTdbState->idstr,    \
@@ -1079,8 +1084,7 @@ rocksdb_iterator_t* streamStateIterCreate(SStreamState* pState, const char* cfNa
       }                                                                                                                \
       code = -1;                                                                                                       \
     } else {                                                                                                           \
-      char*   p = NULL;                                                                                                \
-      int32_t tlen = ginitDict[i].deValueFunc(val, len, NULL, (char**)pVal);                                           \
+      int32_t tlen = ginitDict[i].deValueFunc((void*)val, len, NULL, (char**)pVal);                                    \
       if (tlen <= 0) {                                                                                                 \
         qError("streamState str: %s failed to read from %s_%s, err: already ttl ", toString, pState->pTdbState->idstr, \
                funcname);                                                                                              \
@@ -1089,9 +1093,9 @@ rocksdb_iterator_t* streamStateIterCreate(SStreamState* pState, const char* cfNa
         qTrace("streamState str: %s succ to read from %s_%s, valLen:%d", toString, pState->pTdbState->idstr, funcname, \
                tlen);                                                                                                  \
       }                                                                                                                \
-      taosMemoryFree(val);                                                                                             \
       if (vLen != NULL) *vLen = tlen;                                                                                  \
     }                                                                                                                  \
+    rocksdb_pinnableslice_destroy(pSlice);                                                                             \
     if (code == 0)                                                                                                     \
       qDebug("streamState str: %s succ to read from %s_%s", toString, pState->pTdbState->idstr, funcname);             \
   } while (0);
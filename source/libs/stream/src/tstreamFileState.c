@@ -43,6 +43,9 @@ struct SStreamFileState {
   uint64_t   maxRowCount;
   uint64_t   curRowCount;
   GetTsFun   getTs;
+  int64_t    hitNum;
+  int64_t    missNum;
+  int64_t    diskReadNum;
 };
 
 typedef SRowBuffPos SRowBuffInfo;
@@ -259,8 +262,10 @@ int32_t getRowBuff(SStreamFileState* pFileState, void* pKey, int32_t keyLen, voi
     *pVLen = pFileState->rowSize;
     *pVal = *pos;
     (*pos)->beUsed = true;
+    pFileState->hitNum++;
     return TSDB_CODE_SUCCESS;
   }
+  pFileState->missNum++;
   SRowBuffPos* pNewPos = getNewRowPos(pFileState);
   pNewPos->beUsed = true;
   ASSERT(pNewPos->pRowBuff);
@@ -271,6 +276,7 @@ int32_t getRowBuff(SStreamFileState* pFileState, void* pKey, int32_t keyLen, voi
     int32_t len = 0;
     void*   pVal = NULL;
     int32_t code = streamStateGet_rocksdb(pFileState->pFileStore, pKey, &pVal, &len);
+    pFileState->diskReadNum++;
     qDebug("===stream===get %" PRId64 " from disc, res %d", ts, code);
     if (code == TSDB_CODE_SUCCESS) {
       memcpy(pNewPos->pRowBuff, pVal, len);
@@ -309,6 +315,7 @@ int32_t getRowBuffByPos(SStreamFileState* pFileState, SRowBuffPos* pPos, void**
   int32_t len = 0;
   void*   pBuff = NULL;
   streamStateGet_rocksdb(pFileState->pFileStore, pPos->pKey, &pBuff, &len);
+  pFileState->diskReadNum++;
   memcpy(pPos->pRowBuff, pBuff, len);
   taosMemoryFree(pBuff);
   (*pVal) = pPos->pRowBuff;
@@ -388,6 +395,14 @@ int32_t flushSnapshot(SStreamFileState* pFileState, SStreamSnapshot* pSnapshot,
       code = streamStatePutBatch(pFileState->pFileStore, "default", batch, keyBuf, valBuf, len, 0);
     }
     streamStatePutBatch_rocksdb(pFileState->pFileStore, batch);
+
+    SStreamState* pState = pFileState->pFileStore;
+    int64_t       total = pFileState->hitNum + pFileState->missNum;
+    qInfo("stream state 0x%" PRIx64 "-%d checkpoint:%" PRId64 ", buff rows:%" PRIu64 ", buff size:%" PRIu64
+          ", hit:%" PRId64 ", miss:%" PRId64 ", hit rate:%.2f%%, read from disk:%" PRId64,
+          pState->streamId, pState->taskId, pState->checkPointId, pFileState->curRowCount,
+          pFileState->curRowCount * pFileState->rowSize, pFileState->hitNum, pFileState->missNum,
+          total == 0 ? 0 : pFileState->hitNum * 100.0 / total, pFileState->diskReadNum);
   }
   streamStateDestroyBatch(batch);
 
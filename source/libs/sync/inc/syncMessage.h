@@ -98,7 +98,7 @@ typedef struct SyncAppendEntries {
   SyncTerm  prevLogTerm;
   SyncIndex commitIndex;
   SyncTerm  privateTerm;
-  int16_t   reserved;
+  int16_t   flags;
   uint32_t  dataLen;
   char      data[];
 } SyncAppendEntries;
@@ -116,9 +116,13 @@ typedef struct SyncAppendEntriesReply {
   SyncIndex matchIndex;
   SyncIndex lastSendIndex;
   int64_t   startTime;
-  int16_t   reserved;
+  int16_t   flags;
 } SyncAppendEntriesReply;
 
+// In SyncAppendEntries, data holds consecutive raft entries starting at prevLogIndex + 1. In the reply, the peer
+// accepts such batches. Older nodes leave the field zero, so batches are only sent to peers that set it.
+#define SYNC_APPEND_ENTRIES_BATCH 0x1
+
 typedef struct SyncHeartbeat {
   uint32_t bytes;
   int32_t  vgId;
@@ -200,7 +204,7 @@ typedef struct SyncSnapshotSend {
   SSyncCfg  lastConfig;
   int64_t   startTime;
   int32_t   seq;
-  int16_t   reserved;
+  int16_t   flags;
   uint32_t  dataLen;
   char      data[];
 } SyncSnapshotSend;
@@ -219,9 +223,14 @@ typedef struct SyncSnapshotRsp {
   int32_t   ack;
   int32_t   code;
   SyncIndex snapBeginIndex;  // when ack = SYNC_SNAPSHOT_SEQ_BEGIN, it's valid
-  int16_t   reserved;
+  int16_t   flags;
 } SyncSnapshotRsp;
 
+// In SyncSnapshotRsp, the receiver buffers blocks that arrive ahead of ack + 1 and acks cumulatively, and it can
+// decompress blocks. In SyncSnapshotSend, data is a compressed block. Older nodes leave the field zero.
+#define SYNC_SNAPSHOT_FLAG_WINDOW   0x1
+#define SYNC_SNAPSHOT_FLAG_COMPRESS 0x2
+
 typedef struct SyncLeaderTransfer {
   uint32_t bytes;
   int32_t  vgId;
@@ -261,6 +270,8 @@ int32_t syncBuildAppendEntries(SRpcMsg* pMsg, int32_t dataLen, int32_t vgId);
 int32_t syncBuildAppendEntriesReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
                                             SRpcMsg* pRpcMsg);
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t nEntries,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg);
 int32_t syncBuildHeartbeat(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildHeartbeatReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildPreSnapshot(SRpcMsg* pMsg, int32_t vgId);
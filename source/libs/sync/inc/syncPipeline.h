@@ -22,11 +22,15 @@ extern "C" {
 
 #include "syncInt.h"
 
+// max number of matched entries persisted with one wal write
+#define SYNC_LOG_PERSIST_BATCH 64
+
 typedef struct SSyncReplInfo {
   bool    barrier;
   bool    acked;
   int64_t timeMs;
   int64_t term;
+  int32_t bytes;
 } SSyncReplInfo;
 
 typedef struct SSyncLogReplMgr {
@@ -39,6 +43,8 @@ typedef struct SSyncLogReplMgr {
   int64_t       peerStartTime;
   int32_t       retryBackoff;
   int32_t       peerId;
+  int64_t       sentBytes;  // bytes of the entries in [startIndex, endIndex)
+  bool          peerBatch;  // peer accepts multiple entries in one append entries msg
 } SSyncLogReplMgr;
 
 typedef struct SSyncLogBufEntry {
@@ -85,6 +91,8 @@ int32_t syncLogReplProbe(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex inde
 int32_t syncLogReplRetryOnNeed(SSyncLogReplMgr* pMgr, SSyncNode* pNode);
 int32_t syncLogReplSendTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, SyncTerm* pTerm, SRaftId* pDestId,
                           bool* pBarrier);
+int32_t syncLogReplSendBatchTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, int32_t maxCount,
+                               int64_t maxBytes, int64_t nowMs, SRaftId* pDestId);
 
 int32_t syncLogReplProcessReply(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncAppendEntriesReply* pMsg);
 int32_t syncLogReplRecover(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncAppendEntriesReply* pMsg);
@@ -105,6 +113,9 @@ bool     syncLogBufferIsEmpty(SSyncLogBuffer* pBuf);
 
 int32_t syncLogBufferAppend(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry);
 int32_t syncLogBufferAccept(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevTerm);
+// takes the ownership of all entries, and returns the number of leading entries accepted
+int32_t syncLogBufferAcceptBatch(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t nEntries,
+                                 SyncTerm prevTerm);
 int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* pMatchTerm);
 int32_t syncLogBufferCommit(SSyncLogBuffer* pBuf, SSyncNode* pNode, int64_t commitIndex);
 int32_t syncLogBufferReset(SSyncLogBuffer* pBuf, SSyncNode* pNode);
@@ -30,13 +30,24 @@ extern "C" {
 
 #define SYNC_SNAPSHOT_RETRY_MS 5000
 
+// max data blocks in flight, the window actually used is syncSnapReplWindow
+#define SYNC_SNAPSHOT_BUFFER_SIZE 64
+
+typedef struct SSyncSnapBlock {
+  int32_t seq;
+  int16_t flags;  // SYNC_SNAPSHOT_FLAG_COMPRESS if pBlock is compressed
+  int32_t blockLen;
+  void   *pBlock;
+} SSyncSnapBlock;
+
 typedef struct SSyncSnapshotSender {
   bool           start;
-  int32_t        seq;
-  int32_t        ack;
+  int32_t        seq;  // last data block sent, or SYNC_SNAPSHOT_SEQ_END
+  int32_t        ack;  // all blocks up to it are written by the receiver
   void          *pReader;
-  void          *pCurrentBlock;
-  int32_t        blockLen;
+  bool           readEnd;
+  int16_t        peerFlags;
+  SSyncSnapBlock blocks[SYNC_SNAPSHOT_BUFFER_SIZE];  // blocks in (ack, seq], kept for resending
   SSnapshotParam snapshotParam;
   SSnapshot      snapshot;
   SSyncCfg       lastConfig;
@@ -72,6 +83,9 @@ typedef struct SSyncSnapshotReceiver {
   SSnapshotParam snapshotParam;
   SSnapshot      snapshot;
 
+  // blocks received ahead of ack + 1
+  SSyncSnapBlock blocks[SYNC_SNAPSHOT_BUFFER_SIZE];
+
   // init when create
   SSyncNode *pSyncNode;
 } SSyncSnapshotReceiver;
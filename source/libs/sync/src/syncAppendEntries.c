@@ -89,6 +89,73 @@
 //       /\ UNCHANGED <<candidateVars, leaderVars>>
 //
 
+static int32_t syncNodeOnAppendEntriesBatch(SSyncNode* ths, const SyncAppendEntries* pMsg, SRpcMsg* pRpcRsp,
+                                            bool resetElect) {
+  SyncAppendEntriesReply* pReply = pRpcRsp->pCont;
+  SSyncRaftEntry*         entries[SYNC_APPEND_ENTRIES_BATCH_SIZE] = {0};
+  int32_t                 nEntries = 0;
+  int32_t                 nAccepted = 0;
+
+  // split the batch into raft entries, each of which is a copy like the single entry path
+  for (uint32_t offset = 0; offset < pMsg->dataLen; nEntries++) {
+    SSyncRaftEntry head = {0};
+    if (nEntries >= SYNC_APPEND_ENTRIES_BATCH_SIZE || pMsg->dataLen - offset < sizeof(SSyncRaftEntry)) {
+      goto _INVALID;
+    }
+    memcpy(&head, pMsg->data + offset, sizeof(SSyncRaftEntry));
+    if (head.bytes < sizeof(SSyncRaftEntry) || pMsg->dataLen - offset < head.bytes ||
+        head.index != pMsg->prevLogIndex + 1 + nEntries || head.term < 0) {
+      goto _INVALID;
+    }
+
+    entries[nEntries] = taosMemoryMalloc(head.bytes);
+    if (entries[nEntries] == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      sError("vgId:%d, failed to get raft entry from append entries since %s", ths->vgId, terrstr());
+      goto _IGNORE;
+    }
+    memcpy(entries[nEntries], pMsg->data + offset, head.bytes);
+    offset += head.bytes;
+  }
+
+  sTrace("vgId:%d, recv append entries msg. index:%" PRId64 ", num:%d, term:%" PRId64 ", preLogIndex:%" PRId64
+         ", prevLogTerm:%" PRId64 " commitIndex:%" PRId64 "",
+         pMsg->vgId, pMsg->prevLogIndex + 1, nEntries, pMsg->term, pMsg->prevLogIndex, pMsg->prevLogTerm,
+         pMsg->commitIndex);
+
+  // accept, and acknowledge the whole batch with one reply
+  pReply->lastSendIndex = pMsg->prevLogIndex + nEntries;
+  nAccepted = syncLogBufferAcceptBatch(ths->pLogBuf, ths, entries, nEntries, pMsg->prevLogTerm);
+
+  pReply->matchIndex = syncLogBufferProceed(ths->pLogBuf, ths, &pReply->lastMatchTerm);
+  bool matched = (pReply->matchIndex >= pReply->lastSendIndex);
+  if (nAccepted == nEntries && matched) {
+    pReply->success = true;
+    // update commit index only after matching
+    (void)syncNodeUpdateCommitIndex(ths, TMIN(pMsg->commitIndex, pReply->lastSendIndex));
+  }
+
+  (void)syncNodeSendMsgById(&pReply->destId, ths, pRpcRsp);
+
+  if (syncLogBufferCommit(ths->pLogBuf, ths, ths->commitIndex) < 0) {
+    sError("vgId:%d, failed to commit raft fsm log since %s.", ths->vgId, terrstr());
+  }
+
+  if (resetElect) syncNodeResetElectTimer(ths);
+  return 0;
+
+_INVALID:
+  sError("vgId:%d, invalid batch of append entries received. prev index:%" PRId64 ", term:%" PRId64 ", datalen:%d",
+         ths->vgId, pMsg->prevLogIndex, pMsg->prevLogTerm, pMsg->dataLen);
+
+_IGNORE:
+  rpcFreeCont(pRpcRsp->pCont);
+  for (int32_t i = 0; i < nEntries; i++) {
+    syncEntryDestroy(entries[i]);
+  }
+  return 0;
+}
+
 int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   SyncAppendEntries* pMsg = pRpcMsg->pCont;
   SRpcMsg            rpcRsp = {0};
@@ -117,6 +184,7 @@ int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   pReply->matchIndex = SYNC_INDEX_INVALID;
   pReply->lastSendIndex = pMsg->prevLogIndex + 1;
   pReply->startTime = ths->startTime;
+  pReply->flags = SYNC_APPEND_ENTRIES_BATCH;
 
   if (pMsg->term < raftStoreGetTerm(ths)) {
     goto _SEND_RESPONSE;
@@ -137,6 +205,10 @@ int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
     goto _IGNORE;
   }
 
+  if (pMsg->flags & SYNC_APPEND_ENTRIES_BATCH) {
+    return syncNodeOnAppendEntriesBatch(ths, pMsg, &rpcRsp, resetElect);
+  }
+
   pEntry = syncEntryBuildFromAppendEntries(pMsg);
   if (pEntry == NULL) {
     sError("vgId:%d, failed to get raft entry from append entries since %s", ths->vgId, terrstr());
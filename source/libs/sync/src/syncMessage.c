@@ -182,6 +182,49 @@ int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pE
   return 0;
 }
 
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t nEntries,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg) {
+  ASSERT(nEntries > 0);
+  if (nEntries == 1) {
+    return syncBuildAppendEntriesFromRaftEntry(pNode, ppEntries[0], prevLogTerm, pRpcMsg);
+  }
+
+  uint32_t dataLen = 0;
+  for (int32_t i = 0; i < nEntries; ++i) {
+    ASSERT(ppEntries[i]->index == ppEntries[0]->index + i);
+    dataLen += ppEntries[i]->bytes;
+  }
+
+  uint32_t bytes = sizeof(SyncAppendEntries) + dataLen;
+  pRpcMsg->contLen = bytes;
+  pRpcMsg->pCont = rpcMallocCont(pRpcMsg->contLen);
+  if (pRpcMsg->pCont == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  SyncAppendEntries* pMsg = pRpcMsg->pCont;
+  pMsg->bytes = pRpcMsg->contLen;
+  pMsg->msgType = pRpcMsg->msgType = TDMT_SYNC_APPEND_ENTRIES;
+  pMsg->flags = SYNC_APPEND_ENTRIES_BATCH;
+  pMsg->dataLen = dataLen;
+
+  char* pData = pMsg->data;
+  for (int32_t i = 0; i < nEntries; ++i) {
+    (void)memcpy(pData, ppEntries[i], ppEntries[i]->bytes);
+    pData += ppEntries[i]->bytes;
+  }
+
+  pMsg->prevLogIndex = ppEntries[0]->index - 1;
+  pMsg->prevLogTerm = prevLogTerm;
+  pMsg->vgId = pNode->vgId;
+  pMsg->srcId = pNode->myRaftId;
+  pMsg->term = raftStoreGetTerm(pNode);
+  pMsg->commitIndex = pNode->commitIndex;
+  pMsg->privateTerm = 0;
+  return 0;
+}
+
 int32_t syncBuildHeartbeat(SRpcMsg* pMsg, int32_t vgId) {
   int32_t bytes = sizeof(SyncHeartbeat);
   pMsg->pCont = rpcMallocCont(bytes);
@@ -284,6 +327,7 @@ int32_t syncBuildSnapshotSendRsp(SRpcMsg* pMsg, int32_t vgId) {
   pPreSnapshotRsp->bytes = bytes;
   pPreSnapshotRsp->msgType = TDMT_SYNC_SNAPSHOT_RSP;
   pPreSnapshotRsp->vgId = vgId;
+  pPreSnapshotRsp->flags = SYNC_SNAPSHOT_FLAG_WINDOW | SYNC_SNAPSHOT_FLAG_COMPRESS;
   return 0;
 }
 
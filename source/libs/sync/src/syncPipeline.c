@@ -311,9 +311,9 @@ bool syncLogBufferIsEmpty(SSyncLogBuffer* pBuf) {
   return empty;
 }
 
-int32_t syncLogBufferAccept(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevTerm) {
-  taosThreadMutexLock(&pBuf->mutex);
-  syncLogBufferValidate(pBuf);
+// chained: the entry follows one accepted from the same batch, which is matched against the buffer instead
+static int32_t syncLogBufferAcceptWithoutLock(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry,
+                                              SyncTerm prevTerm, bool chained) {
   int32_t         ret = -1;
   SyncIndex       index = pEntry->index;
   SyncIndex       prevIndex = pEntry->index - 1;
@@ -351,7 +351,7 @@ int32_t syncLogBufferAccept(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEnt
     goto _out;
   }
 
-  if (index > pBuf->matchIndex && lastMatchTerm != prevTerm) {
+  if (index > pBuf->matchIndex && lastMatchTerm != prevTerm && !chained) {
     sWarn("vgId:%d, not ready to accept. index:%" PRId64 ", term:%" PRId64 ": prevterm:%" PRId64
           " != lastmatch:%" PRId64 ". log buffer: [%" PRId64 " %" PRId64 " %" PRId64 ", %" PRId64 ")",
           pNode->vgId, pEntry->index, pEntry->term, prevTerm, lastMatchTerm, pBuf->startIndex, pBuf->commitIndex,
@@ -397,43 +397,103 @@ _out:
     syncEntryDestroy(pExist);
     pExist = NULL;
   }
+  return ret;
+}
+
+int32_t syncLogBufferAccept(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevTerm) {
+  taosThreadMutexLock(&pBuf->mutex);
+  syncLogBufferValidate(pBuf);
+  int32_t ret = syncLogBufferAcceptWithoutLock(pBuf, pNode, pEntry, prevTerm, false);
   syncLogBufferValidate(pBuf);
   taosThreadMutexUnlock(&pBuf->mutex);
   return ret;
 }
 
+int32_t syncLogBufferAcceptBatch(SSyncLogBuffer* pBuf, SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t nEntries,
+                                 SyncTerm prevTerm) {
+  taosThreadMutexLock(&pBuf->mutex);
+  syncLogBufferValidate(pBuf);
+  int32_t nAccepted = 0;
+  for (int32_t i = 0; i < nEntries; ++i) {
+    SSyncRaftEntry* pEntry = ppEntries[i];
+    ppEntries[i] = NULL;
+    if (nAccepted < i) {
+      syncEntryDestroy(pEntry);
+      continue;
+    }
+    SyncTerm term = pEntry->term;
+    if (syncLogBufferAcceptWithoutLock(pBuf, pNode, pEntry, prevTerm, i > 0) == 0) {
+      prevTerm = term;
+      nAccepted++;
+    }
+  }
+  syncLogBufferValidate(pBuf);
+  taosThreadMutexUnlock(&pBuf->mutex);
+  return nAccepted;
+}
+
 static inline bool syncLogStoreNeedFlush(SSyncRaftEntry* pEntry, int32_t replicaNum) {
   return (replicaNum > 1) && (pEntry->originalRpcType == TDMT_VND_COMMIT);
 }
 
-int32_t syncLogStorePersist(SSyncLogStore* pLogStore, SSyncNode* pNode, SSyncRaftEntry* pEntry) {
-  ASSERT(pEntry->index >= 0);
+// persist consecutive entries with one wal write and at most one fsync
+int32_t syncLogStorePersist(SSyncLogStore* pLogStore, SSyncNode* pNode, SSyncRaftEntry** ppEntries,
+                            int32_t numOfEntries) {
+  SSyncRaftEntry* pFirst = ppEntries[0];
+  SSyncRaftEntry* pLast = ppEntries[numOfEntries - 1];
+  ASSERT(pFirst->index >= 0);
   SyncIndex lastVer = pLogStore->syncLogLastIndex(pLogStore);
-  if (lastVer >= pEntry->index && pLogStore->syncLogTruncate(pLogStore, pEntry->index) < 0) {
-    sError("failed to truncate log store since %s. from index:%" PRId64 "", terrstr(), pEntry->index);
+  if (lastVer >= pFirst->index && pLogStore->syncLogTruncate(pLogStore, pFirst->index) < 0) {
+    sError("failed to truncate log store since %s. from index:%" PRId64 "", terrstr(), pFirst->index);
     return -1;
   }
   lastVer = pLogStore->syncLogLastIndex(pLogStore);
-  ASSERT(pEntry->index == lastVer + 1);
+  ASSERT(pFirst->index == lastVer + 1);
 
-  bool doFsync = syncLogStoreNeedFlush(pEntry, pNode->replicaNum);
-  if (pLogStore->syncLogAppendEntry(pLogStore, pEntry, doFsync) < 0) {
-    sError("failed to append sync log entry since %s. index:%" PRId64 ", term:%" PRId64 "", terrstr(), pEntry->index,
-           pEntry->term);
+  bool doFsync = false;
+  for (int32_t i = 0; i < numOfEntries; i++) {
+    doFsync = doFsync || syncLogStoreNeedFlush(ppEntries[i], pNode->replicaNum);
+  }
+
+  if (pLogStore->syncLogAppendEntryBatch(pLogStore, ppEntries, numOfEntries, doFsync) < 0) {
+    sError("failed to append sync log entries since %s. index:%" PRId64 "-%" PRId64 ", term:%" PRId64 "", terrstr(),
+           pFirst->index, pLast->index, pLast->term);
     return -1;
   }
 
   lastVer = pLogStore->syncLogLastIndex(pLogStore);
-  ASSERT(pEntry->index == lastVer);
+  ASSERT(pLast->index == lastVer);
   return 0;
 }
 
+static int64_t syncLogBufferPersistBatch(SSyncLogStore* pLogStore, SSyncNode* pNode, SSyncRaftEntry** ppEntries,
+                                         int32_t* pNum, int64_t matchIndex) {
+  if (*pNum == 0) {
+    return matchIndex;
+  }
+
+  SSyncRaftEntry* pLast = ppEntries[*pNum - 1];
+  if (syncLogStorePersist(pLogStore, pNode, ppEntries, *pNum) < 0) {
+    sError("vgId:%d, failed to persist sync log entries from buffer since %s. index:%" PRId64 "-%" PRId64, pNode->vgId,
+           terrstr(), ppEntries[0]->index, pLast->index);
+    *pNum = 0;
+    return matchIndex;
+  }
+
+  // update my match index
+  syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, pLast->index);
+  *pNum = 0;
+  return pLast->index;
+}
+
 int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* pMatchTerm) {
   taosThreadMutexLock(&pBuf->mutex);
   syncLogBufferValidate(pBuf);
 
-  SSyncLogStore* pLogStore = pNode->pLogStore;
-  int64_t        matchIndex = pBuf->matchIndex;
+  SSyncLogStore*  pLogStore = pNode->pLogStore;
+  int64_t         matchIndex = pBuf->matchIndex;
+  SSyncRaftEntry* entries[SYNC_LOG_PERSIST_BATCH];
+  int32_t         numOfEntries = 0;
 
   while (pBuf->matchIndex + 1 < pBuf->endIndex) {
     int64_t index = pBuf->matchIndex + 1;
@@ -478,20 +538,20 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
     // replicate on demand
     (void)syncNodeReplicateWithoutLock(pNode);
 
-    // persist
-    if (syncLogStorePersist(pLogStore, pNode, pEntry) < 0) {
-      sError("vgId:%d, failed to persist sync log entry from buffer since %s. index:%" PRId64, pNode->vgId, terrstr(),
-             pEntry->index);
-      goto _out;
+    // persist the matched entries in batches
+    entries[numOfEntries++] = pEntry;
+    if (numOfEntries == SYNC_LOG_PERSIST_BATCH) {
+      int64_t persisted = matchIndex;
+      matchIndex = syncLogBufferPersistBatch(pLogStore, pNode, entries, &numOfEntries, matchIndex);
+      if (matchIndex == persisted) {
+        goto _out;
+      }
+      ASSERT(matchIndex == pBuf->matchIndex);
     }
-    ASSERT(pEntry->index == pBuf->matchIndex);
-
-    // update my match index
-    matchIndex = pBuf->matchIndex;
-    syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, pBuf->matchIndex);
   }  // end of while
 
 _out:
+  matchIndex = syncLogBufferPersistBatch(pLogStore, pNode, entries, &numOfEntries, matchIndex);
   pBuf->matchIndex = matchIndex;
   if (pMatchTerm) {
     *pMatchTerm = pBuf->entries[(matchIndex + pBuf->size) % pBuf->size].pItem->term;
@@ -642,6 +702,7 @@ void syncLogReplReset(SSyncLogReplMgr* pMgr) {
   pMgr->endIndex = 0;
   pMgr->restored = false;
   pMgr->retryBackoff = 0;
+  pMgr->sentBytes = 0;
 }
 
 int32_t syncLogReplRetryOnNeed(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
@@ -804,6 +865,7 @@ int32_t syncLogReplProcessHeartbeatReply(SSyncLogReplMgr* pMgr, SSyncNode* pNode
           pNode->vgId, pMsg->srcId.addr, pMsg->startTime, pMgr->peerStartTime);
     syncLogReplReset(pMgr);
     pMgr->peerStartTime = pMsg->startTime;
+    pMgr->peerBatch = false;
   }
   taosThreadMutexUnlock(&pBuf->mutex);
   return 0;
@@ -818,6 +880,7 @@ int32_t syncLogReplProcessReply(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncApp
     syncLogReplReset(pMgr);
     pMgr->peerStartTime = pMsg->startTime;
   }
+  pMgr->peerBatch = (pMsg->flags & SYNC_APPEND_ENTRIES_BATCH) != 0;
 
   if (pMgr->restored) {
     (void)syncLogReplContinue(pMgr, pNode, pMsg);
@@ -879,42 +942,44 @@ int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
   ASSERT(pMgr->restored);
 
   SRaftId*  pDestId = &pNode->replicasId[pMgr->peerId];
-  int32_t   batchSize = TMAX(1, pMgr->size >> (4 + pMgr->retryBackoff));
+  int64_t   windowBytes = (int64_t)SYNC_LOG_REPL_WINDOW_BYTES >> pMgr->retryBackoff;
+  int32_t   maxCount = pMgr->peerBatch ? SYNC_APPEND_ENTRIES_BATCH_SIZE : 1;
   int32_t   count = 0;
+  int32_t   nMsgs = 0;
   int64_t   nowMs = taosGetMonoTimestampMs();
   int64_t   limit = pMgr->size >> 1;
   SyncTerm  term = -1;
-  SyncIndex firstIndex = -1;
+  SyncIndex firstIndex = pMgr->endIndex;
 
-  for (SyncIndex index = pMgr->endIndex; index <= pNode->pLogBuf->matchIndex; index++) {
-    if (batchSize < count || limit <= index - pMgr->startIndex) {
+  // the window is bounded by the bytes in flight, and by the entries the repl mgr could track
+  while (pMgr->endIndex <= pNode->pLogBuf->matchIndex) {
+    SyncIndex index = pMgr->endIndex;
+    if (limit <= index - pMgr->startIndex || windowBytes <= pMgr->sentBytes) {
       break;
     }
     if (pMgr->startIndex + 1 < index && pMgr->states[(index - 1) % pMgr->size].barrier) {
       break;
     }
-    int64_t  pos = index % pMgr->size;
-    SRaftId* pDestId = &pNode->replicasId[pMgr->peerId];
-    bool     barrier = false;
-    SyncTerm term = -1;
-    if (syncLogReplSendTo(pMgr, pNode, index, &term, pDestId, &barrier) < 0) {
+
+    int32_t nEntries = (int32_t)TMIN(maxCount, limit - (index - pMgr->startIndex));
+    int64_t maxBytes = TMIN(SYNC_APPEND_ENTRIES_BATCH_BYTES, windowBytes - pMgr->sentBytes);
+    int32_t nSent = syncLogReplSendBatchTo(pMgr, pNode, index, nEntries, maxBytes, nowMs, pDestId);
+    if (nSent < 0) {
       sError("vgId:%d, failed to replicate log entry since %s. index:%" PRId64 ", dest: 0x%016" PRIx64 "", pNode->vgId,
              terrstr(), index, pDestId->addr);
       return -1;
     }
-    pMgr->states[pos].barrier = barrier;
-    pMgr->states[pos].timeMs = nowMs;
-    pMgr->states[pos].term = term;
-    pMgr->states[pos].acked = false;
+    ASSERT(pMgr->endIndex == index + nSent);
 
-    if (firstIndex == -1) firstIndex = index;
-    count++;
+    count += nSent;
+    nMsgs++;
 
-    pMgr->endIndex = index + 1;
-    if (barrier) {
+    SSyncReplInfo* pLast = &pMgr->states[(pMgr->endIndex - 1) % pMgr->size];
+    term = pLast->term;
+    if (pLast->barrier) {
       sInfo("vgId:%d, replicated sync barrier to dest:%" PRIx64 ". index:%" PRId64 ", term:%" PRId64
             ", repl mgr: rs(%d) [%" PRId64 " %" PRId64 ", %" PRId64 ")",
-            pNode->vgId, pDestId->addr, index, term, pMgr->restored, pMgr->startIndex, pMgr->matchIndex,
+            pNode->vgId, pDestId->addr, pMgr->endIndex - 1, term, pMgr->restored, pMgr->startIndex, pMgr->matchIndex,
             pMgr->endIndex);
       break;
     }
@@ -923,11 +988,11 @@ int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
   syncLogReplRetryOnNeed(pMgr, pNode);
 
   SSyncLogBuffer* pBuf = pNode->pLogBuf;
-  sTrace("vgId:%d, replicated %d msgs to peer:%" PRIx64 ". indexes:%" PRId64 "..., terms: ...%" PRId64
-         ", mgr: (rs:%d) [%" PRId64 " %" PRId64 ", %" PRId64 "), buffer: [%" PRId64 " %" PRId64 " %" PRId64 ", %" PRId64
-         ")",
-         pNode->vgId, count, pDestId->addr, firstIndex, term, pMgr->restored, pMgr->startIndex, pMgr->matchIndex,
-         pMgr->endIndex, pBuf->startIndex, pBuf->commitIndex, pBuf->matchIndex, pBuf->endIndex);
+  sTrace("vgId:%d, replicated %d entries in %d msgs to peer:%" PRIx64 ". indexes:%" PRId64 "..., terms: ...%" PRId64
+         ", sent bytes:%" PRId64 ", mgr: (rs:%d) [%" PRId64 " %" PRId64 ", %" PRId64 "), buffer: [%" PRId64 " %" PRId64
+         " %" PRId64 ", %" PRId64 ")",
+         pNode->vgId, count, nMsgs, pDestId->addr, firstIndex, term, pMgr->sentBytes, pMgr->restored, pMgr->startIndex,
+         pMgr->matchIndex, pMgr->endIndex, pBuf->startIndex, pBuf->commitIndex, pBuf->matchIndex, pBuf->endIndex);
   return 0;
 }
 
@@ -945,6 +1010,7 @@ int32_t syncLogReplContinue(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncAppendE
     pMgr->states[pMsg->lastSendIndex % pMgr->size].acked = true;
     pMgr->matchIndex = TMAX(pMgr->matchIndex, pMsg->matchIndex);
     for (SyncIndex index = pMgr->startIndex; index < pMgr->matchIndex; index++) {
+      pMgr->sentBytes -= pMgr->states[index % pMgr->size].bytes;
       memset(&pMgr->states[index % pMgr->size], 0, sizeof(pMgr->states[0]));
     }
     pMgr->startIndex = pMgr->matchIndex;
@@ -1201,3 +1267,78 @@ _err:
   }
   return -1;
 }
+
+int32_t syncLogReplSendBatchTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, int32_t maxCount,
+                               int64_t maxBytes, int64_t nowMs, SRaftId* pDestId) {
+  SSyncRaftEntry* entries[SYNC_APPEND_ENTRIES_BATCH_SIZE] = {0};
+  bool            inBuf[SYNC_APPEND_ENTRIES_BATCH_SIZE] = {0};
+  SRpcMsg         msgOut = {0};
+  SSyncLogBuffer* pBuf = pNode->pLogBuf;
+  SyncTerm        prevLogTerm = -1;
+  int32_t         count = 0;
+  int64_t         bytes = 0;
+  int32_t         ret = -1;
+
+  ASSERT(index == pMgr->endIndex);
+  maxCount = TMIN(maxCount, SYNC_APPEND_ENTRIES_BATCH_SIZE);
+
+  // the first entry is always sent, however large it is. a barrier ends the batch.
+  while (count < maxCount && index + count <= pBuf->matchIndex) {
+    SSyncRaftEntry* pEntry = syncLogBufferGetOneEntry(pBuf, pNode, index + count, &inBuf[count]);
+    if (pEntry == NULL) {
+      if (count > 0) break;
+      sError("vgId:%d, failed to get raft entry for index:%" PRId64 "", pNode->vgId, index);
+      if (terrno == TSDB_CODE_WAL_LOG_NOT_EXIST) {
+        sInfo("vgId:%d, reset sync log repl of peer:%" PRIx64 " since %s. index:%" PRId64, pNode->vgId, pDestId->addr,
+              terrstr(), index);
+        (void)syncLogReplReset(pMgr);
+      }
+      goto _out;
+    }
+    if (count > 0 && bytes + pEntry->bytes > maxBytes) {
+      if (!inBuf[count]) syncEntryDestroy(pEntry);
+      break;
+    }
+    entries[count++] = pEntry;
+    bytes += pEntry->bytes;
+    if (syncLogReplBarrier(pEntry)) break;
+  }
+  if (count == 0) {
+    goto _out;
+  }
+
+  prevLogTerm = syncLogReplGetPrevLogTerm(pMgr, pNode, index);
+  if (prevLogTerm < 0) {
+    sError("vgId:%d, failed to get prev log term since %s. index:%" PRId64 "", pNode->vgId, terrstr(), index);
+    goto _out;
+  }
+
+  if (syncBuildAppendEntriesFromRaftEntries(pNode, entries, count, prevLogTerm, &msgOut) < 0) {
+    sError("vgId:%d, failed to get append entries for index:%" PRId64 "", pNode->vgId, index);
+    goto _out;
+  }
+
+  (void)syncNodeSendAppendEntries(pNode, pDestId, &msgOut);
+
+  for (int32_t i = 0; i < count; i++) {
+    SSyncReplInfo* pState = &pMgr->states[(index + i) % pMgr->size];
+    pState->barrier = syncLogReplBarrier(entries[i]);
+    pState->acked = false;
+    pState->timeMs = nowMs;
+    pState->term = entries[i]->term;
+    pState->bytes = entries[i]->bytes;
+  }
+  pMgr->sentBytes += bytes;
+  pMgr->endIndex = index + count;
+
+  sTrace("vgId:%d, replicate %d msgs from index:%" PRId64 " term:%" PRId64 " prevterm:%" PRId64 " bytes:%" PRId64
+         " to dest: 0x%016" PRIx64,
+         pNode->vgId, count, index, entries[count - 1]->term, prevLogTerm, bytes, pDestId->addr);
+  ret = count;
+
+_out:
+  for (int32_t i = 0; i < count; i++) {
+    if (!inBuf[i]) syncEntryDestroy(entries[i]);
+  }
+  return ret;
+}
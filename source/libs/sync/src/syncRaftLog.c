@@ -24,6 +24,8 @@
 // public function
 static int32_t   raftLogRestoreFromSnapshot(struct SSyncLogStore* pLogStore, SyncIndex snapshotIndex);
 static int32_t   raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forceSync);
+static int32_t   raftLogAppendEntryBatch(struct SSyncLogStore* pLogStore, SSyncRaftEntry** ppEntries,
+                                         int32_t numOfEntries, bool forceSync);
 static int32_t   raftLogTruncate(struct SSyncLogStore* pLogStore, SyncIndex fromIndex);
 static bool      raftLogExist(struct SSyncLogStore* pLogStore, SyncIndex index);
 static int32_t   raftLogUpdateCommitIndex(SSyncLogStore* pLogStore, SyncIndex index);
@@ -72,6 +74,7 @@ SSyncLogStore* logStoreCreate(SSyncNode* pSyncNode) {
   pLogStore->syncLogLastIndex = raftLogLastIndex;
   pLogStore->syncLogLastTerm = raftLogLastTerm;
   pLogStore->syncLogAppendEntry = raftLogAppendEntry;
+  pLogStore->syncLogAppendEntryBatch = raftLogAppendEntryBatch;
   pLogStore->syncLogGetEntry = raftLogGetEntry;
   pLogStore->syncLogTruncate = raftLogTruncate;
   pLogStore->syncLogWriteIndex = raftLogWriteIndex;
@@ -226,6 +229,54 @@ static int32_t raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntr
   return 0;
 }
 
+static int32_t raftLogAppendEntryBatch(struct SSyncLogStore* pLogStore, SSyncRaftEntry** ppEntries,
+                                       int32_t numOfEntries, bool forceSync) {
+  SSyncLogStoreData* pData = pLogStore->data;
+  SWal*              pWal = pData->pWal;
+
+  SWalAppendEntry* pEntries = taosMemoryCalloc(numOfEntries, sizeof(SWalAppendEntry));
+  if (pEntries == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  for (int32_t i = 0; i < numOfEntries; i++) {
+    SSyncRaftEntry* pEntry = ppEntries[i];
+    pEntries[i].index = pEntry->index;
+    pEntries[i].msgType = pEntry->originalRpcType;
+    pEntries[i].syncMeta.isWeek = pEntry->isWeak;
+    pEntries[i].syncMeta.seqNum = pEntry->seqNum;
+    pEntries[i].syncMeta.term = pEntry->term;
+    pEntries[i].body = pEntry->data;
+    pEntries[i].bodyLen = pEntry->dataLen;
+  }
+
+  SyncIndex firstIndex = ppEntries[0]->index;
+  SyncIndex lastIndex = ppEntries[numOfEntries - 1]->index;
+  int64_t   tsWriteBegin = taosGetTimestampNs();
+  SyncIndex index = walAppendLogBatch(pWal, pEntries, numOfEntries);
+  int64_t   tsElapsed = taosGetTimestampNs() - tsWriteBegin;
+  taosMemoryFree(pEntries);
+
+  if (index < 0) {
+    int32_t     err = terrno;
+    const char* errStr = tstrerror(err);
+    int32_t     sysErr = errno;
+    const char* sysErrStr = strerror(errno);
+
+    sNError(pData->pSyncNode, "wal write error, index:%" PRId64 "-%" PRId64 ", err:0x%x, msg:%s, syserr:%d, sysmsg:%s",
+            firstIndex, lastIndex, err, errStr, sysErr, sysErrStr);
+    return -1;
+  }
+
+  ASSERT(lastIndex == index);
+
+  walFsync(pWal, forceSync);
+
+  sNTrace(pData->pSyncNode, "write index:%" PRId64 "-%" PRId64 ", elapsed:%" PRId64, firstIndex, lastIndex, tsElapsed);
+  return 0;
+}
+
 // entry found, return 0
 // entry not found, return -1, terrno = TSDB_CODE_WAL_LOG_NOT_EXIST
 // other error, return -1
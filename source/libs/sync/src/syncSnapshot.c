@@ -22,6 +22,19 @@
 #include "syncRaftStore.h"
 #include "syncReplication.h"
 #include "syncUtil.h"
+#include "tcompression.h"
+#include "tglobal.h"
+
+static void snapshotBlockClear(SSyncSnapBlock *pBlock) {
+  taosMemoryFree(pBlock->pBlock);
+  memset(pBlock, 0, sizeof(*pBlock));
+}
+
+static void snapshotBlocksClear(SSyncSnapBlock *blocks) {
+  for (int32_t i = 0; i < SYNC_SNAPSHOT_BUFFER_SIZE; ++i) {
+    snapshotBlockClear(&blocks[i]);
+  }
+}
 
 SSyncSnapshotSender *snapshotSenderCreate(SSyncNode *pSyncNode, int32_t replicaIndex) {
   bool condition = (pSyncNode->pFsm->FpSnapshotStartRead != NULL) && (pSyncNode->pFsm->FpSnapshotStopRead != NULL) &&
@@ -38,8 +51,8 @@ SSyncSnapshotSender *snapshotSenderCreate(SSyncNode *pSyncNode, int32_t replicaI
   pSender->seq = SYNC_SNAPSHOT_SEQ_INVALID;
   pSender->ack = SYNC_SNAPSHOT_SEQ_INVALID;
   pSender->pReader = NULL;
-  pSender->pCurrentBlock = NULL;
-  pSender->blockLen = 0;
+  pSender->readEnd = false;
+  pSender->peerFlags = 0;
   pSender->sendingMS = SYNC_SNAPSHOT_RETRY_MS;
   pSender->pSyncNode = pSyncNode;
   pSender->replicaIndex = replicaIndex;
@@ -55,11 +68,8 @@ SSyncSnapshotSender *snapshotSenderCreate(SSyncNode *pSyncNode, int32_t replicaI
 void snapshotSenderDestroy(SSyncSnapshotSender *pSender) {
   if (pSender == NULL) return;
 
-  // free current block
-  if (pSender->pCurrentBlock != NULL) {
-    taosMemoryFree(pSender->pCurrentBlock);
-    pSender->pCurrentBlock = NULL;
-  }
+  // free blocks not acked
+  snapshotBlocksClear(pSender->blocks);
 
   // close reader
   if (pSender->pReader != NULL) {
@@ -78,8 +88,9 @@ int32_t snapshotSenderStart(SSyncSnapshotSender *pSender) {
   pSender->seq = SYNC_SNAPSHOT_SEQ_BEGIN;
   pSender->ack = SYNC_SNAPSHOT_SEQ_INVALID;
   pSender->pReader = NULL;
-  pSender->pCurrentBlock = NULL;
-  pSender->blockLen = 0;
+  pSender->readEnd = false;
+  pSender->peerFlags = 0;
+  snapshotBlocksClear(pSender->blocks);
   pSender->snapshotParam.start = SYNC_INDEX_INVALID;
   pSender->snapshotParam.end = SYNC_INDEX_INVALID;
   pSender->snapshot.data = NULL;
@@ -140,46 +151,47 @@ void snapshotSenderStop(SSyncSnapshotSender *pSender, bool finish) {
     pSender->pReader = NULL;
   }
 
-  // free current block
-  if (pSender->pCurrentBlock != NULL) {
-    taosMemoryFree(pSender->pCurrentBlock);
-    pSender->pCurrentBlock = NULL;
-    pSender->blockLen = 0;
-  }
+  // free blocks not acked
+  snapshotBlocksClear(pSender->blocks);
 }
 
-// when sender receive ack, call this function to send msg from seq
-// seq = ack + 1, already updated
-static int32_t snapshotSend(SSyncSnapshotSender *pSender) {
-  // free memory last time (current seq - 1)
-  if (pSender->pCurrentBlock != NULL) {
-    taosMemoryFree(pSender->pCurrentBlock);
-    pSender->pCurrentBlock = NULL;
-    pSender->blockLen = 0;
-  }
+static int32_t snapshotSenderWindow(SSyncSnapshotSender *pSender) {
+  if ((pSender->peerFlags & SYNC_SNAPSHOT_FLAG_WINDOW) == 0) return 1;
+  return TMIN(TMAX(tsSnapReplWindow, 1), SYNC_SNAPSHOT_BUFFER_SIZE);
+}
 
-  // read data
-  int32_t ret = pSender->pSyncNode->pFsm->FpSnapshotDoRead(pSender->pSyncNode->pFsm, pSender->pReader,
-                                                           &pSender->pCurrentBlock, &pSender->blockLen);
-  if (ret != 0) {
-    sSError(pSender, "snapshot sender read failed since %s", terrstr());
-    return -1;
-  }
+// the block is sent as is if the receiver can not decompress it, or if it does not shrink
+static void snapshotSenderSetBlock(SSyncSnapshotSender *pSender, SSyncSnapBlock *pBlock, void *pData, int32_t len) {
+  pBlock->pBlock = pData;
+  pBlock->blockLen = len;
+  pBlock->flags = 0;
 
-  if (pSender->blockLen > 0) {
-    // has read data
-    sSDebug(pSender, "vgId:%d, snapshot sender continue to read, blockLen:%d seq:%d", pSender->pSyncNode->vgId,
-            pSender->blockLen, pSender->seq);
-  } else {
-    // read finish, update seq to end
-    pSender->seq = SYNC_SNAPSHOT_SEQ_END;
-    sSInfo(pSender, "vgId:%d, snapshot sender read to the end, blockLen:%d seq:%d", pSender->pSyncNode->vgId,
-           pSender->blockLen, pSender->seq);
+  if (!tsSnapReplCompress || (pSender->peerFlags & SYNC_SNAPSHOT_FLAG_COMPRESS) == 0) return;
+
+  // compressed block: raw length, then the string compression output
+  char *pCmpr = taosMemoryMalloc(sizeof(int32_t) + len + 1);
+  if (pCmpr == NULL) return;
+
+  int32_t cmprLen = tsCompressString(pData, len, 1, pCmpr + sizeof(int32_t), len + 1, ONE_STAGE_COMP, NULL, 0);
+  if (cmprLen <= 0 || pCmpr[sizeof(int32_t)] == 0 || sizeof(int32_t) + cmprLen >= len) {
+    taosMemoryFree(pCmpr);
+    return;
   }
 
+  memcpy(pCmpr, &len, sizeof(int32_t));
+  taosMemoryFree(pData);
+  pBlock->pBlock = pCmpr;
+  pBlock->blockLen = sizeof(int32_t) + cmprLen;
+  pBlock->flags = SYNC_SNAPSHOT_FLAG_COMPRESS;
+}
+
+static int32_t snapshotSenderSendMsg(SSyncSnapshotSender *pSender, int32_t seq, SSyncSnapBlock *pBlock,
+                                     const char *event) {
+  int32_t blockLen = (pBlock != NULL) ? pBlock->blockLen : 0;
+
   // build msg
   SRpcMsg rpcMsg = {0};
-  if (syncBuildSnapshotSend(&rpcMsg, pSender->blockLen, pSender->pSyncNode->vgId) != 0) {
+  if (syncBuildSnapshotSend(&rpcMsg, blockLen, pSender->pSyncNode->vgId) != 0) {
     sSError(pSender, "vgId:%d, snapshot sender build msg failed since %s", pSender->pSyncNode->vgId, terrstr());
     return -1;
   }
@@ -193,18 +205,16 @@ static int32_t snapshotSend(SSyncSnapshotSender *pSender) {
   pMsg->lastTerm = pSender->snapshot.lastApplyTerm;
   pMsg->lastConfigIndex = pSender->snapshot.lastConfigIndex;
   pMsg->lastConfig = pSender->lastConfig;
-  pMsg->seq = pSender->seq;
+  pMsg->startTime = pSender->startTime;
+  pMsg->seq = seq;
 
-  if (pSender->pCurrentBlock != NULL) {
-    memcpy(pMsg->data, pSender->pCurrentBlock, pSender->blockLen);
+  if (blockLen > 0) {
+    memcpy(pMsg->data, pBlock->pBlock, blockLen);
+    pMsg->flags = pBlock->flags;
   }
 
   // event log
-  if (pSender->seq == SYNC_SNAPSHOT_SEQ_END) {
-    syncLogSendSyncSnapshotSend(pSender->pSyncNode, pMsg, "snapshot sender finish");
-  } else {
-    syncLogSendSyncSnapshotSend(pSender->pSyncNode, pMsg, "snapshot sender sending");
-  }
+  syncLogSendSyncSnapshotSend(pSender->pSyncNode, pMsg, event);
 
   // send msg
   if (syncNodeSendMsgById(&pMsg->destId, pSender->pSyncNode, &rpcMsg) != 0) {
@@ -216,54 +226,85 @@ static int32_t snapshotSend(SSyncSnapshotSender *pSender) {
   return 0;
 }
 
-// send snapshot data from cache
-int32_t snapshotReSend(SSyncSnapshotSender *pSender) {
-  // build msg
-  SRpcMsg rpcMsg = {0};
-  if (syncBuildSnapshotSend(&rpcMsg, pSender->blockLen, pSender->pSyncNode->vgId) != 0) {
-    sSError(pSender, "snapshot sender build msg failed since %s", terrstr());
-    return -1;
-  }
+// when sender receive ack, call this function to read and send blocks until the window is full.
+// the end msg is sent once all data blocks are acked, so the receiver applies the snapshot after the last write.
+static int32_t snapshotSend(SSyncSnapshotSender *pSender) {
+  int32_t window = snapshotSenderWindow(pSender);
 
-  SyncSnapshotSend *pMsg = rpcMsg.pCont;
-  pMsg->srcId = pSender->pSyncNode->myRaftId;
-  pMsg->destId = pSender->pSyncNode->replicasId[pSender->replicaIndex];
-  pMsg->term = raftStoreGetTerm(pSender->pSyncNode);
-  pMsg->beginIndex = pSender->snapshotParam.start;
-  pMsg->lastIndex = pSender->snapshot.lastApplyIndex;
-  pMsg->lastTerm = pSender->snapshot.lastApplyTerm;
-  pMsg->lastConfigIndex = pSender->snapshot.lastConfigIndex;
-  pMsg->lastConfig = pSender->lastConfig;
-  pMsg->seq = pSender->seq;
+  while (pSender->seq != SYNC_SNAPSHOT_SEQ_END && pSender->seq - pSender->ack < window) {
+    if (pSender->readEnd) {
+      if (pSender->ack < pSender->seq) break;
 
-  if (pSender->pCurrentBlock != NULL && pSender->blockLen > 0) {
-    memcpy(pMsg->data, pSender->pCurrentBlock, pSender->blockLen);
+      // read finish, update seq to end
+      pSender->seq = SYNC_SNAPSHOT_SEQ_END;
+      sSInfo(pSender, "vgId:%d, snapshot sender read to the end, seq:%d", pSender->pSyncNode->vgId, pSender->seq);
+      return snapshotSenderSendMsg(pSender, SYNC_SNAPSHOT_SEQ_END, NULL, "snapshot sender finish");
+    }
+
+    // read data
+    void   *pData = NULL;
+    int32_t len = 0;
+    int32_t ret = pSender->pSyncNode->pFsm->FpSnapshotDoRead(pSender->pSyncNode->pFsm, pSender->pReader, &pData, &len);
+    if (ret != 0) {
+      sSError(pSender, "snapshot sender read failed since %s", terrstr());
+      return -1;
+    }
+
+    if (len <= 0) {
+      taosMemoryFree(pData);
+      pSender->readEnd = true;
+      continue;
+    }
+
+    SSyncSnapBlock *pBlock = &pSender->blocks[(pSender->seq + 1) % SYNC_SNAPSHOT_BUFFER_SIZE];
+    ASSERT(pBlock->pBlock == NULL);
+    snapshotSenderSetBlock(pSender, pBlock, pData, len);
+    pBlock->seq = ++pSender->seq;
+
+    sSDebug(pSender, "vgId:%d, snapshot sender continue to read, blockLen:%d sendLen:%d seq:%d",
+            pSender->pSyncNode->vgId, len, pBlock->blockLen, pSender->seq);
+
+    if (snapshotSenderSendMsg(pSender, pSender->seq, pBlock, "snapshot sender sending") != 0) {
+      return -1;
+    }
   }
 
-  // event log
-  syncLogSendSyncSnapshotSend(pSender->pSyncNode, pMsg, "snapshot sender resend");
+  return 0;
+}
 
-  // send msg
-  if (syncNodeSendMsgById(&pMsg->destId, pSender->pSyncNode, &rpcMsg) != 0) {
-    sSError(pSender, "snapshot sender resend msg failed since %s", terrstr());
-    return -1;
+// send snapshot data from cache. the blocks not acked are all sent again, and the receiver drops the ones it has,
+// so an interrupted transfer resumes from the last block the receiver wrote.
+int32_t snapshotReSend(SSyncSnapshotSender *pSender) {
+  if (pSender->seq <= SYNC_SNAPSHOT_SEQ_BEGIN || pSender->seq == SYNC_SNAPSHOT_SEQ_END) {
+    return snapshotSenderSendMsg(pSender, pSender->seq, NULL, "snapshot sender resend");
+  }
+
+  for (int32_t seq = TMAX(pSender->ack + 1, SYNC_SNAPSHOT_SEQ_BEGIN + 1); seq <= pSender->seq; ++seq) {
+    SSyncSnapBlock *pBlock = &pSender->blocks[seq % SYNC_SNAPSHOT_BUFFER_SIZE];
+    ASSERT(pBlock->seq == seq);
+    if (snapshotSenderSendMsg(pSender, seq, pBlock, "snapshot sender resend") != 0) {
+      sSError(pSender, "snapshot sender resend msg failed since %s", terrstr());
+      return -1;
+    }
   }
 
-  pSender->lastSendTime = taosGetTimestampMs();
   return 0;
 }
 
 static int32_t snapshotSenderUpdateProgress(SSyncSnapshotSender *pSender, SyncSnapshotRsp *pMsg) {
-  if (pMsg->ack != pSender->seq) {
+  if (pMsg->ack < pSender->ack || pMsg->ack > pSender->seq) {
     sSError(pSender, "snapshot sender update seq failed, ack:%d seq:%d", pMsg->ack, pSender->seq);
     terrno = TSDB_CODE_SYN_INTERNAL_ERROR;
     return -1;
   }
 
+  // acks are cumulative, release all blocks acked
+  for (int32_t seq = TMAX(pSender->ack + 1, SYNC_SNAPSHOT_SEQ_BEGIN + 1); seq <= pMsg->ack; ++seq) {
+    snapshotBlockClear(&pSender->blocks[seq % SYNC_SNAPSHOT_BUFFER_SIZE]);
+  }
   pSender->ack = pMsg->ack;
-  pSender->seq++;
 
-  sSDebug(pSender, "snapshot sender update seq:%d", pSender->seq);
+  sSDebug(pSender, "snapshot sender update ack:%d seq:%d", pSender->ack, pSender->seq);
   return 0;
 }
 
@@ -338,6 +379,9 @@ void snapshotReceiverDestroy(SSyncSnapshotReceiver *pReceiver) {
     pReceiver->pWriter = NULL;
   }
 
+  // free blocks received ahead
+  snapshotBlocksClear(pReceiver->blocks);
+
   // free receiver
   taosMemoryFree(pReceiver);
 }
@@ -355,6 +399,7 @@ static int32_t snapshotReceiverStartWriter(SSyncSnapshotReceiver *pReceiver, Syn
 
   // update ack
   pReceiver->ack = SYNC_SNAPSHOT_SEQ_BEGIN;
+  snapshotBlocksClear(pReceiver->blocks);
 
   // update snapshot
   pReceiver->snapshot.lastApplyIndex = pBeginMsg->lastIndex;
@@ -408,9 +453,47 @@ void snapshotReceiverStop(SSyncSnapshotReceiver *pReceiver) {
     sRInfo(pReceiver, "snapshot receiver stop, writer is null");
   }
 
+  snapshotBlocksClear(pReceiver->blocks);
   pReceiver->start = false;
 }
 
+static int32_t snapshotReceiverWrite(SSyncSnapshotReceiver *pReceiver, int16_t flags, void *pData, int32_t len) {
+  if (len <= 0) return 0;
+
+  void *pRaw = NULL;
+  if (flags & SYNC_SNAPSHOT_FLAG_COMPRESS) {
+    int32_t rawLen = 0;
+    if (len > sizeof(int32_t)) {
+      memcpy(&rawLen, pData, sizeof(int32_t));
+    }
+    if (rawLen <= 0) {
+      sRError(pReceiver, "snapshot receiver got invalid compressed block, len:%d", len);
+      terrno = TSDB_CODE_SYN_INVALID_SNAPSHOT_MSG;
+      return -1;
+    }
+
+    pRaw = taosMemoryMalloc(rawLen);
+    if (pRaw == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
+    if (tsDecompressString((char *)pData + sizeof(int32_t), len - sizeof(int32_t), 1, pRaw, rawLen, ONE_STAGE_COMP,
+                           NULL, 0) != rawLen) {
+      sRError(pReceiver, "snapshot receiver failed to decompress block, len:%d rawLen:%d", len, rawLen);
+      taosMemoryFree(pRaw);
+      terrno = TSDB_CODE_SYN_INVALID_SNAPSHOT_MSG;
+      return -1;
+    }
+    pData = pRaw;
+    len = rawLen;
+  }
+
+  int32_t code = pReceiver->pSyncNode->pFsm->FpSnapshotDoWrite(pReceiver->pSyncNode->pFsm, pReceiver->pWriter, pData,
+                                                               len);
+  taosMemoryFree(pRaw);
+  return code;
+}
+
 // when recv last snapshot block, apply data into snapshot
 static int32_t snapshotReceiverFinish(SSyncSnapshotReceiver *pReceiver, SyncSnapshotSend *pMsg) {
   int32_t code = 0;
@@ -418,8 +501,7 @@ static int32_t snapshotReceiverFinish(SSyncSnapshotReceiver *pReceiver, SyncSnap
     // write data
     sRInfo(pReceiver, "snapshot receiver write finish, blockLen:%d seq:%d", pMsg->dataLen, pMsg->seq);
     if (pMsg->dataLen > 0) {
-      code = pReceiver->pSyncNode->pFsm->FpSnapshotDoWrite(pReceiver->pSyncNode->pFsm, pReceiver->pWriter, pMsg->data,
-                                                           pMsg->dataLen);
+      code = snapshotReceiverWrite(pReceiver, pMsg->flags, pMsg->data, pMsg->dataLen);
       if (code != 0) {
         sRError(pReceiver, "failed to finish snapshot receiver write since %s", terrstr());
         return -1;
@@ -468,10 +550,15 @@ static int32_t snapshotReceiverFinish(SSyncSnapshotReceiver *pReceiver, SyncSnap
   return 0;
 }
 
-// apply data block
+// apply data block, and the blocks received ahead of it
 // update progress
 static int32_t snapshotReceiverGotData(SSyncSnapshotReceiver *pReceiver, SyncSnapshotSend *pMsg) {
-  if (pMsg->seq != pReceiver->ack + 1) {
+  if (pMsg->seq <= pReceiver->ack) {
+    sRDebug(pReceiver, "snapshot receiver ignore duplicate block, ack:%d seq:%d", pReceiver->ack, pMsg->seq);
+    return 0;
+  }
+
+  if (pMsg->seq - pReceiver->ack > SYNC_SNAPSHOT_BUFFER_SIZE) {
     sRError(pReceiver, "snapshot receiver invalid seq, ack:%d seq:%d", pReceiver->ack, pMsg->seq);
     terrno = TSDB_CODE_SYN_INVALID_SNAPSHOT_MSG;
     return -1;
@@ -483,23 +570,49 @@ static int32_t snapshotReceiverGotData(SSyncSnapshotReceiver *pReceiver, SyncSna
     return -1;
   }
 
+  if (pMsg->seq > pReceiver->ack + 1) {
+    // a block before it is still in flight, keep it until the gap is filled
+    SSyncSnapBlock *pBlock = &pReceiver->blocks[pMsg->seq % SYNC_SNAPSHOT_BUFFER_SIZE];
+    if (pBlock->pBlock == NULL && pMsg->dataLen > 0) {
+      pBlock->pBlock = taosMemoryMalloc(pMsg->dataLen);
+      if (pBlock->pBlock == NULL) {
+        terrno = TSDB_CODE_OUT_OF_MEMORY;
+        return -1;
+      }
+      memcpy(pBlock->pBlock, pMsg->data, pMsg->dataLen);
+      pBlock->blockLen = pMsg->dataLen;
+      pBlock->flags = pMsg->flags;
+      pBlock->seq = pMsg->seq;
+    }
+    sRDebug(pReceiver, "snapshot receiver keep block ahead, blockLen:%d ack:%d seq:%d", pMsg->dataLen, pReceiver->ack,
+            pMsg->seq);
+    return 0;
+  }
+
   sRDebug(pReceiver, "snapshot receiver continue to write, blockLen:%d seq:%d", pMsg->dataLen, pMsg->seq);
 
-  if (pMsg->dataLen > 0) {
-    // apply data block
-    int32_t code = pReceiver->pSyncNode->pFsm->FpSnapshotDoWrite(pReceiver->pSyncNode->pFsm, pReceiver->pWriter,
-                                                                 pMsg->data, pMsg->dataLen);
-    if (code != 0) {
+  // apply data block
+  if (snapshotReceiverWrite(pReceiver, pMsg->flags, pMsg->data, pMsg->dataLen) != 0) {
+    sRError(pReceiver, "snapshot receiver continue write failed since %s", terrstr());
+    return -1;
+  }
+  pReceiver->ack = pMsg->seq;
+
+  // apply the blocks received ahead
+  while (true) {
+    SSyncSnapBlock *pBlock = &pReceiver->blocks[(pReceiver->ack + 1) % SYNC_SNAPSHOT_BUFFER_SIZE];
+    if (pBlock->pBlock == NULL || pBlock->seq != pReceiver->ack + 1) break;
+
+    if (snapshotReceiverWrite(pReceiver, pBlock->flags, pBlock->pBlock, pBlock->blockLen) != 0) {
       sRError(pReceiver, "snapshot receiver continue write failed since %s", terrstr());
       return -1;
     }
+    pReceiver->ack = pBlock->seq;
+    snapshotBlockClear(pBlock);
   }
 
-  // update progress
-  pReceiver->ack = pMsg->seq;
-
   // event log
-  sRDebug(pReceiver, "snapshot receiver continue to write finish");
+  sRDebug(pReceiver, "snapshot receiver continue to write finish, ack:%d", pReceiver->ack);
   return 0;
 }
 
@@ -522,6 +635,19 @@ SyncIndex syncNodeGetSnapBeginIndex(SSyncNode *ths) {
   return snapStart;
 }
 
+// the receiver takes the start time of the sender, so it does not act before that time comes on its own clock
+static void snapshotReceiverWaitForTime(SSyncSnapshotReceiver *pReceiver, int64_t startTime, const char *stage) {
+  int64_t waitMs = startTime - taosGetTimestampMs();
+  if (waitMs <= 0) return;
+
+  sRInfo(pReceiver, "snapshot receiver %s waitting %" PRId64 "ms for true time, stime:%" PRId64, stage, waitMs,
+         startTime);
+  while (waitMs > 0) {
+    taosMsleep((int32_t)waitMs);
+    waitMs = startTime - taosGetTimestampMs();
+  }
+}
+
 static int32_t syncNodeOnSnapshotPrep(SSyncNode *pSyncNode, SyncSnapshotSend *pMsg) {
   SSyncSnapshotReceiver *pReceiver = pSyncNode->pNewNodeReceiver;
   int64_t                timeNow = taosGetTimestampMs();
@@ -552,19 +678,15 @@ static int32_t syncNodeOnSnapshotPrep(SSyncNode *pSyncNode, SyncSnapshotSend *pM
   }
 
 _START_RECEIVER:
-  if (timeNow - pMsg->startTime > SNAPSHOT_MAX_CLOCK_SKEW_MS) {
+  // the wait for the start time is bounded by the same skew
+  if (TABS(timeNow - pMsg->startTime) > SNAPSHOT_MAX_CLOCK_SKEW_MS) {
     sRError(pReceiver, "snapshot receiver time skew too much, now:%" PRId64 " msg startTime:%" PRId64, timeNow,
             pMsg->startTime);
     terrno = TSDB_CODE_SYN_INTERNAL_ERROR;
     code = terrno;
   } else {
     // waiting for clock match
-    while (timeNow < pMsg->startTime) {
-      sRInfo(pReceiver, "snapshot receiver pre waitting for true time, now:%" PRId64 ", startTime:%" PRId64, timeNow,
-             pMsg->startTime);
-      taosMsleep(10);
-      timeNow = taosGetTimestampMs();
-    }
+    snapshotReceiverWaitForTime(pReceiver, pMsg->startTime, "pre");
 
     if (snapshotReceiverIsStart(pReceiver)) {
       sRInfo(pReceiver, "snapshot receiver already start and force stop pre one");
@@ -667,13 +789,7 @@ static int32_t syncNodeOnSnapshotReceive(SSyncNode *pSyncNode, SyncSnapshotSend
   SSyncSnapshotReceiver *pReceiver = pSyncNode->pNewNodeReceiver;
 
   // waiting for clock match
-  int64_t timeNow = taosGetTimestampMs();
-  while (timeNow < pMsg->startTime) {
-    sRInfo(pReceiver, "snapshot receiver receiving waitting for true time, now:%" PRId64 ", stime:%" PRId64, timeNow,
-           pMsg->startTime);
-    taosMsleep(10);
-    timeNow = taosGetTimestampMs();
-  }
+  snapshotReceiverWaitForTime(pReceiver, pMsg->startTime, "receiving");
 
   int32_t code = 0;
   if (snapshotReceiverGotData(pReceiver, pMsg) != 0) {
@@ -717,13 +833,7 @@ static int32_t syncNodeOnSnapshotEnd(SSyncNode *pSyncNode, SyncSnapshotSend *pMs
   SSyncSnapshotReceiver *pReceiver = pSyncNode->pNewNodeReceiver;
 
   // waiting for clock match
-  int64_t timeNow = taosGetTimestampMs();
-  while (timeNow < pMsg->startTime) {
-    sRInfo(pReceiver, "snapshot receiver finish waitting for true time, now:%" PRId64 ", stime:%" PRId64, timeNow,
-           pMsg->startTime);
-    taosMsleep(10);
-    timeNow = taosGetTimestampMs();
-  }
+  snapshotReceiverWaitForTime(pReceiver, pMsg->startTime, "finish");
 
   int32_t code = snapshotReceiverFinish(pReceiver, pMsg);
   if (code == 0) {
@@ -868,6 +978,7 @@ static int32_t syncNodeOnSnapshotPrepRsp(SSyncNode *pSyncNode, SSyncSnapshotSend
 
   // update sender
   pSender->snapshot = snapshot;
+  pSender->peerFlags = pMsg->flags;
 
   // start reader
   int32_t code = pSyncNode->pFsm->FpSnapshotStartRead(pSyncNode->pFsm, &pSender->snapshotParam, &pSender->pReader);
@@ -1002,7 +1113,7 @@ int32_t syncNodeOnSnapshotRsp(SSyncNode *pSyncNode, const SRpcMsg *pRpcMsg) {
   }
 
   // send next msg
-  if (pMsg->ack == pSender->seq) {
+  if (pMsg->ack > pSender->ack && pMsg->ack <= pSender->seq && pSender->seq != SYNC_SNAPSHOT_SEQ_END) {
     syncLogRecvSyncSnapshotRsp(pSyncNode, pMsg, "process seq data");
     // update sender ack
     if (snapshotSenderUpdateProgress(pSender, pMsg) != 0) {
@@ -1011,12 +1122,15 @@ int32_t syncNodeOnSnapshotRsp(SSyncNode *pSyncNode, const SRpcMsg *pRpcMsg) {
     if (snapshotSend(pSender) != 0) {
       return -1;
     }
-  } else if (pMsg->ack == pSender->seq - 1) {
+  } else if (pMsg->ack == pSender->ack && snapshotSenderWindow(pSender) == 1) {
     // maybe resend
     syncLogRecvSyncSnapshotRsp(pSyncNode, pMsg, "process seq and resend");
     if (snapshotReSend(pSender) != 0) {
       return -1;
     }
+  } else if (pMsg->ack <= pSender->ack) {
+    // the receiver acks again for blocks ahead or duplicated, the window is not moved
+    syncLogRecvSyncSnapshotRsp(pSyncNode, pMsg, "process seq and ignore");
   } else {
     // error log
     syncLogRecvSyncSnapshotRsp(pSyncNode, pMsg, "receive error ack");
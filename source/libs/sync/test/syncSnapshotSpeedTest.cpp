@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include "syncTest.h"
+#include "tglobal.h"
+
+// Measures snapshot transfer between two local replicas.
+//
+// run one process per replica:
+//   syncSnapshotSpeedTest 2 0 <snapshotMB> <blockKB>
+//   syncSnapshotSpeedTest 2 1 <snapshotMB> <blockKB>
+// replica 0 owns a synthetic snapshot and sends it to replica 1 once it is the leader, the throughput is printed by
+// both sides. if replica 1 wins the election, restart it. syncSnapReplWindow and syncSnapReplCompress select the
+// protocol under test.
+
+uint16_t    gPorts[] = {7010, 7110, 7210, 7310, 7410};
+const char* gDir = "./syncSnapshotSpeedTest";
+int32_t     gVgId = 1234;
+int32_t     gMyIndex = 0;
+int64_t     gSnapshotBytes = 0;
+int32_t     gBlockBytes = 0;
+SyncIndex   gLastApplyIndex = SYNC_INDEX_INVALID;
+
+typedef struct {
+  int64_t offset;
+  int64_t startMs;
+} SSpeedReader;
+
+typedef struct {
+  int64_t bytes;
+  int64_t startMs;
+} SSpeedWriter;
+
+static void printSpeed(const char* role, int64_t bytes, int64_t startMs) {
+  int64_t elapsed = TMAX(taosGetTimestampMs() - startMs, 1);
+  printf("%s: %.1f MB in %" PRId64 " ms, %.2f MB/s, window:%d compress:%d\n", role, bytes / 1048576.0, elapsed,
+         bytes / 1048576.0 * 1000 / elapsed, tsSnapReplWindow, tsSnapReplCompress);
+}
+
+void GetSnapshotInfoCb(const struct SSyncFSM* pFsm, SSnapshot* pSnapshot) {
+  pSnapshot->data = NULL;
+  pSnapshot->lastApplyIndex = gLastApplyIndex;
+  pSnapshot->lastApplyTerm = 100;
+  pSnapshot->lastConfigIndex = SYNC_INDEX_INVALID;
+}
+
+int32_t CommitCb(const struct SSyncFSM* pFsm, SRpcMsg* pMsg, const SFsmCbMeta* pMeta) {
+  gLastApplyIndex = TMAX(gLastApplyIndex, pMeta->index);
+  rpcFreeCont(pMsg->pCont);
+  pMsg->pCont = NULL;
+  return 0;
+}
+
+SyncIndex AppliedIndexCb(const struct SSyncFSM* pFsm) { return gLastApplyIndex; }
+
+int32_t ApplyQueueItemsCb(const struct SSyncFSM* pFsm) { return 0; }
+
+bool ApplyQueueEmptyCb(const struct SSyncFSM* pFsm) { return true; }
+
+void RestoreFinishCb(const struct SSyncFSM* pFsm, const SyncIndex commitIdx) {}
+
+int32_t SnapshotStartRead(const struct SSyncFSM* pFsm, void* pParam, void** ppReader) {
+  SSpeedReader* pReader = (SSpeedReader*)taosMemoryCalloc(1, sizeof(SSpeedReader));
+  pReader->startMs = taosGetTimestampMs();
+  *ppReader = pReader;
+  return 0;
+}
+
+void SnapshotStopRead(const struct SSyncFSM* pFsm, void* pReader) {
+  SSpeedReader* pSpeedReader = (SSpeedReader*)pReader;
+  printSpeed("sender", pSpeedReader->offset, pSpeedReader->startMs);
+  taosMemoryFree(pReader);
+}
+
+// blocks look like time series data, so compression has something to do
+int32_t SnapshotDoRead(const struct SSyncFSM* pFsm, void* pReader, void** ppBuf, int32_t* len) {
+  SSpeedReader* pSpeedReader = (SSpeedReader*)pReader;
+  int64_t       left = gSnapshotBytes - pSpeedReader->offset;
+  if (left <= 0) {
+    *ppBuf = NULL;
+    *len = 0;
+    return 0;
+  }
+
+  int32_t  nValues = TMAX((int32_t)(TMIN(left, gBlockBytes) / sizeof(int64_t)), 1);
+  int32_t  bytes = nValues * sizeof(int64_t);
+  int64_t* pBuf = (int64_t*)taosMemoryMalloc(bytes);
+  int64_t  ts = 1600000000000 + pSpeedReader->offset;
+  for (int32_t i = 0; i < nValues; ++i) {
+    pBuf[i] = ts + i * 1000 + taosRand() % 4;
+  }
+
+  pSpeedReader->offset += bytes;
+  *ppBuf = pBuf;
+  *len = bytes;
+  return 0;
+}
+
+int32_t SnapshotStartWrite(const struct SSyncFSM* pFsm, void* pParam, void** ppWriter) {
+  SSpeedWriter* pWriter = (SSpeedWriter*)taosMemoryCalloc(1, sizeof(SSpeedWriter));
+  pWriter->startMs = taosGetTimestampMs();
+  *ppWriter = pWriter;
+  return 0;
+}
+
+int32_t SnapshotStopWrite(const struct SSyncFSM* pFsm, void* pWriter, bool isApply, SSnapshot* pSnapshot) {
+  SSpeedWriter* pSpeedWriter = (SSpeedWriter*)pWriter;
+  if (isApply) {
+    printSpeed("receiver", pSpeedWriter->bytes, pSpeedWriter->startMs);
+    gLastApplyIndex = pSnapshot->lastApplyIndex;
+  }
+  taosMemoryFree(pWriter);
+  return 0;
+}
+
+int32_t SnapshotDoWrite(const struct SSyncFSM* pFsm, void* pWriter, void* pBuf, int32_t len) {
+  ((SSpeedWriter*)pWriter)->bytes += len;
+  return 0;
+}
+
+SSyncFSM* createFsm() {
+  SSyncFSM* pFsm = (SSyncFSM*)taosMemoryCalloc(1, sizeof(SSyncFSM));
+  pFsm->FpCommitCb = CommitCb;
+  pFsm->FpAppliedIndexCb = AppliedIndexCb;
+  pFsm->FpApplyQueueItems = ApplyQueueItemsCb;
+  pFsm->FpApplyQueueEmptyCb = ApplyQueueEmptyCb;
+  pFsm->FpRestoreFinishCb = RestoreFinishCb;
+  pFsm->FpGetSnapshotInfo = GetSnapshotInfoCb;
+  pFsm->FpSnapshotStartRead = SnapshotStartRead;
+  pFsm->FpSnapshotStopRead = SnapshotStopRead;
+  pFsm->FpSnapshotDoRead = SnapshotDoRead;
+  pFsm->FpSnapshotStartWrite = SnapshotStartWrite;
+  pFsm->FpSnapshotStopWrite = SnapshotStopWrite;
+  pFsm->FpSnapshotDoWrite = SnapshotDoWrite;
+  return pFsm;
+}
+
+SWal* createWal(char* path, int32_t vgId) {
+  SWalCfg walCfg;
+  memset(&walCfg, 0, sizeof(SWalCfg));
+  walCfg.vgId = vgId;
+  walCfg.fsyncPeriod = 1000;
+  walCfg.retentionPeriod = 1000;
+  walCfg.rollPeriod = 1000;
+  walCfg.retentionSize = 1000;
+  walCfg.segSize = 1000;
+  walCfg.level = TAOS_WAL_FSYNC;
+  SWal* pWal = walOpen(path, &walCfg);
+  assert(pWal != NULL);
+  return pWal;
+}
+
+int64_t createSyncNode(int32_t replicaNum, int32_t myIndex, int32_t vgId, SWal* pWal, char* path) {
+  SSyncInfo syncInfo = {0};
+  syncInfo.vgId = vgId;
+  syncInfo.msgcb = &gSyncIO->msgcb;
+  syncInfo.syncSendMSg = syncIOSendMsg;
+  syncInfo.syncEqMsg = syncIOEqMsg;
+  syncInfo.pFsm = createFsm();
+  snprintf(syncInfo.path, sizeof(syncInfo.path), "%s_sync_replica%d_index%d", path, replicaNum, myIndex);
+  syncInfo.pWal = pWal;
+
+  SSyncCfg* pCfg = &syncInfo.syncCfg;
+  pCfg->myIndex = myIndex;
+  pCfg->replicaNum = replicaNum;
+
+  for (int i = 0; i < replicaNum; ++i) {
+    pCfg->nodeInfo[i].nodePort = gPorts[i];
+    taosGetFqdn(pCfg->nodeInfo[i].nodeFqdn);
+  }
+
+  int64_t rid = syncOpen(&syncInfo);
+  assert(rid > 0);
+
+  SSyncNode* pSyncNode = (SSyncNode*)syncNodeAcquire(rid);
+  assert(pSyncNode != NULL);
+  gSyncIO->pSyncNode = pSyncNode;
+  syncNodeRelease(pSyncNode);
+
+  return rid;
+}
+
+void usage(char* exe) { printf("usage: %s replicaNum myIndex snapshotMB blockKB\n", exe); }
+
+int main(int argc, char** argv) {
+  tsAsyncLog = 0;
+  sDebugFlag = DEBUG_INFO + DEBUG_SCREEN + DEBUG_FILE;
+  if (argc != 5) {
+    usage(argv[0]);
+    exit(-1);
+  }
+  int32_t replicaNum = atoi(argv[1]);
+  gMyIndex = atoi(argv[2]);
+  gSnapshotBytes = atoll(argv[3]) * 1024 * 1024;
+  gBlockBytes = atoi(argv[4]) * 1024;
+
+  assert(replicaNum == 2);
+  assert(gMyIndex >= 0 && gMyIndex < replicaNum);
+  assert(gBlockBytes > 0);
+
+  // the sender starts with a snapshot, the receiver with nothing
+  gLastApplyIndex = (gMyIndex == 0) ? 1000 : SYNC_INDEX_INVALID;
+
+  int code = walInit();
+  assert(code == 0);
+  code = syncInit();
+  assert(code == 0);
+  code = syncIOStart((char*)"127.0.0.1", gPorts[gMyIndex]);
+  assert(code == 0);
+
+  char walPath[128];
+  snprintf(walPath, sizeof(walPath), "%s_wal_replica%d_index%d", gDir, replicaNum, gMyIndex);
+  taosRemoveDir(walPath);
+  SWal* pWal = createWal(walPath, gVgId);
+
+  int64_t rid = createSyncNode(replicaNum, gMyIndex, gVgId, pWal, (char*)gDir);
+  assert(rid > 0);
+  syncStart(rid);
+
+  SSyncNode* pSyncNode = (SSyncNode*)syncNodeAcquire(rid);
+  assert(pSyncNode != NULL);
+
+  bool started = false;
+  while (1) {
+    if (gMyIndex == 0 && !started && pSyncNode->state == TAOS_SYNC_STATE_LEADER) {
+      started = (syncNodeStartSnapshot(pSyncNode, &pSyncNode->replicasId[1]) == 0);
+    }
+    taosMsleep(100);
+  }
+
+  syncNodeRelease(pSyncNode);
+  syncStop(rid);
+  walClose(pWal);
+  syncIOStop();
+  walCleanUp();
+  return 0;
+}
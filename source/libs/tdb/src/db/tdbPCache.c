@@ -17,18 +17,38 @@
 // #include <sys/types.h>
 // #include <unistd.h>
 
+// The cache is split into shards by page id. Each shard has its own lock, hash table, free list and replacement
+// lists, so lookups of different pages do not serialize on one lock. Shards are kept at TDB_PCACHE_MIN_SHARD_PAGES
+// frames or more, and a shard that runs out of frames borrows one from the others.
+#define TDB_PCACHE_MAX_SHARDS      16
+#define TDB_PCACHE_MIN_SHARD_PAGES 64
+
+// Replacement is a simplified 2Q: an unpinned page goes to the probation list and is only promoted to the protected
+// list once it is hit again while cached. Victims come from probation first, so a one pass scan of an index can not
+// flush the hot pages of the others.
+#define TDB_PCACHE_HOT_PERCENT 75
+
+typedef struct {
+  tdb_rwlock_t lock;
+  int          nFree;
+  SPage       *pFree;
+  int          nPage;
+  int          nHash;
+  SPage      **pgHash;
+  int          nRecyclable;
+  int          nHot;
+  SPage        lru;     // probation
+  SPage        lruHot;  // protected
+  SPCacheStat  stat;
+} SPCacheShard;
+
 struct SPCache {
-  int         szPage;
-  int         nPages;
-  SPage     **aPage;
-  tdb_mutex_t mutex;
-  int         nFree;
-  SPage      *pFree;
-  int         nPage;
-  int         nHash;
-  SPage     **pgHash;
-  int         nRecyclable;
-  SPage       lru;
+  int           szPage;
+  int           nPages;
+  SPage       **aPage;
+  int           nShard;  // power of 2
+  int           nHotMax;  // max length of the protected list of a shard
+  SPCacheShard *aShard;
 };
 
 static inline uint32_t tdbPCachePageHash(const SPgid *pPgid) {
@@ -36,25 +56,48 @@ static inline uint32_t tdbPCachePageHash(const SPgid *pPgid) {
   return (uint32_t)(t[0] + t[1] + t[2] + t[3] + t[4] + t[5] + (pPgid)->pgno);
 }
 
+// the bucket is taken from the low bits of the hash, mix them before choosing the shard
+static inline SPCacheShard *tdbPCacheGetShard(SPCache *pCache, const SPgid *pPgid) {
+  return &pCache->aShard[((tdbPCachePageHash(pPgid) * 2654435761u) >> 16) & (pCache->nShard - 1)];
+}
+
 static int    tdbPCacheOpenImpl(SPCache *pCache);
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn);
-static void   tdbPCachePinPage(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage);
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, TXN *pTxn);
+static void   tdbPCachePinPage(SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheRemovePageFromHash(SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheAddPageToHash(SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheUnpinPage(SPCache *pCache, SPCacheShard *pShard, SPage *pPage);
 static int    tdbPCacheCloseImpl(SPCache *pCache);
 
-static void tdbPCacheInitLock(SPCache *pCache) { tdbMutexInit(&(pCache->mutex), NULL); }
-static void tdbPCacheDestroyLock(SPCache *pCache) { tdbMutexDestroy(&(pCache->mutex)); }
-static void tdbPCacheLock(SPCache *pCache) { tdbMutexLock(&(pCache->mutex)); }
-static void tdbPCacheUnlock(SPCache *pCache) { tdbMutexUnlock(&(pCache->mutex)); }
+static void tdbPCacheInitLock(SPCacheShard *pShard) { tdbRwlockInit(&(pShard->lock), NULL); }
+static void tdbPCacheDestroyLock(SPCacheShard *pShard) { tdbRwlockDestroy(&(pShard->lock)); }
+static void tdbPCacheUnlock(SPCacheShard *pShard) { tdbRwlockUnlock(&(pShard->lock)); }
+
+static void tdbPCacheLock(SPCacheShard *pShard) {
+  if (tdbRwlockTryWrlock(&(pShard->lock)) != 0) {
+    atomic_add_fetch_64(&pShard->stat.nContention, 1);
+    tdbRwlockWrlock(&(pShard->lock));
+  }
+}
+
+static void tdbPCacheLockAll(SPCache *pCache) {
+  for (int iShard = 0; iShard < pCache->nShard; iShard++) {
+    tdbPCacheLock(&pCache->aShard[iShard]);
+  }
+}
+
+static void tdbPCacheUnlockAll(SPCache *pCache) {
+  for (int iShard = pCache->nShard - 1; iShard >= 0; iShard--) {
+    tdbPCacheUnlock(&pCache->aShard[iShard]);
+  }
+}
 
 int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
   SPCache *pCache;
   void    *pPtr;
   SPage   *pPgHdr;
 
-  pCache = (SPCache *)tdbOsCalloc(1, sizeof(*pCache) + sizeof(SPage *) * cacheSize);
+  pCache = (SPCache *)tdbOsCalloc(1, sizeof(*pCache));
   if (pCache == NULL) {
     return -1;
   }
@@ -67,7 +110,21 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
     return -1;
   }
 
+  pCache->nShard = 1;
+  while (pCache->nShard < TDB_PCACHE_MAX_SHARDS && pCache->nShard * 2 * TDB_PCACHE_MIN_SHARD_PAGES <= cacheSize) {
+    pCache->nShard *= 2;
+  }
+  pCache->nHotMax = cacheSize / pCache->nShard * TDB_PCACHE_HOT_PERCENT / 100;
+  pCache->aShard = (SPCacheShard *)tdbOsCalloc(pCache->nShard, sizeof(SPCacheShard));
+  if (pCache->aShard == NULL) {
+    tdbOsFree(pCache->aPage);
+    tdbOsFree(pCache);
+    return -1;
+  }
+
   if (tdbPCacheOpenImpl(pCache) < 0) {
+    tdbOsFree(pCache->aShard);
+    tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
     return -1;
   }
@@ -79,6 +136,7 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
 int tdbPCacheClose(SPCache *pCache) {
   if (pCache) {
     tdbPCacheCloseImpl(pCache);
+    tdbOsFree(pCache->aShard);
     tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
   }
@@ -122,11 +180,13 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
       aPage[iPage]->id = iPage;
     }
 
-    // add page to free list
+    // add page to free list, new frames are spread over the shards
     for (int32_t iPage = pCache->nPages; iPage < nPage; iPage++) {
-      aPage[iPage]->pFreeNext = pCache->pFree;
-      pCache->pFree = aPage[iPage];
-      pCache->nFree++;
+      SPCacheShard *pShard = &pCache->aShard[iPage % pCache->nShard];
+
+      aPage[iPage]->pFreeNext = pShard->pFree;
+      pShard->pFree = aPage[iPage];
+      pShard->nFree++;
     }
 
     for (int32_t iPage = 0; iPage < pCache->nPages; iPage++) {
@@ -136,49 +196,110 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
     tdbOsFree(pCache->aPage);
     pCache->aPage = aPage;
   } else {
-    for (SPage **ppPage = &pCache->pFree; *ppPage;) {
-      int32_t iPage = (*ppPage)->id;
-
-      if (iPage >= nPage) {
-        SPage *pPage = *ppPage;
-        *ppPage = pPage->pFreeNext;
-        pCache->aPage[pPage->id] = NULL;
-        tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-        pCache->nFree--;
-      } else {
-        ppPage = &(*ppPage)->pFreeNext;
+    for (int iShard = 0; iShard < pCache->nShard; iShard++) {
+      SPCacheShard *pShard = &pCache->aShard[iShard];
+
+      for (SPage **ppPage = &pShard->pFree; *ppPage;) {
+        int32_t iPage = (*ppPage)->id;
+
+        if (iPage >= nPage) {
+          SPage *pPage = *ppPage;
+          *ppPage = pPage->pFreeNext;
+          pCache->aPage[pPage->id] = NULL;
+          tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+          pShard->nFree--;
+        } else {
+          ppPage = &(*ppPage)->pFreeNext;
+        }
       }
     }
   }
 
   pCache->nPages = nPage;
+  pCache->nHotMax = nPage / pCache->nShard * TDB_PCACHE_HOT_PERCENT / 100;
   return 0;
 }
 
 int tdbPCacheAlter(SPCache *pCache, int32_t nPage) {
   int ret = 0;
 
-  tdbPCacheLock(pCache);
+  tdbPCacheLockAll(pCache);
 
   ret = tdbPCacheAlterImpl(pCache, nPage);
 
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlockAll(pCache);
 
   return ret;
 }
 
+static SPage *tdbPCacheFindPage(SPCacheShard *pShard, const SPgid *pPgid) {
+  SPage *pPage = pShard->pgHash[tdbPCachePageHash(pPgid) % pShard->nHash];
+  while (pPage) {
+    if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
+    pPage = pPage->pHashNext;
+  }
+
+  return pPage;
+}
+
+// Take one more reference of a page that is pinned by others. Such a page is in no replacement list, so the shard
+// only has to be protected against changes of the hash table, which a shared lock does.
+static bool tdbPCacheRefPinnedPage(SPage *pPage, i32 *pnRef) {
+  i32 nRef = tdbGetPageRef(pPage);
+  while (nRef > 0) {
+    i32 nOld = atomic_val_compare_exchange_32(&pPage->nRef, nRef, nRef + 1);
+    if (nOld == nRef) {
+      *pnRef = nRef + 1;
+      return true;
+    }
+    nRef = nOld;
+  }
+  return false;
+}
+
+// Drop a reference that is not the last one, this never changes the state of the shard and needs no lock.
+static bool tdbPCacheUnrefSharedPage(SPage *pPage) {
+  i32 nRef = tdbGetPageRef(pPage);
+  while (nRef > 1) {
+    i32 nOld = atomic_val_compare_exchange_32(&pPage->nRef, nRef, nRef - 1);
+    if (nOld == nRef) return true;
+    nRef = nOld;
+  }
+  return false;
+}
+
 SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
-  SPage *pPage;
-  i32    nRef = 0;
+  SPCacheShard *pShard = tdbPCacheGetShard(pCache, pPgid);
+  SPage        *pPage;
+  i32           nRef = 0;
+
+  if (tdbRwlockTryWrlock(&(pShard->lock)) != 0) {
+    atomic_add_fetch_64(&pShard->stat.nContention, 1);
+
+    // the shard is busy, but a page pinned by others can still be shared under the read lock
+    if (pTxn) {
+      tdbRwlockRdlock(&(pShard->lock));
+      pPage = tdbPCacheFindPage(pShard, pPgid);
+      if (pPage && pPage->isLocal && tdbPCacheRefPinnedPage(pPage, &nRef)) {
+        atomic_store_8((int8_t volatile *)&pPage->isHot, 1);
+        atomic_add_fetch_64(&pShard->stat.nHit, 1);
+        tdbPCacheUnlock(pShard);
+
+        tdbTrace("pcache/fetch pinned page %p/%d/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id, nRef);
+        return pPage;
+      }
+      tdbPCacheUnlock(pShard);
+    }
 
-  tdbPCacheLock(pCache);
+    tdbRwlockWrlock(&(pShard->lock));
+  }
 
-  pPage = tdbPCacheFetchImpl(pCache, pPgid, pTxn);
+  pPage = tdbPCacheFetchImpl(pCache, pShard, pPgid, pTxn);
   if (pPage) {
     nRef = tdbRefPage(pPage);
   }
 
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pShard);
 
   // printf("thread %" PRId64 " fetch page %d pgno %d pPage %p nRef %d\n", taosGetSelfPthreadId(), pPage->id,
   //        TDB_PAGE_PGNO(pPage), pPage, nRef);
@@ -193,55 +314,65 @@ SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
 }
 
 void tdbPCacheMarkFree(SPCache *pCache, SPage *pPage) {
-  tdbPCacheLock(pCache);
-  tdbPCacheRemovePageFromHash(pCache, pPage);
+  SPCacheShard *pShard = tdbPCacheGetShard(pCache, &pPage->pgid);
+
+  tdbPCacheLock(pShard);
+  tdbPCacheRemovePageFromHash(pShard, pPage);
   pPage->isFree = 1;
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pShard);
 }
 
-static void tdbPCacheFreePage(SPCache *pCache, SPage *pPage) {
+static void tdbPCacheFreePage(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
   if (pPage->id < pCache->nPages) {
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
+    pPage->pFreeNext = pShard->pFree;
+    pShard->pFree = pPage;
     pPage->isFree = 0;
-    ++pCache->nFree;
+    ++pShard->nFree;
     tdbTrace("pcache/free page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
   } else {
     tdbTrace("pcache/free2 page: %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
 
-    tdbPCacheRemovePageFromHash(pCache, pPage);
+    tdbPCacheRemovePageFromHash(pShard, pPage);
     tdbPageDestroy(pPage, tdbDefaultFree, NULL);
   }
 }
 
 void tdbPCacheInvalidatePage(SPCache *pCache, SPager *pPager, SPgno pgno) {
-  SPgid        pgid;
-  const SPgid *pPgid = &pgid;
-  SPage       *pPage = NULL;
+  SPgid         pgid;
+  const SPgid  *pPgid = &pgid;
+  SPage        *pPage = NULL;
+  SPCacheShard *pShard;
 
   memcpy(&pgid, pPager->fid, TDB_FILE_ID_LEN);
   pgid.pgno = pgno;
+  pShard = tdbPCacheGetShard(pCache, pPgid);
 
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
-  while (pPage) {
-    if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
-    pPage = pPage->pHashNext;
-  }
-
+  tdbPCacheLock(pShard);
+  pPage = tdbPCacheFindPage(pShard, pPgid);
   if (pPage) {
-    tdbPCacheRemovePageFromHash(pCache, pPage);
+    tdbPCacheRemovePageFromHash(pShard, pPage);
   }
+  tdbPCacheUnlock(pShard);
 }
 
 void tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn) {
-  i32 nRef;
+  SPCacheShard *pShard;
+  i32           nRef;
 
   if (!pTxn) {
     tdbError("tdb/pcache: null ptr pTxn, release failed.");
     return;
   }
 
-  tdbPCacheLock(pCache);
+  if (tdbPCacheUnrefSharedPage(pPage)) {
+    tdbTrace("pcache/release shared page %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
+    return;
+  }
+
+  // the caller still holds a reference, so the page id and thus the shard can not change under us
+  pShard = tdbPCacheGetShard(pCache, &pPage->pgid);
+
+  tdbPCacheLock(pShard);
   nRef = tdbUnrefPage(pPage);
   tdbTrace("pcache/release page %p/%d/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id, nRef);
   if (nRef == 0) {
@@ -251,26 +382,91 @@ void tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn) {
     // if (nRef == 0) {
     if (pPage->isLocal) {
       if (!pPage->isFree) {
-        tdbPCacheUnpinPage(pCache, pPage);
+        tdbPCacheUnpinPage(pCache, pShard, pPage);
       } else {
-        tdbPCacheFreePage(pCache, pPage);
+        tdbPCacheFreePage(pCache, pShard, pPage);
       }
     } else {
       if (TDB_TXN_IS_WRITE(pTxn)) {
         // remove from hash
-        tdbPCacheRemovePageFromHash(pCache, pPage);
+        tdbPCacheRemovePageFromHash(pShard, pPage);
       }
 
       tdbPageDestroy(pPage, pTxn->xFree, pTxn->xArg);
     }
     // }
   }
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pShard);
 }
 
 int tdbPCacheGetPageSize(SPCache *pCache) { return pCache->szPage; }
 
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
+int tdbPCacheGetShardNum(SPCache *pCache) { return pCache->nShard; }
+
+void tdbPCacheGetStat(SPCache *pCache, int iShard, SPCacheStat *pStat) {
+  SPCacheShard *pShard = &pCache->aShard[iShard];
+
+  pStat->nHit = atomic_load_64(&pShard->stat.nHit);
+  pStat->nMiss = atomic_load_64(&pShard->stat.nMiss);
+  pStat->nEvict = atomic_load_64(&pShard->stat.nEvict);
+  pStat->nSteal = atomic_load_64(&pShard->stat.nSteal);
+  pStat->nContention = atomic_load_64(&pShard->stat.nContention);
+}
+
+static SPage *tdbPCacheAllocFreePage(SPCacheShard *pShard) {
+  SPage *pPage = pShard->pFree;
+
+  if (pPage) {
+    pShard->pFree = pPage->pFreeNext;
+    pShard->nFree--;
+    pPage->pLruNext = NULL;
+  }
+
+  return pPage;
+}
+
+static SPage *tdbPCacheRecyclePage(SPCacheShard *pShard) {
+  SPage *pPage = NULL;
+
+  if (!pShard->lru.pLruPrev->isAnchor) {
+    pPage = pShard->lru.pLruPrev;
+  } else if (!pShard->lruHot.pLruPrev->isAnchor) {
+    pPage = pShard->lruHot.pLruPrev;
+  }
+
+  if (pPage) {
+    tdbPCacheRemovePageFromHash(pShard, pPage);
+    tdbPCachePinPage(pShard, pPage);
+    pShard->stat.nEvict++;
+  }
+
+  return pPage;
+}
+
+// Only try the locks of other shards, waiting for one while holding our own could deadlock
+static SPage *tdbPCacheStealPage(SPCache *pCache, SPCacheShard *pShard) {
+  SPage *pPage = NULL;
+
+  for (int iShard = 0; iShard < pCache->nShard && pPage == NULL; iShard++) {
+    SPCacheShard *pOther = &pCache->aShard[iShard];
+    if (pOther == pShard || tdbRwlockTryWrlock(&(pOther->lock)) != 0) continue;
+
+    pPage = tdbPCacheAllocFreePage(pOther);
+    if (pPage == NULL) {
+      pPage = tdbPCacheRecyclePage(pOther);
+    }
+
+    tdbPCacheUnlock(pOther);
+  }
+
+  if (pPage) {
+    pShard->stat.nSteal++;
+  }
+
+  return pPage;
+}
+
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, SPCacheShard *pShard, const SPgid *pPgid, TXN *pTxn) {
   int    ret = 0;
   SPage *pPage = NULL;
   SPage *pPageH = NULL;
@@ -281,15 +477,13 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   }
 
   // 1. Search the hash table
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
-  while (pPage) {
-    if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
-    pPage = pPage->pHashNext;
-  }
+  pPage = tdbPCacheFindPage(pShard, pPgid);
 
   if (pPage) {
     if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
-      tdbPCachePinPage(pCache, pPage);
+      tdbPCachePinPage(pShard, pPage);
+      pPage->isHot = 1;
+      pShard->stat.nHit++;
       return pPage;
     }
   }
@@ -298,23 +492,22 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   // 2. pPage && pPage->isLocal == 0 && !TDB_TXN_IS_WRITE(pTxn)
   pPageH = pPage;
   pPage = NULL;
+  pShard->stat.nMiss++;
 
   // 2. Try to allocate a new page from the free list
-  if (pCache->pFree) {
-    pPage = pCache->pFree;
-    pCache->pFree = pPage->pFreeNext;
-    pCache->nFree--;
-    pPage->pLruNext = NULL;
-  }
+  pPage = tdbPCacheAllocFreePage(pShard);
 
   // 3. Try to Recycle a page
-  if (!pPage && !pCache->lru.pLruPrev->isAnchor) {
-    pPage = pCache->lru.pLruPrev;
-    tdbPCacheRemovePageFromHash(pCache, pPage);
-    tdbPCachePinPage(pCache, pPage);
+  if (!pPage) {
+    pPage = tdbPCacheRecyclePage(pShard);
+  }
+
+  // 4. Try to borrow a page from other shards
+  if (!pPage) {
+    pPage = tdbPCacheStealPage(pCache, pShard);
   }
 
-  // 4. Try a create new page
+  // 5. Try a create new page
   if (!pPage && pTxn->xMalloc != NULL) {
     ret = tdbPageCreate(pCache->szPage, &pPage, pTxn->xMalloc, pTxn->xArg);
     if (ret < 0 || pPage == NULL) {
@@ -330,10 +523,11 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
     pPage->id = -1;
   }
 
-  // 5. Page here are just created from a free list
+  // 6. Page here are just created from a free list
   // or by recycling or allocated streesly,
   // need to initialize it
   if (pPage) {
+    pPage->isHot = 0;
     if (pPageH) {
       // copy the page content
       memcpy(&(pPage->pgid), pPgid, sizeof(*pPgid));
@@ -363,7 +557,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
       pPage->pPager = NULL;
 
       if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
-        tdbPCacheAddPageToHash(pCache, pPage);
+        tdbPCacheAddPageToHash(pShard, pPage);
       }
     }
   }
@@ -371,7 +565,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   return pPage;
 }
 
-static void tdbPCachePinPage(SPCache *pCache, SPage *pPage) {
+static void tdbPCachePinPage(SPCacheShard *pShard, SPage *pPage) {
   if (pPage->pLruNext != NULL) {
     int32_t nRef = tdbGetPageRef(pPage);
     if (nRef != 0) {
@@ -383,13 +577,23 @@ static void tdbPCachePinPage(SPCache *pCache, SPage *pPage) {
     pPage->pLruNext->pLruPrev = pPage->pLruPrev;
     pPage->pLruNext = NULL;
 
-    pCache->nRecyclable--;
+    pShard->nRecyclable--;
+    if (pPage->isHot) {
+      pShard->nHot--;
+    }
 
     tdbTrace("pcache/pin page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
   }
 }
 
-static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
+static void tdbPCacheLruPush(SPage *pAnchor, SPage *pPage) {
+  pPage->pLruPrev = pAnchor;
+  pPage->pLruNext = pAnchor->pLruNext;
+  pAnchor->pLruNext->pLruPrev = pPage;
+  pAnchor->pLruNext = pPage;
+}
+
+static void tdbPCacheUnpinPage(SPCache *pCache, SPCacheShard *pShard, SPage *pPage) {
   i32 nRef = tdbGetPageRef(pPage);
   if (nRef != 0) {
     tdbError("tdb/pcache: unpin page's ref not zero: %" PRId32, nRef);
@@ -411,46 +615,59 @@ static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
   tdbTrace("pCache:%p unpin page %p/%d, nPages:%d, pgno:%d, ", pCache, pPage, pPage->id, pCache->nPages,
            TDB_PAGE_PGNO(pPage));
   if (pPage->id < pCache->nPages) {
-    pPage->pLruPrev = &(pCache->lru);
-    pPage->pLruNext = pCache->lru.pLruNext;
-    pCache->lru.pLruNext->pLruPrev = pPage;
-    pCache->lru.pLruNext = pPage;
+    if (pPage->isHot) {
+      tdbPCacheLruPush(&(pShard->lruHot), pPage);
+      pShard->nHot++;
+
+      // demote the coldest protected page to probation once the protected list is full
+      if (pShard->nHot > pCache->nHotMax) {
+        SPage *pCold = pShard->lruHot.pLruPrev;
+
+        pCold->pLruPrev->pLruNext = pCold->pLruNext;
+        pCold->pLruNext->pLruPrev = pCold->pLruPrev;
+        pCold->isHot = 0;
+        pShard->nHot--;
+        tdbPCacheLruPush(&(pShard->lru), pCold);
+      }
+    } else {
+      tdbPCacheLruPush(&(pShard->lru), pPage);
+    }
 
-    pCache->nRecyclable++;
+    pShard->nRecyclable++;
 
     // printf("unpin page %d pgno %d pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
     tdbTrace("pcache/unpin page %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
   } else {
     tdbTrace("pcache destroy page: %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
 
-    tdbPCacheRemovePageFromHash(pCache, pPage);
+    tdbPCacheRemovePageFromHash(pShard, pPage);
     tdbPageDestroy(pPage, tdbDefaultFree, NULL);
   }
 }
 
-static void tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+static void tdbPCacheRemovePageFromHash(SPCacheShard *pShard, SPage *pPage) {
+  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pShard->nHash;
 
-  SPage **ppPage = &(pCache->pgHash[h]);
+  SPage **ppPage = &(pShard->pgHash[h]);
   for (; (*ppPage) && *ppPage != pPage; ppPage = &((*ppPage)->pHashNext))
     ;
 
   if (*ppPage) {
     *ppPage = pPage->pHashNext;
-    pCache->nPage--;
+    pShard->nPage--;
     // printf("rmv page %d to hash, pgno %d, pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
   }
 
   tdbTrace("pcache/remove page %p/%d from hash %" PRIu32 " pgno:%d, ", pPage, pPage->id, h, TDB_PAGE_PGNO(pPage));
 }
 
-static void tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+static void tdbPCacheAddPageToHash(SPCacheShard *pShard, SPage *pPage) {
+  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pShard->nHash;
 
-  pPage->pHashNext = pCache->pgHash[h];
-  pCache->pgHash[h] = pPage;
+  pPage->pHashNext = pShard->pgHash[h];
+  pShard->pgHash[h] = pPage;
 
-  pCache->nPage++;
+  pShard->nPage++;
 
   tdbTrace("pcache/add page %p/%d to hash %" PRIu32 " pgno:%d, ", pPage, pPage->id, h, TDB_PAGE_PGNO(pPage));
 }
@@ -461,12 +678,38 @@ static int tdbPCacheOpenImpl(SPCache *pCache) {
   int    tsize;
   int    ret;
 
-  tdbPCacheInitLock(pCache);
+  for (int iShard = 0; iShard < pCache->nShard; iShard++) {
+    SPCacheShard *pShard = &pCache->aShard[iShard];
+
+    tdbPCacheInitLock(pShard);
+
+    pShard->nFree = 0;
+    pShard->pFree = NULL;
 
-  // Open the free list
-  pCache->nFree = 0;
-  pCache->pFree = NULL;
+    // Open the hash table
+    pShard->nPage = 0;
+    pShard->nHash = pCache->nPages / pCache->nShard < 8 ? 8 : pCache->nPages / pCache->nShard;
+    pShard->pgHash = (SPage **)tdbOsCalloc(pShard->nHash, sizeof(SPage *));
+    if (pShard->pgHash == NULL) {
+      // TODO
+      return -1;
+    }
+
+    // Open LRU lists
+    pShard->nRecyclable = 0;
+    pShard->nHot = 0;
+    pShard->lru.isAnchor = 1;
+    pShard->lru.pLruNext = &(pShard->lru);
+    pShard->lru.pLruPrev = &(pShard->lru);
+    pShard->lruHot.isAnchor = 1;
+    pShard->lruHot.pLruNext = &(pShard->lruHot);
+    pShard->lruHot.pLruPrev = &(pShard->lruHot);
+  }
+
+  // Open the free lists
   for (int i = 0; i < pCache->nPages; i++) {
+    SPCacheShard *pShard = &pCache->aShard[i % pCache->nShard];
+
     if (tdbPageCreate(pCache->szPage, &pPage, tdbDefaultMalloc, NULL) < 0) {
       // TODO: handle error
       return -1;
@@ -482,50 +725,44 @@ static int tdbPCacheOpenImpl(SPCache *pCache) {
     pPage->pDirtyNext = NULL;
 
     // add page to free list
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
-    pCache->nFree++;
+    pPage->pFreeNext = pShard->pFree;
+    pShard->pFree = pPage;
+    pShard->nFree++;
 
     // add to local list
     pPage->id = i;
     pCache->aPage[i] = pPage;
   }
 
-  // Open the hash table
-  pCache->nPage = 0;
-  pCache->nHash = pCache->nPages < 8 ? 8 : pCache->nPages;
-  pCache->pgHash = (SPage **)tdbOsCalloc(pCache->nHash, sizeof(SPage *));
-  if (pCache->pgHash == NULL) {
-    // TODO
-    return -1;
-  }
-
-  // Open LRU list
-  pCache->nRecyclable = 0;
-  pCache->lru.isAnchor = 1;
-  pCache->lru.pLruNext = &(pCache->lru);
-  pCache->lru.pLruPrev = &(pCache->lru);
-
   return 0;
 }
 
 static int tdbPCacheCloseImpl(SPCache *pCache) {
-  // free free page
-  for (SPage *pPage = pCache->pFree; pPage;) {
-    SPage *pPageT = pPage->pFreeNext;
-    tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-    pPage = pPageT;
-  }
+  for (int iShard = 0; iShard < pCache->nShard; iShard++) {
+    SPCacheShard *pShard = &pCache->aShard[iShard];
 
-  for (int32_t iBucket = 0; iBucket < pCache->nHash; iBucket++) {
-    for (SPage *pPage = pCache->pgHash[iBucket]; pPage;) {
-      SPage *pPageT = pPage->pHashNext;
+    tdbDebug("pcache/shard %d hit:%" PRId64 " miss:%" PRId64 " evict:%" PRId64 " steal:%" PRId64
+             " contention:%" PRId64,
+             iShard, pShard->stat.nHit, pShard->stat.nMiss, pShard->stat.nEvict, pShard->stat.nSteal,
+             pShard->stat.nContention);
+
+    // free free page
+    for (SPage *pPage = pShard->pFree; pPage;) {
+      SPage *pPageT = pPage->pFreeNext;
       tdbPageDestroy(pPage, tdbDefaultFree, NULL);
       pPage = pPageT;
     }
-  }
 
-  tdbOsFree(pCache->pgHash);
-  tdbPCacheDestroyLock(pCache);
+    for (int32_t iBucket = 0; iBucket < pShard->nHash; iBucket++) {
+      for (SPage *pPage = pShard->pgHash[iBucket]; pPage;) {
+        SPage *pPageT = pPage->pHashNext;
+        tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+        pPage = pPageT;
+      }
+    }
+
+    tdbOsFree(pShard->pgHash);
+    tdbPCacheDestroyLock(pShard);
+  }
   return 0;
 }
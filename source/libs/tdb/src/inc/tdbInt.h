@@ -208,6 +208,7 @@ int  tdbPagerRollback(SPager *pPager);
   u8           isLocal;    \
   u8           isDirty;    \
   u8           isFree;     \
+  u8           isHot;      \
   volatile i32 nRef;       \
   i32          id;         \
   SPage       *pFreeNext;  \
@@ -218,6 +219,14 @@ int  tdbPagerRollback(SPager *pPager);
   SPager      *pPager;     \
   SPgid        pgid;
 
+typedef struct {
+  i64 nHit;
+  i64 nMiss;
+  i64 nEvict;
+  i64 nSteal;       // pages taken from other shards
+  i64 nContention;  // lock acquisitions that had to wait
+} SPCacheStat;
+
 // For page ref
 
 int    tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache);
@@ -228,6 +237,8 @@ void   tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn);
 void   tdbPCacheMarkFree(SPCache *pCache, SPage *pPage);
 void   tdbPCacheInvalidatePage(SPCache *pCache, SPager *pPager, SPgno pgno);
 int    tdbPCacheGetPageSize(SPCache *pCache);
+int    tdbPCacheGetShardNum(SPCache *pCache);
+void   tdbPCacheGetStat(SPCache *pCache, int iShard, SPCacheStat *pStat);
 
 // tdbPage.c ====================================
 typedef u8 SCell;
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#define ALLOW_FORBID_FUNC
+#include "os.h"
+#include "tdbInt.h"
+
+#include <thread>
+#include <vector>
+
+static int64_t pcacheMisses(SPCache *pCache) {
+  int64_t nMiss = 0;
+  for (int i = 0; i < tdbPCacheGetShardNum(pCache); i++) {
+    SPCacheStat stat;
+    tdbPCacheGetStat(pCache, i, &stat);
+    nMiss += stat.nMiss;
+  }
+  return nMiss;
+}
+
+static void pcacheTouch(SPCache *pCache, TXN *pTxn, SPgno pgno) {
+  SPgid pgid = {0};
+  pgid.fileid[0] = 1;
+  pgid.pgno = pgno;
+
+  SPage *pPage = tdbPCacheFetch(pCache, &pgid, pTxn);
+  ASSERT_NE(pPage, nullptr);
+  ASSERT_EQ(pPage->pgid.pgno, pgno);
+  tdbPCacheRelease(pCache, pPage, pTxn);
+}
+
+// a one pass scan over many more pages than the cache holds must not evict pages that are hit repeatedly
+TEST(tdb_pcache_test, scan_resistance) {
+  SPCache *pCache = NULL;
+  TXN      txn = {0};
+  txn.xMalloc = tdbDefaultMalloc;
+  txn.xFree = tdbDefaultFree;
+
+  ASSERT_EQ(tdbPCacheOpen(4096, 1024, &pCache), 0);
+
+  const SPgno nHot = 64;
+  for (int loop = 0; loop < 3; loop++) {
+    for (SPgno pgno = 1; pgno <= nHot; pgno++) {
+      pcacheTouch(pCache, &txn, pgno);
+    }
+  }
+
+  for (SPgno pgno = 10000; pgno < 20000; pgno++) {
+    pcacheTouch(pCache, &txn, pgno);
+  }
+
+  int64_t nMiss = pcacheMisses(pCache);
+  for (SPgno pgno = 1; pgno <= nHot; pgno++) {
+    pcacheTouch(pCache, &txn, pgno);
+  }
+  ASSERT_EQ(pcacheMisses(pCache), nMiss);
+
+  tdbPCacheClose(pCache);
+}
+
+TEST(tdb_pcache_test, concurrent_fetch) {
+  SPCache *pCache = NULL;
+  ASSERT_EQ(tdbPCacheOpen(4096, 512, &pCache), 0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([pCache, t]() {
+      TXN txn = {0};
+      txn.xMalloc = tdbDefaultMalloc;
+      txn.xFree = tdbDefaultFree;
+
+      uint32_t seed = t + 1;
+      for (int i = 0; i < 100000; i++) {
+        SPgno pgno = (taosRandR(&seed) % 4) ? 1 + taosRandR(&seed) % 32 : 1000 + taosRandR(&seed) % 2000;
+        pcacheTouch(pCache, &txn, pgno);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  tdbPCacheClose(pCache);
+}
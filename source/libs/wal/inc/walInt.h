@@ -144,6 +144,14 @@ static inline void walResetVer(SWalVer* pVer) {
   pVer->lastVer = -1;
 }
 
+// wait until the fsync in flight is done, should be called with pWal->mutex held
+// before closing or switching the log file
+static inline void walWaitFsync(SWal* pWal) {
+  while (pWal->fsyncing) {
+    taosThreadCondWait(&pWal->fsyncCond, &pWal->mutex);
+  }
+}
+
 int walLoadMeta(SWal* pWal);
 int walSaveMeta(SWal* pWal);
 int walRemoveMeta(SWal* pWal);
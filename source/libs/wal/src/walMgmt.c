@@ -87,6 +87,13 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
     return NULL;
   }
 
+  if (taosThreadCondInit(&pWal->fsyncCond, NULL) < 0) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    taosThreadMutexDestroy(&pWal->mutex);
+    taosMemoryFree(pWal);
+    return NULL;
+  }
+
   // set config
   memcpy(&pWal->cfg, pCfg, sizeof(SWalCfg));
 
@@ -156,6 +163,9 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
     goto _err;
   }
 
+  // logs restored from disk are treated as synced
+  pWal->syncedVer = pWal->vers.lastVer;
+
   // add ref
   pWal->refId = taosAddRef(tsWal.refSetId, pWal);
   if (pWal->refId < 0) {
@@ -170,6 +180,7 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
 _err:
   taosArrayDestroy(pWal->fileInfoSet);
   taosHashCleanup(pWal->pRefHash);
+  taosThreadCondDestroy(&pWal->fsyncCond);
   taosThreadMutexDestroy(&pWal->mutex);
   taosMemoryFree(pWal);
   pWal = NULL;
@@ -211,6 +222,7 @@ int32_t walPersist(SWal *pWal) {
 
 void walClose(SWal *pWal) {
   taosThreadMutexLock(&pWal->mutex);
+  walWaitFsync(pWal);
   (void)walSaveMeta(pWal);
   taosCloseFile(&pWal->pLogFile);
   pWal->pLogFile = NULL;
@@ -239,6 +251,7 @@ static void walFreeObj(void *wal) {
   SWal *pWal = wal;
   wDebug("vgId:%d, wal:%p is freed", pWal->cfg.vgId, pWal);
 
+  taosThreadCondDestroy(&pWal->fsyncCond);
   taosThreadMutexDestroy(&pWal->mutex);
   taosMemoryFreeClear(pWal);
 }
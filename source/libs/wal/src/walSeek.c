@@ -78,6 +78,8 @@ int64_t walChangeWrite(SWal* pWal, int64_t ver) {
   int       code;
   TdFilePtr pIdxTFile, pLogTFile;
   char      fnameStr[WAL_FILE_LEN];
+
+  walWaitFsync(pWal);
   if (pWal->pLogFile != NULL) {
     code = taosFsyncFile(pWal->pLogFile);
     if (code != 0) {
@@ -36,6 +36,7 @@ int32_t walRestoreFromSnapshot(SWal *pWal, int64_t ver) {
     }
   }
 
+  walWaitFsync(pWal);
   taosCloseFile(&pWal->pLogFile);
   taosCloseFile(&pWal->pIdxFile);
 
@@ -75,6 +76,7 @@ int32_t walRestoreFromSnapshot(SWal *pWal, int64_t ver) {
   pWal->vers.commitVer = ver;
   pWal->vers.snapshotVer = ver;
   pWal->vers.verInSnapshotting = -1;
+  pWal->syncedVer = ver;
 
   taosThreadMutexUnlock(&pWal->mutex);
   return 0;
@@ -109,6 +111,8 @@ int32_t walRollback(SWal *pWal, int64_t ver) {
     return -1;
   }
 
+  walWaitFsync(pWal);
+
   // find correct file
   if (ver < walGetLastFileFirstVer(pWal)) {
     // change current files
@@ -202,6 +206,7 @@ int32_t walRollback(SWal *pWal, int64_t ver) {
     return -1;
   }
   pWal->vers.lastVer = ver - 1;
+  if (pWal->syncedVer > pWal->vers.lastVer) pWal->syncedVer = pWal->vers.lastVer;
   ((SWalFileInfo *)taosArrayGetLast(pWal->fileInfoSet))->lastVer = ver - 1;
   ((SWalFileInfo *)taosArrayGetLast(pWal->fileInfoSet))->fileSize = entry.offset;
   taosCloseFile(&pIdxFile);
@@ -387,6 +392,8 @@ END:
 int32_t walRollImpl(SWal *pWal) {
   int32_t code = 0;
 
+  walWaitFsync(pWal);
+
   if (pWal->pIdxFile != NULL) {
     code = taosFsyncFile(pWal->pIdxFile);
     if (code != 0) {
@@ -411,6 +418,7 @@ int32_t walRollImpl(SWal *pWal) {
       terrno = TAOS_SYSTEM_ERROR(errno);
       goto END;
     }
+    pWal->syncedVer = pWal->vers.lastVer;
   }
 
   TdFilePtr pIdxFile, pLogFile;
@@ -429,6 +437,7 @@ int32_t walRollImpl(SWal *pWal) {
   wDebug("vgId:%d, wal create new file for write:%s", pWal->cfg.vgId, fnameStr);
   if (pLogFile == NULL) {
     terrno = TAOS_SYSTEM_ERROR(errno);
+    taosCloseFile(&pIdxFile);
     code = -1;
     goto END;
   }
@@ -455,67 +464,59 @@ END:
   return code;
 }
 
-static int32_t walWriteIndex(SWal *pWal, int64_t ver, int64_t offset) {
-  SWalIdxEntry  entry = {.ver = ver, .offset = offset};
+static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, const SWalAppendEntry *pEntries, int32_t numOfEntries,
+                                         SWalCkHead *pHeads, SWalIdxEntry *pIdxEntries, TdIoVec *pIov) {
+  int64_t       offset = walGetCurFileOffset(pWal);
   SWalFileInfo *pFileInfo = walGetCurFileInfo(pWal);
+  int64_t       index = pEntries[0].index;
+  int64_t       lastIndex = pEntries[numOfEntries - 1].index;
+  int64_t       idxOffset = (index - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
+  int64_t       logSize = 0;
 
-  int64_t idxOffset = (entry.ver - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
-  wDebug("vgId:%d, write index, index:%" PRId64 ", offset:%" PRId64 ", at %" PRId64, pWal->cfg.vgId, ver, offset,
-         idxOffset);
-
-  int64_t size = taosWriteFile(pWal->pIdxFile, &entry, sizeof(SWalIdxEntry));
-  if (size != sizeof(SWalIdxEntry)) {
-    wError("vgId:%d, failed to write idx entry due to %s. ver:%" PRId64, pWal->cfg.vgId, strerror(errno), ver);
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return -1;
-  }
-
-  // check alignment of idx entries
-  int64_t endOffset = taosLSeekFile(pWal->pIdxFile, 0, SEEK_END);
-  if (endOffset < 0) {
-    wFatal("vgId:%d, failed to seek end of idxfile due to %s. ver:%" PRId64 "", pWal->cfg.vgId, strerror(errno), ver);
-  }
-  return 0;
-}
+  for (int32_t i = 0; i < numOfEntries; i++) {
+    const SWalAppendEntry *pEntry = &pEntries[i];
+    SWalCkHead            *pHead = &pHeads[i];
 
-static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta,
-                                         const void *body, int32_t bodyLen) {
-  int64_t code = 0;
+    pHead->magic = WAL_MAGIC;
+    pHead->head.protoVer = WAL_PROTO_VER;
+    pHead->head.version = pEntry->index;
+    pHead->head.bodyLen = pEntry->bodyLen;
+    pHead->head.msgType = pEntry->msgType;
+    pHead->head.ingestTs = 0;
 
-  int64_t       offset = walGetCurFileOffset(pWal);
-  SWalFileInfo *pFileInfo = walGetCurFileInfo(pWal);
+    // sync info for sync module
+    pHead->head.syncMeta = pEntry->syncMeta;
 
-  pWal->writeHead.head.version = index;
-  pWal->writeHead.head.bodyLen = bodyLen;
-  pWal->writeHead.head.msgType = msgType;
-  pWal->writeHead.head.ingestTs = 0;
+    pHead->cksumHead = walCalcHeadCksum(pHead);
+    pHead->cksumBody = walCalcBodyCksum(pEntry->body, pEntry->bodyLen);
+    wDebug("vgId:%d, wal write log %" PRId64 ", msgType: %s, cksum head %u cksum body %u", pWal->cfg.vgId,
+           pEntry->index, TMSG_INFO(pEntry->msgType), pHead->cksumHead, pHead->cksumBody);
 
-  // sync info for sync module
-  pWal->writeHead.head.syncMeta = syncMeta;
+    pIdxEntries[i].ver = pEntry->index;
+    pIdxEntries[i].offset = offset + logSize;
 
-  pWal->writeHead.cksumHead = walCalcHeadCksum(&pWal->writeHead);
-  pWal->writeHead.cksumBody = walCalcBodyCksum(body, bodyLen);
-  wDebug("vgId:%d, wal write log %" PRId64 ", msgType: %s, cksum head %u cksum body %u", pWal->cfg.vgId, index,
-         TMSG_INFO(msgType), pWal->writeHead.cksumHead, pWal->writeHead.cksumBody);
+    pIov[2 * i].iov_base = pHead;
+    pIov[2 * i].iov_len = sizeof(SWalCkHead);
+    pIov[2 * i + 1].iov_base = (void *)pEntry->body;
+    pIov[2 * i + 1].iov_len = pEntry->bodyLen;
 
-  code = walWriteIndex(pWal, index, offset);
-  if (code < 0) {
-    goto END;
+    logSize += sizeof(SWalCkHead) + pEntry->bodyLen;
   }
 
-  if (taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
+  wDebug("vgId:%d, write index, index:%" PRId64 "~%" PRId64 ", offset:%" PRId64 ", at %" PRId64, pWal->cfg.vgId,
+         index, lastIndex, offset, idxOffset);
+
+  int64_t idxSize = numOfEntries * sizeof(SWalIdxEntry);
+  if (taosWriteFile(pWal->pIdxFile, pIdxEntries, idxSize) != idxSize) {
+    wError("vgId:%d, failed to write idx entry due to %s. ver:%" PRId64, pWal->cfg.vgId, strerror(errno), index);
     terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-           strerror(errno));
-    code = -1;
     goto END;
   }
 
-  if (taosWriteFile(pWal->pLogFile, (char *)body, bodyLen) != bodyLen) {
+  if (taosWritevFile(pWal->pLogFile, pIov, numOfEntries * 2) != logSize) {
     terrno = TAOS_SYSTEM_ERROR(errno);
     wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
            strerror(errno));
-    code = -1;
     goto END;
   }
 
@@ -523,10 +524,10 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
   if (pWal->vers.firstVer == -1) {
     pWal->vers.firstVer = 0;
   }
-  pWal->vers.lastVer = index;
-  pWal->totSize += sizeof(SWalCkHead) + bodyLen;
-  pFileInfo->lastVer = index;
-  pFileInfo->fileSize += sizeof(SWalCkHead) + bodyLen;
+  pWal->vers.lastVer = lastIndex;
+  pWal->totSize += logSize;
+  pFileInfo->lastVer = lastIndex;
+  pFileInfo->fileSize += logSize;
 
   return 0;
 
@@ -538,7 +539,6 @@ END:
     terrno = TAOS_SYSTEM_ERROR(errno);
   }
 
-  int64_t idxOffset = (index - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
   if (taosFtruncateFile(pWal->pIdxFile, idxOffset) < 0) {
     wFatal("vgId:%d, failed to ftruncate idxfile to offset:%" PRId64 "during recovery due to %s", pWal->cfg.vgId,
            idxOffset, strerror(errno));
@@ -547,6 +547,15 @@ END:
   return -1;
 }
 
+static int32_t walWriteOne(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body,
+                           int32_t bodyLen) {
+  SWalAppendEntry entry = {
+      .index = index, .msgType = msgType, .syncMeta = syncMeta, .body = body, .bodyLen = bodyLen};
+  SWalIdxEntry idxEntry;
+  TdIoVec      iov[2];
+  return walWriteImpl(pWal, &entry, 1, &pWal->writeHead, &idxEntry, iov);
+}
+
 int64_t walAppendLog(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body,
                      int32_t bodyLen) {
   taosThreadMutexLock(&pWal->mutex);
@@ -569,7 +578,7 @@ int64_t walAppendLog(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syn
     }
   }
 
-  if (walWriteImpl(pWal, index, msgType, syncMeta, body, bodyLen) < 0) {
+  if (walWriteOne(pWal, index, msgType, syncMeta, body, bodyLen) < 0) {
     taosThreadMutexUnlock(&pWal->mutex);
     return -1;
   }
@@ -578,6 +587,60 @@ int64_t walAppendLog(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syn
   return index;
 }
 
+int64_t walAppendLogBatch(SWal *pWal, const SWalAppendEntry *pEntries, int32_t numOfEntries) {
+  if (numOfEntries <= 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return -1;
+  }
+
+  for (int32_t i = 1; i < numOfEntries; i++) {
+    if (pEntries[i].index != pEntries[0].index + i) {
+      terrno = TSDB_CODE_WAL_INVALID_VER;
+      return -1;
+    }
+  }
+
+  int64_t       index = -1;
+  SWalCkHead   *pHeads = taosMemoryMalloc(numOfEntries * sizeof(SWalCkHead));
+  SWalIdxEntry *pIdxEntries = taosMemoryMalloc(numOfEntries * sizeof(SWalIdxEntry));
+  TdIoVec      *pIov = taosMemoryMalloc(numOfEntries * 2 * sizeof(TdIoVec));
+  if (pHeads == NULL || pIdxEntries == NULL || pIov == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  taosThreadMutexLock(&pWal->mutex);
+
+  if (pEntries[0].index != pWal->vers.lastVer + 1) {
+    terrno = TSDB_CODE_WAL_INVALID_VER;
+    goto _unlock;
+  }
+
+  if (walCheckAndRoll(pWal) < 0) {
+    goto _unlock;
+  }
+
+  if (pWal->pLogFile == NULL || pWal->pIdxFile == NULL || pWal->writeCur < 0) {
+    if (walInitWriteFile(pWal) < 0) {
+      goto _unlock;
+    }
+  }
+
+  if (walWriteImpl(pWal, pEntries, numOfEntries, pHeads, pIdxEntries, pIov) < 0) {
+    goto _unlock;
+  }
+
+  index = pEntries[numOfEntries - 1].index;
+
+_unlock:
+  taosThreadMutexUnlock(&pWal->mutex);
+_exit:
+  taosMemoryFree(pHeads);
+  taosMemoryFree(pIdxEntries);
+  taosMemoryFree(pIov);
+  return index;
+}
+
 int32_t walWriteWithSyncInfo(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body,
                              int32_t bodyLen) {
   int32_t code = 0;
@@ -605,7 +668,7 @@ int32_t walWriteWithSyncInfo(SWal *pWal, int64_t index, tmsg_t msgType, SWalSync
     }
   }
 
-  if (walWriteImpl(pWal, index, msgType, syncMeta, body, bodyLen) < 0) {
+  if (walWriteOne(pWal, index, msgType, syncMeta, body, bodyLen) < 0) {
     taosThreadMutexUnlock(&pWal->mutex);
     return -1;
   }
@@ -624,13 +687,38 @@ int32_t walWrite(SWal *pWal, int64_t index, tmsg_t msgType, const void *body, in
 }
 
 void walFsync(SWal *pWal, bool forceFsync) {
+  if (!forceFsync && (pWal->cfg.level != TAOS_WAL_FSYNC || pWal->cfg.fsyncPeriod != 0)) {
+    return;
+  }
+
   taosThreadMutexLock(&pWal->mutex);
-  if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
-    wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync", pWal->cfg.vgId, walGetCurFileFirstVer(pWal));
-    if (taosFsyncFile(pWal->pLogFile) < 0) {
-      wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, walGetCurFileFirstVer(pWal),
-             strerror(errno));
-    }
+
+  // wait for the fsync in flight, it may already cover the versions of this caller
+  int64_t targetVer = pWal->vers.lastVer;
+  walWaitFsync(pWal);
+  if (pWal->syncedVer >= targetVer || pWal->pLogFile == NULL) {
+    taosThreadMutexUnlock(&pWal->mutex);
+    return;
+  }
+
+  // the log file can not be closed or switched while fsyncing is set
+  TdFilePtr pLogFile = pWal->pLogFile;
+  int64_t   syncVer = pWal->vers.lastVer;
+  int64_t   fileFirstVer = walGetCurFileFirstVer(pWal);
+  pWal->fsyncing = 1;
+  taosThreadMutexUnlock(&pWal->mutex);
+
+  wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync, ver:%" PRId64, pWal->cfg.vgId, fileFirstVer, syncVer);
+  int32_t code = taosFsyncFile(pLogFile);
+  if (code < 0) {
+    wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, fileFirstVer, strerror(errno));
+  }
+
+  taosThreadMutexLock(&pWal->mutex);
+  pWal->fsyncing = 0;
+  if (code == 0 && syncVer > pWal->syncedVer) {
+    pWal->syncedVer = syncVer;
   }
+  taosThreadCondBroadcast(&pWal->fsyncCond);
   taosThreadMutexUnlock(&pWal->mutex);
 }
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "taoserror.h"
+#include "tcompare.h"
+#include "wal.h"
+
+typedef struct {
+  int32_t  index;
+  int32_t  numOfReqs;
+  int32_t  batchSize;
+  int32_t  bodyLen;
+  bool     fsync;
+  SWal    *pWal;
+  int64_t *pLatency;  // us
+  TdThread thread;
+} SBenchInfo;
+
+// appends take the version from the wal, so they are serialized by the caller just like the sync module
+static TdThreadMutex tsAppendMutex;
+
+static void *appendFunc(void *param) {
+  SBenchInfo      *pInfo = (SBenchInfo *)param;
+  char            *body = taosMemoryMalloc(pInfo->bodyLen);
+  SWalAppendEntry *pEntries = taosMemoryCalloc(pInfo->batchSize, sizeof(SWalAppendEntry));
+  memset(body, 'a' + pInfo->index % 26, pInfo->bodyLen);
+
+  for (int32_t i = 0; i < pInfo->numOfReqs; i += pInfo->batchSize) {
+    int32_t num = TMIN(pInfo->batchSize, pInfo->numOfReqs - i);
+    int64_t start = taosGetTimestampUs();
+
+    taosThreadMutexLock(&tsAppendMutex);
+    int64_t index = walGetLastVer(pInfo->pWal) + 1;
+    int64_t code = 0;
+    if (pInfo->batchSize == 1) {
+      SWalSyncInfo syncMeta = {.isWeek = -1, .seqNum = UINT64_MAX, .term = UINT64_MAX};
+      code = walAppendLog(pInfo->pWal, index, TDMT_VND_SUBMIT, syncMeta, body, pInfo->bodyLen);
+    } else {
+      for (int32_t j = 0; j < num; j++) {
+        pEntries[j].index = index + j;
+        pEntries[j].msgType = TDMT_VND_SUBMIT;
+        pEntries[j].syncMeta = (SWalSyncInfo){.isWeek = -1, .seqNum = UINT64_MAX, .term = UINT64_MAX};
+        pEntries[j].body = body;
+        pEntries[j].bodyLen = pInfo->bodyLen;
+      }
+      code = walAppendLogBatch(pInfo->pWal, pEntries, num);
+    }
+    taosThreadMutexUnlock(&tsAppendMutex);
+
+    if (code < 0) {
+      printf("thread:%d, failed to append since %s\n", pInfo->index, terrstr());
+      break;
+    }
+
+    walFsync(pInfo->pWal, pInfo->fsync);
+
+    int64_t elapsed = taosGetTimestampUs() - start;
+    for (int32_t j = 0; j < num; j++) {
+      pInfo->pLatency[i + j] = elapsed;
+    }
+  }
+
+  taosMemoryFree(pEntries);
+  taosMemoryFree(body);
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  int32_t numOfThreads = 4;
+  int32_t numOfReqs = 100000;
+  int32_t batchSize = 1;
+  int32_t bodyLen = 128;
+  bool    fsync = true;
+  char    path[PATH_MAX] = TD_TMP_DIR_PATH "wal_bench";
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-t") == 0 && i < argc - 1) {
+      numOfThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      numOfReqs = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-b") == 0 && i < argc - 1) {
+      batchSize = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-m") == 0 && i < argc - 1) {
+      bodyLen = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-f") == 0 && i < argc - 1) {
+      fsync = atoi(argv[++i]) != 0;
+    } else if (strcmp(argv[i], "-p") == 0 && i < argc - 1) {
+      tstrncpy(path, argv[++i], sizeof(path));
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-t threads]: number of append threads, default is:%d\n", numOfThreads);
+      printf("  [-n entries]: number of entries per thread, default is:%d\n", numOfReqs);
+      printf("  [-b batchSize]: entries per append call, default is:%d\n", batchSize);
+      printf("  [-m bodyLen]: entry body size, default is:%d\n", bodyLen);
+      printf("  [-f fsync]: fsync after each append, default is:%d\n", fsync);
+      printf("  [-p path]: wal directory, default is:%s\n", path);
+      printf("  [-h help]: print out this help\n\n");
+      exit(0);
+    }
+  }
+  if (batchSize <= 0) batchSize = 1;
+
+  if (walInit() != 0) {
+    printf("failed to init wal since %s\n", terrstr());
+    return -1;
+  }
+
+  taosRemoveDir(path);
+  SWalCfg cfg = {0};
+  cfg.rollPeriod = -1;
+  cfg.segSize = -1;
+  cfg.level = TAOS_WAL_FSYNC;
+  SWal *pWal = walOpen(path, &cfg);
+  if (pWal == NULL) {
+    printf("failed to open wal since %s\n", terrstr());
+    return -1;
+  }
+
+  taosThreadMutexInit(&tsAppendMutex, NULL);
+
+  int64_t     total = (int64_t)numOfThreads * numOfReqs;
+  int64_t    *pLatency = taosMemoryCalloc(total, sizeof(int64_t));
+  SBenchInfo *pInfos = taosMemoryCalloc(numOfThreads, sizeof(SBenchInfo));
+  int64_t     start = taosGetTimestampUs();
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    SBenchInfo *pInfo = &pInfos[i];
+    pInfo->index = i;
+    pInfo->numOfReqs = numOfReqs;
+    pInfo->batchSize = batchSize;
+    pInfo->bodyLen = bodyLen;
+    pInfo->fsync = fsync;
+    pInfo->pWal = pWal;
+    pInfo->pLatency = pLatency + (int64_t)i * numOfReqs;
+    taosThreadCreate(&pInfo->thread, NULL, appendFunc, pInfo);
+  }
+
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    taosThreadJoin(pInfos[i].thread, NULL);
+  }
+  int64_t elapsed = taosGetTimestampUs() - start;
+
+  taosSort(pLatency, total, sizeof(int64_t), compareInt64Val);
+  int64_t p50 = pLatency[total / 2];
+  int64_t p99 = pLatency[TMIN(total - 1, total * 99 / 100)];
+
+  printf("threads:%d entries:%" PRId64 " batch:%d bodyLen:%d fsync:%d\n", numOfThreads, total, batchSize, bodyLen,
+         fsync);
+  printf("elapsed:%.3f ms, throughput:%.1f entries/s, latency p50:%" PRId64 " us, p99:%" PRId64 " us\n",
+         elapsed / 1000.0, total * 1000000.0 / TMAX(elapsed, 1), p50, p99);
+
+  walClose(pWal);
+  walCleanUp();
+  taosRemoveDir(path);
+  taosThreadMutexDestroy(&tsAppendMutex);
+  taosMemoryFree(pInfos);
+  taosMemoryFree(pLatency);
+  return 0;
+}
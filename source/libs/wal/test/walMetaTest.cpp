@@ -442,3 +442,47 @@ TEST_F(WalRetentionEnv, repairMeta1) {
     }
   }
 }
+
+TEST_F(WalKeepEnv, appendBatchRead) {
+  walResetEnv();
+  int         code;
+  SWalReader* pRead = walOpenReader(pWal, NULL);
+  ASSERT(pRead != NULL);
+
+  char            bodies[100][100];
+  SWalAppendEntry entries[10];
+  for (int i = 0; i < 100; i += 10) {
+    for (int j = 0; j < 10; j++) {
+      sprintf(bodies[i + j], "%s-%d", ranStr, i + j);
+      entries[j].index = i + j;
+      entries[j].msgType = 0;
+      entries[j].syncMeta.isWeek = -1;
+      entries[j].syncMeta.seqNum = UINT64_MAX;
+      entries[j].syncMeta.term = UINT64_MAX;
+      entries[j].body = bodies[i + j];
+      entries[j].bodyLen = strlen(bodies[i + j]);
+    }
+    int64_t index = walAppendLogBatch(pWal, entries, 10);
+    ASSERT_EQ(index, i + 9);
+    walFsync(pWal, true);
+  }
+  ASSERT_EQ(pWal->vers.lastVer, 99);
+  ASSERT_EQ(pWal->syncedVer, 99);
+
+  // not consecutive
+  entries[0].index = 100;
+  entries[1].index = 102;
+  ASSERT_EQ(walAppendLogBatch(pWal, entries, 2), -1);
+
+  for (int i = 0; i < 100; i++) {
+    code = walReadVer(pRead, i);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead->pHead->head.version, i);
+    int len = strlen(bodies[i]);
+    ASSERT_EQ(pRead->pHead->head.bodyLen, len);
+    for (int j = 0; j < len; j++) {
+      EXPECT_EQ(bodies[i][j], pRead->pHead->head.body[j]);
+    }
+  }
+  walCloseReader(pRead);
+}
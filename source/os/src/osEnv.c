@@ -42,6 +42,7 @@ char tsSSE42Enable = 0;
 char tsAVXEnable = 0;
 char tsAVX2Enable = 0;
 char tsFMAEnable = 0;
+char tsAVX512Enable = 0;
 
 void osDefaultInit() {
   taosSeedRand(taosSafeRand());
@@ -510,6 +510,82 @@ int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t
   return ret;
 }
 
+int64_t taosWritevFile(TdFilePtr pFile, const TdIoVec *iov, int32_t iovcnt) {
+  if (pFile == NULL) {
+    return 0;
+  }
+#if FILE_WITH_LOCK
+  taosThreadRwlockWrlock(&(pFile->rwlock));
+#endif
+  if (pFile->fd < 0) {
+#if FILE_WITH_LOCK
+    taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+    return 0;
+  }
+
+  int64_t total = 0;
+#ifdef WINDOWS
+  for (int32_t i = 0; i < iovcnt; ++i) {
+    int64_t nleft = iov[i].iov_len;
+    char   *tbuf = (char *)iov[i].iov_base;
+    while (nleft > 0) {
+      int64_t nwritten = _write(pFile->fd, (void *)tbuf, (uint32_t)nleft);
+      if (nwritten < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+#if FILE_WITH_LOCK
+        taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+        return -1;
+      }
+      nleft -= nwritten;
+      tbuf += nwritten;
+      total += nwritten;
+    }
+  }
+#else
+  TdIoVec vec[TD_IOV_MAX];
+  int32_t idx = 0;
+  while (idx < iovcnt) {
+    int32_t cnt = TMIN(iovcnt - idx, TD_IOV_MAX);
+    memcpy(vec, iov + idx, cnt * sizeof(TdIoVec));
+
+    // writev may return short, continue from the first iovec not fully written
+    TdIoVec *pVec = vec;
+    while (cnt > 0) {
+      int64_t nwritten = writev(pFile->fd, pVec, cnt);
+      if (nwritten < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+#if FILE_WITH_LOCK
+        taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+        return -1;
+      }
+      total += nwritten;
+      while (cnt > 0 && nwritten >= (int64_t)pVec->iov_len) {
+        nwritten -= pVec->iov_len;
+        pVec++;
+        cnt--;
+        idx++;
+      }
+      if (cnt > 0 && nwritten > 0) {
+        pVec->iov_base = (char *)pVec->iov_base + nwritten;
+        pVec->iov_len -= nwritten;
+      }
+    }
+  }
+#endif
+
+#if FILE_WITH_LOCK
+  taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+  return total;
+}
+
 int64_t taosLSeekFile(TdFilePtr pFile, int64_t offset, int32_t whence) {
   if (pFile == NULL || pFile->fd < 0) {
     return -1;
@@ -248,7 +248,7 @@ void taosGetSystemInfo() {
   taosGetCpuCores(&tsNumOfCores);
   taosGetTotalMemory(&tsTotalMemoryKB);
   taosGetCpuUsage(NULL, NULL);
-  taosGetCpuInstructions(&tsSSE42Enable, &tsAVXEnable, &tsAVX2Enable, &tsFMAEnable);
+  taosGetCpuInstructions(&tsSSE42Enable, &tsAVXEnable, &tsAVX2Enable, &tsFMAEnable, &tsAVX512Enable);
 #endif
 }
 
@@ -535,7 +535,7 @@ void taosGetCpuUsage(double *cpu_system, double *cpu_engine) {
                       : "0"(level))
 
 // todo add for windows and mac
-int32_t taosGetCpuInstructions(char* sse42, char* avx, char* avx2, char* fma) {
+int32_t taosGetCpuInstructions(char* sse42, char* avx, char* avx2, char* fma, char* avx512) {
 #ifdef WINDOWS
 #elif defined(_TD_DARWIN_64)
 #else
@@ -559,11 +559,20 @@ int32_t taosGetCpuInstructions(char* sse42, char* avx, char* avx2, char* fma) {
   *sse42 = (char) ((ecx & bit_SSE4_2) == bit_SSE4_2);
   *avx   = (char) ((ecx & bit_AVX) == bit_AVX);
   *fma   = (char) ((ecx & bit_FMA) == bit_FMA);
+  uint32_t ecx1 = ecx;
 
   // work around a bug in GCC.
   // Ref to https://gcc.gnu.org/bugzilla/show_bug.cgi?id=77756
   __cpuid_fix(7u, eax, ebx, ecx, edx);
   *avx2 = (char) ((ebx & bit_AVX2) == bit_AVX2);
+
+  // avx512 also requires the os to save the opmask and zmm registers, i.e. XCR0 bits 5, 6 and 7
+  *avx512 = 0;
+  if ((ebx & bit_AVX512F) == bit_AVX512F && (ecx1 & bit_OSXSAVE) == bit_OSXSAVE) {
+    uint32_t xcr0 = 0, xcr0Hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(xcr0), "=d"(xcr0Hi) : "c"(0));
+    *avx512 = (char)((xcr0 & 0xE6) == 0xE6);
+  }
 #endif   // _TD_X86_
 #endif
 
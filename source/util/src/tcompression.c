@@ -227,8 +227,117 @@ int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char
   return opos;
 }
 
-int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type) {
+// The simd level used by the decoders, picked at runtime from the cpu features and the SIMD-builtins switch.
+#define DECODE_SIMD_NONE   0
+#define DECODE_SIMD_AVX2   1
+#define DECODE_SIMD_AVX512 2
+
+static FORCE_INLINE int32_t getDecodeSimdLevel() {
+#if __AVX512F__
+  if (tsAVX512Enable && tsSIMDBuiltins) return DECODE_SIMD_AVX512;
+#endif
+#if __AVX2__
+  if (tsAVX2Enable && tsSIMDBuiltins) return DECODE_SIMD_AVX2;
+#endif
+  return DECODE_SIMD_NONE;
+}
+
+// Decode num values of bit width from a simple8b word into p, returns the last decoded value.
+static int64_t decodeSimple8bWord(uint64_t w, int32_t bit, int32_t num, int64_t prev_value, int64_t *p) {
+  uint64_t mask = INT64MASK(bit);
+  int32_t  v = 4;
+  for (int32_t i = 0; i < num; i++) {
+    uint64_t zigzag_value = ((w >> v) & mask);
+    prev_value += ZIGZAG_DECODE(int64_t, zigzag_value);
+    p[i] = prev_value;
+    v += bit;
+  }
+  return prev_value;
+}
+
+#if __AVX2__
+static int64_t decodeSimple8bWordAVX2(uint64_t w, int32_t bit, int32_t num, int64_t prev_value, int64_t *p) {
+  int32_t batch = num >> 2;
+  int32_t remain = num & 0x03;
+
+  __m256i base = _mm256_set1_epi64x(w);
+  __m256i maskVal = _mm256_set1_epi64x(INT64MASK(bit));
+  __m256i one = _mm256_set1_epi64x(1);
+  __m256i zero = _mm256_setzero_si256();
+  __m256i shiftBits = _mm256_set_epi64x(bit * 3 + 4, bit * 2 + 4, bit + 4, 4);
+  __m256i inc = _mm256_set1_epi64x(bit << 2);
+  __m256i prev = _mm256_set1_epi64x(prev_value);
+
+  for (int32_t i = 0; i < batch; ++i) {
+    __m256i zigzagVal = _mm256_and_si256(_mm256_srlv_epi64(base, shiftBits), maskVal);
+
+    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
+    __m256i signmask = _mm256_sub_epi64(zero, _mm256_and_si256(zigzagVal, one));
+    __m256i delta = _mm256_xor_si256(_mm256_srli_epi64(zigzagVal, 1), signmask);
 
+    // prefix sum of the four deltas: [d0, d0+d1, d2, d2+d3] then add d0+d1 to the upper half
+    delta = _mm256_add_epi64(delta, _mm256_slli_si256(delta, 8));
+    delta = _mm256_add_epi64(delta, _mm256_blend_epi32(_mm256_permute4x64_epi64(delta, 0x50), zero, 0x0F));
+    delta = _mm256_add_epi64(delta, prev);
+
+    _mm256_storeu_si256((__m256i *)(p + (i << 2)), delta);
+    prev = _mm256_permute4x64_epi64(delta, 0xFF);
+    shiftBits = _mm256_add_epi64(shiftBits, inc);
+  }
+
+  prev_value = _mm256_extract_epi64(prev, 0);
+  if (remain > 0) {
+    int32_t done = batch << 2;
+    prev_value = decodeSimple8bWord(w >> (done * bit), bit, remain, prev_value, p + done);
+  }
+  return prev_value;
+}
+#endif
+
+#if __AVX512F__
+static int64_t decodeSimple8bWordAVX512(uint64_t w, int32_t bit, int32_t num, int64_t prev_value, int64_t *p) {
+  int32_t batch = num >> 3;
+  int32_t remain = num & 0x07;
+
+  __m512i base = _mm512_set1_epi64(w);
+  __m512i maskVal = _mm512_set1_epi64(INT64MASK(bit));
+  __m512i one = _mm512_set1_epi64(1);
+  __m512i zero = _mm512_setzero_si512();
+  __m512i shiftBits = _mm512_set_epi64(bit * 7 + 4, bit * 6 + 4, bit * 5 + 4, bit * 4 + 4, bit * 3 + 4, bit * 2 + 4,
+                                       bit + 4, 4);
+  __m512i inc = _mm512_set1_epi64(bit << 3);
+  __m512i prev = _mm512_set1_epi64(prev_value);
+  __m512i idx1 = _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0);
+  __m512i idx2 = _mm512_set_epi64(5, 4, 3, 2, 1, 0, 0, 0);
+  __m512i idx4 = _mm512_set_epi64(3, 2, 1, 0, 0, 0, 0, 0);
+  __m512i idxLast = _mm512_set1_epi64(7);
+
+  for (int32_t i = 0; i < batch; ++i) {
+    __m512i zigzagVal = _mm512_and_si512(_mm512_srlv_epi64(base, shiftBits), maskVal);
+    __m512i signmask = _mm512_sub_epi64(zero, _mm512_and_si512(zigzagVal, one));
+    __m512i delta = _mm512_xor_si512(_mm512_srli_epi64(zigzagVal, 1), signmask);
+
+    // log-step prefix sum over the eight lanes
+    delta = _mm512_add_epi64(delta, _mm512_maskz_permutexvar_epi64(0xFE, idx1, delta));
+    delta = _mm512_add_epi64(delta, _mm512_maskz_permutexvar_epi64(0xFC, idx2, delta));
+    delta = _mm512_add_epi64(delta, _mm512_maskz_permutexvar_epi64(0xF0, idx4, delta));
+    delta = _mm512_add_epi64(delta, prev);
+
+    _mm512_storeu_si512((void *)(p + (i << 3)), delta);
+    prev = _mm512_permutexvar_epi64(idxLast, delta);
+    shiftBits = _mm512_add_epi64(shiftBits, inc);
+  }
+
+  prev_value = _mm_cvtsi128_si64(_mm512_castsi512_si128(prev));
+  if (remain > 0) {
+    int32_t done = batch << 3;
+    prev_value = decodeSimple8bWord(w >> (done * bit), bit, remain, prev_value, p + done);
+  }
+  return prev_value;
+}
+#endif
+
+int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type) {
   int32_t word_length = 0;
   switch (type) {
     case TSDB_DATA_TYPE_BIGINT:
@@ -260,240 +369,66 @@ int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, cha
   int32_t selector_to_elems[] = {240, 120, 60, 30, 20, 15, 12, 10, 8, 7, 6, 5, 4, 3, 2, 1};
 
   const char *ip = input + 1;
-  int32_t     count = 0;
   int32_t     _pos = 0;
   int64_t     prev_value = 0;
+  int32_t     simdLevel = getDecodeSimdLevel();
 
-#if __AVX2__
-  while (1) {
-    if (_pos == nelements) break;
+  // values of the narrower types are decoded as int64 first and then truncated, just like the scalar loop did
+  int64_t buf[240];
 
+  while (_pos < nelements) {
     uint64_t w = 0;
     memcpy(&w, ip, LONG_BYTES);
+    ip += LONG_BYTES;
 
-    char    selector = (char)(w & INT64MASK(4));       // selector = 4
-    char    bit = bit_per_integer[(int32_t)selector];  // bit = 3
-    int32_t elems = selector_to_elems[(int32_t)selector];
+    int32_t selector = (int32_t)(w & INT64MASK(4));
+    int32_t bit = bit_per_integer[selector];
+    int32_t num = TMIN(selector_to_elems[selector], nelements - _pos);
 
-    // Optimize the performance, by remove the constantly switch operation.
-    int32_t  v = 4;
-    uint64_t zigzag_value = 0;
-    uint64_t mask = INT64MASK(bit);
+    int64_t *p = (type == TSDB_DATA_TYPE_BIGINT) ? ((int64_t *)output + _pos) : buf;
+    if (selector == 0 || selector == 1) {
+      for (int32_t i = 0; i < num; i++) {
+        p[i] = prev_value;
+      }
+    } else {
+      // words holding only a few wide values are cheaper to unpack with the scalar loop
+      switch (num >= 8 ? simdLevel : DECODE_SIMD_NONE) {
+#if __AVX512F__
+        case DECODE_SIMD_AVX512:
+          prev_value = decodeSimple8bWordAVX512(w, bit, num, prev_value, p);
+          break;
+#endif
+#if __AVX2__
+        case DECODE_SIMD_AVX2:
+          prev_value = decodeSimple8bWordAVX2(w, bit, num, prev_value, p);
+          break;
+#endif
+        default:
+          prev_value = decodeSimple8bWord(w, bit, num, prev_value, p);
+          break;
+      }
+    }
 
     switch (type) {
-      case TSDB_DATA_TYPE_BIGINT: {
-        int64_t* p = (int64_t*) output;
-
-        int32_t gRemainder = (nelements - _pos);
-        int32_t num = (gRemainder > elems)? elems:gRemainder;
-
-        int32_t batch = num >> 2;
-        int32_t remain = num & 0x03;
-        if (selector == 0 || selector == 1) {
-          if (tsAVX2Enable && tsSIMDBuiltins) {
-            for (int32_t i = 0; i < batch; ++i) {
-              __m256i prev = _mm256_set1_epi64x(prev_value);
-              _mm256_storeu_si256((__m256i *)&p[_pos], prev);
-              _pos += 4;
-            }
-
-            for (int32_t i = 0; i < remain; ++i) {
-              p[_pos++] = prev_value;
-            }
-          } else {
-            for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-              p[_pos++] = prev_value;
-              v += bit;
-            }
-          }
-        } else {
-          if (tsAVX2Enable && tsSIMDBuiltins) {
-            __m256i base = _mm256_set1_epi64x(w);
-            __m256i maskVal = _mm256_set1_epi64x(mask);
-
-            __m256i shiftBits = _mm256_set_epi64x(bit * 3 + 4, bit * 2 + 4, bit + 4, 4);
-            __m256i inc = _mm256_set1_epi64x(bit << 2);
-
-            for (int32_t i = 0; i < batch; ++i) {
-              __m256i after = _mm256_srlv_epi64(base, shiftBits);
-              __m256i zigzagVal = _mm256_and_si256(after, maskVal);
-
-              // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-              __m256i signmask = _mm256_and_si256(_mm256_set1_epi64x(1), zigzagVal);
-              signmask = _mm256_sub_epi64(_mm256_setzero_si256(), signmask);
-              // get the four zigzag values here
-              __m256i delta = _mm256_xor_si256(_mm256_srli_epi64(zigzagVal, 1), signmask);
-
-              // calculate the cumulative sum (prefix sum) for each number
-              // decode[0] = prev_value + final[0]
-              // decode[1] = decode[0] + final[1]   -----> prev_value + final[0] + final[1]
-              // decode[2] = decode[1] + final[2]   -----> prev_value + final[0] + final[1] + final[2]
-              // decode[3] = decode[2] + final[3]   -----> prev_value + final[0] + final[1] + final[2] + final[3]
-
-              //  1, 2, 3, 4
-              //+ 0, 1, 0, 3
-              //  1, 3, 3, 7
-              // shift and add for the first round
-              __m128i prev = _mm_set1_epi64x(prev_value);
-              __m256i x =  _mm256_slli_si256(delta, 8);
-
-              delta = _mm256_add_epi64(delta, x);
-              _mm256_storeu_si256((__m256i *)&p[_pos], delta);
-
-              //  1, 3, 3, 7
-              //+ 0, 0, 3, 3
-              //  1, 3, 6, 10
-              // shift and add operation for the second round
-              __m128i firstPart = _mm_loadu_si128((__m128i *)&p[_pos]);
-              __m128i secondItem = _mm_set1_epi64x(p[_pos + 1]);
-              __m128i secPart = _mm_add_epi64(_mm_loadu_si128((__m128i *)&p[_pos + 2]), secondItem);
-              firstPart = _mm_add_epi64(firstPart, prev);
-              secPart = _mm_add_epi64(secPart, prev);
-
-              // save it in the memory
-              _mm_storeu_si128((__m128i *)&p[_pos], firstPart);
-              _mm_storeu_si128((__m128i *)&p[_pos + 2], secPart);
-
-              shiftBits = _mm256_add_epi64(shiftBits, inc);
-              prev_value = p[_pos + 3];
-//              uDebug("_pos:%d %"PRId64", %"PRId64", %"PRId64", %"PRId64, _pos, p[_pos], p[_pos+1], p[_pos+2], p[_pos+3]);
-              _pos += 4;
-            }
-
-            // handle the remain value
-            for (int32_t i = 0; i < remain; i++) {
-              zigzag_value = ((w >> (v + (batch * bit * 4))) & mask);
-              prev_value += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-              p[_pos++] = prev_value;
-//              uDebug("_pos:%d %"PRId64, _pos-1, p[_pos-1]);
-
-              v += bit;
-            }
-          } else {
-            for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-              zigzag_value = ((w >> v) & mask);
-              prev_value += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-              p[_pos++] = prev_value;
-//              uDebug("_pos:%d %"PRId64, _pos-1, p[_pos-1]);
-
-              v += bit;
-            }
-          }
-        }
-      } break;
       case TSDB_DATA_TYPE_INT: {
-        int32_t* p = (int32_t*) output;
-
-        if (selector == 0 || selector == 1) {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            p[_pos++] = (int32_t)prev_value;
-          }
-        } else {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            zigzag_value = ((w >> v) & mask);
-            prev_value += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = (int32_t)prev_value;
-            v += bit;
-          }
-        }
+        int32_t *o = (int32_t *)output + _pos;
+        for (int32_t i = 0; i < num; i++) o[i] = (int32_t)buf[i];
       } break;
       case TSDB_DATA_TYPE_SMALLINT: {
-        int16_t* p = (int16_t*) output;
-
-        if (selector == 0 || selector == 1) {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            p[_pos++] = (int16_t)prev_value;
-          }
-        } else {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            zigzag_value = ((w >> v) & mask);
-            prev_value += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = (int16_t)prev_value;
-            v += bit;
-          }
-        }
+        int16_t *o = (int16_t *)output + _pos;
+        for (int32_t i = 0; i < num; i++) o[i] = (int16_t)buf[i];
       } break;
-
       case TSDB_DATA_TYPE_TINYINT: {
-        int8_t *p = (int8_t *)output;
-
-        if (selector == 0 || selector == 1) {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            p[_pos++] = (int8_t)prev_value;
-          }
-        } else {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            zigzag_value = ((w >> v) & mask);
-            prev_value += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = (int8_t)prev_value;
-            v += bit;
-          }
-        }
+        int8_t *o = (int8_t *)output + _pos;
+        for (int32_t i = 0; i < num; i++) o[i] = (int8_t)buf[i];
       } break;
+      default:
+        break;
     }
-
-    ip += LONG_BYTES;
+    _pos += num;
   }
 
   return nelements * word_length;
-#else
-
-  while (1) {
-    if (count == nelements) break;
-
-    uint64_t w = 0;
-    memcpy(&w, ip, LONG_BYTES);
-
-    char    selector = (char)(w & INT64MASK(4));       // selector = 4
-    char    bit = bit_per_integer[(int32_t)selector];  // bit = 3
-    int32_t elems = selector_to_elems[(int32_t)selector];
-
-    for (int32_t i = 0; i < elems; i++) {
-      uint64_t zigzag_value;
-
-      if (selector == 0 || selector == 1) {
-        zigzag_value = 0;
-      } else {
-        zigzag_value = ((w >> (4 + bit * i)) & INT64MASK(bit));
-      }
-      int64_t diff = ZIGZAG_DECODE(int64_t, zigzag_value);
-      int64_t curr_value = diff + prev_value;
-      prev_value = curr_value;
-
-      switch (type) {
-        case TSDB_DATA_TYPE_BIGINT:
-          *((int64_t *)output + _pos) = (int64_t)curr_value;
-          _pos++;
-          break;
-        case TSDB_DATA_TYPE_INT:
-          *((int32_t *)output + _pos) = (int32_t)curr_value;
-          _pos++;
-          break;
-        case TSDB_DATA_TYPE_SMALLINT:
-          *((int16_t *)output + _pos) = (int16_t)curr_value;
-          _pos++;
-          break;
-        case TSDB_DATA_TYPE_TINYINT:
-          *((int8_t *)output + _pos) = (int8_t)curr_value;
-          _pos++;
-          break;
-        default:
-          perror("Wrong integer types.\n");
-          return -1;
-      }
-      count++;
-      if (count == nelements) break;
-    }
-    ip += LONG_BYTES;
-  }
-
-  return nelements * word_length;
-#endif
 }
 
 /* ----------------------------------------------Bool Compression
@@ -745,6 +680,77 @@ _exit_over:
   return nelements * LONG_BYTES + 1;
 }
 
+// Rebuild the timestamps in place from the zigzag decoded delta of deltas, p[0] already holds the first value.
+static void decodeDeltaOfDelta(int64_t *p, int32_t nelements) {
+  int64_t prev_value = p[0];
+  int64_t prev_delta = 0;
+  for (int32_t i = 1; i < nelements; i++) {
+    prev_delta = p[i] + prev_delta;
+    prev_value = prev_value + prev_delta;
+    p[i] = prev_value;
+  }
+}
+
+#if __AVX2__
+static FORCE_INLINE __m256i prefixSumEpi64AVX2(__m256i x) {
+  x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+  return _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x50), _mm256_setzero_si256(), 0x0F));
+}
+
+static void decodeDeltaOfDeltaAVX2(int64_t *p, int32_t nelements) {
+  __m256i prevValue = _mm256_set1_epi64x(p[0]);
+  __m256i prevDelta = _mm256_setzero_si256();
+
+  int32_t i = 1;
+  for (; i + 4 <= nelements; i += 4) {
+    __m256i delta = _mm256_add_epi64(prefixSumEpi64AVX2(_mm256_loadu_si256((__m256i *)(p + i))), prevDelta);
+    __m256i value = _mm256_add_epi64(prefixSumEpi64AVX2(delta), prevValue);
+    _mm256_storeu_si256((__m256i *)(p + i), value);
+    prevDelta = _mm256_permute4x64_epi64(delta, 0xFF);
+    prevValue = _mm256_permute4x64_epi64(value, 0xFF);
+  }
+
+  int64_t prev_value = _mm256_extract_epi64(prevValue, 0);
+  int64_t prev_delta = _mm256_extract_epi64(prevDelta, 0);
+  for (; i < nelements; i++) {
+    prev_delta = p[i] + prev_delta;
+    prev_value = prev_value + prev_delta;
+    p[i] = prev_value;
+  }
+}
+#endif
+
+#if __AVX512F__
+static FORCE_INLINE __m512i prefixSumEpi64AVX512(__m512i x) {
+  x = _mm512_add_epi64(x, _mm512_maskz_permutexvar_epi64(0xFE, _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0), x));
+  x = _mm512_add_epi64(x, _mm512_maskz_permutexvar_epi64(0xFC, _mm512_set_epi64(5, 4, 3, 2, 1, 0, 0, 0), x));
+  return _mm512_add_epi64(x, _mm512_maskz_permutexvar_epi64(0xF0, _mm512_set_epi64(3, 2, 1, 0, 0, 0, 0, 0), x));
+}
+
+static void decodeDeltaOfDeltaAVX512(int64_t *p, int32_t nelements) {
+  __m512i idxLast = _mm512_set1_epi64(7);
+  __m512i prevValue = _mm512_set1_epi64(p[0]);
+  __m512i prevDelta = _mm512_setzero_si512();
+
+  int32_t i = 1;
+  for (; i + 8 <= nelements; i += 8) {
+    __m512i delta = _mm512_add_epi64(prefixSumEpi64AVX512(_mm512_loadu_si512((void *)(p + i))), prevDelta);
+    __m512i value = _mm512_add_epi64(prefixSumEpi64AVX512(delta), prevValue);
+    _mm512_storeu_si512((void *)(p + i), value);
+    prevDelta = _mm512_permutexvar_epi64(idxLast, delta);
+    prevValue = _mm512_permutexvar_epi64(idxLast, value);
+  }
+
+  int64_t prev_value = _mm_cvtsi128_si64(_mm512_castsi512_si128(prevValue));
+  int64_t prev_delta = _mm_cvtsi128_si64(_mm512_castsi512_si128(prevDelta));
+  for (; i < nelements; i++) {
+    prev_delta = p[i] + prev_delta;
+    prev_value = prev_value + prev_delta;
+    p[i] = prev_value;
+  }
+}
+#endif
+
 int32_t tsDecompressTimestampImp(const char *const input, const int32_t nelements, char *const output) {
   ASSERTS(nelements >= 0, "nelements is negative");
   if (nelements == 0) return 0;
@@ -757,58 +763,51 @@ int32_t tsDecompressTimestampImp(const char *const input, const int32_t nelement
 
     int32_t ipos = 1, opos = 0;
     int8_t  nbytes = 0;
-    int64_t prev_value = 0;
-    int64_t prev_delta = 0;
-    int64_t delta_of_delta = 0;
 
-    while (1) {
+    // The variable length fields can only be parsed one by one, so unpack the delta of deltas first and rebuild the
+    // timestamps with the two prefix sums afterwards.
+    while (opos < nelements) {
       uint8_t flags = input[ipos++];
       // Decode dd1
       uint64_t dd1 = 0;
       nbytes = flags & INT8MASK(4);
-      if (nbytes == 0) {
-        delta_of_delta = 0;
+      if (is_bigendian()) {
+        memcpy(((char *)(&dd1)) + LONG_BYTES - nbytes, input + ipos, nbytes);
       } else {
-        if (is_bigendian()) {
-          memcpy(((char *)(&dd1)) + LONG_BYTES - nbytes, input + ipos, nbytes);
-        } else {
-          memcpy(&dd1, input + ipos, nbytes);
-        }
-        delta_of_delta = ZIGZAG_DECODE(int64_t, dd1);
+        memcpy(&dd1, input + ipos, nbytes);
       }
       ipos += nbytes;
-      if (opos == 0) {
-        prev_value = delta_of_delta;
-        prev_delta = 0;
-        ostream[opos++] = delta_of_delta;
-      } else {
-        prev_delta = delta_of_delta + prev_delta;
-        prev_value = prev_value + prev_delta;
-        ostream[opos++] = prev_value;
-      }
-      if (opos == nelements) return nelements * LONG_BYTES;
+      ostream[opos++] = ZIGZAG_DECODE(int64_t, dd1);
+      if (opos == nelements) break;
 
       // Decode dd2
       uint64_t dd2 = 0;
       nbytes = (flags >> 4) & INT8MASK(4);
-      if (nbytes == 0) {
-        delta_of_delta = 0;
+      if (is_bigendian()) {
+        memcpy(((char *)(&dd2)) + LONG_BYTES - nbytes, input + ipos, nbytes);
       } else {
-        if (is_bigendian()) {
-          memcpy(((char *)(&dd2)) + LONG_BYTES - nbytes, input + ipos, nbytes);
-        } else {
-          memcpy(&dd2, input + ipos, nbytes);
-        }
-        // zigzag_decoding
-        delta_of_delta = ZIGZAG_DECODE(int64_t, dd2);
+        memcpy(&dd2, input + ipos, nbytes);
       }
       ipos += nbytes;
-      prev_delta = delta_of_delta + prev_delta;
-      prev_value = prev_value + prev_delta;
-      ostream[opos++] = prev_value;
-      if (opos == nelements) return nelements * LONG_BYTES;
+      ostream[opos++] = ZIGZAG_DECODE(int64_t, dd2);
     }
 
+    switch (getDecodeSimdLevel()) {
+#if __AVX512F__
+      case DECODE_SIMD_AVX512:
+        decodeDeltaOfDeltaAVX512(ostream, nelements);
+        break;
+#endif
+#if __AVX2__
+      case DECODE_SIMD_AVX2:
+        decodeDeltaOfDeltaAVX2(ostream, nelements);
+        break;
+#endif
+      default:
+        decodeDeltaOfDelta(ostream, nelements);
+        break;
+    }
+    return nelements * LONG_BYTES;
   } else {
     ASSERT(0);
     return -1;
@@ -924,36 +923,101 @@ FORCE_INLINE uint64_t decodeDoubleValue(const char *const input, int32_t *const
   return diff;
 }
 
+// Rebuild the values in place from the xor diffs, i.e. an inclusive xor prefix scan.
+static void decodeXorDiff64(uint64_t *p, int32_t nelements) {
+  uint64_t prev_value = 0;
+  for (int32_t i = 0; i < nelements; i++) {
+    prev_value ^= p[i];
+    p[i] = prev_value;
+  }
+}
+
+#if __AVX2__
+static void decodeXorDiff64AVX2(uint64_t *p, int32_t nelements) {
+  __m256i prev = _mm256_setzero_si256();
+
+  int32_t i = 0;
+  for (; i + 4 <= nelements; i += 4) {
+    __m256i x = _mm256_loadu_si256((__m256i *)(p + i));
+    x = _mm256_xor_si256(x, _mm256_slli_si256(x, 8));
+    x = _mm256_xor_si256(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x50), _mm256_setzero_si256(), 0x0F));
+    x = _mm256_xor_si256(x, prev);
+    _mm256_storeu_si256((__m256i *)(p + i), x);
+    prev = _mm256_permute4x64_epi64(x, 0xFF);
+  }
+
+  uint64_t prev_value = _mm256_extract_epi64(prev, 0);
+  for (; i < nelements; i++) {
+    prev_value ^= p[i];
+    p[i] = prev_value;
+  }
+}
+#endif
+
+#if __AVX512F__
+static void decodeXorDiff64AVX512(uint64_t *p, int32_t nelements) {
+  __m512i idx1 = _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0);
+  __m512i idx2 = _mm512_set_epi64(5, 4, 3, 2, 1, 0, 0, 0);
+  __m512i idx4 = _mm512_set_epi64(3, 2, 1, 0, 0, 0, 0, 0);
+  __m512i idxLast = _mm512_set1_epi64(7);
+  __m512i prev = _mm512_setzero_si512();
+
+  int32_t i = 0;
+  for (; i + 8 <= nelements; i += 8) {
+    __m512i x = _mm512_loadu_si512((void *)(p + i));
+    x = _mm512_xor_si512(x, _mm512_maskz_permutexvar_epi64(0xFE, idx1, x));
+    x = _mm512_xor_si512(x, _mm512_maskz_permutexvar_epi64(0xFC, idx2, x));
+    x = _mm512_xor_si512(x, _mm512_maskz_permutexvar_epi64(0xF0, idx4, x));
+    x = _mm512_xor_si512(x, prev);
+    _mm512_storeu_si512((void *)(p + i), x);
+    prev = _mm512_permutexvar_epi64(idxLast, x);
+  }
+
+  uint64_t prev_value = _mm_cvtsi128_si64(_mm512_castsi512_si128(prev));
+  for (; i < nelements; i++) {
+    prev_value ^= p[i];
+    p[i] = prev_value;
+  }
+}
+#endif
+
 int32_t tsDecompressDoubleImp(const char *const input, const int32_t nelements, char *const output) {
   // output stream
-  double *ostream = (double *)output;
+  uint64_t *ostream = (uint64_t *)output;
 
   if (input[0] == 1) {
     memcpy(output, input + 1, nelements * DOUBLE_BYTES);
     return nelements * DOUBLE_BYTES;
   }
 
-  uint8_t  flags = 0;
-  int32_t  ipos = 1;
-  int32_t  opos = 0;
-  uint64_t diff = 0;
-  union {
-    uint64_t bits;
-    double   real;
-  } curr;
-
-  curr.bits = 0;
+  uint8_t flags = 0;
+  int32_t ipos = 1;
+  int32_t opos = 0;
 
+  // unpack the xor diffs first, then rebuild the values with a xor prefix scan
   for (int32_t i = 0; i < nelements; i++) {
     if ((i & 0x01) == 0) {
       flags = input[ipos++];
     }
 
-    diff = decodeDoubleValue(input, &ipos, flags & 0x0f);
+    ostream[opos++] = decodeDoubleValue(input, &ipos, flags & 0x0f);
     flags >>= 4;
-    curr.bits ^= diff;
+  }
 
-    ostream[opos++] = curr.real;
+  switch (getDecodeSimdLevel()) {
+#if __AVX512F__
+    case DECODE_SIMD_AVX512:
+      decodeXorDiff64AVX512(ostream, nelements);
+      break;
+#endif
+#if __AVX2__
+    case DECODE_SIMD_AVX2:
+      decodeXorDiff64AVX2(ostream, nelements);
+      break;
+#endif
+    default:
+      decodeXorDiff64(ostream, nelements);
+      break;
   }
 
   return nelements * DOUBLE_BYTES;
@@ -1068,19 +1132,82 @@ uint32_t decodeFloatValue(const char *const input, int32_t *const ipos, uint8_t
   return diff;
 }
 
+static void decodeXorDiff32(uint32_t *p, int32_t nelements) {
+  uint32_t prev_value = 0;
+  for (int32_t i = 0; i < nelements; i++) {
+    prev_value ^= p[i];
+    p[i] = prev_value;
+  }
+}
+
+#if __AVX2__
+static void decodeXorDiff32AVX2(uint32_t *p, int32_t nelements) {
+  __m256i prev = _mm256_setzero_si256();
+  __m256i idxLast = _mm256_set1_epi32(7);
+  __m256i idxHalf = _mm256_set1_epi32(3);
+
+  int32_t i = 0;
+  for (; i + 8 <= nelements; i += 8) {
+    __m256i x = _mm256_loadu_si256((__m256i *)(p + i));
+    // scan inside each 128-bit lane, then carry the low lane into the high lane
+    x = _mm256_xor_si256(x, _mm256_slli_si256(x, 4));
+    x = _mm256_xor_si256(x, _mm256_slli_si256(x, 8));
+    x = _mm256_xor_si256(x, _mm256_blend_epi32(_mm256_permutevar8x32_epi32(x, idxHalf), _mm256_setzero_si256(), 0x0F));
+    x = _mm256_xor_si256(x, prev);
+    _mm256_storeu_si256((__m256i *)(p + i), x);
+    prev = _mm256_permutevar8x32_epi32(x, idxLast);
+  }
+
+  uint32_t prev_value = (uint32_t)_mm256_extract_epi32(prev, 0);
+  for (; i < nelements; i++) {
+    prev_value ^= p[i];
+    p[i] = prev_value;
+  }
+}
+#endif
+
+#if __AVX512F__
+static void decodeXorDiff32AVX512(uint32_t *p, int32_t nelements) {
+  __m512i idx1 = _mm512_set_epi32(14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 0);
+  __m512i idx2 = _mm512_set_epi32(13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 0, 0);
+  __m512i idx4 = _mm512_set_epi32(11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 0, 0, 0, 0);
+  __m512i idx8 = _mm512_set_epi32(7, 6, 5, 4, 3, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  __m512i idxLast = _mm512_set1_epi32(15);
+  __m512i prev = _mm512_setzero_si512();
+
+  int32_t i = 0;
+  for (; i + 16 <= nelements; i += 16) {
+    __m512i x = _mm512_loadu_si512((void *)(p + i));
+    x = _mm512_xor_si512(x, _mm512_maskz_permutexvar_epi32(0xFFFE, idx1, x));
+    x = _mm512_xor_si512(x, _mm512_maskz_permutexvar_epi32(0xFFFC, idx2, x));
+    x = _mm512_xor_si512(x, _mm512_maskz_permutexvar_epi32(0xFFF0, idx4, x));
+    x = _mm512_xor_si512(x, _mm512_maskz_permutexvar_epi32(0xFF00, idx8, x));
+    x = _mm512_xor_si512(x, prev);
+    _mm512_storeu_si512((void *)(p + i), x);
+    prev = _mm512_permutexvar_epi32(idxLast, x);
+  }
+
+  uint32_t prev_value = (uint32_t)_mm_cvtsi128_si32(_mm512_castsi512_si128(prev));
+  for (; i < nelements; i++) {
+    prev_value ^= p[i];
+    p[i] = prev_value;
+  }
+}
+#endif
+
 int32_t tsDecompressFloatImp(const char *const input, const int32_t nelements, char *const output) {
-  float *ostream = (float *)output;
+  uint32_t *ostream = (uint32_t *)output;
 
   if (input[0] == 1) {
     memcpy(output, input + 1, nelements * FLOAT_BYTES);
     return nelements * FLOAT_BYTES;
   }
 
-  uint8_t  flags = 0;
-  int32_t  ipos = 1;
-  int32_t  opos = 0;
-  uint32_t prev_value = 0;
+  uint8_t flags = 0;
+  int32_t ipos = 1;
+  int32_t opos = 0;
 
+  // unpack the xor diffs first, then rebuild the values with a xor prefix scan
   for (int32_t i = 0; i < nelements; i++) {
     if (i % 2 == 0) {
       flags = input[ipos++];
@@ -1089,17 +1216,23 @@ int32_t tsDecompressFloatImp(const char *const input, const int32_t nelements, c
     uint8_t flag = flags & INT8MASK(4);
     flags >>= 4;
 
-    uint32_t diff = decodeFloatValue(input, &ipos, flag);
-    union {
-      uint32_t bits;
-      float    real;
-    } curr;
-
-    uint32_t predicted = prev_value;
-    curr.bits = predicted ^ diff;
-    prev_value = curr.bits;
+    ostream[opos++] = decodeFloatValue(input, &ipos, flag);
+  }
 
-    ostream[opos++] = curr.real;
+  switch (getDecodeSimdLevel()) {
+#if __AVX512F__
+    case DECODE_SIMD_AVX512:
+      decodeXorDiff32AVX512(ostream, nelements);
+      break;
+#endif
+#if __AVX2__
+    case DECODE_SIMD_AVX2:
+      decodeXorDiff32AVX2(ostream, nelements);
+      break;
+#endif
+    default:
+      decodeXorDiff32(ostream, nelements);
+      break;
   }
 
   return nelements * FLOAT_BYTES;
@@ -2,6 +2,7 @@
 #include "tpagedbuf.h"
 #include "taoserror.h"
 #include "tcompression.h"
+#include "tsched.h"
 #include "tsimplehash.h"
 #include "tlog.h"
 
@@ -11,6 +12,19 @@
 #define HAS_DATA_IN_DISK(_p)           ((_p)->offset >= 0)
 #define NO_IN_MEM_AVAILABLE_PAGES(_b)  (listNEles((_b)->lruList) >= (_b)->inMemPages)
 
+#define PAGED_BUF_QUEUE_SIZE      10000
+#define PAGED_BUF_FLUSH_BATCH     32                 // max pages written by one background task
+#define PAGED_BUF_FLUSH_BYTES     (4 * 1024 * 1024)  // max bytes written by one background task
+#define PAGED_BUF_PREFETCH_PAGES  16                 // max pages read ahead but not consumed yet
+#define PAGED_BUF_MIN_COMPRESS    8                  // a page is stored raw if lz4 saves less than 1/8 of it
+
+#define PAGED_BUF_IO_IDLE    0
+#define PAGED_BUF_IO_RUNNING 1
+#define PAGED_BUF_IO_DONE    2
+
+int32_t tsPagedBufDirtyRatio = 50;
+bool    tsPagedBufCompress = false;
+
 typedef struct SPageDiskInfo {
   int64_t offset;
   int32_t length;
@@ -24,8 +38,30 @@ struct SPageInfo {
   int32_t    length : 29;
   bool       used : 1;   // set current page is in used
   bool       dirty : 1;  // set current buffer page is dirty or not
+  bool       flushing : 1;  // the page is written to disk by the background task
 };
 
+typedef struct SPrefetchedPage {
+  int32_t pageId;
+  char*   pData;  // allocated in the same layout as SPageInfo.pData
+} SPrefetchedPage;
+
+// The background task owns the file, pFree and nextPos while it is running. The query thread waits for it before
+// doing any disk io itself, and applies its results to the page infos when it is done.
+typedef struct SPagedBufIOTask {
+  SDiskbasedBuf* pBuf;
+  SArray*        pFlushPages;  // SPageInfo*, dirty pages to write
+  SArray*        pFlushPos;    // SPageDiskInfo, the new position of each written page
+  SArray*        pLoadPages;   // SPageInfo*, pages to read ahead
+  SArray*        pLoadData;    // char*, the loaded page or NULL if failed
+  char*          pIOBuf;       // contiguous area of the relocated pages
+  int32_t        ioBufSize;
+  uint64_t       fileSize;
+  int64_t        flushBytes;
+  int64_t        loadBytes;
+  int32_t        code;
+} SPagedBufIOTask;
+
 struct SDiskbasedBuf {
   int32_t   numOfPages;
   int64_t   totalBufSize;
@@ -49,8 +85,43 @@ struct SDiskbasedBuf {
   char*               id;           // for debug purpose
   bool                printStatis;  // Print statistics info when closing this buffer.
   SDiskbasedBufStatis statis;
+
+  TdThreadMutex   ioLock;
+  TdThreadCond    ioCond;
+  int8_t          ioStatus;      // status of the background task
+  SPagedBufIOTask ioTask;
+  int32_t         dirtyPages;    // dirty high-water mark, older dirty pages in lru list are written in background
+  int32_t         scanDelay;     // evictions before the lru list is scanned for dirty pages again
+  SArray*         pPrefetchReq;  // page ids to read ahead by the next background task
+  SArray*         pPrefetched;   // SPrefetchedPage, pages read ahead
 };
 
+static SSchedQueue pagedBufQueue = {0};
+static int32_t     pagedBufThreads = 0;
+
+int32_t dBufInitIOPool() {
+  if (pagedBufThreads > 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t numOfThreads = (int32_t)(tsNumOfCores / 2);
+  TRANGE(numOfThreads, 2, 16);
+  if (taosInitScheduler(PAGED_BUF_QUEUE_SIZE, numOfThreads, "paged-buf", &pagedBufQueue) == NULL) {
+    uError("failed to init paged buffer io pool, numOfThreads:%d", numOfThreads);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pagedBufThreads = numOfThreads;
+  return TSDB_CODE_SUCCESS;
+}
+
+void dBufCleanupIOPool() {
+  if (pagedBufThreads > 0) {
+    pagedBufThreads = 0;
+    taosCleanUpScheduler(&pagedBufQueue);
+  }
+}
+
 static int32_t createDiskFile(SDiskbasedBuf* pBuf) {
   if (pBuf->path == NULL) {  // prepare the file name when needed it
     char path[PATH_MAX] = {0};
@@ -70,29 +141,51 @@ static int32_t createDiskFile(SDiskbasedBuf* pBuf) {
   return TSDB_CODE_SUCCESS;
 }
 
-static char* doCompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
+static FORCE_INLINE int32_t getPagePayloadSize(const SDiskbasedBuf* pBuf) {
+  return pBuf->pageSize + sizeof(SFilePage);
+}
+
+// The codec is chosen per page: lz4, or raw if lz4 does not shrink the page enough to pay for decompressing it. The
+// encoded page is in pOut when compression is on, otherwise the page itself is returned.
+static char* encodePage(SDiskbasedBuf* pBuf, char* pPage, char* pOut, int32_t* len) {
+  int32_t size = getPagePayloadSize(pBuf);
   if (!pBuf->comp) {
-    *dst = srcSize;
-    return data;
+    *len = size;
+    return pPage;
   }
 
-  *dst = tsCompressString(data, srcSize, 1, pBuf->assistBuf, srcSize, ONE_STAGE_COMP, NULL, 0);
-
-  memcpy(data, pBuf->assistBuf, *dst);
-  return data;
+  *len = tsCompressString(pPage, size, 1, pOut, size + 1, ONE_STAGE_COMP, NULL, 0);
+  if (*len <= 0 || *len > size - size / PAGED_BUF_MIN_COMPRESS) {
+    pOut[0] = 0;  // the indicator of uncompressed data
+    memcpy(pOut + 1, pPage, size);
+    *len = size + 1;
+  }
+  return pOut;
 }
 
-static char* doDecompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
-  if (!pBuf->comp) {
-    *dst = srcSize;
-    return data;
+// load the page at offset into pPage, pScratch holds the encoded page when compression is on
+static int32_t doLoadPageImpl(SDiskbasedBuf* pBuf, int64_t offset, int32_t length, char* pPage, char* pScratch) {
+  char* pRead = pBuf->comp ? pScratch : pPage;
+
+  int32_t ret = taosLSeekFile(pBuf->pFile, offset, SEEK_SET);
+  if (ret == -1) {
+    return TAOS_SYSTEM_ERROR(errno);
+  }
+
+  ret = (int32_t)taosReadFile(pBuf->pFile, pRead, length);
+  if (ret != length) {
+    return TAOS_SYSTEM_ERROR(errno);
   }
 
-  *dst = tsDecompressString(data, srcSize, 1, pBuf->assistBuf, pBuf->pageSize, ONE_STAGE_COMP, NULL, 0);
-  if (*dst > 0) {
-    memcpy(data, pBuf->assistBuf, *dst);
+  if (pBuf->comp) {
+    int32_t size = tsDecompressString(pScratch, length, 1, pPage, getPagePayloadSize(pBuf), ONE_STAGE_COMP, NULL, 0);
+    if (size != getPagePayloadSize(pBuf)) {
+      uError("failed to decompress buf page, offset:%" PRId64 ", length:%d, %s", offset, length, pBuf->id);
+      return TSDB_CODE_COMPRESS_ERROR;
+    }
   }
-  return data;
+
+  return TSDB_CODE_SUCCESS;
 }
 
 static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
@@ -129,16 +222,26 @@ static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
 
 static FORCE_INLINE size_t getAllocPageSize(int32_t pageSize) { return pageSize + POINTER_BYTES + sizeof(SFilePage); }
 
-static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
-  int32_t ret = taosLSeekFile(pBuf->pFile, offset, SEEK_SET);
+static int32_t doWriteFile(TdFilePtr pFile, int64_t offset, const char* pData, int32_t size) {
+  int32_t ret = taosLSeekFile(pFile, offset, SEEK_SET);
   if (ret == -1) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return terrno;
+    return TAOS_SYSTEM_ERROR(errno);
   }
 
-  ret = (int32_t)taosWriteFile(pBuf->pFile, pData, size);
+  ret = (int32_t)taosWriteFile(pFile, pData, size);
   if (ret != size) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
+    return TAOS_SYSTEM_ERROR(errno);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
+  int64_t st = taosGetTimestampUs();
+  int32_t code = doWriteFile(pBuf->pFile, offset, pData, size);
+  pBuf->statis.stallTime += taosGetTimestampUs() - st;
+  if (code != TSDB_CODE_SUCCESS) {
+    terrno = code;
     return terrno;
   }
 
@@ -165,13 +268,7 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
 
   char* t = NULL;
   if ((!HAS_DATA_IN_DISK(pg)) || pg->dirty) {
-    void* payload = GET_PAYLOAD_DATA(pg);
-    t = doCompressData(payload, pBuf->pageSize + sizeof(SFilePage), &size, pBuf);
-    if (size < 0) {
-      uError("failed to compress data when flushing data to disk, %s", pBuf->id);
-      terrno = TSDB_CODE_INVALID_PARA;
-      return NULL;
-    }
+    t = encodePage(pBuf, GET_PAYLOAD_DATA(pg), pBuf->assistBuf, &size);
   }
 
   // this page is flushed to disk for the first time
@@ -241,27 +338,332 @@ static int32_t loadPageFromDisk(SDiskbasedBuf* pBuf, SPageInfo* pg) {
     return TSDB_CODE_INVALID_PARA;
   }
 
-  int32_t ret = taosLSeekFile(pBuf->pFile, pg->offset, SEEK_SET);
-  if (ret == -1) {
-    ret = TAOS_SYSTEM_ERROR(errno);
-    return ret;
-  }
-
-  void* pPage = (void*)GET_PAYLOAD_DATA(pg);
-  ret = (int32_t)taosReadFile(pBuf->pFile, pPage, pg->length);
-  if (ret != pg->length) {
-    ret = TAOS_SYSTEM_ERROR(errno);
-    return ret;
+  int64_t st = taosGetTimestampUs();
+  int32_t code = doLoadPageImpl(pBuf, pg->offset, pg->length, GET_PAYLOAD_DATA(pg), pBuf->assistBuf);
+  pBuf->statis.stallTime += taosGetTimestampUs() - st;
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
   }
 
   pBuf->statis.loadBytes += pg->length;
   pBuf->statis.loadPages += 1;
-
-  int32_t fullSize = 0;
-  doDecompressData(pPage, pg->length, &fullSize, pBuf);
   return 0;
 }
 
+static void doPagedBufWriteBehind(SPagedBufIOTask* pTask) {
+  SDiskbasedBuf* pBuf = pTask->pBuf;
+  int32_t        num = taosArrayGetSize(pTask->pFlushPages);
+  int64_t        runOffset = pBuf->nextPos;
+  int32_t        runLen = 0;
+
+  for (int32_t i = 0; i < num && pTask->code == TSDB_CODE_SUCCESS; ++i) {
+    SPageInfo* pg = taosArrayGetP(pTask->pFlushPages, i);
+    char*      pOut = pTask->pIOBuf + runLen;
+    int32_t    len = 0;
+    char*      pData = encodePage(pBuf, GET_PAYLOAD_DATA(pg), pOut, &len);
+
+    SPageDiskInfo pos = {.offset = pg->offset, .length = len};
+    if (HAS_DATA_IN_DISK(pg) && pg->length >= len) {  // the old place is large enough
+      pTask->code = doWriteFile(pBuf->pFile, pos.offset, pData, len);
+      pTask->fileSize = TMAX(pTask->fileSize, pos.offset + len);
+    } else {  // relocated pages are appended to the file, and written in one go
+      if (pData != pOut) {
+        memcpy(pOut, pData, len);
+      }
+      pos.offset = runOffset + runLen;
+      runLen += len;
+    }
+
+    taosArrayPush(pTask->pFlushPos, &pos);
+    pTask->flushBytes += len;
+  }
+
+  if (pTask->code == TSDB_CODE_SUCCESS && runLen > 0) {
+    pTask->code = doWriteFile(pBuf->pFile, runOffset, pTask->pIOBuf, runLen);
+    if (pTask->code == TSDB_CODE_SUCCESS) {
+      pBuf->nextPos = runOffset + runLen;
+      pTask->fileSize = TMAX(pTask->fileSize, pBuf->nextPos);
+    }
+  }
+}
+
+static void doPagedBufReadAhead(SPagedBufIOTask* pTask) {
+  SDiskbasedBuf* pBuf = pTask->pBuf;
+  int32_t        num = taosArrayGetSize(pTask->pLoadPages);
+
+  for (int32_t i = 0; i < num; ++i) {
+    SPageInfo* pg = taosArrayGetP(pTask->pLoadPages, i);
+    char*      pData = taosMemoryMalloc(getAllocPageSize(pBuf->pageSize));
+    if (pData != NULL) {
+      int32_t code = doLoadPageImpl(pBuf, pg->offset, pg->length, pData + POINTER_BYTES, pTask->pIOBuf);
+      if (code == TSDB_CODE_SUCCESS) {
+        pTask->loadBytes += pg->length;
+      } else {  // it is only a hint, the page is loaded again when needed
+        uWarn("failed to read ahead buf page:%d since %s, %s", pg->pageId, tstrerror(code), pBuf->id);
+        taosMemoryFreeClear(pData);
+      }
+    }
+
+    taosArrayPush(pTask->pLoadData, &pData);
+  }
+}
+
+static void doPagedBufIOTask(SSchedMsg* pMsg) {
+  SPagedBufIOTask* pTask = pMsg->ahandle;
+  SDiskbasedBuf*   pBuf = pTask->pBuf;
+
+  doPagedBufWriteBehind(pTask);
+  doPagedBufReadAhead(pTask);
+
+  taosThreadMutexLock(&pBuf->ioLock);
+  atomic_store_8(&pBuf->ioStatus, PAGED_BUF_IO_DONE);
+  taosThreadCondSignal(&pBuf->ioCond);
+  taosThreadMutexUnlock(&pBuf->ioLock);
+}
+
+// Apply the results of the background task once it is done. If wait is true, block until the running task is done,
+// which is required before the query thread does any disk io itself.
+static void reapPagedBufIOTask(SDiskbasedBuf* pBuf, bool wait) {
+  int8_t status = atomic_load_8(&pBuf->ioStatus);
+  if (status == PAGED_BUF_IO_IDLE || (status == PAGED_BUF_IO_RUNNING && !wait)) {
+    return;
+  }
+
+  // the lock is taken even if the task is seen done, since the worker still signals and releases it after setting the
+  // status, and the buffer may be destroyed right after this
+  int64_t st = taosGetTimestampUs();
+  taosThreadMutexLock(&pBuf->ioLock);
+  while (atomic_load_8(&pBuf->ioStatus) == PAGED_BUF_IO_RUNNING) {
+    taosThreadCondWait(&pBuf->ioCond, &pBuf->ioLock);
+  }
+  taosThreadMutexUnlock(&pBuf->ioLock);
+  if (status == PAGED_BUF_IO_RUNNING) {
+    pBuf->statis.stallTime += taosGetTimestampUs() - st;
+  }
+
+  SPagedBufIOTask* pTask = &pBuf->ioTask;
+  int32_t          num = taosArrayGetSize(pTask->pFlushPages);
+  for (int32_t i = 0; i < num; ++i) {
+    SPageInfo* pg = taosArrayGetP(pTask->pFlushPages, i);
+    pg->flushing = false;
+    if (pTask->code != TSDB_CODE_SUCCESS) {  // the page stays dirty, and is written again when it is evicted
+      continue;
+    }
+
+    SPageDiskInfo* pos = taosArrayGet(pTask->pFlushPos, i);
+    if (HAS_DATA_IN_DISK(pg) && pos->offset != pg->offset) {
+      SPageDiskInfo dinfo = {.length = pg->length, .offset = pg->offset};
+      taosArrayPush(pBuf->pFree, &dinfo);
+    }
+
+    pg->offset = pos->offset;
+    pg->length = pos->length;
+    pg->dirty = false;
+  }
+
+  if (pTask->code == TSDB_CODE_SUCCESS) {
+    pBuf->statis.flushBytes += pTask->flushBytes;
+    pBuf->statis.flushPages += num;
+    pBuf->statis.asyncFlushPages += num;
+  } else {
+    uWarn("failed to write %d buf pages in background since %s, %s", num, tstrerror(pTask->code), pBuf->id);
+  }
+
+  if (pBuf->fileSize < pTask->fileSize) {
+    pBuf->fileSize = pTask->fileSize;
+  }
+
+  num = taosArrayGetSize(pTask->pLoadPages);
+  for (int32_t i = 0; i < num; ++i) {
+    SPageInfo* pg = taosArrayGetP(pTask->pLoadPages, i);
+    char*      pData = taosArrayGetP(pTask->pLoadData, i);
+    if (pData != NULL) {
+      SPrefetchedPage page = {.pageId = pg->pageId, .pData = pData};
+      taosArrayPush(pBuf->pPrefetched, &page);
+      pBuf->statis.loadPages += 1;
+      pBuf->statis.prefetchPages += 1;
+    }
+  }
+  pBuf->statis.loadBytes += pTask->loadBytes;
+
+  taosArrayClear(pTask->pFlushPages);
+  taosArrayClear(pTask->pFlushPos);
+  taosArrayClear(pTask->pLoadPages);
+  taosArrayClear(pTask->pLoadData);
+  pTask->fileSize = 0;
+  pTask->flushBytes = 0;
+  pTask->loadBytes = 0;
+  pTask->code = TSDB_CODE_SUCCESS;
+  atomic_store_8(&pBuf->ioStatus, PAGED_BUF_IO_IDLE);
+}
+
+// The dirty pages beyond the dirty high-water mark, counted from the head of the lru list, are written in background,
+// so that evicting them later needs no disk io on the query thread.
+static void collectWriteBehindPages(SDiskbasedBuf* pBuf, SArray* pPages) {
+  int32_t numOfCold = listNEles(pBuf->lruList) - pBuf->dirtyPages;
+  if (numOfCold <= 0) {
+    return;
+  }
+
+  if (pBuf->scanDelay > 0) {
+    pBuf->scanDelay -= 1;
+    return;
+  }
+
+  int32_t maxPages = TMIN(PAGED_BUF_FLUSH_BATCH, TMAX(PAGED_BUF_FLUSH_BYTES / pBuf->pageSize, 1));
+
+  SListIter iter = {0};
+  tdListInitIter(pBuf->lruList, &iter, TD_LIST_BACKWARD);
+
+  SListNode* pn = NULL;
+  while ((pn = tdListNext(&iter)) != NULL && (numOfCold--) > 0) {
+    SPageInfo* pg = *(SPageInfo**)pn->data;
+    if (!pg->used && pg->dirty) {
+      taosArrayPush(pPages, &pg);
+      if (taosArrayGetSize(pPages) >= maxPages) {
+        break;
+      }
+    }
+  }
+
+  // all cold pages are clean, no need to scan again before they are replaced
+  if (taosArrayGetSize(pPages) == 0) {
+    pBuf->scanDelay = listNEles(pBuf->lruList) - pBuf->dirtyPages;
+  }
+}
+
+static void submitPagedBufIOTask(SDiskbasedBuf* pBuf) {
+  reapPagedBufIOTask(pBuf, false);
+  if (atomic_load_8(&pBuf->ioStatus) != PAGED_BUF_IO_IDLE) {
+    return;
+  }
+
+  SPagedBufIOTask* pTask = &pBuf->ioTask;
+  if (NO_IN_MEM_AVAILABLE_PAGES(pBuf)) {
+    collectWriteBehindPages(pBuf, pTask->pFlushPages);
+  }
+
+  // the requested pages may have been loaded since
+  int32_t num = taosArrayGetSize(pBuf->pPrefetchReq);
+  for (int32_t i = 0; i < num; ++i) {
+    int32_t*    pageId = taosArrayGet(pBuf->pPrefetchReq, i);
+    SPageInfo** pi = tSimpleHashGet(pBuf->all, pageId, sizeof(int32_t));
+    if (pi != NULL && !BUF_PAGE_IN_MEM(*pi) && HAS_DATA_IN_DISK(*pi)) {
+      taosArrayPush(pTask->pLoadPages, pi);
+    }
+  }
+  taosArrayClear(pBuf->pPrefetchReq);
+
+  int32_t numOfFlush = taosArrayGetSize(pTask->pFlushPages);
+  if (numOfFlush == 0 && taosArrayGetSize(pTask->pLoadPages) == 0) {
+    return;
+  }
+
+  int32_t code = (pagedBufThreads > 0) ? TSDB_CODE_SUCCESS : TSDB_CODE_FAILED;
+  if (code == TSDB_CODE_SUCCESS && pBuf->pFile == NULL) {
+    code = createDiskFile(pBuf);
+  }
+
+  int32_t ioBufSize = (getPagePayloadSize(pBuf) + 1) * TMAX(numOfFlush, 1);
+  if (code == TSDB_CODE_SUCCESS && pTask->ioBufSize < ioBufSize) {
+    char* p = taosMemoryRealloc(pTask->pIOBuf, ioBufSize);
+    if (p == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+    } else {
+      pTask->pIOBuf = p;
+      pTask->ioBufSize = ioBufSize;
+    }
+  }
+
+  if (code == TSDB_CODE_SUCCESS) {
+    for (int32_t i = 0; i < numOfFlush; ++i) {
+      SPageInfo* pg = taosArrayGetP(pTask->pFlushPages, i);
+      pg->flushing = true;
+    }
+
+    atomic_store_8(&pBuf->ioStatus, PAGED_BUF_IO_RUNNING);
+    SSchedMsg schedMsg = {.fp = doPagedBufIOTask, .ahandle = pTask};
+    if (taosScheduleTask(&pagedBufQueue, &schedMsg) == 0) {
+      return;
+    }
+
+    for (int32_t i = 0; i < numOfFlush; ++i) {
+      SPageInfo* pg = taosArrayGetP(pTask->pFlushPages, i);
+      pg->flushing = false;
+    }
+    atomic_store_8(&pBuf->ioStatus, PAGED_BUF_IO_IDLE);
+  }
+
+  // the pages are written when evicted, or loaded when needed, as if there is no background task
+  taosArrayClear(pTask->pFlushPages);
+  taosArrayClear(pTask->pLoadPages);
+}
+
+static bool isPagePrefetched(SDiskbasedBuf* pBuf, int32_t pageId) {
+  for (int32_t i = 0; i < taosArrayGetSize(pBuf->pPrefetchReq); ++i) {
+    if (*(int32_t*)taosArrayGet(pBuf->pPrefetchReq, i) == pageId) {
+      return true;
+    }
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pBuf->pPrefetched); ++i) {
+    if (((SPrefetchedPage*)taosArrayGet(pBuf->pPrefetched, i))->pageId == pageId) {
+      return true;
+    }
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pBuf->ioTask.pLoadPages); ++i) {
+    if (((SPageInfo*)taosArrayGetP(pBuf->ioTask.pLoadPages, i))->pageId == pageId) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// the page has been read ahead, use the loaded copy instead of the page extracted for it
+static bool takePrefetchedPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
+  int32_t num = taosArrayGetSize(pBuf->pPrefetched);
+  for (int32_t i = 0; i < num; ++i) {
+    SPrefetchedPage* pPage = taosArrayGet(pBuf->pPrefetched, i);
+    if (pPage->pageId == pg->pageId) {
+      taosMemoryFree(pg->pData);
+      pg->pData = pPage->pData;
+      ((void**)pg->pData)[0] = pg;
+      taosArrayRemove(pBuf->pPrefetched, i);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void clearPrefetchedPages(SDiskbasedBuf* pBuf) {
+  int32_t num = taosArrayGetSize(pBuf->pPrefetched);
+  for (int32_t i = 0; i < num; ++i) {
+    SPrefetchedPage* pPage = taosArrayGet(pBuf->pPrefetched, i);
+    taosMemoryFree(pPage->pData);
+  }
+
+  taosArrayClear(pBuf->pPrefetched);
+  taosArrayClear(pBuf->pPrefetchReq);
+}
+
+static int32_t loadBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
+  reapPagedBufIOTask(pBuf, false);
+  if (takePrefetchedPage(pBuf, pg)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // the file is used by the background task, which may be reading this page right now
+  reapPagedBufIOTask(pBuf, true);
+  if (takePrefetchedPage(pBuf, pg)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  return loadPageFromDisk(pBuf, pg);
+}
+
 static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
   pBuf->numOfPages += 1;
 
@@ -278,6 +680,7 @@ static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
   ppi->used = true;
   ppi->pn = NULL;
   ppi->dirty = false;
+  ppi->flushing = false;
 
   return *(SPageInfo**)taosArrayPush(pBuf->pIdList, &ppi);
 }
@@ -293,7 +696,7 @@ static SListNode* getEldestUnrefedPage(SDiskbasedBuf* pBuf) {
     SPageInfo* p = *(SPageInfo**)(pageInfo->pData);
     ASSERT(pageInfo->pageId >= 0 && pageInfo->pn == pn && p == pageInfo);
 
-    if (!pageInfo->used) {
+    if (!pageInfo->used && !pageInfo->flushing) {
       break;
     }
   }
@@ -303,6 +706,14 @@ static SListNode* getEldestUnrefedPage(SDiskbasedBuf* pBuf) {
 
 static char* evictBufPage(SDiskbasedBuf* pBuf) {
   SListNode* pn = getEldestUnrefedPage(pBuf);
+
+  // A dirty page is written by the query thread, which has to wait for the background task that owns the file. So
+  // does the case that all the unused pages are being written by the task.
+  if (atomic_load_8(&pBuf->ioStatus) != PAGED_BUF_IO_IDLE && (pn == NULL || (*(SPageInfo**)pn->data)->dirty)) {
+    reapPagedBufIOTask(pBuf, true);
+    pn = getEldestUnrefedPage(pBuf);
+  }
+
   if (pn == NULL) {  // no available buffer pages now, return.
     terrno = TSDB_CODE_OUT_OF_MEMORY;
     return NULL;
@@ -346,6 +757,9 @@ int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMem
     goto _error;
   }
 
+  taosThreadMutexInit(&pPBuf->ioLock, NULL);
+  taosThreadCondInit(&pPBuf->ioCond, NULL);
+
   pPBuf->pageSize = pagesize;
   pPBuf->numOfPages = 0;  // all pages are in buffer in the first place
   pPBuf->totalBufSize = 0;
@@ -362,6 +776,7 @@ int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMem
   }
 
   pPBuf->inMemPages = inMemBufSize / pagesize;  // maximum allowed pages, it is a soft limit.
+  pPBuf->dirtyPages = (int32_t)((int64_t)pPBuf->inMemPages * TMIN(TMAX(tsPagedBufDirtyRatio, 0), 100) / 100);
   pPBuf->lruList = tdListNew(POINTER_BYTES);
   if (pPBuf->lruList == NULL) {
     goto _error;
@@ -382,6 +797,21 @@ int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMem
   pPBuf->prefix = (char*)dir;
   pPBuf->emptyDummyIdList = taosArrayInit(1, sizeof(int32_t));
 
+  SPagedBufIOTask* pTask = &pPBuf->ioTask;
+  pTask->pBuf = pPBuf;
+  pTask->pFlushPages = taosArrayInit(4, POINTER_BYTES);
+  pTask->pFlushPos = taosArrayInit(4, sizeof(SPageDiskInfo));
+  pTask->pLoadPages = taosArrayInit(4, POINTER_BYTES);
+  pTask->pLoadData = taosArrayInit(4, POINTER_BYTES);
+  pPBuf->pPrefetchReq = taosArrayInit(4, sizeof(int32_t));
+  pPBuf->pPrefetched = taosArrayInit(4, sizeof(SPrefetchedPage));
+  if (pTask->pFlushPages == NULL || pTask->pFlushPos == NULL || pTask->pLoadPages == NULL ||
+      pTask->pLoadData == NULL || pPBuf->pPrefetchReq == NULL || pPBuf->pPrefetched == NULL) {
+    goto _error;
+  }
+
+  setBufPageCompressOnDisk(pPBuf, tsPagedBufCompress);
+
   //  qDebug("QInfo:0x%"PRIx64" create resBuf for output, page size:%d, inmem buf pages:%d, file:%s", qId,
   //  pPBuf->pageSize, pPBuf->inMemPages, pPBuf->path);
 
@@ -398,6 +828,8 @@ static char* doExtractPage(SDiskbasedBuf* pBuf, bool* newPage) {
     if (availablePage == NULL) {
       uWarn("no available buf pages, current:%d, max:%d, reason: %s, %s", listNEles(pBuf->lruList), pBuf->inMemPages,
             terrstr(), pBuf->id)
+    } else {  // get the next pages to evict ready
+      submitPagedBufIOTask(pBuf);
     }
   } else {
     availablePage =
@@ -474,6 +906,10 @@ void* getBufPage(SDiskbasedBuf* pBuf, int32_t id) {
   }
 
   if (BUF_PAGE_IN_MEM(*pi)) {  // it is in memory
+    if ((*pi)->flushing) {  // it is being written by the background task
+      reapPagedBufIOTask(pBuf, true);
+    }
+
     // no need to update the LRU list if only one page exists
     if (pBuf->numOfPages == 1) {
       (*pi)->used = true;
@@ -514,7 +950,7 @@ void* getBufPage(SDiskbasedBuf* pBuf, int32_t id) {
 
     // some data has been flushed to disk, and needs to be loaded into buffer again.
     if (HAS_DATA_IN_DISK(*pi)) {
-      int32_t code = loadPageFromDisk(pBuf, *pi);
+      int32_t code = loadBufPage(pBuf, *pi);
       if (code != 0) {
         if (newPage) {
           taosMemoryFree((*pi)->pData);
@@ -567,6 +1003,7 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
     return;
   }
 
+  reapPagedBufIOTask(pBuf, true);
   dBufPrintStatis(pBuf);
 
   bool needRemoveFile = false;
@@ -595,6 +1032,11 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
           ps->getPages, ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->loadBytes / 1024.0f,
           ps->loadPages, ps->loadBytes / (1024.0 * ps->loadPages));
     }
+
+    if (ps->flushPages > 0 || ps->loadPages > 0) {
+      uDebug("Background write/read-ahead pages:%d/%d, io stall:%.3f ms, %s", ps->asyncFlushPages, ps->prefetchPages,
+             ps->stallTime / 1000.0, pBuf->id);
+    }
   }
 
   if (needRemoveFile) {
@@ -621,6 +1063,19 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
   taosArrayDestroy(pBuf->emptyDummyIdList);
   taosArrayDestroy(pBuf->pFree);
 
+  if (pBuf->pPrefetched != NULL) {
+    clearPrefetchedPages(pBuf);
+  }
+  taosArrayDestroy(pBuf->pPrefetched);
+  taosArrayDestroy(pBuf->pPrefetchReq);
+  taosArrayDestroy(pBuf->ioTask.pFlushPages);
+  taosArrayDestroy(pBuf->ioTask.pFlushPos);
+  taosArrayDestroy(pBuf->ioTask.pLoadPages);
+  taosArrayDestroy(pBuf->ioTask.pLoadData);
+  taosMemoryFreeClear(pBuf->ioTask.pIOBuf);
+  taosThreadCondDestroy(&pBuf->ioCond);
+  taosThreadMutexDestroy(&pBuf->ioLock);
+
   tSimpleHashCleanup(pBuf->all);
 
   taosMemoryFreeClear(pBuf->id);
@@ -650,12 +1105,15 @@ void setBufPageDirty(void* pPage, bool dirty) {
 void setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp) {
   pBuf->comp = comp;
   if (comp  && (pBuf->assistBuf == NULL)) {
-    pBuf->assistBuf = taosMemoryMalloc(pBuf->pageSize + 2);  // EXTRA BYTES
+    pBuf->assistBuf = taosMemoryMalloc(getPagePayloadSize(pBuf) + 1);  // 1 byte for the codec indicator
   }
 }
 
 void dBufSetBufPageRecycled(SDiskbasedBuf* pBuf, void* pPage) {
   SPageInfo* ppi = getPageInfoFromPayload(pPage);
+  if (ppi->flushing) {
+    reapPagedBufIOTask(pBuf, true);
+  }
 
   ppi->used = false;
   ppi->dirty = false;
@@ -669,6 +1127,27 @@ void dBufSetBufPageRecycled(SDiskbasedBuf* pBuf, void* pPage) {
   tdListAppend(pBuf->freePgList, &ppi);
 }
 
+void dBufPrefetchPages(SDiskbasedBuf* pBuf, const int32_t* pageIds, int32_t num) {
+  int32_t maxPages = TMIN(PAGED_BUF_PREFETCH_PAGES, TMAX(pBuf->inMemPages / 4, 1));
+  int32_t numOfPending = taosArrayGetSize(pBuf->pPrefetchReq) + taosArrayGetSize(pBuf->pPrefetched) +
+                         taosArrayGetSize(pBuf->ioTask.pLoadPages);
+
+  for (int32_t i = 0; i < num && numOfPending < maxPages; ++i) {
+    SPageInfo** pi = tSimpleHashGet(pBuf->all, &pageIds[i], sizeof(int32_t));
+    if (pi == NULL || *pi == NULL || BUF_PAGE_IN_MEM(*pi) || !HAS_DATA_IN_DISK(*pi) ||
+        isPagePrefetched(pBuf, pageIds[i])) {
+      continue;
+    }
+
+    taosArrayPush(pBuf->pPrefetchReq, &pageIds[i]);
+    numOfPending += 1;
+  }
+
+  if (taosArrayGetSize(pBuf->pPrefetchReq) > 0) {
+    submitPagedBufIOTask(pBuf);
+  }
+}
+
 void dBufSetPrintInfo(SDiskbasedBuf* pBuf) { pBuf->printStatis = true; }
 
 SDiskbasedBufStatis getDBufStatis(const SDiskbasedBuf* pBuf) { return pBuf->statis; }
@@ -700,6 +1179,9 @@ void dBufPrintStatis(const SDiskbasedBuf* pBuf) {
 }
 
 void clearDiskbasedBuf(SDiskbasedBuf* pBuf) {
+  reapPagedBufIOTask(pBuf, true);
+  clearPrefetchedPages(pBuf);
+
   size_t n = taosArrayGetSize(pBuf->pIdList);
   for (int32_t i = 0; i < n; ++i) {
     SPageInfo* pi = taosArrayGetP(pBuf->pIdList, i);
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+#include "tcompression.h"
+#include "tdef.h"
+
+typedef int32_t (*FCompress)(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int32_t nOut, uint8_t cmprAlg,
+                             void *pBuf, int32_t nBuf);
+
+typedef struct {
+  const char *name;
+  int8_t      type;
+  int32_t     bytes;
+  FCompress   compress;
+  FCompress   decompress;
+} SCodecInfo;
+
+static SCodecInfo tsCodecs[] = {
+    {"timestamp", TSDB_DATA_TYPE_TIMESTAMP, LONG_BYTES, tsCompressTimestamp, tsDecompressTimestamp},
+    {"tinyint", TSDB_DATA_TYPE_TINYINT, CHAR_BYTES, tsCompressTinyint, tsDecompressTinyint},
+    {"smallint", TSDB_DATA_TYPE_SMALLINT, SHORT_BYTES, tsCompressSmallint, tsDecompressSmallint},
+    {"int", TSDB_DATA_TYPE_INT, INT_BYTES, tsCompressInt, tsDecompressInt},
+    {"bigint", TSDB_DATA_TYPE_BIGINT, LONG_BYTES, tsCompressBigint, tsDecompressBigint},
+    {"float", TSDB_DATA_TYPE_FLOAT, FLOAT_BYTES, tsCompressFloat, tsDecompressFloat},
+    {"double", TSDB_DATA_TYPE_DOUBLE, DOUBLE_BYTES, tsCompressDouble, tsDecompressDouble},
+};
+
+// slowly changing values, which is what the delta and xor based codecs are designed for
+static void genData(int8_t type, int32_t numOfRows, char *pData) {
+  int64_t ts = 1600000000000;
+  int64_t v = 0;
+  double  d = 20.0;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    ts += 1000 + (int64_t)(taosRand() % 3);
+    v += (int64_t)(taosRand() % 7) - 3;
+    d += ((int32_t)(taosRand() % 100) - 50) / 1000.0;
+    switch (type) {
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        ((int64_t *)pData)[i] = ts;
+        break;
+      case TSDB_DATA_TYPE_TINYINT:
+        ((int8_t *)pData)[i] = (int8_t)v;
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        ((int16_t *)pData)[i] = (int16_t)v;
+        break;
+      case TSDB_DATA_TYPE_INT:
+        ((int32_t *)pData)[i] = (int32_t)v;
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+        ((int64_t *)pData)[i] = v;
+        break;
+      case TSDB_DATA_TYPE_FLOAT:
+        ((float *)pData)[i] = (float)d;
+        break;
+      case TSDB_DATA_TYPE_DOUBLE:
+        ((double *)pData)[i] = d;
+        break;
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int32_t numOfRows = 4096;
+  int32_t rounds = 10000;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-n") == 0 && i < argc - 1) {
+      numOfRows = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0 && i < argc - 1) {
+      rounds = atoi(argv[++i]);
+    } else {
+      printf("\nusage: %s [options] \n", argv[0]);
+      printf("  [-n rows]: number of values per block, default is:%d\n", numOfRows);
+      printf("  [-r rounds]: number of decompressions per codec, default is:%d\n", rounds);
+      printf("  [-h help]: print out this help\n\n");
+      exit(0);
+    }
+  }
+  if (numOfRows <= 0) numOfRows = 1;
+  if (rounds <= 0) rounds = 1;
+
+  taosGetSystemInfo();
+  char avx2 = tsAVX2Enable;
+  char avx512 = tsAVX512Enable;
+
+  // each level is measured only if it is both compiled in and supported by the cpu
+  const char *levels[] = {"scalar", "avx2", "avx512"};
+  bool        enabled[] = {true, false, false};
+#if __AVX2__
+  enabled[1] = avx2;
+#endif
+#if __AVX512F__
+  enabled[2] = avx512;
+#endif
+
+  int32_t size = numOfRows * LONG_BYTES;
+  char   *pRaw = taosMemoryMalloc(size);
+  char   *pCmpr = taosMemoryMalloc(size + 1);
+  char   *pOut = taosMemoryMalloc(size);
+
+  printf("rows:%d rounds:%d\n", numOfRows, rounds);
+  printf("%-10s %8s %8s %10s %10s %10s\n", "type", "rawKB", "ratio", levels[0], levels[1], levels[2]);
+
+  for (int32_t c = 0; c < tListLen(tsCodecs); ++c) {
+    SCodecInfo *pCodec = &tsCodecs[c];
+    int32_t     rawSize = numOfRows * pCodec->bytes;
+
+    genData(pCodec->type, numOfRows, pRaw);
+    int32_t cmprSize = pCodec->compress(pRaw, rawSize, numOfRows, pCmpr, size + 1, ONE_STAGE_COMP, NULL, 0);
+
+    double gbps[3] = {0};
+    for (int32_t l = 0; l < 3; ++l) {
+      if (!enabled[l]) continue;
+
+      tsSIMDBuiltins = (l > 0);
+      tsAVX2Enable = (l == 1) ? avx2 : 0;
+      tsAVX512Enable = (l == 2) ? avx512 : 0;
+
+      int64_t start = taosGetTimestampUs();
+      for (int32_t r = 0; r < rounds; ++r) {
+        pCodec->decompress(pCmpr, cmprSize, numOfRows, pOut, rawSize, ONE_STAGE_COMP, NULL, 0);
+      }
+      int64_t elapsed = TMAX(taosGetTimestampUs() - start, 1);
+      gbps[l] = (double)rawSize * rounds / elapsed / 1000.0;
+
+      if (memcmp(pOut, pRaw, rawSize) != 0) {
+        printf("%s: %s decoding does not match the input\n", pCodec->name, levels[l]);
+        return -1;
+      }
+    }
+
+    printf("%-10s %8.1f %8.2f %10.2f %10.2f %10.2f\n", pCodec->name, rawSize / 1024.0, (double)rawSize / cmprSize,
+           gbps[0], gbps[1], gbps[2]);
+  }
+  printf("throughput in GB/s of decompressed data, 0 means the level is not available\n");
+
+  tsSIMDBuiltins = 0;
+  tsAVX2Enable = avx2;
+  tsAVX512Enable = avx512;
+  taosMemoryFree(pRaw);
+  taosMemoryFree(pCmpr);
+  taosMemoryFree(pOut);
+  return 0;
+}
@@ -219,6 +219,63 @@ void testFlushAndReadBackBuffer() {
   destroyDiskbasedBuf(pBuf);
 }
 
+// pages evicted by the background writer and read ahead on hint must come back unchanged, compressible or not
+void asyncSpillTest(int32_t dirtyRatio, bool comp) {
+  int32_t dirtyRatio0 = tsPagedBufDirtyRatio;
+  bool    comp0 = tsPagedBufCompress;
+  tsPagedBufDirtyRatio = dirtyRatio;
+  tsPagedBufCompress = comp;
+
+  SDiskbasedBuf* pBuf = NULL;
+  int32_t        pageSize = 4096;
+  int32_t        numOfPages = 256;
+  ASSERT_EQ(createDiskbasedBuf(&pBuf, pageSize, pageSize * 8, "asyncSpillTest", TD_TMP_DIR_PATH), 0);
+
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    int32_t    pageId = -1;
+    SFilePage* pPg = static_cast<SFilePage*>(getNewBufPage(pBuf, &pageId));
+    ASSERT_TRUE(pPg != NULL);
+    ASSERT_EQ(pageId, i);
+
+    int32_t* p = (int32_t*)pPg->data;
+    for (int32_t j = 0; j < pageSize / sizeof(int32_t); ++j) {
+      p[j] = (i % 2 == 0) ? i : taosRand();  // odd pages can not be compressed
+    }
+    p[0] = i;
+    setBufPageDirty(pPg, true);
+    releaseBufPage(pBuf, pPg);
+  }
+
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    int32_t next = i + 1;
+    if (next < numOfPages) {
+      dBufPrefetchPages(pBuf, &next, 1);
+    }
+
+    SFilePage* pPg = static_cast<SFilePage*>(getBufPage(pBuf, i));
+    ASSERT_TRUE(pPg != NULL);
+    int32_t* p = (int32_t*)pPg->data;
+    ASSERT_EQ(p[0], i);
+    if (i % 2 == 0) {
+      ASSERT_EQ(p[pageSize / sizeof(int32_t) - 1], i);
+    }
+    releaseBufPage(pBuf, pPg);
+  }
+
+  SDiskbasedBufStatis statis = getDBufStatis(pBuf);
+  ASSERT_GT(statis.loadPages, 0);
+  ASSERT_GT(statis.prefetchPages, 0);
+  if (dirtyRatio < 100) {
+    ASSERT_GT(statis.asyncFlushPages, 0);
+  } else {
+    ASSERT_EQ(statis.asyncFlushPages, 0);
+  }
+
+  destroyDiskbasedBuf(pBuf);
+  tsPagedBufDirtyRatio = dirtyRatio0;
+  tsPagedBufCompress = comp0;
+}
+
 }  // namespace
 
 TEST(testCase, resultBufferTest) {
@@ -229,4 +286,12 @@ TEST(testCase, resultBufferTest) {
   testFlushAndReadBackBuffer();
 }
 
+TEST(testCase, asyncSpillTest) {
+  ASSERT_EQ(dBufInitIOPool(), 0);
+  asyncSpillTest(0, false);
+  asyncSpillTest(50, true);
+  asyncSpillTest(100, true);
+  dBufCleanupIOPool();
+}
+
 #pragma GCC diagnostic pop
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// plan cache benchmark, the same select statement is repeated so its plan is taken from the plan cache of the client,
+// then the statement is run with a different constant every time so it is always planned again. The end-to-end
+// latency of both rounds is reported, set queryPlanCacheSize to 0 in taos.cfg to get the baseline without the cache.
+// to compile: gcc -o planCacheBench planCacheBench.c -ltaos
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "taos.h"
+
+static char    host[128] = "localhost";
+static char    dbName[64] = "plan_cache_bench";
+static int     numOfTables = 10;
+static int     numOfRows = 100;
+static int64_t numOfQueries = 10000;
+
+static int64_t getTimeUs() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static int execSql(TAOS *taos, const char *sql) {
+  TAOS_RES *res = taos_query(taos, sql);
+  int       code = taos_errno(res);
+  if (code != 0) {
+    printf("failed to run %s since %s\n", sql, taos_errstr(res));
+  }
+  taos_free_result(res);
+  return code;
+}
+
+static int prepareData(TAOS *taos) {
+  char sql[1024];
+  snprintf(sql, sizeof(sql), "drop database if exists %s", dbName);
+  execSql(taos, sql);
+  snprintf(sql, sizeof(sql), "create database %s vgroups 2", dbName);
+  if (execSql(taos, sql) != 0) return -1;
+  snprintf(sql, sizeof(sql), "create stable %s.stb (ts timestamp, c1 int, c2 double) tags (t1 int)", dbName);
+  if (execSql(taos, sql) != 0) return -1;
+
+  int64_t startTs = 1600000000000;
+  for (int t = 0; t < numOfTables; ++t) {
+    for (int r = 0; r < numOfRows; r += 10) {
+      int len = snprintf(sql, sizeof(sql), "insert into %s.t%d using %s.stb tags(%d) values", dbName, t, dbName, t);
+      for (int i = r; i < r + 10 && i < numOfRows; ++i) {
+        len += snprintf(sql + len, sizeof(sql) - len, "(%" PRId64 ",%d,%f)", startTs + i, i, i * 0.5);
+      }
+      if (execSql(taos, sql) != 0) return -1;
+    }
+  }
+  return 0;
+}
+
+static int64_t runQueries(TAOS *taos, bool sameSql) {
+  char    sql[256];
+  int64_t start = getTimeUs();
+  for (int64_t i = 0; i < numOfQueries; ++i) {
+    snprintf(sql, sizeof(sql), "select count(*), avg(c2) from stb where c1 > %d group by t1",
+             sameSql ? numOfRows / 2 : (int)(i % 1000000));
+
+    TAOS_RES *res = taos_query(taos, sql);
+    if (taos_errno(res) != 0) {
+      printf("failed to run %s since %s\n", sql, taos_errstr(res));
+      taos_free_result(res);
+      return -1;
+    }
+    while (taos_fetch_row(res) != NULL) {
+    }
+    taos_free_result(res);
+  }
+  return getTimeUs() - start;
+}
+
+static void printHelp(const char *name) {
+  printf("usage: %s [-h host] [-d db] [-t tables] [-r rows per table] [-n queries]\n", name);
+}
+
+int main(int argc, char *argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 >= argc) {
+      printHelp(argv[0]);
+      return 1;
+    } else if (strcmp(argv[i], "-h") == 0) {
+      snprintf(host, sizeof(host), "%s", argv[++i]);
+    } else if (strcmp(argv[i], "-d") == 0) {
+      snprintf(dbName, sizeof(dbName), "%s", argv[++i]);
+    } else if (strcmp(argv[i], "-t") == 0) {
+      numOfTables = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0) {
+      numOfRows = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0) {
+      numOfQueries = atoll(argv[++i]);
+    } else {
+      printHelp(argv[0]);
+      return 1;
+    }
+  }
+  if (numOfTables <= 0 || numOfRows <= 0 || numOfQueries <= 0) {
+    printHelp(argv[0]);
+    return 1;
+  }
+
+  TAOS *taos = taos_connect(host, "root", "taosdata", NULL, 0);
+  if (taos == NULL) {
+    printf("failed to connect to %s\n", host);
+    return 1;
+  }
+  if (prepareData(taos) != 0 || taos_select_db(taos, dbName) != 0) {
+    taos_close(taos);
+    return 1;
+  }
+
+  int64_t sameUs = runQueries(taos, true);
+  int64_t diffUs = runQueries(taos, false);
+  if (sameUs >= 0 && diffUs >= 0) {
+    printf("queries:%" PRId64 ", same sql avg latency:%.1fus, different sql avg latency:%.1fus\n", numOfQueries,
+           (double)sameUs / (double)numOfQueries, (double)diffUs / (double)numOfQueries);
+  }
+
+  taos_close(taos);
+  taos_cleanup();
+  return (sameUs >= 0 && diffUs >= 0) ? 0 : 1;
+}
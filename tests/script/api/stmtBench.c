@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// stmt insert benchmark, every thread binds batches of fixed-width columns into its own table with
+// taos_stmt_bind_param_batch. The rows/s of the client bind (bind + add batch) and of the whole insert are reported
+// per thread, run it against two client builds to compare bind paths.
+// to compile: gcc -o stmtBench stmtBench.c -ltaos -lpthread
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "taos.h"
+
+#define NUM_OF_COLS 6
+
+typedef struct {
+  int       index;
+  pthread_t thread;
+  int64_t   bindUs;
+  int64_t   totalUs;
+  int64_t   rows;
+  int       code;
+} SThreadInfo;
+
+static char    host[128] = "localhost";
+static char    dbName[64] = "stmt_bench";
+static int     numOfThreads = 1;
+static int64_t numOfRows = 1000000;
+static int     batchRows = 10000;
+static int     nullStep = 0;  // every n-th row of c5 is null, 0 means no null
+
+static int64_t getTimeUs() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static int execSql(TAOS *taos, const char *sql) {
+  TAOS_RES *res = taos_query(taos, sql);
+  int       code = taos_errno(res);
+  if (code != 0) {
+    printf("failed to run %s since %s\n", sql, taos_errstr(res));
+  }
+  taos_free_result(res);
+  return code;
+}
+
+static void *insertFunc(void *param) {
+  SThreadInfo *pInfo = (SThreadInfo *)param;
+  TAOS        *taos = taos_connect(host, "root", "taosdata", dbName, 0);
+  if (taos == NULL) {
+    printf("thread:%d, failed to connect to %s\n", pInfo->index, host);
+    pInfo->code = -1;
+    return NULL;
+  }
+
+  char sql[256];
+  snprintf(sql, sizeof(sql), "create table if not exists t%d using stb tags(%d)", pInfo->index, pInfo->index);
+  if ((pInfo->code = execSql(taos, sql)) != 0) {
+    taos_close(taos);
+    return NULL;
+  }
+
+  int64_t *ts = malloc(sizeof(int64_t) * batchRows);
+  int32_t *c1 = malloc(sizeof(int32_t) * batchRows);
+  int64_t *c2 = malloc(sizeof(int64_t) * batchRows);
+  double  *c3 = malloc(sizeof(double) * batchRows);
+  float   *c4 = malloc(sizeof(float) * batchRows);
+  int32_t *c5 = malloc(sizeof(int32_t) * batchRows);
+  char    *isNull = calloc(batchRows, 1);
+
+  TAOS_MULTI_BIND bind[NUM_OF_COLS] = {0};
+  bind[0] = (TAOS_MULTI_BIND){TSDB_DATA_TYPE_TIMESTAMP, ts, sizeof(int64_t), NULL, NULL, 0};
+  bind[1] = (TAOS_MULTI_BIND){TSDB_DATA_TYPE_INT, c1, sizeof(int32_t), NULL, NULL, 0};
+  bind[2] = (TAOS_MULTI_BIND){TSDB_DATA_TYPE_BIGINT, c2, sizeof(int64_t), NULL, NULL, 0};
+  bind[3] = (TAOS_MULTI_BIND){TSDB_DATA_TYPE_DOUBLE, c3, sizeof(double), NULL, NULL, 0};
+  bind[4] = (TAOS_MULTI_BIND){TSDB_DATA_TYPE_FLOAT, c4, sizeof(float), NULL, NULL, 0};
+  bind[5] = (TAOS_MULTI_BIND){TSDB_DATA_TYPE_INT, c5, sizeof(int32_t), NULL, nullStep > 0 ? isNull : NULL, 0};
+
+  TAOS_STMT *stmt = taos_stmt_init(taos);
+  snprintf(sql, sizeof(sql), "insert into t%d values(?,?,?,?,?,?)", pInfo->index);
+  if (stmt == NULL || taos_stmt_prepare(stmt, sql, 0) != 0) {
+    printf("thread:%d, failed to prepare since %s\n", pInfo->index, taos_stmt_errstr(stmt));
+    pInfo->code = -1;
+    goto _end;
+  }
+
+  int64_t startTs = 1600000000000;
+  int64_t start = getTimeUs();
+  for (int64_t r = 0; r < numOfRows; r += batchRows) {
+    int num = (int)((numOfRows - r) < batchRows ? (numOfRows - r) : batchRows);
+    for (int i = 0; i < num; ++i) {
+      ts[i] = startTs + r + i;
+      c1[i] = (int32_t)(r + i);
+      c2[i] = r + i;
+      c3[i] = (r + i) * 0.5;
+      c4[i] = (float)i;
+      c5[i] = i;
+      isNull[i] = (nullStep > 0 && i % nullStep == 0);
+    }
+    for (int c = 0; c < NUM_OF_COLS; ++c) {
+      bind[c].num = num;
+    }
+
+    int64_t bindStart = getTimeUs();
+    if (taos_stmt_bind_param_batch(stmt, bind) != 0 || taos_stmt_add_batch(stmt) != 0) {
+      printf("thread:%d, failed to bind since %s\n", pInfo->index, taos_stmt_errstr(stmt));
+      pInfo->code = -1;
+      break;
+    }
+    pInfo->bindUs += getTimeUs() - bindStart;
+
+    if (taos_stmt_execute(stmt) != 0) {
+      printf("thread:%d, failed to execute since %s\n", pInfo->index, taos_stmt_errstr(stmt));
+      pInfo->code = -1;
+      break;
+    }
+    pInfo->rows += num;
+  }
+  pInfo->totalUs = getTimeUs() - start;
+
+_end:
+  taos_stmt_close(stmt);
+  taos_close(taos);
+  free(ts);
+  free(c1);
+  free(c2);
+  free(c3);
+  free(c4);
+  free(c5);
+  free(isNull);
+  return NULL;
+}
+
+static void printHelp(const char *name) {
+  printf("usage: %s [-h host] [-d db] [-t threads] [-n rows per thread] [-b rows per batch] [-N null step]\n", name);
+}
+
+int main(int argc, char *argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 >= argc) {
+      printHelp(argv[0]);
+      return 1;
+    } else if (strcmp(argv[i], "-h") == 0) {
+      snprintf(host, sizeof(host), "%s", argv[++i]);
+    } else if (strcmp(argv[i], "-d") == 0) {
+      snprintf(dbName, sizeof(dbName), "%s", argv[++i]);
+    } else if (strcmp(argv[i], "-t") == 0) {
+      numOfThreads = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0) {
+      numOfRows = atoll(argv[++i]);
+    } else if (strcmp(argv[i], "-b") == 0) {
+      batchRows = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-N") == 0) {
+      nullStep = atoi(argv[++i]);
+    } else {
+      printHelp(argv[0]);
+      return 1;
+    }
+  }
+  if (numOfThreads <= 0 || numOfRows <= 0 || batchRows <= 0) {
+    printHelp(argv[0]);
+    return 1;
+  }
+
+  TAOS *taos = taos_connect(host, "root", "taosdata", NULL, 0);
+  if (taos == NULL) {
+    printf("failed to connect to %s\n", host);
+    return 1;
+  }
+
+  char sql[256];
+  snprintf(sql, sizeof(sql), "drop database if exists %s", dbName);
+  execSql(taos, sql);
+  snprintf(sql, sizeof(sql), "create database %s", dbName);
+  if (execSql(taos, sql) != 0) return 1;
+  snprintf(sql, sizeof(sql),
+           "create stable %s.stb (ts timestamp, c1 int, c2 bigint, c3 double, c4 float, c5 int) tags (t1 int)", dbName);
+  if (execSql(taos, sql) != 0) return 1;
+  taos_close(taos);
+
+  SThreadInfo *pInfos = calloc(numOfThreads, sizeof(SThreadInfo));
+  for (int i = 0; i < numOfThreads; ++i) {
+    pInfos[i].index = i;
+    pthread_create(&pInfos[i].thread, NULL, insertFunc, &pInfos[i]);
+  }
+
+  double bindRate = 0;
+  double totalRate = 0;
+  for (int i = 0; i < numOfThreads; ++i) {
+    pthread_join(pInfos[i].thread, NULL);
+    SThreadInfo *pInfo = &pInfos[i];
+    double       bind = pInfo->bindUs > 0 ? pInfo->rows * 1000000.0 / pInfo->bindUs : 0;
+    double       total = pInfo->totalUs > 0 ? pInfo->rows * 1000000.0 / pInfo->totalUs : 0;
+    printf("thread:%d, code:%d, rows:%" PRId64 ", bind rows/s:%.0f, insert rows/s:%.0f\n", i, pInfo->code, pInfo->rows,
+           bind, total);
+    bindRate += bind;
+    totalRate += total;
+  }
+
+  printf("threads:%d, batch rows:%d, null step:%d, avg bind rows/s per thread:%.0f, avg insert rows/s per thread:%.0f\n",
+         numOfThreads, batchRows, nullStep, bindRate / numOfThreads, totalRate / numOfThreads);
+
+  free(pInfos);
+  taos_cleanup();
+  return 0;
+}
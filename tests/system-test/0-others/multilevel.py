@@ -242,6 +242,19 @@ class TDTestCase:
         time.sleep(3)
         tdSql.haveFile('/mnt/data1/',1)
         tdSql.haveFile('/mnt/data2/',1)
+        self.check_migrate_progress('dbtest')
+
+    def check_migrate_progress(self, dbname):
+        # the progress is reported with the vnode load of the status message, only the vgroup of tb1 has data
+        for i in range(30):
+            tdSql.query(f"select sum(migrate_size), sum(migrate_done), max(migrate_speed) from information_schema.ins_vgroups where db_name='{dbname}'")
+            if (tdSql.queryResult[0][0] or 0) > 0:
+                break
+            time.sleep(1)
+        tdLog.info(f"migrate progress of {dbname}: {tdSql.queryResult}")
+        size = tdSql.queryResult[0][0] or 0
+        if size <= 0 or tdSql.queryResult[0][1] != size or tdSql.queryResult[0][2] <= 0:
+            tdLog.exit(f"unexpected migrate progress {tdSql.queryResult}")
 
     def run(self):
         self.basic()
@@ -0,0 +1,82 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.rowNum = 5000
+        self.ts = 1537146000000
+        self.aggs = "_wstart, _wend, count(*), count(c1), sum(c1), min(c1), max(c2), avg(c2), spread(c3), first(c1), last(c3)"
+        self.intervals = ["interval(1a)", "interval(7a)", "interval(100a)", "interval(1s)", "interval(300a) sliding(100a)"]
+
+    # many windows in each block, a null every seventh row, and rows in both the files and the memtable
+    def prepare_data(self, dbname):
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} vgroups 1 minrows 10 maxrows 200")
+        tdSql.execute(f"create table {dbname}.ntb(ts timestamp, c1 int, c2 double, c3 bigint)")
+        tdSql.execute(f"create table {dbname}.stb(ts timestamp, c1 int, c2 double, c3 bigint) tags(t1 int)")
+        tdSql.execute(f"create table {dbname}.ctb0 using {dbname}.stb tags(0)")
+        tdSql.execute(f"create table {dbname}.ctb1 using {dbname}.stb tags(1)")
+
+        for i in range(0, self.rowNum, 100):
+            rows = []
+            for j in range(i, i + 100):
+                c1 = "null" if j % 7 == 0 else str(j % 113)
+                rows.append(f"({self.ts + j * 3}, {c1}, {j * 0.25}, {j * j})")
+            values = " ".join(rows)
+            for tb in ["ntb", "ctb0", "ctb1"]:
+                tdSql.execute(f"insert into {dbname}.{tb} values {values}")
+            if i == self.rowNum // 2:
+                tdSql.execute(f"flush database {dbname}")
+
+    def query_all(self, sql):
+        tdSql.query(sql)
+        return tdSql.queryResult
+
+    # twa needs interpolation between the windows, which keeps the operator on the per window path
+    def check_same_as_per_window(self, dbname, tb, partition=""):
+        cols = f"tbname, {self.aggs}" if partition else self.aggs
+        order = "order by 1, 2" if partition else "order by 1"
+        for interval in self.intervals:
+            batched = self.query_all(f"select {cols} from {dbname}.{tb} {partition} {interval} {order}")
+            perWindow = self.query_all(f"select {cols}, twa(c1) from {dbname}.{tb} {partition} {interval} {order}")
+            if len(batched) == 0 or len(batched) != len(perWindow):
+                tdLog.exit(f"{tb} {interval}: {len(batched)} windows, {len(perWindow)} on the per window path")
+
+            for i in range(len(batched)):
+                if tuple(batched[i]) != tuple(perWindow[i][:-1]):
+                    tdLog.exit(f"{tb} {interval} window {i}: {batched[i]} differs from {perWindow[i]}")
+
+    def check_sum(self, dbname):
+        tdSql.query(f"select count(*), count(c1), sum(c1) from {dbname}.ntb interval(100a)")
+        expectRows = (self.rowNum * 3 + 99) // 100
+        tdSql.checkRows(expectRows)
+
+        total = 0
+        for row in tdSql.queryResult:
+            total += row[0]
+        if total != self.rowNum:
+            tdLog.exit(f"{total} rows in all windows, {self.rowNum} expected")
+
+        tdSql.query(f"select sum(s) from (select sum(c1) s from {dbname}.ntb interval(7a))")
+        tdSql.checkData(0, 0, sum([j % 113 for j in range(self.rowNum) if j % 7 != 0]))
+
+    def run(self):
+        dbname = "db"
+        self.prepare_data(dbname)
+
+        self.check_sum(dbname)
+        self.check_same_as_per_window(dbname, "ntb")
+        self.check_same_as_per_window(dbname, "stb", "partition by tbname")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
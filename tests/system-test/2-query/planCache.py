@@ -0,0 +1,97 @@
+import time
+import taos
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.ts = 1537146000000
+        self.user = "plan_cache_user"
+
+    def prepare_data(self, dbname):
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} vgroups 2")
+        tdSql.execute(f"create table {dbname}.stb(ts timestamp, c1 int, c2 bigint) tags(t1 int)")
+        tdSql.execute(f"create table {dbname}.ntb(ts timestamp, c1 int, c2 bigint)")
+        for i in range(4):
+            tdSql.execute(f"create table {dbname}.ctb{i} using {dbname}.stb tags({i})")
+            tdSql.execute(f"insert into {dbname}.ctb{i} values({self.ts}, {i}, {i * 2})({self.ts + 1}, {i + 10}, {i * 2 + 10})")
+        tdSql.execute(f"insert into {dbname}.ntb values({self.ts}, 1, 2)({self.ts + 1}, 3, 4)")
+
+    # the second run of a statement takes its plan from the plan cache of the client
+    def query_twice(self, sql, rows, cols):
+        for i in range(2):
+            tdSql.query(sql)
+            tdSql.checkRows(rows)
+            tdSql.checkCols(cols)
+
+    def check_alter_table(self, dbname):
+        self.query_twice(f"select * from {dbname}.ntb", 2, 3)
+        tdSql.execute(f"alter table {dbname}.ntb add column c3 int")
+        self.query_twice(f"select * from {dbname}.ntb", 2, 4)
+        tdSql.execute(f"alter table {dbname}.ntb drop column c2")
+        self.query_twice(f"select * from {dbname}.ntb", 2, 3)
+
+        self.query_twice(f"select * from {dbname}.stb", 8, 4)
+        tdSql.execute(f"alter stable {dbname}.stb add column c3 int")
+        self.query_twice(f"select * from {dbname}.stb", 8, 5)
+        tdSql.execute(f"alter stable {dbname}.stb add tag t2 int")
+        self.query_twice(f"select * from {dbname}.stb", 8, 6)
+
+        # the same versions, but a new table
+        self.query_twice(f"select c1 from {dbname}.ctb0", 2, 1)
+        tdSql.execute(f"drop table {dbname}.ctb0")
+        tdSql.execute(f"create table {dbname}.ctb0 using {dbname}.stb tags(0, 0)")
+        tdSql.execute(f"insert into {dbname}.ctb0 values({self.ts}, 100, 200, 300)")
+        self.query_twice(f"select c1 from {dbname}.ctb0", 1, 1)
+        tdSql.checkData(0, 0, 100)
+
+    def check_revoke(self, dbname):
+        tdSql.execute(f"create user {self.user} pass 'taosdata'")
+        tdSql.execute(f"grant read on {dbname} to {self.user}")
+        time.sleep(3)
+
+        conn = taos.connect(user=self.user, password="taosdata")
+        sql = f"select count(*) from {dbname}.stb"
+        for i in range(2):
+            res = conn.query(sql)
+            if res.fetch_all()[0][0] != 8:
+                tdLog.exit(f"unexpected result of {sql}")
+            res.close()
+
+        tdSql.execute(f"revoke read on {dbname} from {self.user}")
+
+        # the privileges reach the client with the heartbeat, a cached plan must not outlive them
+        revoked = False
+        for i in range(30):
+            try:
+                conn.query(sql).close()
+            except Exception as e:
+                tdLog.info(f"{sql} failed after revoke since {e}")
+                revoked = True
+                break
+            time.sleep(1)
+        conn.close()
+        if not revoked:
+            tdLog.exit(f"{sql} still succeeds after revoke")
+
+        tdSql.execute(f"drop user {self.user}")
+
+    def run(self):
+        dbname = "db"
+        self.prepare_data(dbname)
+        self.check_alter_table(dbname)
+        self.check_revoke(dbname)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,79 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    # few read ahead slots, so that one file set has many more blocks than slots
+    updatecfgDict = {'tsdbReadAheadBlocks': 2}
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.rowNum = 4000
+        self.ts = 1537146000000
+
+    def prepare_data(self, dbname):
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} vgroups 1 minrows 10 maxrows 200")
+        tdSql.execute(f"create table {dbname}.ntb(ts timestamp, c1 int, c2 bigint)")
+        for i in range(0, self.rowNum, 100):
+            values = " ".join([f"({self.ts + j}, {j}, {j * 2})" for j in range(i, i + 100)])
+            tdSql.execute(f"insert into {dbname}.ntb values {values}")
+        tdSql.execute(f"flush database {dbname}")
+
+    def check_all_blocks(self, dbname):
+        tdSql.query(f"select count(*), sum(c1), min(c1), max(c1) from {dbname}.ntb where c2 >= 0")
+        tdSql.checkData(0, 0, self.rowNum)
+        tdSql.checkData(0, 1, (self.rowNum - 1) * self.rowNum // 2)
+        tdSql.checkData(0, 2, 0)
+        tdSql.checkData(0, 3, self.rowNum - 1)
+
+        tdSql.query(f"select c1, c2 from {dbname}.ntb order by ts asc")
+        tdSql.checkRows(self.rowNum)
+        for i in range(0, self.rowNum, 199):
+            tdSql.checkData(i, 0, i)
+            tdSql.checkData(i, 1, i * 2)
+
+        tdSql.query(f"select c1, c2 from {dbname}.ntb order by ts desc")
+        tdSql.checkRows(self.rowNum)
+        for i in range(0, self.rowNum, 199):
+            tdSql.checkData(i, 0, self.rowNum - 1 - i)
+            tdSql.checkData(i, 1, (self.rowNum - 1 - i) * 2)
+
+    # most blocks are skipped by their sma, the slots of the blocks read ahead but passed must be reused
+    def check_skipped_blocks(self, dbname):
+        cond = "c1 < 100 or (c1 >= 2000 and c1 < 2100) or c1 >= 3900"
+        tdSql.query(f"select count(*), sum(c1) from {dbname}.ntb where {cond}")
+        tdSql.checkData(0, 0, 300)
+        tdSql.checkData(0, 1, 604850)
+
+        tdSql.query(f"select c1 from {dbname}.ntb where {cond} order by ts asc")
+        tdSql.checkRows(300)
+        tdSql.checkData(0, 0, 0)
+        tdSql.checkData(100, 0, 2000)
+        tdSql.checkData(299, 0, 3999)
+
+        tdSql.query(f"select c1 from {dbname}.ntb where {cond} order by ts desc")
+        tdSql.checkRows(300)
+        tdSql.checkData(0, 0, 3999)
+        tdSql.checkData(100, 0, 2099)
+        tdSql.checkData(299, 0, 0)
+
+    def run(self):
+        dbname = "db"
+        self.prepare_data(dbname)
+
+        # several rounds, so the readers and their slots are reused
+        for i in range(3):
+            self.check_all_blocks(dbname)
+            self.check_skipped_blocks(dbname)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())